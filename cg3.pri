@@ -59,6 +59,10 @@ CG3_EXAMPLES {
     include (cg3/examples.pri)
 }
 
+CG3_BENCHMARKS {
+    include (cg3/benchmarks.pri)
+}
+
 
 DISTFILES += \
     $$PWD/LICENSE \
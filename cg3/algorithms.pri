@@ -19,7 +19,13 @@ HEADERS += \
     $$PWD/algorithms/2d/convexhull2d_incremental.h \
     $$PWD/algorithms/graph_algorithms.h \
     $$PWD/algorithms/sphere_coverage.h \
-    $$PWD/algorithms/global_optimal_rotation_matrix.h
+    $$PWD/algorithms/global_optimal_rotation_matrix.h \
+    $$PWD/algorithms/surface_sampling.h \
+    $$PWD/algorithms/mesh_curvature.h \
+    $$PWD/algorithms/mesh_quality.h \
+    $$PWD/algorithms/heat_geodesics.h \
+    $$PWD/algorithms/triangle_bvh.h \
+    $$PWD/algorithms/mesh_self_intersections.h
 
 SOURCES += \
     $$PWD/algorithms/convexhull.tpp \
@@ -27,4 +33,15 @@ SOURCES += \
     $$PWD/algorithms/2d/convexhull2d_incremental.tpp \
     $$PWD/algorithms/graph_algorithms.tpp \
     $$PWD/algorithms/sphere_coverage.tpp \
-    $$PWD/algorithms/global_optimal_rotation_matrix.cpp
+    $$PWD/algorithms/global_optimal_rotation_matrix.cpp \
+    $$PWD/algorithms/global_optimal_rotation_matrix.tpp \
+    $$PWD/algorithms/surface_sampling.cpp \
+    $$PWD/algorithms/surface_sampling.tpp \
+    $$PWD/algorithms/mesh_curvature.cpp \
+    $$PWD/algorithms/mesh_quality.cpp \
+    $$PWD/algorithms/heat_geodesics.cpp \
+    $$PWD/algorithms/heat_geodesics.tpp \
+    $$PWD/algorithms/triangle_bvh.cpp \
+    $$PWD/algorithms/triangle_bvh.tpp \
+    $$PWD/algorithms/mesh_self_intersections.cpp \
+    $$PWD/algorithms/mesh_self_intersections.tpp
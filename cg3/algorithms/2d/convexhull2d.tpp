@@ -10,6 +10,7 @@
 
 #include "cg3/geometry/2d/point2d.h"
 #include "cg3/geometry/2d/utils2d.h"
+#include "cg3/utilities/profiler.h"
 
 namespace cg3 {
 
@@ -45,6 +46,7 @@ void getConvexHull2D(const InputContainer& container, OutputContainer& convexHul
 template <class T, class InputIterator, class OutputIterator>
 OutputIterator getConvexHull2D(InputIterator first, InputIterator end, OutputIterator outIt)
 {
+    CG3_PROFILE_SCOPE("getConvexHull2D");
     //If the container is empty
     if (first == end)
         return outIt;
@@ -6,6 +6,8 @@
  */
 #include "convexhull2d_incremental.h"
 
+#include "cg3/utilities/profiler.h"
+
 namespace cg3 {
 
 
@@ -72,6 +74,7 @@ IncrementalConvexHull<T>::IncrementalConvexHull(const InputContainer& container)
 template <class T> template <class InputIterator>
 void IncrementalConvexHull<T>::addPoints(const InputIterator first, const InputIterator end)
 {
+    CG3_PROFILE_SCOPE("IncrementalConvexHull::addPoints");
     for (InputIterator it = first; it != end; it++) {
         this->addPoint(*it);
     }
@@ -108,7 +111,7 @@ void IncrementalConvexHull<T>::addPoint(const Point2D<T>& point)
 template <class T> template <class OutputIterator>
 void IncrementalConvexHull<T>::getConvexHull(OutputIterator out)
 {
-
+    CG3_PROFILE_SCOPE("IncrementalConvexHull::getConvexHull");
     if (this->upper.size() > 1) {
 
         //Upper convex hull
@@ -8,6 +8,8 @@
 
 #include "convexhull.h"
 #include <Eigen/Dense>
+#include <cg3/utilities/flat_hash_map.h>
+#include <cg3/utilities/profiler.h>
 
 namespace cg3 {
 
@@ -24,11 +26,11 @@ inline void insertTet(Dcel &dcel, const Pointd &p0, const Pointd &p1, const Poin
 
 inline void horizonEdgeList(std::vector<Dcel::HalfEdge*> &horizon, const std::set<Dcel::Face*>& visibleFaces, std::set<Dcel::Vertex*>& horizonVertex, const Pointd &next_point);
 
-inline void calculateP(std::vector<std::set<Pointd> >& P, const BipartiteGraph<Pointd, unsigned int>& cg, std::vector<Dcel::HalfEdge*> &horizonEdges);
+inline void calculateP(std::vector<FlatHashSet<Pointd> >& P, const BipartiteGraph<Pointd, unsigned int>& cg, std::vector<Dcel::HalfEdge*> &horizonEdges);
 
 inline void deleteVisibleFaces(Dcel & ch, std::set<Dcel::Vertex*>& horizonVertices, const std::set<Dcel::Face*>& visibleFaces, BipartiteGraph<Pointd, unsigned int>& cg);
 
-inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdges, const Pointd & p, BipartiteGraph<Pointd, unsigned int>& cg, std::vector<std::set<Pointd> > & P);
+inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdges, const Pointd & p, BipartiteGraph<Pointd, unsigned int>& cg, std::vector<FlatHashSet<Pointd> > & P);
 
 }
 
@@ -56,6 +58,7 @@ Dcel convexHull(const InputContainer& container)
 template <class InputIterator>
 Dcel convexHull(InputIterator first, InputIterator end)
 {
+    CG3_PROFILE_SCOPE("convexHull");
     Dcel convexHull;
     BipartiteGraph<Pointd, unsigned int> cg;
 
@@ -128,7 +131,7 @@ Dcel convexHull(InputIterator first, InputIterator end)
                  * sull'orizzonte con next_point.
                  * P è quindi un array di array: ogni riga i corrisponde all'i-esimo elemento di horizon.
                  */
-                std::vector< std::set<Pointd> > P;
+                std::vector<FlatHashSet<Pointd> > P;
                 internal::calculateP(P, cg, horizonEdges);
 
                 /**
@@ -392,7 +395,7 @@ inline void horizonEdgeList(std::vector<Dcel::HalfEdge*>& horizon, const std::se
     // finché non ho ritrovaro il primo bordo
 }
 
-inline void calculateP(std::vector< std::set<Pointd> > &P, const BipartiteGraph<Pointd, unsigned int> &cg, std::vector<Dcel::HalfEdge*> &horizonEdges)
+inline void calculateP(std::vector<FlatHashSet<Pointd> > &P, const BipartiteGraph<Pointd, unsigned int> &cg, std::vector<Dcel::HalfEdge*> &horizonEdges)
 {
     Dcel::HalfEdge* he0, *he1;
     Dcel::Face* f0, *f1;
@@ -404,7 +407,7 @@ inline void calculateP(std::vector< std::set<Pointd> > &P, const BipartiteGraph<
         he1 = he0->getTwin();
         f0 = he0->getFace();
         f1 = he1->getFace();
-        // viene inserito in P[i] l'array ordinato contente i punti visibili da f0 e f1
+        // viene inserito in P[i] l'insieme contenente i punti visibili da f0 e f1
         for (const Pointd& p : cg.adjacentRightNodeIterator(f0->getId()))
             P[i].insert(p);
         for (const Pointd& p : cg.adjacentRightNodeIterator(f1->getId()))
@@ -466,7 +469,7 @@ inline void deleteVisibleFaces(Dcel & ch, std::set<Dcel::Vertex*>& horizonVertic
     }
 }
 
-inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*> & horizonEdges, const Pointd & p, BipartiteGraph<Pointd, unsigned int>& cg, std::vector<std::set<Pointd> >& P)
+inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*> & horizonEdges, const Pointd & p, BipartiteGraph<Pointd, unsigned int>& cg, std::vector<FlatHashSet<Pointd> >& P)
 {
     Dcel::Vertex* v3, *v1, *v2;                   // id di vertici della faccia inserita: v3 è SEMPRE l'id del nuovo punto inserito nel ch.
     Dcel::HalfEdge* e1, *e2, *e3;                     // id degli half edge della faccia inserita: e1 è il twin dell'edge sull'orizzonte
@@ -13,19 +13,25 @@
 #include <Eigen/Core>
 #endif
 #ifdef CG3_DCEL_DEFINED
-#include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/mesh_traits.h>
 #endif
 
 namespace cg3 {
 #ifdef CG3_WITH_EIGEN
 #ifdef CG3_DCEL_DEFINED
-Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel& inputMesh, unsigned int nDirs = 1000, bool deterministic = false);
+template <typename Mesh>
+Eigen::Matrix3d globalOptimalRotationMatrix(const Mesh& inputMesh, unsigned int nDirs = 1000, bool deterministic = false);
+
+namespace internal {
+
+void defineRotation(const Vec3& zAxis, Vec3& rotationAxis, double& angle);
+
+} //namespace cg3::internal
 #endif // CG3_DCEL_DEFINED
-#ifdef CG3_EIGENMESH_DEFINED
-Eigen::Matrix3d globalOptimalRotationMatrix(const SimpleEigenMesh& inputMesh, unsigned int nDirs = 1000, bool deterministic = false);
-#endif // CG3_EIGENMESH_DEFINED
 #endif // CG3_WITH_EIGEN
 
 }
 
+#include "global_optimal_rotation_matrix.tpp"
+
 #endif // CG3_GLOBAL_OPTIMAL_ROTATION_MATRIX_H
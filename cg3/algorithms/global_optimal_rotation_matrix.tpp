@@ -0,0 +1,67 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ * @author Marco Livesu (marco.livesu@gmail.com)
+ */
+#include "global_optimal_rotation_matrix.h"
+
+#include <set>
+#include <cg3/geometry/transformations.h>
+
+namespace cg3 {
+
+#ifdef CG3_WITH_EIGEN
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @brief globalOptimalRotationMatrix
+ * Returns the rotation that minimizes the L1 norm of the face normals of the
+ * mesh, chosen among nDirs directions of the sphere. Mesh is any mesh with a
+ * MeshTraits specialization (Dcel, CompactTriMesh, SimpleEigenMesh,
+ * EigenMesh); the normals stored in the mesh are used.
+ */
+template <typename Mesh>
+Eigen::Matrix3d globalOptimalRotationMatrix(
+        const Mesh& inputMesh,
+        unsigned int nDirs,
+        bool deterministic)
+{
+    typedef MeshTraits<Mesh> Traits;
+    std::vector<Vec3> normals;
+    forEachMeshFace(inputMesh, [&](unsigned int f) {
+        normals.push_back(Traits::getFaceNormal(inputMesh, f));
+    });
+
+    std::vector<Vec3> dirPool = cg3::sphereCoverage(nDirs, deterministic);
+
+    std::set<std::pair<double,Vec3>> priorizitedOrientations;
+    for(Vec3& zAxis : dirPool) {
+        Vec3 axis;
+        double angle;
+        zAxis.normalize();
+        internal::defineRotation(zAxis, axis, angle);
+        Eigen::Matrix3d mr = getRotationMatrix(axis, angle);
+
+        double L1_extent = 0.0;
+        for(Vec3 n : normals) {
+            n.rotate(mr);
+            L1_extent += std::fabs(n.x()) + std::fabs(n.y()) + std::fabs(n.z());
+        }
+
+        priorizitedOrientations.insert(std::make_pair(L1_extent,zAxis));
+    }
+
+    Vec3  bestZ  = priorizitedOrientations.begin()->second;
+
+    Vec3  axis;
+    double angle;
+    bestZ.normalize();
+    internal::defineRotation(bestZ, axis, angle);
+
+    return cg3::getRotationMatrix(Vec3(axis), angle);
+}
+#endif // CG3_DCEL_DEFINED
+#endif // CG3_WITH_EIGEN
+
+}
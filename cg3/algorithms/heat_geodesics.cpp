@@ -0,0 +1,305 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "heat_geodesics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cg3/utilities/profiler.h>
+
+namespace cg3 {
+
+#ifdef CG3_WITH_EIGEN
+
+namespace internal {
+
+/* source sets solved together, with a single back substitution on a block
+ * of right hand sides */
+static const unsigned int HEAT_GEODESICS_BLOCK_SIZE = 8;
+
+/* root of the set of i, with path halving */
+inline unsigned int heatGeodesicsRoot(std::vector<unsigned int>& parents, unsigned int i)
+{
+    while (parents[i] != i) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+} //namespace cg3::internal
+
+HeatGeodesics::HeatGeodesics() :
+    nComponents(0),
+    timeStep(0),
+    valid(false)
+{
+}
+
+HeatGeodesics::HeatGeodesics(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        double timeFactor) :
+    HeatGeodesics()
+{
+    build(vertices, triangles, timeFactor);
+}
+
+/**
+ * @brief HeatGeodesics::build
+ * Assembles the cotangent Laplacian and the lumped mass matrix of the mesh,
+ * and factorizes the matrices of the heat flow and of the Poisson equation.
+ * Degenerate triangles are skipped: vertices that are not used by any
+ * triangle with positive area are isolated vertices.
+ */
+void HeatGeodesics::build(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        double timeFactor)
+{
+    CG3_PROFILE_SCOPE("HeatGeodesics::build");
+    this->vertices = vertices;
+    this->triangles = triangles;
+    unsigned int n = (unsigned int)vertices.size();
+    unsigned int nTriangles = (unsigned int)triangles.size();
+    cotangents.resize(nTriangles);
+    valid = false;
+
+    //cotangents of the corners, areas and mean edge length
+    std::vector<double> doubleAreas(nTriangles);
+    std::vector<double> edgeLengths(nTriangles);
+    parallelFor(0u, nTriangles, [&](unsigned int t) {
+        const std::array<unsigned int, 3>& tri = triangles[t];
+        double length = 0;
+        Vec3 cross;
+        for (unsigned int i = 0; i < 3; i++) {
+            const Pointd& p = vertices[tri[i]];
+            Vec3 e1 = vertices[tri[(i+1)%3]] - p, e2 = vertices[tri[(i+2)%3]] - p;
+            if (i == 0)
+                cross = e1.cross(e2);
+            cotangents[t][i] = e1.dot(e2);
+            length += e1.getLength();
+        }
+        doubleAreas[t] = cross.getLength();
+        //degenerate triangles do not contribute to the operators
+        for (unsigned int i = 0; i < 3; i++)
+            cotangents[t][i] = doubleAreas[t] > 0 ? cotangents[t][i] / doubleAreas[t] : 0;
+        edgeLengths[t] = length;
+    });
+    double totalArea = 0, meanEdge = 0;
+    unsigned int nValid = 0;
+    for (unsigned int t = 0; t < nTriangles; t++) {
+        if (doubleAreas[t] == 0)
+            continue;
+        totalArea += doubleAreas[t] / 2;
+        meanEdge += edgeLengths[t];
+        nValid++;
+    }
+    meanEdge = nValid > 0 ? meanEdge / (3 * nValid) : 0;
+    timeStep = timeFactor * meanEdge * meanEdge;
+
+    //connected components
+    std::vector<unsigned int> parents(n);
+    for (unsigned int v = 0; v < n; v++)
+        parents[v] = v;
+    for (unsigned int t = 0; t < nTriangles; t++) {
+        const std::array<unsigned int, 3>& tri = triangles[t];
+        if (doubleAreas[t] == 0)
+            continue;
+        for (unsigned int i = 1; i < 3; i++) {
+            unsigned int a = internal::heatGeodesicsRoot(parents, tri[0]);
+            unsigned int b = internal::heatGeodesicsRoot(parents, tri[i]);
+            if (a != b)
+                parents[std::max(a, b)] = std::min(a, b);
+        }
+    }
+    components.resize(n);
+    nComponents = 0;
+    for (unsigned int v = 0; v < n; v++) {
+        unsigned int r = internal::heatGeodesicsRoot(parents, v);
+        components[v] = r == v ? nComponents++ : components[r];
+    }
+
+    //positive semidefinite cotangent Laplacian and lumped mass matrix
+    std::vector<Eigen::Triplet<double>> laplacian;
+    laplacian.reserve(12 * (size_t)nTriangles);
+    std::vector<double> masses(n, 0);
+    for (unsigned int t = 0; t < nTriangles; t++) {
+        const std::array<unsigned int, 3>& tri = triangles[t];
+        for (unsigned int k = 0; k < 3; k++) {
+            unsigned int i = tri[(k+1)%3], j = tri[(k+2)%3];
+            double w = cotangents[t][k] / 2;
+            laplacian.push_back(Eigen::Triplet<double>(i, j, -w));
+            laplacian.push_back(Eigen::Triplet<double>(j, i, -w));
+            laplacian.push_back(Eigen::Triplet<double>(i, i, w));
+            laplacian.push_back(Eigen::Triplet<double>(j, j, w));
+            masses[tri[k]] += doubleAreas[t] / 6;
+        }
+    }
+    SparseMatrix l(n, n);
+    l.setFromTriplets(laplacian.begin(), laplacian.end());
+    SparseMatrix m(n, n), isolated(n, n);
+    std::vector<Eigen::Triplet<double>> diagonal, isolatedDiagonal;
+    for (unsigned int v = 0; v < n; v++) {
+        diagonal.push_back(Eigen::Triplet<double>(v, v, masses[v]));
+        if (masses[v] == 0)
+            isolatedDiagonal.push_back(Eigen::Triplet<double>(v, v, 1));
+    }
+    m.setFromTriplets(diagonal.begin(), diagonal.end());
+    isolated.setFromTriplets(isolatedDiagonal.begin(), isolatedDiagonal.end());
+
+    //the Laplacian is singular on the constant functions: a small multiple of
+    //the mass matrix makes it definite, and the constant shifts the distances
+    //by a value that is removed on the sources
+    double eps = totalArea > 0 ? 1e-8 / totalArea : 1;
+    SparseMatrix heat = m + timeStep * l + isolated;
+    SparseMatrix poisson = l + eps * m + isolated;
+    heatFactorization.compute(heat);
+    poissonFactorization.compute(poisson);
+    valid = heatFactorization.info() == Eigen::Success && poissonFactorization.info() == Eigen::Success;
+}
+
+/**
+ * @brief HeatGeodesics::isValid
+ * @return true if the operators have been built and factorized
+ */
+bool HeatGeodesics::isValid() const
+{
+    return valid;
+}
+
+unsigned int HeatGeodesics::getNumberVertices() const
+{
+    return (unsigned int)vertices.size();
+}
+
+double HeatGeodesics::getTimeStep() const
+{
+    return timeStep;
+}
+
+std::vector<double> HeatGeodesics::distances(unsigned int source) const
+{
+    return distances(std::vector<unsigned int>(1, source));
+}
+
+/**
+ * @brief HeatGeodesics::distances
+ * @return the distance of every vertex from the nearest vertex of sources
+ */
+std::vector<double> HeatGeodesics::distances(const std::vector<unsigned int>& sources) const
+{
+    std::vector<std::vector<unsigned int>> sourceSets(1, sources);
+    std::vector<std::vector<double>> d(1);
+    solve(sourceSets, 0, 1, d);
+    return std::move(d[0]);
+}
+
+/**
+ * @brief HeatGeodesics::distances
+ * @return for every source set, the distance of every vertex from the nearest
+ * vertex of the set. Blocks of source sets are solved in parallel.
+ */
+std::vector<std::vector<double>> HeatGeodesics::distances(
+        const std::vector<std::vector<unsigned int>>& sourceSets,
+        const ParallelOptions& options) const
+{
+    CG3_PROFILE_SCOPE("HeatGeodesics::distances");
+    const unsigned int blockSize = internal::HEAT_GEODESICS_BLOCK_SIZE;
+    unsigned int nSets = (unsigned int)sourceSets.size();
+    unsigned int nBlocks = (nSets + blockSize - 1) / blockSize;
+    std::vector<std::vector<double>> d(nSets);
+    ParallelOptions blockOptions(options.nThreads, 1, options.deterministic);
+    parallelFor(0u, nBlocks, [&](unsigned int b) {
+        solve(sourceSets, b * blockSize, std::min(nSets, (b + 1) * blockSize), d);
+    }, blockOptions);
+    return d;
+}
+
+/**
+ * @brief HeatGeodesics::solve
+ * Computes the distances of the source sets in [begin, end), solving the heat
+ * flow and the Poisson equation on all of them with a single back
+ * substitution each.
+ */
+void HeatGeodesics::solve(
+        const std::vector<std::vector<unsigned int>>& sourceSets,
+        unsigned int begin,
+        unsigned int end,
+        std::vector<std::vector<double>>& distances) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    unsigned int n = (unsigned int)vertices.size();
+    unsigned int k = end - begin;
+    for (unsigned int s = begin; s < end; s++)
+        distances[s].assign(n, inf);
+    if (!valid || n == 0)
+        return;
+
+    //heat flow
+    Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(n, k);
+    for (unsigned int s = 0; s < k; s++)
+        for (unsigned int v : sourceSets[begin + s])
+            if (v < n)
+                rhs(v, s) = 1;
+    Eigen::MatrixXd u = heatFactorization.solve(rhs);
+
+    //divergence of the normalized gradient
+    Eigen::MatrixXd div = Eigen::MatrixXd::Zero(n, k);
+    for (unsigned int t = 0; t < triangles.size(); t++) {
+        const std::array<unsigned int, 3>& tri = triangles[t];
+        const Pointd& p0 = vertices[tri[0]];
+        const Pointd& p1 = vertices[tri[1]];
+        const Pointd& p2 = vertices[tri[2]];
+        Vec3 normal = (p1 - p0).cross(p2 - p0);
+        double doubleArea = normal.getLength();
+        if (doubleArea == 0)
+            continue;
+        normal /= doubleArea;
+        //gradients of the hat functions, times the double area
+        Vec3 g0 = normal.cross(p2 - p1), g1 = normal.cross(p0 - p2), g2 = normal.cross(p1 - p0);
+        for (unsigned int s = 0; s < k; s++) {
+            Vec3 x = -(g0 * u(tri[0], s) + g1 * u(tri[1], s) + g2 * u(tri[2], s));
+            double length = x.getLength();
+            if (length == 0)
+                continue;
+            x /= length;
+            for (unsigned int i = 0; i < 3; i++) {
+                unsigned int j = (i + 1) % 3, l = (i + 2) % 3;
+                const Pointd& p = vertices[tri[i]];
+                div(tri[i], s) += (cotangents[t][l] * (vertices[tri[j]] - p).dot(x) +
+                                   cotangents[t][j] * (vertices[tri[l]] - p).dot(x)) / 2;
+            }
+        }
+    }
+
+    //distances, shifted to be zero on the sources of every component
+    Eigen::MatrixXd phi = poissonFactorization.solve(-div);
+    std::vector<double> shift(nComponents);
+    std::vector<unsigned int> nSources(nComponents);
+    for (unsigned int s = 0; s < k; s++) {
+        std::fill(shift.begin(), shift.end(), 0);
+        std::fill(nSources.begin(), nSources.end(), 0);
+        for (unsigned int v : sourceSets[begin + s]) {
+            if (v < n) {
+                shift[components[v]] += phi(v, s);
+                nSources[components[v]]++;
+            }
+        }
+        std::vector<double>& d = distances[begin + s];
+        for (unsigned int v = 0; v < n; v++) {
+            unsigned int c = components[v];
+            if (nSources[c] > 0)
+                d[v] = std::max(0.0, phi(v, s) - shift[c] / nSources[c]);
+        }
+    }
+}
+
+#endif // CG3_WITH_EIGEN
+
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_HEAT_GEODESICS_H
+#define CG3_HEAT_GEODESICS_H
+
+#include <array>
+#include <vector>
+
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/parallel.h>
+#ifdef CG3_WITH_EIGEN
+#include <Eigen/Sparse>
+#endif
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/mesh_traits.h>
+#endif
+
+namespace cg3 {
+
+#ifdef CG3_WITH_EIGEN
+/**
+ * @ingroup cg3algorithms
+ * @brief The HeatGeodesics class computes geodesic distances on a triangle
+ * mesh with the heat method (Crane, Weischedel, Wardetzky: Geodesics in
+ * heat, 2013):
+ * 1. the heat u is diffused from the sources for a time t, solving
+ *    (M + tL) u = d, where M is the lumped mass matrix and L the cotangent
+ *    Laplacian;
+ * 2. the normalized gradient X = -grad(u) / |grad(u)| is computed per face;
+ * 3. the distance is the solution of the Poisson equation L phi = -div(X),
+ *    shifted to be zero on the sources.
+ *
+ * The two matrices are assembled and factorized with a sparse Cholesky
+ * decomposition once, when the object is built: every query costs only two
+ * back substitutions and a pass on the faces. Keep a HeatGeodesics for every
+ * mesh, and batch the queries with many source sets, whose back
+ * substitutions run in parallel:
+ *
+ * \code{.cpp}
+ * cg3::HeatGeodesics geodesics(mesh);
+ * std::vector<std::vector<double>> d = geodesics.distances(sourceSets);
+ * \endcode
+ *
+ * Distances are indexed by vertex (by vertex id for a Dcel). Vertices that
+ * are not connected to any source, and isolated vertices, have infinite
+ * distance. The time step is timeFactor times the square of the mean edge
+ * length: larger factors give smoother distances.
+ */
+class HeatGeodesics
+{
+public:
+    HeatGeodesics();
+    HeatGeodesics(
+            const std::vector<Pointd>& vertices,
+            const std::vector<std::array<unsigned int, 3>>& triangles,
+            double timeFactor = 1);
+    #ifdef CG3_DCEL_DEFINED
+    template <typename Mesh>
+    HeatGeodesics(const Mesh& mesh, double timeFactor = 1);
+    #endif
+
+    void build(
+            const std::vector<Pointd>& vertices,
+            const std::vector<std::array<unsigned int, 3>>& triangles,
+            double timeFactor = 1);
+
+    bool isValid() const;
+    unsigned int getNumberVertices() const;
+    double getTimeStep() const;
+
+    std::vector<double> distances(unsigned int source) const;
+    std::vector<double> distances(const std::vector<unsigned int>& sources) const;
+    std::vector<std::vector<double>> distances(
+            const std::vector<std::vector<unsigned int>>& sourceSets,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+protected:
+    typedef Eigen::SparseMatrix<double> SparseMatrix;
+    typedef Eigen::SimplicialLDLT<SparseMatrix> Factorization;
+
+    void solve(
+            const std::vector<std::vector<unsigned int>>& sourceSets,
+            unsigned int begin,
+            unsigned int end,
+            std::vector<std::vector<double>>& distances) const;
+
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<std::array<double, 3>> cotangents; //cotangent of the angle in every corner
+    std::vector<unsigned int> components;          //connected component of every vertex
+    unsigned int nComponents;
+    double timeStep;
+    bool valid;
+
+    Factorization heatFactorization;    //M + tL
+    Factorization poissonFactorization; //L + eps M
+};
+#endif // CG3_WITH_EIGEN
+
+}
+
+#include "heat_geodesics.tpp"
+
+#endif // CG3_HEAT_GEODESICS_H
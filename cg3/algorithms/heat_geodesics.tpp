@@ -0,0 +1,32 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "heat_geodesics.h"
+
+namespace cg3 {
+
+#ifdef CG3_WITH_EIGEN
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @brief HeatGeodesics::HeatGeodesics
+ * Builds the operators of any mesh with a MeshTraits specialization (Dcel,
+ * CompactTriMesh, SimpleEigenMesh, EigenMesh). Polygonal faces are fan
+ * triangulated.
+ */
+template <typename Mesh>
+HeatGeodesics::HeatGeodesics(const Mesh& mesh, double timeFactor) :
+    HeatGeodesics()
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    build(vertices, triangles, timeFactor);
+}
+#endif // CG3_DCEL_DEFINED
+#endif // CG3_WITH_EIGEN
+
+}
@@ -0,0 +1,310 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "mesh_curvature.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <cg3/utilities/profiler.h>
+
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/algorithms/dcel_algorithms.h>
+#endif
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
+namespace cg3 {
+
+#ifdef CG3_DCEL_DEFINED
+
+namespace internal {
+
+/* area weighted normal of a vertex, computed from the geometry */
+Vec3 curvatureVertexNormal(const CompactTriMesh& mesh, unsigned int v)
+{
+    Vec3 n;
+    for (unsigned int f : mesh.incidentFaceIterator(v)) {
+        Pointd p0 = mesh.getVertex(mesh.getFaceVertex(f, 0));
+        Pointd p1 = mesh.getVertex(mesh.getFaceVertex(f, 1));
+        Pointd p2 = mesh.getVertex(mesh.getFaceVertex(f, 2));
+        n += (p1 - p0).cross(p2 - p0);
+    }
+    n.normalize();
+    return n;
+}
+
+/* k1 >= k2 from mean and Gaussian curvature */
+void principalCurvatures(double h, double k, double& k1, double& k2)
+{
+    double d = std::sqrt(std::max(0.0, h * h - k));
+    k1 = h + d;
+    k2 = h - d;
+}
+
+/**
+ * @brief Mean curvature from the cotangent Laplacian and Gaussian curvature
+ * from the angle defect of the vertex v, both divided by the mixed Voronoi
+ * area of v (Meyer, Desbrun, Schroder, Barr: Discrete differential geometry
+ * operators for triangulated 2-manifolds, 2003).
+ */
+void discreteCurvatures(const CompactTriMesh& mesh, unsigned int v, double& h, double& k)
+{
+    Pointd p = mesh.getVertex(v);
+    Vec3 laplacian, normal;
+    double area = 0, angles = 0;
+    for (unsigned int he : mesh.outgoingHalfEdgeIterator(v)) {
+        //triangle (v, a, b)
+        Pointd a = mesh.getVertex(mesh.getToVertex(he));
+        Pointd b = mesh.getVertex(mesh.getToVertex(CompactTriMesh::getNext(he)));
+        Vec3 ea = a - p, eb = b - p, ab = b - a;
+        Vec3 cross = ea.cross(eb);
+        double doubleArea = cross.getLength();
+        if (doubleArea == 0)
+            continue;
+        normal += cross;
+
+        double dotV = ea.dot(eb), dotA = -ea.dot(ab), dotB = eb.dot(ab);
+        angles += std::atan2(doubleArea, dotV);
+        double cotA = dotA / doubleArea, cotB = dotB / doubleArea;
+        laplacian += ea * cotB + eb * cotA;
+
+        if (dotV < 0)
+            area += doubleArea / 4;
+        else if (dotA < 0 || dotB < 0)
+            area += doubleArea / 8;
+        else
+            area += (ea.getLengthSquared() * cotB + eb.getLengthSquared() * cotA) / 8;
+    }
+    if (area == 0) {
+        h = k = 0;
+        return;
+    }
+    normal.normalize();
+    //laplacian = sum of (cot alpha + cot beta)(pj - p) = -4 A H n
+    h = -laplacian.dot(normal) / (4 * area);
+    double fullAngle = mesh.isBoundaryVertex(v) ? M_PI : 2 * M_PI;
+    k = (fullAngle - angles) / area;
+}
+
+/* solves the symmetric positive definite system a x = b of size n with a
+ * Cholesky decomposition; returns false if a is singular */
+bool solveSymmetric(double a[5][5], double b[5], unsigned int n)
+{
+    for (unsigned int j = 0; j < n; j++) {
+        double d = a[j][j];
+        for (unsigned int k = 0; k < j; k++)
+            d -= a[j][k] * a[j][k];
+        if (d <= 1e-12)
+            return false;
+        a[j][j] = std::sqrt(d);
+        for (unsigned int i = j + 1; i < n; i++) {
+            double s = a[i][j];
+            for (unsigned int k = 0; k < j; k++)
+                s -= a[i][k] * a[j][k];
+            a[i][j] = s / a[j][j];
+        }
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int k = 0; k < i; k++)
+            b[i] -= a[i][k] * b[k];
+        b[i] /= a[i][i];
+    }
+    for (unsigned int i = n; i-- > 0; ) {
+        for (unsigned int k = i + 1; k < n; k++)
+            b[i] -= a[k][i] * b[k];
+        b[i] /= a[i][i];
+    }
+    return true;
+}
+
+/**
+ * @brief Principal curvatures and directions of the vertex v, from the
+ * height function z = a x^2 + b xy + c y^2 + d x + e y fitted with least
+ * squares on the one-ring of v, in the tangent frame of the vertex normal
+ * (only the quadratic terms when the one-ring has less than 5 vertices).
+ */
+void quadricCurvatures(
+        const CompactTriMesh& mesh,
+        unsigned int v,
+        double& k1,
+        double& k2,
+        Vec3& d1,
+        Vec3& d2)
+{
+    Pointd p = mesh.getVertex(v);
+    Vec3 n = curvatureVertexNormal(mesh, v);
+    k1 = k2 = 0;
+    d1 = d2 = Vec3();
+    if (n.getLengthSquared() == 0)
+        return;
+    Vec3 u = std::abs(n.x()) < 0.9 ? Vec3(1, 0, 0).cross(n) : Vec3(0, 1, 0).cross(n);
+    u.normalize();
+    Vec3 w = n.cross(u);
+
+    //normal equations, coordinates scaled by the average edge length
+    unsigned int nNeighbors = 0;
+    double scale = 0;
+    for (unsigned int a : mesh.adjacentVertexIterator(v)) {
+        scale += mesh.getVertex(a).dist(p);
+        nNeighbors++;
+    }
+    if (nNeighbors < 3 || scale == 0)
+        return;
+    scale = nNeighbors / scale;
+    unsigned int nParams = nNeighbors >= 5 ? 5 : 3;
+    double ata[5][5] = {}, atb[5] = {};
+    for (unsigned int a : mesh.adjacentVertexIterator(v)) {
+        Vec3 d = (mesh.getVertex(a) - p) * scale;
+        double x = d.dot(u), y = d.dot(w), z = d.dot(n);
+        double row[5] = {x * x, x * y, y * y, x, y};
+        for (unsigned int i = 0; i < nParams; i++) {
+            for (unsigned int j = 0; j <= i; j++)
+                ata[i][j] += row[i] * row[j];
+            atb[i] += row[i] * z;
+        }
+    }
+    for (unsigned int i = 0; i < nParams; i++)
+        for (unsigned int j = i + 1; j < nParams; j++)
+            ata[i][j] = ata[j][i];
+    if (!solveSymmetric(ata, atb, nParams))
+        return;
+    double ca = atb[0], cb = atb[1], cc = atb[2];
+    double cd = nParams == 5 ? atb[3] : 0, ce = nParams == 5 ? atb[4] : 0;
+
+    //shape operator S = I^-1 II of the graph of the height function at the
+    //origin; II is negated, so that convex surfaces have positive curvature
+    double e = 1 + cd * cd, f = cd * ce, g = 1 + ce * ce;
+    double l = std::sqrt(1 + cd * cd + ce * ce);
+    double L = -2 * ca / l, M = -cb / l, N = -2 * cc / l;
+    double det = e * g - f * f;
+    double s00 = (g * L - f * M) / det, s01 = (g * M - f * N) / det;
+    double s10 = (e * M - f * L) / det, s11 = (e * N - f * M) / det;
+    double h = (s00 + s11) / 2;
+    double disc = std::sqrt(std::max(0.0, (s00 - s11) * (s00 - s11) / 4 + s01 * s10));
+    k1 = (h + disc) * scale;
+    k2 = (h - disc) * scale;
+
+    //eigenvectors in parameter space, mapped on the tangent plane
+    auto direction = [&](double lambda) {
+        double x1 = s01, y1 = lambda - s00;
+        double x2 = lambda - s11, y2 = s10;
+        double x = x1, y = y1;
+        if (x2 * x2 + y2 * y2 > x1 * x1 + y1 * y1) {
+            x = x2;
+            y = y2;
+        }
+        Vec3 dir = u * x + w * y + n * (cd * x + ce * y);
+        dir.normalize();
+        return dir;
+    };
+    if (disc > 1e-10) {
+        d1 = direction(h + disc);
+        d2 = n.cross(d1);
+        d2.normalize();
+    }
+    else { //umbilic: any tangent direction
+        d1 = u;
+        d2 = w;
+    }
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief vertexCurvatures
+ * Computes the curvatures of every vertex of a triangle mesh, in parallel.
+ * Topology is read from the CompactTriMesh, whose one-rings are visited
+ * with arithmetic on the implicit half edges: building a CompactTriMesh once
+ * and reusing it avoids walking the pointers of a Dcel for every vertex.
+ *
+ * Curvatures on boundary vertices are computed on their partial one-ring,
+ * and are less reliable.
+ */
+VertexCurvatures vertexCurvatures(
+        const CompactTriMesh& mesh,
+        CurvatureMethod method,
+        const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("vertexCurvatures");
+    unsigned int n = mesh.getNumberVertices();
+    VertexCurvatures c;
+    c.mean.resize(n);
+    c.gaussian.resize(n);
+    c.k1.resize(n);
+    c.k2.resize(n);
+    if (method == CURVATURE_DISCRETE_OPERATORS) {
+        parallelFor(0u, n, [&](unsigned int v) {
+            internal::discreteCurvatures(mesh, v, c.mean[v], c.gaussian[v]);
+            internal::principalCurvatures(c.mean[v], c.gaussian[v], c.k1[v], c.k2[v]);
+        }, options);
+    }
+    else {
+        c.direction1.resize(n);
+        c.direction2.resize(n);
+        parallelFor(0u, n, [&](unsigned int v) {
+            internal::quadricCurvatures(mesh, v, c.k1[v], c.k2[v], c.direction1[v], c.direction2[v]);
+            c.mean[v] = (c.k1[v] + c.k2[v]) / 2;
+            c.gaussian[v] = c.k1[v] * c.k2[v];
+        }, options);
+    }
+    return c;
+}
+
+/**
+ * @brief vertexCurvatures
+ * The curvatures are indexed by vertex id. Faces that are not triangles are
+ * triangulated with a fan.
+ */
+VertexCurvatures vertexCurvatures(
+        const Dcel& mesh,
+        CurvatureMethod method,
+        const ParallelOptions& options)
+{
+    CompactTriMesh compact(mesh);
+    VertexCurvatures dense = vertexCurvatures(compact, method, options);
+    dcelAlgorithms::DenseIndex index(mesh);
+    if (index.isCompact() && index.getNumberVertices() == mesh.getNumberVertexIds())
+        return dense;
+
+    VertexCurvatures c;
+    unsigned int nIds = mesh.getNumberVertexIds();
+    c.mean.assign(nIds, 0);
+    c.gaussian.assign(nIds, 0);
+    c.k1.assign(nIds, 0);
+    c.k2.assign(nIds, 0);
+    if (method == CURVATURE_QUADRIC_FITTING) {
+        c.direction1.assign(nIds, Vec3());
+        c.direction2.assign(nIds, Vec3());
+    }
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        unsigned int id = index.vertex(i)->getId();
+        c.mean[id] = dense.mean[i];
+        c.gaussian[id] = dense.gaussian[i];
+        c.k1[id] = dense.k1[i];
+        c.k2[id] = dense.k2[i];
+        if (method == CURVATURE_QUADRIC_FITTING) {
+            c.direction1[id] = dense.direction1[i];
+            c.direction2[id] = dense.direction2[i];
+        }
+    }, options);
+    return c;
+}
+
+#endif // CG3_DCEL_DEFINED
+
+#ifdef CG3_EIGENMESH_DEFINED
+VertexCurvatures vertexCurvatures(
+        const SimpleEigenMesh& mesh,
+        CurvatureMethod method,
+        const ParallelOptions& options)
+{
+    return vertexCurvatures(CompactTriMesh(mesh), method, options);
+}
+#endif // CG3_EIGENMESH_DEFINED
+
+}
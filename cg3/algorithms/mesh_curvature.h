@@ -0,0 +1,76 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_MESH_CURVATURE_H
+#define CG3_MESH_CURVATURE_H
+
+#include <vector>
+
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/parallel.h>
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/compact_trimesh/compact_trimesh.h>
+#endif
+
+namespace cg3 {
+
+#ifdef CG3_EIGENMESH_DEFINED
+class SimpleEigenMesh;
+#endif
+
+typedef enum {
+    /** mean curvature from the cotangent Laplacian, Gaussian curvature from
+     *  the angle defect, both on mixed Voronoi areas (Meyer et al. 2003) */
+    CURVATURE_DISCRETE_OPERATORS,
+    /** principal curvatures and directions from a quadric fitted on the
+     *  one-ring, in the tangent frame of the vertex */
+    CURVATURE_QUADRIC_FITTING
+} CurvatureMethod;
+
+/**
+ * @ingroup cg3algorithms
+ * @brief Curvatures of the vertices of a mesh, in contiguous arrays indexed
+ * by vertex (by vertex id for a Dcel, with zeros on the ids of deleted
+ * vertices).
+ *
+ * Signs follow the orientation of the faces: a sphere with outward normals
+ * has positive mean and Gaussian curvature. Principal curvatures satisfy
+ * k1 >= k2; principal directions are computed only by quadric fitting, and
+ * are empty otherwise.
+ */
+struct VertexCurvatures
+{
+    std::vector<double> mean;
+    std::vector<double> gaussian;
+    std::vector<double> k1;
+    std::vector<double> k2;
+    std::vector<Vec3> direction1;
+    std::vector<Vec3> direction2;
+};
+
+#ifdef CG3_DCEL_DEFINED
+VertexCurvatures vertexCurvatures(
+        const CompactTriMesh& mesh,
+        CurvatureMethod method = CURVATURE_DISCRETE_OPERATORS,
+        const ParallelOptions& options = ParallelOptions());
+
+VertexCurvatures vertexCurvatures(
+        const Dcel& mesh,
+        CurvatureMethod method = CURVATURE_DISCRETE_OPERATORS,
+        const ParallelOptions& options = ParallelOptions());
+#endif // CG3_DCEL_DEFINED
+
+#ifdef CG3_EIGENMESH_DEFINED
+VertexCurvatures vertexCurvatures(
+        const SimpleEigenMesh& mesh,
+        CurvatureMethod method = CURVATURE_DISCRETE_OPERATORS,
+        const ParallelOptions& options = ParallelOptions());
+#endif // CG3_EIGENMESH_DEFINED
+
+}
+
+#endif // CG3_MESH_CURVATURE_H
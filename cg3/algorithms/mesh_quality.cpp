@@ -0,0 +1,658 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "mesh_quality.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cg3/utilities/profiler.h>
+
+#ifdef CG3_WITH_EIGEN
+#include <Eigen/Core>
+#endif
+
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/algorithms/dcel_algorithms.h>
+#endif
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
+namespace cg3 {
+
+QualityHistogram::QualityHistogram(double min, double max, unsigned int nBins) :
+    min(min),
+    max(max),
+    counts(nBins, 0)
+{
+}
+
+/**
+ * @brief QualityHistogram::bin
+ * @return the bin of value, clamped to the first and to the last bin
+ */
+unsigned int QualityHistogram::bin(double value) const
+{
+    if (counts.empty())
+        return 0;
+    double t = (value - min) / (max - min) * counts.size();
+    if (!(t > 0))
+        return 0;
+    if (t >= counts.size())
+        return (unsigned int)counts.size() - 1;
+    return (unsigned int)t;
+}
+
+double QualityHistogram::binWidth() const
+{
+    return counts.empty() ? 0 : (max - min) / counts.size();
+}
+
+double QualityHistogram::binMin(unsigned int i) const
+{
+    return min + i * binWidth();
+}
+
+double QualityHistogram::binMax(unsigned int i) const
+{
+    return min + (i + 1) * binWidth();
+}
+
+#ifdef CG3_DCEL_DEFINED
+
+namespace internal {
+
+/* faces of a block, whose measures are computed together */
+static const unsigned int QUALITY_BLOCK_WIDTH = 8;
+/* faces processed by every task */
+static const unsigned int QUALITY_CHUNK_SIZE = 2048;
+/* a face is degenerate if its double area is below this fraction of the
+ * squared length of its longest edge */
+static const double QUALITY_DEGENERATE_EPSILON = 1e-12;
+
+/* partial statistics of a chunk of faces or edges */
+struct QualityChunk
+{
+    QualityChunk(unsigned int nBins) :
+        nDegenerate(0), nSlivers(0), nFaces(0),
+        minAngle(180), maxAngle(0), sumAspectRatio(0), maxAspectRatio(0),
+        minEdge(std::numeric_limits<double>::max()), maxEdge(0),
+        nEdges(0), sumEdge(0), maxDihedral(0),
+        aspectRatio(nBins, 0), minAngles(nBins, 0), maxAngles(nBins, 0),
+        edgeLength(nBins, 0), dihedral(nBins, 0)
+    {
+    }
+
+    unsigned int nDegenerate, nSlivers, nFaces;
+    double minAngle, maxAngle, sumAspectRatio, maxAspectRatio;
+    double minEdge, maxEdge;
+    unsigned int nEdges;
+    double sumEdge, maxDihedral;
+    std::vector<unsigned int> aspectRatio, minAngles, maxAngles, edgeLength, dihedral;
+};
+
+inline void addHistogram(std::vector<unsigned int>& a, const std::vector<unsigned int>& b)
+{
+    for (unsigned int i = 0; i < a.size(); i++)
+        a[i] += b[i];
+}
+
+/* operations on the lanes of a block: on a single lane (double) or on all
+ * the lanes at once (Eigen array) */
+inline double laneSqrt(double x) { return std::sqrt(x); }
+inline double laneMax(double x, double y) { return std::max(x, y); }
+inline double laneMin(double x, double y) { return std::min(x, y); }
+inline double laneSelect(bool c, double x, double y) { return c ? x : y; }
+inline bool laneNot(bool c) { return !c; }
+#ifdef CG3_WITH_EIGEN
+typedef Eigen::Array<double, QUALITY_BLOCK_WIDTH, 1> QualityLanes;
+typedef Eigen::Array<bool, QUALITY_BLOCK_WIDTH, 1> QualityMask;
+inline QualityLanes laneSqrt(const QualityLanes& x) { return x.sqrt(); }
+inline QualityLanes laneMax(const QualityLanes& x, const QualityLanes& y) { return x.max(y); }
+inline QualityLanes laneMax(const QualityLanes& x, double y) { return x.max(y); }
+inline QualityLanes laneMin(const QualityLanes& x, const QualityLanes& y) { return x.min(y); }
+inline QualityLanes laneMin(const QualityLanes& x, double y) { return x.min(y); }
+inline QualityLanes laneSelect(const QualityMask& c, double x, const QualityLanes& y) { return c.select(x, y); }
+inline QualityMask laneNot(const QualityMask& c) { return !c; }
+#endif
+
+/**
+ * @brief Measures of the lanes of a block, given the coordinates of their
+ * vertices (a, b and c, one component each). The measures of degenerate
+ * triangles are set to the ones of a flat triangle: infinite aspect ratio,
+ * and cosines of 1 and -1 of the smallest and of the largest angles.
+ */
+template <typename T, typename Mask>
+void qualityLanes(
+        const T p[9],
+        T& area2,
+        T& shortest,
+        T& longest,
+        T& cosMax,
+        T& cosMin,
+        T& aspect,
+        Mask& degenerate)
+{
+    T e0x = p[3] - p[0], e0y = p[4] - p[1], e0z = p[5] - p[2]; //a -> b
+    T e1x = p[6] - p[3], e1y = p[7] - p[4], e1z = p[8] - p[5]; //b -> c
+    T e2x = p[0] - p[6], e2y = p[1] - p[7], e2z = p[2] - p[8]; //c -> a
+    T cx = e0y * e2z - e0z * e2y, cy = e0z * e2x - e0x * e2z, cz = e0x * e2y - e0y * e2x;
+    area2 = laneSqrt(cx * cx + cy * cy + cz * cz);
+    T sq0 = e0x * e0x + e0y * e0y + e0z * e0z;
+    T sq1 = e1x * e1x + e1y * e1y + e1z * e1z;
+    T sq2 = e2x * e2x + e2y * e2y + e2z * e2z;
+    T l0 = laneSqrt(sq0), l1 = laneSqrt(sq1), l2 = laneSqrt(sq2);
+    shortest = laneMin(l0, laneMin(l1, l2));
+    longest = laneMax(l0, laneMax(l1, l2));
+    T minArea2 = QUALITY_DEGENERATE_EPSILON * longest * longest;
+    degenerate = laneNot(area2 > minArea2);
+    //law of cosines on the angles in a, b and c
+    T ca = (sq0 + sq2 - sq1) / laneMax(2 * l0 * l2, 1e-300);
+    T cb = (sq0 + sq1 - sq2) / laneMax(2 * l0 * l1, 1e-300);
+    T cc = (sq1 + sq2 - sq0) / laneMax(2 * l1 * l2, 1e-300);
+    cosMax = laneSelect(degenerate, 1.0, laneMin(laneMax(ca, laneMax(cb, cc)), 1.0));
+    cosMin = laneSelect(degenerate, -1.0, laneMax(laneMin(ca, laneMin(cb, cc)), -1.0));
+    aspect = laneSelect(
+                degenerate, std::numeric_limits<double>::infinity(),
+                longest * (l0 + l1 + l2) / (2 * std::sqrt(3.0) * laneMax(area2, 1e-300)));
+}
+
+/**
+ * @brief Measures of a block of n <= QUALITY_BLOCK_WIDTH triangles, starting
+ * from the face f. The coordinates are gathered in arrays, one per
+ * component, and all the measures that do not need a trigonometric function
+ * are computed on all the lanes together with Eigen arrays (one lane at a
+ * time without Eigen). The angles are then computed face by face.
+ */
+void qualityBlock(
+        const std::vector<double>& coords,
+        const std::vector<unsigned int>& triangles,
+        unsigned int f,
+        unsigned int n,
+        float* areas,
+        float* aspectRatios,
+        float* minAngles,
+        float* maxAngles,
+        double* lMin,
+        double* lMax,
+        bool* degenerate)
+{
+    const unsigned int W = QUALITY_BLOCK_WIDTH;
+    double p[9][W];
+    for (unsigned int l = 0; l < W; l++) {
+        unsigned int face = f + std::min(l, n - 1); //padding lanes repeat the last face
+        for (unsigned int v = 0; v < 3; v++)
+            for (unsigned int c = 0; c < 3; c++)
+                p[3*v+c][l] = coords[3 * (size_t)triangles[3 * (size_t)face + v] + c];
+    }
+
+    #ifdef CG3_WITH_EIGEN
+    QualityLanes lanes[9];
+    for (unsigned int i = 0; i < 9; i++)
+        lanes[i] = Eigen::Map<const QualityLanes>(p[i]);
+    QualityLanes area2, cosMax, cosMin, aspect, shortest, longest;
+    QualityMask d;
+    qualityLanes(lanes, area2, shortest, longest, cosMax, cosMin, aspect, d);
+    #else
+    double area2[W], cosMax[W], cosMin[W], aspect[W], shortest[W], longest[W];
+    bool d[W];
+    for (unsigned int l = 0; l < W; l++) {
+        double lane[9];
+        for (unsigned int i = 0; i < 9; i++)
+            lane[i] = p[i][l];
+        qualityLanes(lane, area2[l], shortest[l], longest[l], cosMax[l], cosMin[l], aspect[l], d[l]);
+    }
+    #endif
+
+    const double toDegrees = 180 / M_PI;
+    for (unsigned int l = 0; l < n; l++) {
+        degenerate[l] = d[l];
+        areas[l] = (float)(area2[l] / 2);
+        aspectRatios[l] = (float)aspect[l];
+        minAngles[l] = (float)(std::acos(cosMax[l]) * toDegrees);
+        maxAngles[l] = (float)(std::acos(cosMin[l]) * toDegrees);
+        lMin[l] = shortest[l];
+        lMax[l] = longest[l];
+    }
+}
+
+inline Vec3 qualityFaceNormal(const CompactTriMesh& mesh, unsigned int f)
+{
+    Pointd a = mesh.getVertex(mesh.getFaceVertex(f, 0));
+    Vec3 n = (mesh.getVertex(mesh.getFaceVertex(f, 1)) - a).cross(mesh.getVertex(mesh.getFaceVertex(f, 2)) - a);
+    n.normalize();
+    return n;
+}
+
+} //namespace cg3::internal
+
+MeshQuality::MeshQuality() :
+    sliverAspectRatio(10),
+    nEdges(0), nDegenerate(0), nSlivers(0),
+    minAngle(0), maxAngle(0), meanAspectRatio(0), maxAspectRatio(0),
+    minEdgeLength(0), maxEdgeLength(0), meanEdgeLength(0), maxDihedralAngle(0)
+{
+}
+
+MeshQuality::MeshQuality(
+        const CompactTriMesh& mesh,
+        double sliverAspectRatio,
+        unsigned int nBins,
+        const ParallelOptions& options) :
+    MeshQuality()
+{
+    build(mesh, sliverAspectRatio, nBins, options);
+}
+
+/**
+ * @brief MeshQuality::MeshQuality
+ * Per face arrays and index lists refer to the face ids of the Dcel.
+ * Statistics and histograms are computed on the triangles of the fan
+ * triangulation of the faces.
+ */
+MeshQuality::MeshQuality(
+        const Dcel& mesh,
+        double sliverAspectRatio,
+        unsigned int nBins,
+        const ParallelOptions& options) :
+    MeshQuality()
+{
+    build(CompactTriMesh(mesh), sliverAspectRatio, nBins, options);
+
+    //from the triangles of the CompactTriMesh to the face ids
+    dcelAlgorithms::DenseIndex index(mesh);
+    unsigned int nFaces = index.getNumberFaces();
+    std::vector<unsigned int> nTriangles(nFaces), triangleOffsets(nFaces + 1);
+    parallelFor(0u, nFaces, [&](unsigned int i) {
+        unsigned int n = index.face(i)->getNumberIncidentVertices();
+        nTriangles[i] = n >= 3 ? n - 2 : 0;
+    }, options);
+    triangleOffsets[nFaces] = parallelExclusiveScan(
+                nTriangles.begin(), nTriangles.end(), triangleOffsets.begin(), 0u,
+                std::plus<unsigned int>(), options);
+    if (index.isCompact() && triangleOffsets[nFaces] == nFaces && nFaces == mesh.getNumberFaceIds())
+        return; //triangle mesh with contiguous ids
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    unsigned int nIds = mesh.getNumberFaceIds();
+    std::vector<float> a(nIds, nan), ar(nIds, nan), mina(nIds, nan), maxa(nIds, nan);
+    parallelFor(0u, nFaces, [&](unsigned int i) {
+        unsigned int id = index.face(i)->getId();
+        if (triangleOffsets[i] == triangleOffsets[i+1])
+            return;
+        a[id] = 0;
+        ar[id] = 0;
+        mina[id] = 180;
+        maxa[id] = 0;
+        for (unsigned int t = triangleOffsets[i]; t < triangleOffsets[i+1]; t++) {
+            a[id] += areas[t];
+            ar[id] = std::max(ar[id], aspectRatios[t]);
+            mina[id] = std::min(mina[id], minAngles[t]);
+            maxa[id] = std::max(maxa[id], maxAngles[t]);
+        }
+    }, options);
+    areas.swap(a);
+    aspectRatios.swap(ar);
+    minAngles.swap(mina);
+    maxAngles.swap(maxa);
+    nDegenerate = (unsigned int)getDegenerateFaces(options).size();
+    nSlivers = (unsigned int)getSliverFaces(options).size();
+}
+
+#ifdef CG3_EIGENMESH_DEFINED
+MeshQuality::MeshQuality(
+        const SimpleEigenMesh& mesh,
+        double sliverAspectRatio,
+        unsigned int nBins,
+        const ParallelOptions& options) :
+    MeshQuality()
+{
+    build(CompactTriMesh(mesh), sliverAspectRatio, nBins, options);
+}
+#endif
+
+/**
+ * @brief MeshQuality::build
+ * Computes the measures of the faces and of the edges of the mesh.
+ * @param sliverAspectRatio: faces with larger aspect ratio are slivers
+ * @param nBins: number of bins of the histograms
+ */
+void MeshQuality::build(
+        const CompactTriMesh& mesh,
+        double sliverAspectRatio,
+        unsigned int nBins,
+        const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("MeshQuality::build");
+    const unsigned int W = internal::QUALITY_BLOCK_WIDTH;
+    const unsigned int chunk = internal::QUALITY_CHUNK_SIZE;
+    unsigned int nFaces = mesh.getNumberFaces();
+    unsigned int nChunks = (nFaces + chunk - 1) / chunk;
+    ParallelOptions chunkOptions(options.nThreads, 1, options.deterministic);
+    this->sliverAspectRatio = sliverAspectRatio;
+    areas.resize(nFaces);
+    aspectRatios.resize(nFaces);
+    minAngles.resize(nFaces);
+    maxAngles.resize(nFaces);
+
+    aspectRatioHistogram = QualityHistogram(1, 2 * sliverAspectRatio, nBins);
+    minAngleHistogram = QualityHistogram(0, 60, nBins);
+    maxAngleHistogram = QualityHistogram(60, 180, nBins);
+    dihedralAngleHistogram = QualityHistogram(0, 180, nBins);
+
+    //face pass
+    std::vector<internal::QualityChunk> chunks(nChunks, internal::QualityChunk(nBins));
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        internal::QualityChunk& s = chunks[c];
+        unsigned int end = std::min(nFaces, (c + 1) * chunk);
+        double lMin[W], lMax[W];
+        bool degenerate[W];
+        for (unsigned int f = c * chunk; f < end; f += W) {
+            unsigned int n = std::min(W, end - f);
+            internal::qualityBlock(
+                        mesh.getCoordinates(), mesh.getTriangles(), f, n,
+                        &areas[f], &aspectRatios[f], &minAngles[f], &maxAngles[f],
+                        lMin, lMax, degenerate);
+            for (unsigned int l = 0; l < n; l++) {
+                s.minEdge = std::min(s.minEdge, lMin[l]);
+                s.maxEdge = std::max(s.maxEdge, lMax[l]);
+                if (degenerate[l]) {
+                    s.nDegenerate++;
+                    continue;
+                }
+                unsigned int i = f + l;
+                s.nFaces++;
+                if (aspectRatios[i] > sliverAspectRatio)
+                    s.nSlivers++;
+                s.minAngle = std::min(s.minAngle, (double)minAngles[i]);
+                s.maxAngle = std::max(s.maxAngle, (double)maxAngles[i]);
+                s.sumAspectRatio += aspectRatios[i];
+                s.maxAspectRatio = std::max(s.maxAspectRatio, (double)aspectRatios[i]);
+                if (nBins > 0) {
+                    s.aspectRatio[aspectRatioHistogram.bin(aspectRatios[i])]++;
+                    s.minAngles[minAngleHistogram.bin(minAngles[i])]++;
+                    s.maxAngles[maxAngleHistogram.bin(maxAngles[i])]++;
+                }
+            }
+        }
+    }, chunkOptions);
+
+    internal::QualityChunk total(nBins);
+    for (const internal::QualityChunk& s : chunks) {
+        total.nDegenerate += s.nDegenerate;
+        total.nSlivers += s.nSlivers;
+        total.nFaces += s.nFaces;
+        total.minAngle = std::min(total.minAngle, s.minAngle);
+        total.maxAngle = std::max(total.maxAngle, s.maxAngle);
+        total.sumAspectRatio += s.sumAspectRatio;
+        total.maxAspectRatio = std::max(total.maxAspectRatio, s.maxAspectRatio);
+        total.minEdge = std::min(total.minEdge, s.minEdge);
+        total.maxEdge = std::max(total.maxEdge, s.maxEdge);
+        internal::addHistogram(total.aspectRatio, s.aspectRatio);
+        internal::addHistogram(total.minAngles, s.minAngles);
+        internal::addHistogram(total.maxAngles, s.maxAngles);
+    }
+    if (nFaces == 0)
+        total.minEdge = 0;
+    nDegenerate = total.nDegenerate;
+    nSlivers = total.nSlivers;
+    minAngle = total.nFaces > 0 ? total.minAngle : 0;
+    maxAngle = total.maxAngle;
+    meanAspectRatio = total.nFaces > 0 ? total.sumAspectRatio / total.nFaces : 0;
+    maxAspectRatio = total.maxAspectRatio;
+    minEdgeLength = total.minEdge;
+    maxEdgeLength = total.maxEdge;
+    aspectRatioHistogram.counts = total.aspectRatio;
+    minAngleHistogram.counts = total.minAngles;
+    maxAngleHistogram.counts = total.maxAngles;
+    edgeLengthHistogram = QualityHistogram(minEdgeLength, maxEdgeLength, nBins);
+
+    //edge pass: every edge is visited from its half edge with the smallest index
+    std::fill(chunks.begin(), chunks.end(), internal::QualityChunk(nBins));
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        internal::QualityChunk& s = chunks[c];
+        unsigned int end = std::min(nFaces, (c + 1) * chunk);
+        for (unsigned int f = c * chunk; f < end; f++) {
+            Vec3 n;
+            bool normal = false;
+            for (unsigned int i = 0; i < 3; i++) {
+                unsigned int he = CompactTriMesh::getHalfEdge(f, i);
+                unsigned int twin = mesh.getTwin(he);
+                if (twin != CompactTriMesh::NULL_ID && twin < he)
+                    continue;
+                double length = mesh.getVertex(mesh.getFromVertex(he)).dist(mesh.getVertex(mesh.getToVertex(he)));
+                s.nEdges++;
+                s.sumEdge += length;
+                if (nBins > 0)
+                    s.edgeLength[edgeLengthHistogram.bin(length)]++;
+                if (twin == CompactTriMesh::NULL_ID || std::isinf(aspectRatios[f]) ||
+                        std::isinf(aspectRatios[CompactTriMesh::getFace(twin)]))
+                    continue;
+                if (!normal) {
+                    n = internal::qualityFaceNormal(mesh, f);
+                    normal = true;
+                }
+                Vec3 nt = internal::qualityFaceNormal(mesh, CompactTriMesh::getFace(twin));
+                double dihedral = std::acos(std::max(-1.0, std::min(1.0, n.dot(nt)))) * 180 / M_PI;
+                s.maxDihedral = std::max(s.maxDihedral, dihedral);
+                if (nBins > 0)
+                    s.dihedral[dihedralAngleHistogram.bin(dihedral)]++;
+            }
+        }
+    }, chunkOptions);
+
+    for (const internal::QualityChunk& s : chunks) {
+        total.nEdges += s.nEdges;
+        total.sumEdge += s.sumEdge;
+        total.maxDihedral = std::max(total.maxDihedral, s.maxDihedral);
+        internal::addHistogram(total.edgeLength, s.edgeLength);
+        internal::addHistogram(total.dihedral, s.dihedral);
+    }
+    nEdges = total.nEdges;
+    meanEdgeLength = nEdges > 0 ? total.sumEdge / nEdges : 0;
+    maxDihedralAngle = total.maxDihedral;
+    edgeLengthHistogram.counts = total.edgeLength;
+    dihedralAngleHistogram.counts = total.dihedral;
+}
+
+unsigned int MeshQuality::getNumberFaces() const
+{
+    return (unsigned int)areas.size();
+}
+
+unsigned int MeshQuality::getNumberEdges() const
+{
+    return nEdges;
+}
+
+unsigned int MeshQuality::getNumberDegenerateFaces() const
+{
+    return nDegenerate;
+}
+
+/**
+ * @brief MeshQuality::getNumberSliverFaces
+ * @return the number of non degenerate faces with aspect ratio larger than
+ * the sliver threshold
+ */
+unsigned int MeshQuality::getNumberSliverFaces() const
+{
+    return nSlivers;
+}
+
+const std::vector<float>& MeshQuality::getFaceAreas() const
+{
+    return areas;
+}
+
+const std::vector<float>& MeshQuality::getAspectRatios() const
+{
+    return aspectRatios;
+}
+
+const std::vector<float>& MeshQuality::getMinAngles() const
+{
+    return minAngles;
+}
+
+const std::vector<float>& MeshQuality::getMaxAngles() const
+{
+    return maxAngles;
+}
+
+double MeshQuality::getMinAngle() const
+{
+    return minAngle;
+}
+
+double MeshQuality::getMaxAngle() const
+{
+    return maxAngle;
+}
+
+double MeshQuality::getMeanAspectRatio() const
+{
+    return meanAspectRatio;
+}
+
+double MeshQuality::getMaxAspectRatio() const
+{
+    return maxAspectRatio;
+}
+
+double MeshQuality::getMinEdgeLength() const
+{
+    return minEdgeLength;
+}
+
+double MeshQuality::getMaxEdgeLength() const
+{
+    return maxEdgeLength;
+}
+
+double MeshQuality::getMeanEdgeLength() const
+{
+    return meanEdgeLength;
+}
+
+/**
+ * @brief MeshQuality::getMaxDihedralAngle
+ * @return the maximum angle between the normals of two adjacent non
+ * degenerate faces, in degrees
+ */
+double MeshQuality::getMaxDihedralAngle() const
+{
+    return maxDihedralAngle;
+}
+
+const QualityHistogram& MeshQuality::getAspectRatioHistogram() const
+{
+    return aspectRatioHistogram;
+}
+
+const QualityHistogram& MeshQuality::getMinAngleHistogram() const
+{
+    return minAngleHistogram;
+}
+
+const QualityHistogram& MeshQuality::getMaxAngleHistogram() const
+{
+    return maxAngleHistogram;
+}
+
+const QualityHistogram& MeshQuality::getEdgeLengthHistogram() const
+{
+    return edgeLengthHistogram;
+}
+
+const QualityHistogram& MeshQuality::getDihedralAngleHistogram() const
+{
+    return dihedralAngleHistogram;
+}
+
+std::vector<unsigned int> MeshQuality::getDegenerateFaces(const ParallelOptions& options) const
+{
+    return selectFaces([&](unsigned int f) {
+        return std::isinf(aspectRatios[f]);
+    }, options);
+}
+
+std::vector<unsigned int> MeshQuality::getSliverFaces(const ParallelOptions& options) const
+{
+    return selectFaces([&](unsigned int f) {
+        return aspectRatios[f] > sliverAspectRatio && !std::isinf(aspectRatios[f]);
+    }, options);
+}
+
+/**
+ * @brief MeshQuality::getFacesWithAspectRatioAbove
+ * @return the sorted indices of the faces with aspect ratio larger than
+ * aspectRatio, degenerate faces included
+ */
+std::vector<unsigned int> MeshQuality::getFacesWithAspectRatioAbove(
+        double aspectRatio,
+        const ParallelOptions& options) const
+{
+    return selectFaces([&](unsigned int f) {
+        return aspectRatios[f] > aspectRatio;
+    }, options);
+}
+
+std::vector<unsigned int> MeshQuality::getFacesWithMinAngleBelow(
+        double angle,
+        const ParallelOptions& options) const
+{
+    return selectFaces([&](unsigned int f) {
+        return minAngles[f] < angle;
+    }, options);
+}
+
+std::vector<unsigned int> MeshQuality::getFacesWithMaxAngleAbove(
+        double angle,
+        const ParallelOptions& options) const
+{
+    return selectFaces([&](unsigned int f) {
+        return maxAngles[f] > angle;
+    }, options);
+}
+
+/**
+ * @brief MeshQuality::selectFaces
+ * @return the sorted indices of the faces that satisfy p, selected in
+ * parallel with a count, a scan and a write pass on chunks of faces
+ */
+template <typename Predicate>
+std::vector<unsigned int> MeshQuality::selectFaces(Predicate p, const ParallelOptions& options) const
+{
+    const unsigned int chunk = internal::QUALITY_CHUNK_SIZE;
+    unsigned int nFaces = getNumberFaces();
+    unsigned int nChunks = (nFaces + chunk - 1) / chunk;
+    ParallelOptions chunkOptions(options.nThreads, 1, options.deterministic);
+    std::vector<unsigned int> counts(nChunks, 0), offsets(nChunks);
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        unsigned int end = std::min(nFaces, (c + 1) * chunk);
+        for (unsigned int f = c * chunk; f < end; f++)
+            if (p(f))
+                counts[c]++;
+    }, chunkOptions);
+    unsigned int n = parallelExclusiveScan(
+                counts.begin(), counts.end(), offsets.begin(), 0u, std::plus<unsigned int>(), options);
+    std::vector<unsigned int> faces(n);
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        unsigned int end = std::min(nFaces, (c + 1) * chunk);
+        unsigned int i = offsets[c];
+        for (unsigned int f = c * chunk; f < end; f++)
+            if (p(f))
+                faces[i++] = f;
+    }, chunkOptions);
+    return faces;
+}
+
+#endif // CG3_DCEL_DEFINED
+
+}
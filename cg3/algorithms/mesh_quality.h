@@ -0,0 +1,171 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_MESH_QUALITY_H
+#define CG3_MESH_QUALITY_H
+
+#include <vector>
+
+#include <cg3/utilities/parallel.h>
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/compact_trimesh/compact_trimesh.h>
+#endif
+
+namespace cg3 {
+
+#ifdef CG3_EIGENMESH_DEFINED
+class SimpleEigenMesh;
+#endif
+
+/**
+ * @ingroup cg3algorithms
+ * @brief Histogram with uniform bins on the range [min, max]; values out of
+ * the range are counted in the first or in the last bin.
+ */
+struct QualityHistogram
+{
+    QualityHistogram(double min = 0, double max = 1, unsigned int nBins = 0);
+
+    unsigned int bin(double value) const;
+    double binWidth() const;
+    double binMin(unsigned int i) const;
+    double binMax(unsigned int i) const;
+
+    double min;
+    double max;
+    std::vector<unsigned int> counts;
+};
+
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @ingroup cg3algorithms
+ * @brief The MeshQuality class computes the quality measures of the
+ * triangles of a mesh in a single parallel pass on the faces, followed by a
+ * parallel pass on the edges:
+ * - per face: area, aspect ratio, minimum and maximum angle (in degrees);
+ * - per edge: length and dihedral angle (0 for coplanar faces, in degrees);
+ * - minimum, maximum and mean of every measure, and histograms;
+ * - degenerate faces (null area with respect to their longest edge) and
+ *   slivers (faces with aspect ratio larger than a threshold).
+ *
+ * The aspect ratio of a triangle is the ratio between its longest edge and
+ * the diameter of its inscribed circle, normalized such that it is 1 for
+ * the equilateral triangle. Degenerate faces have infinite aspect ratio, and
+ * are not counted in the statistics and in the histograms.
+ *
+ * Faces are processed in blocks of 8, whose coordinates are gathered in
+ * arrays, one per component: when Eigen is available, the measures of a
+ * block that do not need a trigonometric function are computed with Eigen
+ * arrays, whose operations are SIMD packets on all the faces of the block.
+ *
+ * Per face arrays are indexed by face (by face id for a Dcel, with NaN on
+ * the ids of the deleted faces). Faces of a Dcel that are not triangles are
+ * fan triangulated, and take the measures of their worst triangle.
+ *
+ * \code{.cpp}
+ * cg3::MeshQuality quality(mesh);
+ * if (quality.getNumberDegenerateFaces() > 0 || quality.getMinAngle() < 5)
+ *     repair(mesh, quality.getFacesWithMinAngleBelow(5));
+ * \endcode
+ */
+class MeshQuality
+{
+public:
+    MeshQuality();
+    MeshQuality(
+            const CompactTriMesh& mesh,
+            double sliverAspectRatio = 10,
+            unsigned int nBins = 32,
+            const ParallelOptions& options = ParallelOptions());
+    MeshQuality(
+            const Dcel& mesh,
+            double sliverAspectRatio = 10,
+            unsigned int nBins = 32,
+            const ParallelOptions& options = ParallelOptions());
+    #ifdef CG3_EIGENMESH_DEFINED
+    MeshQuality(
+            const SimpleEigenMesh& mesh,
+            double sliverAspectRatio = 10,
+            unsigned int nBins = 32,
+            const ParallelOptions& options = ParallelOptions());
+    #endif
+
+    void build(
+            const CompactTriMesh& mesh,
+            double sliverAspectRatio = 10,
+            unsigned int nBins = 32,
+            const ParallelOptions& options = ParallelOptions());
+
+    unsigned int getNumberFaces() const;
+    unsigned int getNumberEdges() const;
+    unsigned int getNumberDegenerateFaces() const;
+    unsigned int getNumberSliverFaces() const;
+
+    //per face measures
+    const std::vector<float>& getFaceAreas() const;
+    const std::vector<float>& getAspectRatios() const;
+    const std::vector<float>& getMinAngles() const;
+    const std::vector<float>& getMaxAngles() const;
+
+    //statistics
+    double getMinAngle() const;
+    double getMaxAngle() const;
+    double getMeanAspectRatio() const;
+    double getMaxAspectRatio() const;
+    double getMinEdgeLength() const;
+    double getMaxEdgeLength() const;
+    double getMeanEdgeLength() const;
+    double getMaxDihedralAngle() const;
+
+    const QualityHistogram& getAspectRatioHistogram() const;
+    const QualityHistogram& getMinAngleHistogram() const;
+    const QualityHistogram& getMaxAngleHistogram() const;
+    const QualityHistogram& getEdgeLengthHistogram() const;
+    const QualityHistogram& getDihedralAngleHistogram() const;
+
+    //faces to repair
+    std::vector<unsigned int> getDegenerateFaces(const ParallelOptions& options = ParallelOptions()) const;
+    std::vector<unsigned int> getSliverFaces(const ParallelOptions& options = ParallelOptions()) const;
+    std::vector<unsigned int> getFacesWithAspectRatioAbove(
+            double aspectRatio,
+            const ParallelOptions& options = ParallelOptions()) const;
+    std::vector<unsigned int> getFacesWithMinAngleBelow(
+            double angle,
+            const ParallelOptions& options = ParallelOptions()) const;
+    std::vector<unsigned int> getFacesWithMaxAngleAbove(
+            double angle,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+protected:
+    template <typename Predicate>
+    std::vector<unsigned int> selectFaces(Predicate p, const ParallelOptions& options) const;
+
+    std::vector<float> areas;
+    std::vector<float> aspectRatios;
+    std::vector<float> minAngles;
+    std::vector<float> maxAngles;
+
+    double sliverAspectRatio;
+    unsigned int nEdges;
+    unsigned int nDegenerate;
+    unsigned int nSlivers;
+    double minAngle, maxAngle;
+    double meanAspectRatio, maxAspectRatio;
+    double minEdgeLength, maxEdgeLength, meanEdgeLength;
+    double maxDihedralAngle;
+
+    QualityHistogram aspectRatioHistogram;
+    QualityHistogram minAngleHistogram;
+    QualityHistogram maxAngleHistogram;
+    QualityHistogram edgeLengthHistogram;
+    QualityHistogram dihedralAngleHistogram;
+};
+#endif // CG3_DCEL_DEFINED
+
+}
+
+#endif // CG3_MESH_QUALITY_H
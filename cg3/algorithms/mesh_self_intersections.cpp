@@ -0,0 +1,588 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "mesh_self_intersections.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cg3/utilities/profiler.h>
+
+#include "triangle_bvh.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/* half of the machine epsilon, and the error bounds of the orientation
+ * predicates evaluated in double precision (Shewchuk, Adaptive precision
+ * floating-point arithmetic and fast robust geometric predicates, 1997) */
+static const double EXACT_EPSILON = std::numeric_limits<double>::epsilon() / 2;
+static const double ORIENT2D_ERROR_BOUND = (3 + 16 * EXACT_EPSILON) * EXACT_EPSILON;
+static const double ORIENT3D_ERROR_BOUND = (7 + 56 * EXACT_EPSILON) * EXACT_EPSILON;
+/* projection of a degenerate triangle */
+static const unsigned char NO_PROJECTION = 3;
+
+/* exact value of a sum of doubles: nonoverlapping components sorted by
+ * increasing magnitude, without zeros. The capacity is enough for the
+ * determinant of orient3d on differences of doubles. */
+struct ExactExpansion
+{
+    static const unsigned int CAPACITY = 192;
+    double c[CAPACITY];
+    unsigned int n;
+};
+
+/* a + b = s + e, exactly */
+inline void exactTwoSum(double a, double b, double& s, double& e)
+{
+    s = a + b;
+    double bv = s - a;
+    double av = s - bv;
+    e = (a - av) + (b - bv);
+}
+
+/* a * b = p + e, exactly (Dekker's product, without fused multiply add) */
+inline void exactTwoProduct(double a, double b, double& p, double& e)
+{
+    const double splitter = 134217729.0; //2^27 + 1
+    p = a * b;
+    double c = splitter * a;
+    double aHi = c - (c - a), aLo = a - aHi;
+    c = splitter * b;
+    double bHi = c - (c - b), bLo = b - bHi;
+    e = aLo * bLo - (((p - aHi * bHi) - aLo * bHi) - aHi * bLo);
+}
+
+inline void exactDifference(double a, double b, ExactExpansion& h)
+{
+    double s, e;
+    exactTwoSum(a, -b, s, e);
+    h.n = 0;
+    if (e != 0)
+        h.c[h.n++] = e;
+    if (s != 0)
+        h.c[h.n++] = s;
+}
+
+/* h = e + b; h can be e */
+inline void exactGrow(const ExactExpansion& e, double b, ExactExpansion& h)
+{
+    double q = b;
+    unsigned int n = 0;
+    for (unsigned int i = 0; i < e.n; i++) {
+        double s, err;
+        exactTwoSum(q, e.c[i], s, err);
+        if (err != 0)
+            h.c[n++] = err;
+        q = s;
+    }
+    if (q != 0)
+        h.c[n++] = q;
+    h.n = n;
+}
+
+/* e += f */
+inline void exactAdd(ExactExpansion& e, const ExactExpansion& f)
+{
+    for (unsigned int j = 0; j < f.n; j++)
+        exactGrow(e, f.c[j], e);
+}
+
+/* h = e * b */
+inline void exactScale(const ExactExpansion& e, double b, ExactExpansion& h)
+{
+    h.n = 0;
+    if (e.n == 0 || b == 0)
+        return;
+    double q, hh;
+    exactTwoProduct(e.c[0], b, q, hh);
+    if (hh != 0)
+        h.c[h.n++] = hh;
+    for (unsigned int i = 1; i < e.n; i++) {
+        double p1, p0, sum;
+        exactTwoProduct(e.c[i], b, p1, p0);
+        exactTwoSum(q, p0, sum, hh);
+        if (hh != 0)
+            h.c[h.n++] = hh;
+        exactTwoSum(p1, sum, q, hh);
+        if (hh != 0)
+            h.c[h.n++] = hh;
+    }
+    if (q != 0)
+        h.c[h.n++] = q;
+}
+
+/* h = e * f */
+inline void exactProduct(const ExactExpansion& e, const ExactExpansion& f, ExactExpansion& h)
+{
+    ExactExpansion t;
+    h.n = 0;
+    for (unsigned int j = 0; j < f.n; j++) {
+        exactScale(e, f.c[j], t);
+        exactAdd(h, t);
+    }
+}
+
+/* h = a * b - c * d */
+inline void exactMinor(
+        const ExactExpansion& a,
+        const ExactExpansion& b,
+        const ExactExpansion& c,
+        const ExactExpansion& d,
+        ExactExpansion& h)
+{
+    ExactExpansion t;
+    exactProduct(a, b, h);
+    exactProduct(c, d, t);
+    for (unsigned int i = 0; i < t.n; i++)
+        t.c[i] = -t.c[i];
+    exactAdd(h, t);
+}
+
+/* the sign of an expansion is the sign of its largest component */
+inline int exactSign(const ExactExpansion& e)
+{
+    return e.n == 0 ? 0 : (e.c[e.n-1] > 0 ? 1 : -1);
+}
+
+inline int orient2dExact(const Pointd& a, const Pointd& b, const Pointd& c, unsigned int x, unsigned int y)
+{
+    ExactExpansion acx, acy, bcx, bcy, det;
+    exactDifference(a[x], c[x], acx);
+    exactDifference(a[y], c[y], acy);
+    exactDifference(b[x], c[x], bcx);
+    exactDifference(b[y], c[y], bcy);
+    exactMinor(acx, bcy, acy, bcx, det);
+    return exactSign(det);
+}
+
+inline int orient3dExact(const Pointd& a, const Pointd& b, const Pointd& c, const Pointd& d)
+{
+    ExactExpansion ad[3], bd[3], cd[3], minor, term, det;
+    for (unsigned int i = 0; i < 3; i++) {
+        exactDifference(a[i], d[i], ad[i]);
+        exactDifference(b[i], d[i], bd[i]);
+        exactDifference(c[i], d[i], cd[i]);
+    }
+    //expansion along z, skipping the null terms (e.g. points on a plane
+    //orthogonal to z)
+    const ExactExpansion* z[3] = {&ad[2], &bd[2], &cd[2]};
+    const ExactExpansion* x[3] = {&bd[0], &cd[0], &ad[0]};
+    const ExactExpansion* y[3] = {&bd[1], &cd[1], &ad[1]};
+    det.n = 0;
+    for (unsigned int i = 0; i < 3; i++) {
+        if (z[i]->n == 0)
+            continue;
+        unsigned int j = (i + 1) % 3;
+        exactMinor(*x[i], *y[j], *y[i], *x[j], minor);
+        exactProduct(*z[i], minor, term);
+        exactAdd(det, term);
+    }
+    return exactSign(det);
+}
+
+/* sign of the orientation of a, b, c projected on the axes x and y: the
+ * determinant is evaluated in double precision, and exactly only if its sign
+ * is not certified by the error bound. A null permanent means that every
+ * product has a null factor, and the determinant is zero (as in the exact
+ * arithmetic, underflows are not considered). */
+inline int orient2d(const Pointd& a, const Pointd& b, const Pointd& c, unsigned int x, unsigned int y)
+{
+    double left = (a[x] - c[x]) * (b[y] - c[y]);
+    double right = (a[y] - c[y]) * (b[x] - c[x]);
+    double det = left - right;
+    double permanent = std::abs(left) + std::abs(right);
+    double bound = ORIENT2D_ERROR_BOUND * permanent;
+    if (det > bound)
+        return 1;
+    if (-det > bound)
+        return -1;
+    if (permanent == 0)
+        return 0;
+    return orient2dExact(a, b, c, x, y);
+}
+
+/* sign of the volume of the tetrahedron a, b, c, d, filtered as orient2d */
+inline int orient3d(const Pointd& a, const Pointd& b, const Pointd& c, const Pointd& d)
+{
+    double adx = a.x() - d.x(), ady = a.y() - d.y(), adz = a.z() - d.z();
+    double bdx = b.x() - d.x(), bdy = b.y() - d.y(), bdz = b.z() - d.z();
+    double cdx = c.x() - d.x(), cdy = c.y() - d.y(), cdz = c.z() - d.z();
+    double bdxcdy = bdx * cdy, bdycdx = bdy * cdx;
+    double cdxady = cdx * ady, cdyadx = cdy * adx;
+    double adxbdy = adx * bdy, adybdx = ady * bdx;
+    double det = adz * (bdxcdy - bdycdx) + bdz * (cdxady - cdyadx) + cdz * (adxbdy - adybdx);
+    double permanent = (std::abs(bdxcdy) + std::abs(bdycdx)) * std::abs(adz) +
+                       (std::abs(cdxady) + std::abs(cdyadx)) * std::abs(bdz) +
+                       (std::abs(adxbdy) + std::abs(adybdx)) * std::abs(cdz);
+    double bound = ORIENT3D_ERROR_BOUND * permanent;
+    if (det > bound)
+        return 1;
+    if (-det > bound)
+        return -1;
+    if (permanent == 0)
+        return 0;
+    return orient3dExact(a, b, c, d);
+}
+
+/* a triangle is given by the pointers to its vertices, and by the axis
+ * dropped by its projection on a coordinate plane */
+struct ExactTriangle
+{
+    const Pointd* p[3];
+    unsigned int axis;
+};
+
+/* axis that can be dropped without making the triangle degenerate,
+ * preferring the largest component of the normal; NO_PROJECTION if the
+ * triangle is degenerate */
+inline unsigned char triangleProjectionAxis(const Pointd& p0, const Pointd& p1, const Pointd& p2)
+{
+    Vec3 n = (p1 - p0).cross(p2 - p0);
+    unsigned int axes[3] = {0, 1, 2};
+    std::sort(axes, axes + 3, [&](unsigned int a, unsigned int b) {
+        return std::abs(n[a]) > std::abs(n[b]);
+    });
+    for (unsigned int axis : axes)
+        if (orient2d(p0, p1, p2, (axis + 1) % 3, (axis + 2) % 3) != 0)
+            return (unsigned char)axis;
+    return NO_PROJECTION;
+}
+
+inline int orient2d(const Pointd& a, const Pointd& b, const Pointd& c, unsigned int axis)
+{
+    return orient2d(a, b, c, (axis + 1) % 3, (axis + 2) % 3);
+}
+
+inline bool sameStrictSign(int s0, int s1, int s2)
+{
+    return (s0 > 0 && s1 > 0 && s2 > 0) || (s0 < 0 && s1 < 0 && s2 < 0);
+}
+
+/* the closed segment pq and the closed triangle, all of them in the plane of
+ * the triangle, intersect if they are not separated by the line of an edge
+ * of the triangle or by the line of the segment */
+inline bool segmentTriangle2d(const Pointd& p, const Pointd& q, const ExactTriangle& t)
+{
+    int s = orient2d(*t.p[0], *t.p[1], *t.p[2], t.axis);
+    for (unsigned int i = 0; i < 3; i++) {
+        const Pointd& a = *t.p[i];
+        const Pointd& b = *t.p[(i+1)%3];
+        if (orient2d(a, b, p, t.axis) * s < 0 && orient2d(a, b, q, t.axis) * s < 0)
+            return false;
+    }
+    return !sameStrictSign(
+                orient2d(p, q, *t.p[0], t.axis),
+                orient2d(p, q, *t.p[1], t.axis),
+                orient2d(p, q, *t.p[2], t.axis));
+}
+
+/* two closed coplanar triangles intersect if they are not separated by the
+ * line of an edge of one of them */
+inline bool trianglesIntersecting2d(const ExactTriangle& a, const ExactTriangle& b)
+{
+    const ExactTriangle* t[2] = {&a, &b};
+    for (unsigned int k = 0; k < 2; k++) {
+        const ExactTriangle& x = *t[k];
+        const ExactTriangle& y = *t[1-k];
+        int s = orient2d(*x.p[0], *x.p[1], *x.p[2], a.axis);
+        for (unsigned int i = 0; i < 3; i++) {
+            const Pointd& p = *x.p[i];
+            const Pointd& q = *x.p[(i+1)%3];
+            if (orient2d(p, q, *y.p[0], a.axis) * s < 0 &&
+                orient2d(p, q, *y.p[1], a.axis) * s < 0 &&
+                orient2d(p, q, *y.p[2], a.axis) * s < 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+/* the closed segment pq intersects the closed triangle; sp and sq are the
+ * orientations of p and q with respect to the plane of the triangle */
+inline bool segmentTriangle(const Pointd& p, const Pointd& q, int sp, int sq, const ExactTriangle& t)
+{
+    if (sp * sq > 0)
+        return false;
+    if (sp == 0 && sq == 0)
+        return segmentTriangle2d(p, q, t);
+    //the line pq crosses the plane inside the triangle if it turns around
+    //all the edges in the same direction
+    int o0 = orient3d(p, q, *t.p[0], *t.p[1]);
+    int o1 = orient3d(p, q, *t.p[1], *t.p[2]);
+    int o2 = orient3d(p, q, *t.p[2], *t.p[0]);
+    return !((o0 > 0 || o1 > 0 || o2 > 0) && (o0 < 0 || o1 < 0 || o2 < 0));
+}
+
+/* p, coplanar with the triangle v, c, d, lies in the closed wedge of the
+ * triangle at v */
+inline bool pointInWedge(const Pointd& p, const Pointd& v, const Pointd& c, const Pointd& d, unsigned int axis)
+{
+    int s = orient2d(v, c, d, axis);
+    return orient2d(v, c, p, axis) * s >= 0 && orient2d(v, p, d, axis) * s >= 0;
+}
+
+/* the closed triangles intersect */
+inline bool trianglesIntersecting(const ExactTriangle& a, const ExactTriangle& b)
+{
+    int sb[3], sa[3];
+    for (unsigned int i = 0; i < 3; i++)
+        sb[i] = orient3d(*a.p[0], *a.p[1], *a.p[2], *b.p[i]);
+    if (sameStrictSign(sb[0], sb[1], sb[2]))
+        return false;
+    if (sb[0] == 0 && sb[1] == 0 && sb[2] == 0)
+        return trianglesIntersecting2d(a, b);
+    for (unsigned int i = 0; i < 3; i++)
+        sa[i] = orient3d(*b.p[0], *b.p[1], *b.p[2], *a.p[i]);
+    if (sameStrictSign(sa[0], sa[1], sa[2]))
+        return false;
+    for (unsigned int i = 0; i < 3; i++) {
+        unsigned int j = (i + 1) % 3;
+        if (segmentTriangle(*a.p[i], *a.p[j], sa[i], sa[j], b) ||
+            segmentTriangle(*b.p[i], *b.p[j], sb[i], sb[j], a))
+            return true;
+    }
+    return false;
+}
+
+/* the triangles t1 and t2 of a mesh intersect in points that are not shared
+ * by their boundaries: the shared vertices and edges are not intersections */
+inline bool meshTrianglesIntersecting(
+        const std::vector<Pointd>& vertices,
+        const std::array<unsigned int, 3>& t1,
+        const std::array<unsigned int, 3>& t2,
+        unsigned int axis1,
+        unsigned int axis2)
+{
+    //shared[i]: vertex of t2 equal to the vertex i of t1, or 3
+    unsigned int shared[3], nShared = 0;
+    for (unsigned int i = 0; i < 3; i++) {
+        shared[i] = 3;
+        for (unsigned int j = 0; j < 3; j++)
+            if (t1[i] == t2[j])
+                shared[i] = j;
+        if (shared[i] < 3)
+            nShared++;
+    }
+    ExactTriangle a = {{&vertices[t1[0]], &vertices[t1[1]], &vertices[t1[2]]}, axis1};
+    ExactTriangle b = {{&vertices[t2[0]], &vertices[t2[1]], &vertices[t2[2]]}, axis2};
+    if (nShared == 0)
+        return trianglesIntersecting(a, b);
+    if (nShared == 3)
+        return true;
+    if (nShared == 2) {
+        //triangles sharing an edge overlap only if they are coplanar and
+        //folded on the same side of the edge
+        unsigned int i = shared[0] == 3 ? 0 : (shared[1] == 3 ? 1 : 2);
+        unsigned int j = 3 - shared[(i+1)%3] - shared[(i+2)%3];
+        const Pointd& u = *a.p[(i+1)%3];
+        const Pointd& w = *a.p[(i+2)%3];
+        if (orient3d(u, w, *a.p[i], *b.p[j]) != 0)
+            return false;
+        return orient2d(u, w, *a.p[i], axis1) * orient2d(u, w, *b.p[j], axis1) > 0;
+    }
+    //triangles v, a1, a2 and v, b1, b2 sharing a vertex: they intersect
+    //elsewhere if an opposite edge crosses the other triangle, or if an edge
+    //incident to v lies on the other triangle
+    unsigned int i = shared[0] < 3 ? 0 : (shared[1] < 3 ? 1 : 2);
+    unsigned int j = shared[i];
+    const Pointd& v = *a.p[i];
+    const Pointd& a1 = *a.p[(i+1)%3];
+    const Pointd& a2 = *a.p[(i+2)%3];
+    const Pointd& b1 = *b.p[(j+1)%3];
+    const Pointd& b2 = *b.p[(j+2)%3];
+    int sb1 = orient3d(v, a1, a2, b1), sb2 = orient3d(v, a1, a2, b2);
+    if (sb1 * sb2 > 0)
+        return false;
+    int sa1 = orient3d(v, b1, b2, a1), sa2 = orient3d(v, b1, b2, a2);
+    if (sa1 * sa2 > 0)
+        return false;
+    ExactTriangle va = {{&v, &a1, &a2}, axis1};
+    ExactTriangle vb = {{&v, &b1, &b2}, axis2};
+    return segmentTriangle(b1, b2, sb1, sb2, va) ||
+           segmentTriangle(a1, a2, sa1, sa2, vb) ||
+           (sa1 == 0 && pointInWedge(a1, v, b1, b2, axis2)) ||
+           (sa2 == 0 && pointInWedge(a2, v, b1, b2, axis2)) ||
+           (sb1 == 0 && pointInWedge(b1, v, a1, a2, axis1)) ||
+           (sb2 == 0 && pointInWedge(b2, v, a1, a2, axis1));
+}
+
+/* end points of the segment where the triangle t crosses the plane of the
+ * triangle o, as positions along direction */
+inline void planeCrossing(
+        const Pointd* t[3],
+        const Pointd* o[3],
+        const Vec3& direction,
+        Pointd& first,
+        Pointd& last)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    Vec3 normal = (*o[1] - *o[0]).cross(*o[2] - *o[0]);
+    double d[3];
+    for (unsigned int i = 0; i < 3; i++)
+        d[i] = normal.dot(*t[i] - *o[0]);
+    double lo = inf, hi = -inf;
+    auto add = [&](const Pointd& p) {
+        double s = direction.dot(p);
+        if (s < lo) {
+            lo = s;
+            first = p;
+        }
+        if (s > hi) {
+            hi = s;
+            last = p;
+        }
+    };
+    for (unsigned int i = 0; i < 3; i++) {
+        unsigned int j = (i + 1) % 3;
+        if (d[i] == 0)
+            add(*t[i]);
+        if ((d[i] < 0 && d[j] > 0) || (d[i] > 0 && d[j] < 0))
+            add(*t[i] + (*t[j] - *t[i]) * (d[i] / (d[i] - d[j])));
+    }
+    if (lo == inf) {
+        //rounding: the vertex nearest to the plane
+        unsigned int i = 0;
+        for (unsigned int k = 1; k < 3; k++)
+            if (std::abs(d[k]) < std::abs(d[i]))
+                i = k;
+        add(*t[i]);
+    }
+}
+
+/* intersection segment of two intersecting triangles that are not
+ * coplanar: the overlap of the segments where each triangle crosses the plane
+ * of the other one */
+inline Segment3Dd intersectionSegment(const Pointd* a[3], const Pointd* b[3])
+{
+    Vec3 direction = (*a[1] - *a[0]).cross(*a[2] - *a[0]).cross((*b[1] - *b[0]).cross(*b[2] - *b[0]));
+    Pointd firstA, lastA, firstB, lastB;
+    planeCrossing(a, b, direction, firstA, lastA);
+    planeCrossing(b, a, direction, firstB, lastB);
+    Pointd first = direction.dot(firstA) >= direction.dot(firstB) ? firstA : firstB;
+    Pointd last = direction.dot(lastA) <= direction.dot(lastB) ? lastA : lastB;
+    if (direction.dot(last) < direction.dot(first))
+        last = first;
+    return Segment3Dd(first, last);
+}
+
+} //namespace cg3::internal
+
+SelfIntersection::SelfIntersection() :
+    triangle1(0),
+    triangle2(0),
+    face1(0),
+    face2(0),
+    coplanar(false)
+{
+}
+
+/**
+ * @ingroup cg3algorithms
+ * @brief selfIntersectingTriangles
+ * Finds the pairs of triangles of a mesh that intersect in points that are not
+ * shared by their boundaries: two triangles that share a vertex (by index)
+ * intersect only if they have other points in common, and two triangles that
+ * share an edge intersect only if they are coplanar and overlap.
+ *
+ * The candidate pairs are the triangles with overlapping bounding boxes,
+ * found with a traversal of a TriangleBvh against itself, and they are tested
+ * in parallel during the traversal. The tests use only the signs of
+ * orientation predicates, that are evaluated in double precision and
+ * recomputed exactly when the rounding error could change their sign: the
+ * result is exact for any input, including coplanar and touching triangles.
+ *
+ * Degenerate triangles (with collinear vertices) are not tested, and vertices
+ * with the same position but different indices are not considered shared.
+ * @param triangleFaces: face of every triangle; triangles of the same face
+ * are not tested. If empty, every triangle is a face.
+ * @return the pairs (i, j), with i < j, of intersecting triangles, sorted
+ */
+std::vector<std::pair<unsigned int, unsigned int>> selfIntersectingTriangles(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces,
+        const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("selfIntersectingTriangles");
+    unsigned int nTriangles = (unsigned int)triangles.size();
+    std::vector<unsigned char> axes(nTriangles);
+    parallelFor(0u, nTriangles, [&](unsigned int t) {
+        axes[t] = internal::triangleProjectionAxis(
+                    vertices[triangles[t][0]], vertices[triangles[t][1]], vertices[triangles[t][2]]);
+    }, options);
+    TriangleBvh bvh;
+    bvh.build(vertices, triangles, triangleFaces, options);
+    return bvh.overlappingPairs([&](unsigned int t1, unsigned int t2) {
+        if (axes[t1] == internal::NO_PROJECTION || axes[t2] == internal::NO_PROJECTION)
+            return false;
+        if (!triangleFaces.empty() && triangleFaces[t1] == triangleFaces[t2])
+            return false;
+        return internal::meshTrianglesIntersecting(vertices, triangles[t1], triangles[t2], axes[t1], axes[t2]);
+    }, options);
+}
+
+/**
+ * @ingroup cg3algorithms
+ * @brief selfIntersections
+ * Finds the pairs of intersecting triangles as selfIntersectingTriangles, and
+ * computes their intersection segments.
+ * @return an intersection for every pair of intersecting triangles, sorted
+ * by triangles
+ */
+std::vector<SelfIntersection> selfIntersections(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<std::pair<unsigned int, unsigned int>> pairs =
+            selfIntersectingTriangles(vertices, triangles, triangleFaces, options);
+    std::vector<SelfIntersection> intersections(pairs.size());
+    parallelFor((size_t)0, pairs.size(), [&](size_t i) {
+        SelfIntersection& s = intersections[i];
+        s.triangle1 = pairs[i].first;
+        s.triangle2 = pairs[i].second;
+        s.face1 = triangleFaces.empty() ? s.triangle1 : triangleFaces[s.triangle1];
+        s.face2 = triangleFaces.empty() ? s.triangle2 : triangleFaces[s.triangle2];
+        const Pointd* a[3];
+        const Pointd* b[3];
+        for (unsigned int k = 0; k < 3; k++) {
+            a[k] = &vertices[triangles[s.triangle1][k]];
+            b[k] = &vertices[triangles[s.triangle2][k]];
+        }
+        s.coplanar = true;
+        for (unsigned int k = 0; k < 3; k++)
+            if (internal::orient3d(*a[0], *a[1], *a[2], *b[k]) != 0)
+                s.coplanar = false;
+        if (!s.coplanar)
+            s.segment = internal::intersectionSegment(a, b);
+    }, options);
+    return intersections;
+}
+
+/**
+ * @ingroup cg3algorithms
+ * @brief areTrianglesIntersecting
+ * Exact test of intersection between the closed triangles p and q (see
+ * selfIntersectingTriangles); degenerate triangles do not intersect.
+ */
+bool areTrianglesIntersecting(
+        const Pointd& p0, const Pointd& p1, const Pointd& p2,
+        const Pointd& q0, const Pointd& q1, const Pointd& q2)
+{
+    unsigned char axis1 = internal::triangleProjectionAxis(p0, p1, p2);
+    unsigned char axis2 = internal::triangleProjectionAxis(q0, q1, q2);
+    if (axis1 == internal::NO_PROJECTION || axis2 == internal::NO_PROJECTION)
+        return false;
+    internal::ExactTriangle a = {{&p0, &p1, &p2}, axis1};
+    internal::ExactTriangle b = {{&q0, &q1, &q2}, axis2};
+    return internal::trianglesIntersecting(a, b);
+}
+
+}
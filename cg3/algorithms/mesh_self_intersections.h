@@ -0,0 +1,74 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_MESH_SELF_INTERSECTIONS_H
+#define CG3_MESH_SELF_INTERSECTIONS_H
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <cg3/geometry/point.h>
+#include <cg3/geometry/segment.h>
+#include <cg3/utilities/parallel.h>
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/mesh_traits.h>
+#endif
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3algorithms
+ * @brief Intersection between two triangles of a mesh. If the triangles are
+ * not coplanar, they intersect in segment (whose end points coincide if they
+ * touch in a single point); the intersection of coplanar triangles is a
+ * polygon, and segment is not set.
+ */
+struct SelfIntersection
+{
+    SelfIntersection();
+
+    unsigned int triangle1;
+    unsigned int triangle2;
+    unsigned int face1;
+    unsigned int face2;
+    bool coplanar;
+    Segment3Dd segment;
+};
+
+std::vector<std::pair<unsigned int, unsigned int>> selfIntersectingTriangles(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces = std::vector<unsigned int>(),
+        const ParallelOptions& options = ParallelOptions());
+
+std::vector<SelfIntersection> selfIntersections(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces = std::vector<unsigned int>(),
+        const ParallelOptions& options = ParallelOptions());
+
+bool areTrianglesIntersecting(
+        const Pointd& p0, const Pointd& p1, const Pointd& p2,
+        const Pointd& q0, const Pointd& q1, const Pointd& q2);
+
+#ifdef CG3_DCEL_DEFINED
+template <typename Mesh>
+std::vector<std::pair<unsigned int, unsigned int>> meshSelfIntersectingFaces(
+        const Mesh& mesh,
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename Mesh>
+std::vector<SelfIntersection> meshSelfIntersections(
+        const Mesh& mesh,
+        const ParallelOptions& options = ParallelOptions());
+#endif
+
+}
+
+#include "mesh_self_intersections.tpp"
+
+#endif // CG3_MESH_SELF_INTERSECTIONS_H
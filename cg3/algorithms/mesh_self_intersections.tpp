@@ -0,0 +1,64 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "mesh_self_intersections.h"
+
+#include <algorithm>
+
+namespace cg3 {
+
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @ingroup cg3algorithms
+ * @brief meshSelfIntersectingFaces
+ * Finds the pairs of faces of a mesh that intersect in points that are not
+ * shared by their boundaries (see selfIntersectingTriangles). Works on any
+ * mesh with a MeshTraits specialization; polygonal faces are fan
+ * triangulated, and the triangles of the same face are not tested.
+ * @return the pairs (f1, f2), with f1 < f2, of face ids, sorted
+ */
+template <typename Mesh>
+std::vector<std::pair<unsigned int, unsigned int>> meshSelfIntersectingFaces(
+        const Mesh& mesh,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    std::vector<std::pair<unsigned int, unsigned int>> pairs =
+            selfIntersectingTriangles(vertices, triangles, triangleFaces, options);
+    for (std::pair<unsigned int, unsigned int>& p : pairs) {
+        unsigned int f1 = triangleFaces[p.first], f2 = triangleFaces[p.second];
+        p = std::make_pair(std::min(f1, f2), std::max(f1, f2));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+}
+
+/**
+ * @ingroup cg3algorithms
+ * @brief meshSelfIntersections
+ * Finds the intersecting pairs of triangles of a mesh, as
+ * meshSelfIntersectingFaces, and computes their intersection segments.
+ * @return an intersection for every pair of intersecting triangles, with the
+ * face ids of the mesh
+ */
+template <typename Mesh>
+std::vector<SelfIntersection> meshSelfIntersections(
+        const Mesh& mesh,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    return selfIntersections(vertices, triangles, triangleFaces, options);
+}
+#endif // CG3_DCEL_DEFINED
+
+}
@@ -25,8 +25,8 @@ inline std::vector<Pointd> sphereCoverage(
     std::vector<Pointd> points;
     points.reserve(nSamples);
 
-    static std::random_device r;
-    static std::mt19937 mt(r());
+    //one generator per thread: sphereCoverage can be called concurrently
+    static thread_local std::mt19937 mt(std::random_device{}());
     std::uniform_real_distribution<> dist(0, 1);
 
     double rnd;
@@ -0,0 +1,410 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "surface_sampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cg3/geometry/spatial_hash.h>
+#include <cg3/utilities/flat_hash_map.h>
+#include <cg3/utilities/random.h>
+
+namespace cg3 {
+
+namespace internal {
+
+/* samples are generated in chunks of fixed size, every chunk with its own
+ * random stream: results do not depend on the number of threads */
+static const unsigned int SAMPLING_CHUNK_SIZE = 4096;
+static const unsigned int STRATIFIED_CHUNK_SIZE = 1024;
+
+/* Poisson disk sampling: number of candidates per sample and parameters of
+ * the weight function of the sample elimination */
+static const unsigned int POISSON_CANDIDATES_RATIO = 5;
+static const double POISSON_ALPHA = 8;
+static const double POISSON_BETA = 0.65;
+static const double POISSON_GAMMA = 1.5;
+
+inline double triangleArea(
+        const std::vector<Pointd>& vertices,
+        const std::array<unsigned int, 3>& t)
+{
+    const Pointd& a = vertices[t[0]];
+    return (vertices[t[1]] - a).cross(vertices[t[2]] - a).getLength() / 2;
+}
+
+template <class RNG>
+inline Pointd randomPointInTriangle(
+        const std::vector<Pointd>& vertices,
+        const std::array<unsigned int, 3>& t,
+        RNG& rng)
+{
+    double r1 = std::sqrt(randomDouble(rng));
+    double r2 = randomDouble(rng);
+    return vertices[t[0]] * (1 - r1) +
+           vertices[t[1]] * (r1 * (1 - r2)) +
+           vertices[t[2]] * (r1 * r2);
+}
+
+std::vector<double> triangleAreas(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const ParallelOptions& options)
+{
+    std::vector<double> areas(triangles.size());
+    parallelFor(std::size_t(0), triangles.size(), [&](std::size_t i) {
+        areas[i] = triangleArea(vertices, triangles[i]);
+    }, options);
+    return areas;
+}
+
+/**
+ * @brief Max heap of candidate indices on their weights, that allows to
+ * decrease the weight of a candidate that is in the heap. Ties are broken
+ * by index, so the order of elimination is deterministic.
+ */
+class EliminationHeap
+{
+public:
+    EliminationHeap(std::vector<double>& weights) :
+        w(weights), heap(weights.size()), pos(weights.size())
+    {
+        for (unsigned int i = 0; i < heap.size(); i++) {
+            heap[i] = i;
+            pos[i] = i;
+        }
+        for (std::size_t i = heap.size() / 2; i-- > 0; )
+            siftDown((unsigned int)i);
+    }
+
+    unsigned int pop()
+    {
+        unsigned int top = heap[0];
+        pos[top] = REMOVED;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            pos[heap[0]] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    bool contains(unsigned int i) const { return pos[i] != REMOVED; }
+
+    void decrease(unsigned int i, double delta)
+    {
+        w[i] -= delta;
+        siftDown(pos[i]);
+    }
+
+private:
+    bool before(unsigned int a, unsigned int b) const
+    {
+        return w[a] > w[b] || (w[a] == w[b] && a > b);
+    }
+
+    void siftDown(unsigned int p)
+    {
+        unsigned int n = (unsigned int)heap.size();
+        unsigned int e = heap[p];
+        for (;;) {
+            unsigned int c = 2 * p + 1;
+            if (c >= n)
+                break;
+            if (c + 1 < n && before(heap[c + 1], heap[c]))
+                c++;
+            if (!before(heap[c], e))
+                break;
+            heap[p] = heap[c];
+            pos[heap[p]] = p;
+            p = c;
+        }
+        heap[p] = e;
+        pos[e] = p;
+    }
+
+    static const unsigned int REMOVED = std::numeric_limits<unsigned int>::max();
+
+    std::vector<double>& w;
+    std::vector<unsigned int> heap;
+    std::vector<unsigned int> pos;
+};
+
+typedef FlatHashMap<Point<long long int>, std::pair<unsigned int, unsigned int>> CandidateCells;
+
+/* calls f(j, sqDist) for every candidate j != i closer than dMax to the
+ * candidate i; the cells of the hash are dMax large, hence only the 27 cells
+ * around the cell of i are visited */
+template <class F>
+void forEachCloseCandidate(
+        unsigned int i,
+        const std::vector<Pointd>& candidates,
+        const std::vector<unsigned int>& sorted,
+        const CandidateCells& cells,
+        const SpatialHash& hash,
+        double dMax,
+        F f)
+{
+    const Pointd& p = candidates[i];
+    Point<long long int> c = hash.cell(p);
+    for (long long int x = c.x() - 1; x <= c.x() + 1; x++) {
+        for (long long int y = c.y() - 1; y <= c.y() + 1; y++) {
+            for (long long int z = c.z() - 1; z <= c.z() + 1; z++) {
+                CandidateCells::const_iterator it = cells.find(Point<long long int>(x, y, z));
+                if (it == cells.end())
+                    continue;
+                for (unsigned int k = it->second.first; k < it->second.second; k++) {
+                    unsigned int j = sorted[k];
+                    double sqDist = (candidates[j] - p).getLengthSquared();
+                    if (j != i && sqDist < dMax * dMax)
+                        f(j, sqDist);
+                }
+            }
+        }
+    }
+}
+
+/* runs the sampler on a triangulation and maps the triangles of the samples
+ * to the faces of the mesh */
+std::vector<Pointd> sampleTriangulation(
+        SurfaceSampler sampler,
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> samples = sampler(vertices, triangles, nSamples, seed, sampleFaces, options);
+    if (sampleFaces != nullptr && !triangleFaces.empty()) {
+        std::vector<unsigned int>& f = *sampleFaces;
+        parallelFor(std::size_t(0), f.size(), [&](std::size_t i) {
+            f[i] = triangleFaces[f[i]];
+        }, options);
+    }
+    return samples;
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief uniformSurfaceSampling
+ * Samples nSamples points uniformly on the surface of a triangle mesh: faces
+ * are chosen with probability proportional to their area (with an alias
+ * table, in constant time per sample), and points are uniform in the faces.
+ */
+std::vector<Pointd> uniformSurfaceSampling(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> samples;
+    if (sampleFaces != nullptr)
+        sampleFaces->clear();
+    if (triangles.empty() || nSamples == 0)
+        return samples;
+
+    AliasTable table(internal::triangleAreas(vertices, triangles, options));
+    samples.resize(nSamples);
+    if (sampleFaces != nullptr)
+        sampleFaces->resize(nSamples);
+
+    const unsigned int chunk = internal::SAMPLING_CHUNK_SIZE;
+    unsigned int nChunks = (unsigned int)(((std::uint64_t)nSamples + chunk - 1) / chunk);
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        std::mt19937_64 rng = randomStream(seed, c);
+        unsigned int end = (unsigned int)std::min((std::uint64_t)nSamples, ((std::uint64_t)c + 1) * chunk);
+        for (unsigned int i = c * chunk; i < end; i++) {
+            unsigned int t = table.sample(rng);
+            samples[i] = internal::randomPointInTriangle(vertices, triangles[t], rng);
+            if (sampleFaces != nullptr)
+                (*sampleFaces)[i] = t;
+        }
+    }, ParallelOptions(options.nThreads, 1, options.deterministic));
+    return samples;
+}
+
+/**
+ * @brief stratifiedSurfaceSampling
+ * Samples nSamples points on the surface of a triangle mesh, such that every
+ * face gets either the floor or the ceiling of its expected number of
+ * samples (nSamples times the area of the face over the total area): the
+ * number of samples of every face is chosen by systematic sampling, with a
+ * single random offset on the cumulative areas of the faces.
+ * Unlike uniformSurfaceSampling, the number of samples on a face never
+ * deviates from the expected one by more than one.
+ *
+ * Samples are sorted by face.
+ */
+std::vector<Pointd> stratifiedSurfaceSampling(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> samples;
+    if (sampleFaces != nullptr)
+        sampleFaces->clear();
+    if (triangles.empty() || nSamples == 0)
+        return samples;
+
+    unsigned int nTriangles = (unsigned int)triangles.size();
+    std::vector<double> areas = internal::triangleAreas(vertices, triangles, options);
+    std::vector<double> cumulativeAreas(nTriangles);
+    double totalArea = parallelExclusiveScan(
+                areas.begin(), areas.end(), cumulativeAreas.begin(), 0.0, std::plus<double>(), options);
+    if (!(totalArea > 0))
+        return samples;
+
+    //the samples of the face t are offsets[t], ..., offsets[t+1]-1
+    std::mt19937_64 rng = randomStream(seed, 0);
+    double u = randomDouble(rng);
+    std::vector<unsigned int> offsets(nTriangles + 1);
+    parallelFor(0u, nTriangles, [&](unsigned int t) {
+        double o = std::floor(nSamples * (cumulativeAreas[t] / totalArea) + u);
+        offsets[t] = (unsigned int)std::min(o, (double)nSamples);
+    }, options);
+    offsets[nTriangles] = nSamples;
+    samples.resize(nSamples);
+    if (sampleFaces != nullptr)
+        sampleFaces->resize(nSamples);
+
+    const unsigned int chunk = internal::STRATIFIED_CHUNK_SIZE;
+    unsigned int nChunks = (nTriangles + chunk - 1) / chunk;
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        std::mt19937_64 rng = randomStream(seed, (std::uint64_t)c + 1);
+        unsigned int end = std::min(nTriangles, (c + 1) * chunk);
+        for (unsigned int t = c * chunk; t < end; t++) {
+            for (unsigned int i = offsets[t]; i < offsets[t+1]; i++) {
+                samples[i] = internal::randomPointInTriangle(vertices, triangles[t], rng);
+                if (sampleFaces != nullptr)
+                    (*sampleFaces)[i] = t;
+            }
+        }
+    }, ParallelOptions(options.nThreads, 1, options.deterministic));
+    return samples;
+}
+
+/**
+ * @brief poissonDiskSurfaceSampling
+ * Samples nSamples points with a blue noise (Poisson disk) distribution on
+ * the surface of a triangle mesh, using the sample elimination algorithm:
+ * a set of uniform candidates, 5 times larger than nSamples, is generated,
+ * and the candidates with the largest number of close neighbours are
+ * eliminated until nSamples candidates are left.
+ *
+ * Candidates are binned with a spatial hash whose cells are as large as the
+ * neighbourhood radius. Candidates and their initial weights are computed in
+ * parallel, while the elimination is sequential. Distances are Euclidean.
+ *
+ * @link C. Yuksel, Sample Elimination for Generating Poisson Disk Sample
+ * Sets, Computer Graphics Forum (Eurographics), 2015
+ */
+std::vector<Pointd> poissonDiskSurfaceSampling(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::uint64_t nc = std::min(
+                (std::uint64_t)nSamples * internal::POISSON_CANDIDATES_RATIO,
+                (std::uint64_t)std::numeric_limits<unsigned int>::max() - 1);
+    std::vector<unsigned int> candidateFaces;
+    std::vector<Pointd> candidates = uniformSurfaceSampling(
+                vertices, triangles, (unsigned int)nc, seed, &candidateFaces, options);
+    if (candidates.size() <= nSamples) {
+        if (sampleFaces != nullptr)
+            sampleFaces->swap(candidateFaces);
+        return candidates;
+    }
+    unsigned int nCandidates = (unsigned int)candidates.size();
+
+    std::vector<double> areas = internal::triangleAreas(vertices, triangles, options);
+    double totalArea = parallelReduce(
+                std::size_t(0), areas.size(), 0.0,
+                [&](std::size_t i) { return areas[i]; },
+                std::plus<double>(), options);
+
+    //maximum radius of nSamples disks that pack the surface
+    double rMax = std::sqrt(totalArea / (2 * std::sqrt(3.0) * nSamples));
+    double dMax = 2 * rMax;
+    double dMin = dMax * internal::POISSON_BETA *
+            (1 - std::pow((double)nSamples / nCandidates, internal::POISSON_GAMMA));
+    auto weight = [&](double sqDist) {
+        double d = sqDist > dMin * dMin ? std::sqrt(sqDist) : dMin;
+        return std::pow(1 - d / dMax, internal::POISSON_ALPHA);
+    };
+
+    //spatial hash: candidates sorted by cell, ranges of the cells in a map
+    SpatialHash hash(dMax);
+    std::vector<Point<long long int>> cells(nCandidates);
+    parallelFor(0u, nCandidates, [&](unsigned int i) {
+        cells[i] = hash.cell(candidates[i]);
+    }, options);
+    std::vector<unsigned int> sorted(nCandidates);
+    for (unsigned int i = 0; i < nCandidates; i++)
+        sorted[i] = i;
+    parallelSort(sorted.begin(), sorted.end(), [&](unsigned int a, unsigned int b) {
+        return cells[a] < cells[b];
+    }, options);
+    internal::CandidateCells ranges;
+    for (unsigned int i = 0; i < nCandidates; ) {
+        unsigned int j = i + 1;
+        while (j < nCandidates && cells[sorted[j]] == cells[sorted[i]])
+            j++;
+        ranges[cells[sorted[i]]] = std::make_pair(i, j);
+        i = j;
+    }
+    std::vector<Point<long long int>>().swap(cells);
+
+    std::vector<double> weights(nCandidates, 0);
+    parallelFor(0u, nCandidates, [&](unsigned int i) {
+        double w = 0;
+        internal::forEachCloseCandidate(i, candidates, sorted, ranges, hash, dMax,
+                                        [&](unsigned int, double sqDist) {
+            w += weight(sqDist);
+        });
+        weights[i] = w;
+    }, options);
+
+    internal::EliminationHeap heap(weights);
+    for (unsigned int n = nCandidates; n > nSamples; n--) {
+        unsigned int i = heap.pop();
+        internal::forEachCloseCandidate(i, candidates, sorted, ranges, hash, dMax,
+                                        [&](unsigned int j, double sqDist) {
+            if (heap.contains(j))
+                heap.decrease(j, weight(sqDist));
+        });
+    }
+
+    std::vector<Pointd> samples;
+    samples.reserve(nSamples);
+    if (sampleFaces != nullptr) {
+        sampleFaces->clear();
+        sampleFaces->reserve(nSamples);
+    }
+    for (unsigned int i = 0; i < nCandidates; i++) {
+        if (heap.contains(i)) {
+            samples.push_back(candidates[i]);
+            if (sampleFaces != nullptr)
+                sampleFaces->push_back(candidateFaces[i]);
+        }
+    }
+    return samples;
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_SURFACE_SAMPLING_H
+#define CG3_SURFACE_SAMPLING_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/parallel.h>
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/mesh_traits.h>
+#endif
+
+namespace cg3 {
+
+/*
+ * All the samplers are reproducible: for a given seed, they return the same
+ * samples regardless of the number of threads. If sampleFaces is not nullptr,
+ * it is filled with the face that contains every sample.
+ */
+
+std::vector<Pointd> uniformSurfaceSampling(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        unsigned int nSamples,
+        std::uint64_t seed = 0,
+        std::vector<unsigned int>* sampleFaces = nullptr,
+        const ParallelOptions& options = ParallelOptions());
+
+std::vector<Pointd> stratifiedSurfaceSampling(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        unsigned int nSamples,
+        std::uint64_t seed = 0,
+        std::vector<unsigned int>* sampleFaces = nullptr,
+        const ParallelOptions& options = ParallelOptions());
+
+std::vector<Pointd> poissonDiskSurfaceSampling(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        unsigned int nSamples,
+        std::uint64_t seed = 0,
+        std::vector<unsigned int>* sampleFaces = nullptr,
+        const ParallelOptions& options = ParallelOptions());
+
+#ifdef CG3_DCEL_DEFINED
+template <typename Mesh>
+std::vector<Pointd> uniformSurfaceSampling(
+        const Mesh& mesh,
+        unsigned int nSamples,
+        std::uint64_t seed = 0,
+        std::vector<unsigned int>* sampleFaces = nullptr,
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename Mesh>
+std::vector<Pointd> stratifiedSurfaceSampling(
+        const Mesh& mesh,
+        unsigned int nSamples,
+        std::uint64_t seed = 0,
+        std::vector<unsigned int>* sampleFaces = nullptr,
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename Mesh>
+std::vector<Pointd> poissonDiskSurfaceSampling(
+        const Mesh& mesh,
+        unsigned int nSamples,
+        std::uint64_t seed = 0,
+        std::vector<unsigned int>* sampleFaces = nullptr,
+        const ParallelOptions& options = ParallelOptions());
+#endif // CG3_DCEL_DEFINED
+
+namespace internal {
+
+typedef std::vector<Pointd> (*SurfaceSampler)(
+        const std::vector<Pointd>&,
+        const std::vector<std::array<unsigned int, 3>>&,
+        unsigned int,
+        std::uint64_t,
+        std::vector<unsigned int>*,
+        const ParallelOptions&);
+
+std::vector<Pointd> sampleTriangulation(
+        SurfaceSampler sampler,
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options);
+
+} //namespace cg3::internal
+
+}
+
+#include "surface_sampling.tpp"
+
+#endif // CG3_SURFACE_SAMPLING_H
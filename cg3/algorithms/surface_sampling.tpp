@@ -0,0 +1,70 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "surface_sampling.h"
+
+namespace cg3 {
+
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @brief uniformSurfaceSampling
+ * Samples the surface of any mesh with a MeshTraits specialization (Dcel,
+ * CompactTriMesh, SimpleEigenMesh, EigenMesh). Polygonal faces are fan
+ * triangulated, and the ids of sampleFaces are face ids of the mesh.
+ */
+template <typename Mesh>
+std::vector<Pointd> uniformSurfaceSampling(
+        const Mesh& mesh,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    return internal::sampleTriangulation(
+                &uniformSurfaceSampling, vertices, triangles, triangleFaces,
+                nSamples, seed, sampleFaces, options);
+}
+
+template <typename Mesh>
+std::vector<Pointd> stratifiedSurfaceSampling(
+        const Mesh& mesh,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    return internal::sampleTriangulation(
+                &stratifiedSurfaceSampling, vertices, triangles, triangleFaces,
+                nSamples, seed, sampleFaces, options);
+}
+
+template <typename Mesh>
+std::vector<Pointd> poissonDiskSurfaceSampling(
+        const Mesh& mesh,
+        unsigned int nSamples,
+        std::uint64_t seed,
+        std::vector<unsigned int>* sampleFaces,
+        const ParallelOptions& options)
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    return internal::sampleTriangulation(
+                &poissonDiskSurfaceSampling, vertices, triangles, triangleFaces,
+                nSamples, seed, sampleFaces, options);
+}
+#endif // CG3_DCEL_DEFINED
+
+}
@@ -0,0 +1,975 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "triangle_bvh.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <cg3/utilities/profiler.h>
+#include <cg3/utilities/random.h>
+
+namespace cg3 {
+
+namespace internal {
+
+static const unsigned int BVH_NUMBER_BINS = 16;
+static const unsigned int BVH_MAX_LEAF_SIZE = 8;
+/* below this depth the nodes are split at the median, bounding the depth of
+ * the traversal stacks */
+static const unsigned int BVH_MAX_SAH_DEPTH = 64;
+static const unsigned int BVH_STACK_SIZE = 128;
+/* tolerance on the barycentric coordinates of the hits, that closes the
+ * cracks left by rounding between triangles sharing an edge */
+static const double BVH_BARYCENTRIC_EPSILON = 1e-10;
+/* cost of the traversal of a node, relative to the test of a block of
+ * triangles */
+static const double BVH_TRAVERSAL_COST = 1;
+
+inline double bvhHalfArea(const double min[3], const double max[3])
+{
+    double dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+/* entry distance of a ray in a box, or infinity if the ray misses the box in
+ * (tMin, tMax); a ray parallel to a slab whose origin lies on one of its
+ * planes gives a NaN, and the slab is skipped (the origin is inside it) */
+inline double bvhBoxEntry(
+        const double min[3],
+        const double max[3],
+        const double origin[3],
+        const double invDirection[3],
+        double tMin,
+        double tMax)
+{
+    double tNear = tMin, tFar = tMax;
+    for (unsigned int i = 0; i < 3; i++) {
+        double t1 = (min[i] - origin[i]) * invDirection[i];
+        double t2 = (max[i] - origin[i]) * invDirection[i];
+        if (t1 != t1 || t2 != t2)
+            continue;
+        double tn = t1 < t2 ? t1 : t2;
+        double tf = t1 < t2 ? t2 : t1;
+        tNear = tn > tNear ? tn : tNear;
+        tFar = tf < tFar ? tf : tFar;
+    }
+    return tNear <= tFar ? tNear : std::numeric_limits<double>::infinity();
+}
+
+inline void bvhRayArrays(const Ray& ray, double origin[3], double direction[3], double invDirection[3])
+{
+    for (unsigned int i = 0; i < 3; i++) {
+        origin[i] = ray.origin[i];
+        direction[i] = ray.direction[i];
+        invDirection[i] = 1 / direction[i];
+    }
+}
+
+} //namespace cg3::internal
+
+const unsigned int RayHit::NO_HIT;
+const unsigned int TriangleBvh::MAX_PACKET_SIZE;
+const unsigned int TriangleBvh::BLOCK_WIDTH;
+
+Ray::Ray() :
+    tMin(0),
+    tMax(std::numeric_limits<double>::infinity())
+{
+}
+
+Ray::Ray(const Pointd& origin, const Vec3& direction, double tMin, double tMax) :
+    origin(origin),
+    direction(direction),
+    tMin(tMin),
+    tMax(tMax)
+{
+}
+
+RayHit::RayHit() :
+    t(std::numeric_limits<double>::infinity()),
+    u(0),
+    v(0),
+    triangle(NO_HIT),
+    face(NO_HIT)
+{
+}
+
+bool RayHit::isHit() const
+{
+    return triangle != NO_HIT;
+}
+
+TriangleBvh::TriangleBvh()
+{
+}
+
+TriangleBvh::TriangleBvh(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const ParallelOptions& options)
+{
+    build(vertices, triangles, std::vector<unsigned int>(), options);
+}
+
+/**
+ * @brief TriangleBvh::build
+ * Builds the hierarchy on the given triangles, replacing the previous ones.
+ * @param triangleFaces: face of every triangle, reported by the hits; if
+ * empty, the face of a triangle is its index
+ */
+void TriangleBvh::build(
+        const std::vector<Pointd>& vertices,
+        const std::vector<std::array<unsigned int, 3>>& triangles,
+        const std::vector<unsigned int>& triangleFaces,
+        const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("TriangleBvh::build");
+    this->vertices = vertices;
+    this->triangles = triangles;
+    unsigned int nTriangles = (unsigned int)triangles.size();
+    this->triangleFaces = triangleFaces;
+    if (this->triangleFaces.empty()) {
+        this->triangleFaces.resize(nTriangles);
+        for (unsigned int t = 0; t < nTriangles; t++)
+            this->triangleFaces[t] = t;
+    }
+    nodes.clear();
+    blocks.clear();
+    triangleIds.clear();
+    if (nTriangles == 0)
+        return;
+
+    //bounding box and centroid of every triangle, reordered with the
+    //triangles during the build
+    std::vector<BuildReference> references(nTriangles);
+    parallelFor(0u, nTriangles, [&](unsigned int t) {
+        double* b = references[t].box;
+        for (unsigned int i = 0; i < 3; i++) {
+            double c0 = vertices[triangles[t][0]][i];
+            double c1 = vertices[triangles[t][1]][i];
+            double c2 = vertices[triangles[t][2]][i];
+            b[i] = std::min(c0, std::min(c1, c2));
+            b[3+i] = std::max(c0, std::max(c1, c2));
+            b[6+i] = (b[i] + b[3+i]) / 2;
+        }
+        references[t].triangle = t;
+    }, options);
+
+    //top levels, then subtrees in parallel, appended to the nodes
+    unsigned int nThreads = internal::parallelThreads(options);
+    unsigned int maxSequentialSize = std::max(256u, nTriangles / (4 * nThreads));
+    std::vector<unsigned int> tasks;
+    nodes.resize(1);
+    buildNode(0, 0, nTriangles, 0, nodes, references, maxSequentialSize,
+              nTriangles > maxSequentialSize ? &tasks : nullptr);
+    unsigned int nTasks = (unsigned int)tasks.size() / 4;
+    std::vector<std::vector<Node>> subtrees(nTasks);
+    parallelFor(0u, nTasks, [&](unsigned int t) {
+        subtrees[t].resize(1);
+        buildNode(0, tasks[4*t+1], tasks[4*t+2], tasks[4*t+3], subtrees[t], references, maxSequentialSize, nullptr);
+    }, ParallelOptions(options.nThreads, 1));
+    for (unsigned int t = 0; t < nTasks; t++) {
+        //the root replaces the node of the task, the other nodes are appended
+        unsigned int base = (unsigned int)nodes.size() - 1;
+        for (unsigned int i = 0; i < subtrees[t].size(); i++) {
+            Node n = subtrees[t][i];
+            if (n.count == 0)
+                n.offset += base;
+            if (i == 0)
+                nodes[tasks[4*t]] = n;
+            else
+                nodes.push_back(n);
+        }
+    }
+
+    //leaves: from ranges of triangles to blocks of coordinates
+    std::vector<unsigned int> leaves;
+    unsigned int nBlocks = 0;
+    for (unsigned int i = 0; i < nodes.size(); i++) {
+        if (nodes[i].count > 0) {
+            leaves.push_back(i);
+            leaves.push_back(nodes[i].offset);
+            nodes[i].offset = nBlocks;
+            nBlocks += (nodes[i].count + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+        }
+    }
+    blocks.assign(nBlocks, TriangleBlock());
+    std::vector<unsigned int> ids((size_t)nBlocks * BLOCK_WIDTH, RayHit::NO_HIT);
+    parallelFor(0u, (unsigned int)leaves.size() / 2, [&](unsigned int l) {
+        const Node& n = nodes[leaves[2*l]];
+        for (unsigned int k = 0; k < n.count; k++) {
+            unsigned int t = references[leaves[2*l+1] + k].triangle;
+            unsigned int slot = n.offset * BLOCK_WIDTH + k;
+            TriangleBlock& b = blocks[slot / BLOCK_WIDTH];
+            unsigned int lane = slot % BLOCK_WIDTH;
+            const Pointd& p0 = vertices[triangles[t][0]];
+            Vec3 e1 = vertices[triangles[t][1]] - p0, e2 = vertices[triangles[t][2]] - p0;
+            for (unsigned int i = 0; i < 3; i++) {
+                b.p0[i][lane] = p0[i];
+                b.e1[i][lane] = e1[i];
+                b.e2[i][lane] = e2[i];
+            }
+            ids[slot] = t;
+        }
+    }, options);
+    triangleIds.swap(ids);
+}
+
+unsigned int TriangleBvh::getNumberTriangles() const
+{
+    return (unsigned int)triangles.size();
+}
+
+unsigned int TriangleBvh::getNumberNodes() const
+{
+    return (unsigned int)nodes.size();
+}
+
+BoundingBox TriangleBvh::getBoundingBox() const
+{
+    if (nodes.empty())
+        return BoundingBox();
+    return BoundingBox(
+                Pointd(nodes[0].min[0], nodes[0].min[1], nodes[0].min[2]),
+                Pointd(nodes[0].max[0], nodes[0].max[1], nodes[0].max[2]));
+}
+
+std::array<Pointd, 3> TriangleBvh::getTriangle(unsigned int t) const
+{
+    std::array<Pointd, 3> tri = {{vertices[triangles[t][0]], vertices[triangles[t][1]], vertices[triangles[t][2]]}};
+    return tri;
+}
+
+unsigned int TriangleBvh::getTriangleFace(unsigned int t) const
+{
+    return triangleFaces[t];
+}
+
+/**
+ * @brief TriangleBvh::closestHit
+ * @param[out] hit: the nearest intersection of the ray in (tMin, tMax)
+ * @return true if the ray hits a triangle
+ */
+bool TriangleBvh::closestHit(const Ray& ray, RayHit& hit) const
+{
+    return traverse<false>(ray, hit);
+}
+
+/**
+ * @brief TriangleBvh::anyHit
+ * @return true if the ray hits a triangle in (tMin, tMax); the traversal
+ * stops at the first hit found
+ */
+bool TriangleBvh::anyHit(const Ray& ray) const
+{
+    RayHit hit;
+    return traverse<true>(ray, hit);
+}
+
+/**
+ * @brief TriangleBvh::countHits
+ * @return the number of triangles hit by the ray in (tMin, tMax); a ray that
+ * passes through an edge or a vertex counts all the triangles incident to it
+ */
+unsigned int TriangleBvh::countHits(const Ray& ray) const
+{
+    if (nodes.empty())
+        return 0;
+    double o[3], d[3], inv[3];
+    internal::bvhRayArrays(ray, o, d, inv);
+    unsigned int stack[internal::BVH_STACK_SIZE];
+    unsigned int sp = 0, count = 0;
+    stack[sp++] = 0;
+    double t[BLOCK_WIDTH], u[BLOCK_WIDTH], v[BLOCK_WIDTH];
+    while (sp > 0) {
+        const Node& n = nodes[stack[--sp]];
+        if (std::isinf(internal::bvhBoxEntry(n.min, n.max, o, inv, ray.tMin, ray.tMax)))
+            continue;
+        if (n.count == 0) {
+            stack[sp++] = n.offset;
+            stack[sp++] = n.offset + 1;
+            continue;
+        }
+        unsigned int nBlocks = (n.count + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+        for (unsigned int b = n.offset; b < n.offset + nBlocks; b++) {
+            intersectBlock(b, o, d, ray.tMin, t, u, v);
+            for (unsigned int l = 0; l < BLOCK_WIDTH; l++)
+                if (t[l] < ray.tMax)
+                    count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief TriangleBvh::closestHitPacket
+ * Closest hits of a packet of n <= MAX_PACKET_SIZE rays, that traverse the
+ * hierarchy together: a node is visited if any ray of the packet hits it.
+ * Packets are efficient when rays have close origins and directions.
+ */
+void TriangleBvh::closestHitPacket(const Ray* rays, unsigned int n, RayHit* hits) const
+{
+    traversePacket<false>(rays, n, hits);
+}
+
+void TriangleBvh::anyHitPacket(const Ray* rays, unsigned int n, bool* hits) const
+{
+    RayHit h[MAX_PACKET_SIZE];
+    traversePacket<true>(rays, n, h);
+    for (unsigned int i = 0; i < n; i++)
+        hits[i] = h[i].isHit();
+}
+
+std::vector<RayHit> TriangleBvh::closestHits(
+        const std::vector<Ray>& rays,
+        const ParallelOptions& options) const
+{
+    std::vector<RayHit> hits(rays.size());
+    parallelFor((size_t)0, rays.size(), [&](size_t i) {
+        traverse<false>(rays[i], hits[i]);
+    }, options);
+    return hits;
+}
+
+/**
+ * @brief TriangleBvh::anyHits
+ * @return 1 for the rays that hit a triangle, 0 for the others
+ */
+std::vector<unsigned char> TriangleBvh::anyHits(
+        const std::vector<Ray>& rays,
+        const ParallelOptions& options) const
+{
+    std::vector<unsigned char> hits(rays.size());
+    parallelFor((size_t)0, rays.size(), [&](size_t i) {
+        RayHit hit;
+        hits[i] = traverse<true>(rays[i], hit) ? 1 : 0;
+    }, options);
+    return hits;
+}
+
+/**
+ * @brief TriangleBvh::castCameraRays
+ * Casts a ray from eye through the center of every pixel of an image of a
+ * pinhole camera looking at target, with vertical field of view fovY (in
+ * degrees). Tiles of 4x2 pixels are cast as packets, in parallel.
+ * @return the closest hits of the pixels, row by row from the top
+ */
+std::vector<RayHit> TriangleBvh::castCameraRays(
+        const Pointd& eye,
+        const Pointd& target,
+        const Vec3& up,
+        double fovY,
+        unsigned int width,
+        unsigned int height,
+        const ParallelOptions& options) const
+{
+    const unsigned int tileWidth = 4, tileHeight = MAX_PACKET_SIZE / 4;
+    Vec3 forward = target - eye;
+    forward.normalize();
+    Vec3 right = forward.cross(up);
+    right.normalize();
+    Vec3 trueUp = right.cross(forward);
+    double h = std::tan(fovY * M_PI / 360);
+    double w = h * width / std::max(1u, height);
+
+    std::vector<RayHit> hits((size_t)width * height);
+    unsigned int nTilesX = (width + tileWidth - 1) / tileWidth;
+    unsigned int nTilesY = (height + tileHeight - 1) / tileHeight;
+    parallelFor(0u, nTilesX * nTilesY, [&](unsigned int tile) {
+        unsigned int x0 = (tile % nTilesX) * tileWidth, y0 = (tile / nTilesX) * tileHeight;
+        Ray rays[MAX_PACKET_SIZE];
+        RayHit packet[MAX_PACKET_SIZE];
+        unsigned int pixels[MAX_PACKET_SIZE];
+        unsigned int n = 0;
+        for (unsigned int y = y0; y < std::min(height, y0 + tileHeight); y++) {
+            for (unsigned int x = x0; x < std::min(width, x0 + tileWidth); x++) {
+                double px = (2 * (x + 0.5) / width - 1) * w;
+                double py = (1 - 2 * (y + 0.5) / height) * h;
+                Vec3 d = forward + right * px + trueUp * py;
+                d.normalize();
+                rays[n] = Ray(eye, d);
+                pixels[n++] = y * width + x;
+            }
+        }
+        traversePacket<false>(rays, n, packet);
+        for (unsigned int i = 0; i < n; i++)
+            hits[pixels[i]] = packet[i];
+    }, options);
+    return hits;
+}
+
+/**
+ * @brief TriangleBvh::buildNode
+ * Builds the subtree of node on the triangles [begin, end) of references.
+ * If tasks is not nullptr, subtrees with at most maxSequentialSize triangles
+ * are not built, but added to tasks as (node, begin, end, depth).
+ */
+void TriangleBvh::buildNode(
+        unsigned int node,
+        unsigned int begin,
+        unsigned int end,
+        unsigned int depth,
+        std::vector<Node>& nodes,
+        std::vector<BuildReference>& references,
+        unsigned int maxSequentialSize,
+        std::vector<unsigned int>* tasks)
+{
+    const unsigned int nBins = internal::BVH_NUMBER_BINS;
+    const double inf = std::numeric_limits<double>::infinity();
+    unsigned int n = end - begin;
+    double cMin[3] = {inf, inf, inf}, cMax[3] = {-inf, -inf, -inf};
+    Node& current = nodes[node];
+    for (unsigned int i = 0; i < 3; i++) {
+        current.min[i] = inf;
+        current.max[i] = -inf;
+    }
+    for (unsigned int k = begin; k < end; k++) {
+        const double* b = references[k].box;
+        for (unsigned int i = 0; i < 3; i++) {
+            current.min[i] = std::min(current.min[i], b[i]);
+            current.max[i] = std::max(current.max[i], b[3+i]);
+            cMin[i] = std::min(cMin[i], b[6+i]);
+            cMax[i] = std::max(cMax[i], b[6+i]);
+        }
+    }
+    current.offset = begin;
+    current.count = n;
+    if (tasks != nullptr && n <= maxSequentialSize) {
+        tasks->push_back(node);
+        tasks->push_back(begin);
+        tasks->push_back(end);
+        tasks->push_back(depth);
+        return;
+    }
+    //the triangles are tested in blocks: a block is never split
+    if (n <= BLOCK_WIDTH)
+        return;
+
+    //binned surface area heuristic, along the largest extent of the centroids
+    double bestCost = inf;
+    unsigned int bestAxis = 0, bestBin = 0;
+    for (unsigned int i = 1; i < 3; i++)
+        if (cMax[i] - cMin[i] > cMax[bestAxis] - cMin[bestAxis])
+            bestAxis = i;
+    if (depth < internal::BVH_MAX_SAH_DEPTH && cMax[bestAxis] > cMin[bestAxis]) {
+        double scale = nBins / (cMax[bestAxis] - cMin[bestAxis]);
+        unsigned int counts[nBins] = {};
+        double binMin[nBins][3], binMax[nBins][3];
+        for (unsigned int j = 0; j < nBins; j++) {
+            for (unsigned int i = 0; i < 3; i++) {
+                binMin[j][i] = inf;
+                binMax[j][i] = -inf;
+            }
+        }
+        for (unsigned int k = begin; k < end; k++) {
+            const double* b = references[k].box;
+            unsigned int j = std::min(nBins - 1, (unsigned int)((b[6+bestAxis] - cMin[bestAxis]) * scale));
+            counts[j]++;
+            for (unsigned int i = 0; i < 3; i++) {
+                binMin[j][i] = std::min(binMin[j][i], b[i]);
+                binMax[j][i] = std::max(binMax[j][i], b[3+i]);
+            }
+        }
+        //areas of the left sides, then sweep from the right
+        double leftArea[nBins];
+        unsigned int leftCount[nBins];
+        double lMin[3] = {inf, inf, inf}, lMax[3] = {-inf, -inf, -inf};
+        unsigned int count = 0;
+        for (unsigned int j = 0; j + 1 < nBins; j++) {
+            count += counts[j];
+            for (unsigned int i = 0; i < 3; i++) {
+                lMin[i] = std::min(lMin[i], binMin[j][i]);
+                lMax[i] = std::max(lMax[i], binMax[j][i]);
+            }
+            leftCount[j] = count;
+            leftArea[j] = count > 0 ? internal::bvhHalfArea(lMin, lMax) : 0;
+        }
+        double rMin[3] = {inf, inf, inf}, rMax[3] = {-inf, -inf, -inf};
+        count = 0;
+        for (unsigned int j = nBins - 1; j > 0; j--) {
+            count += counts[j];
+            for (unsigned int i = 0; i < 3; i++) {
+                rMin[i] = std::min(rMin[i], binMin[j][i]);
+                rMax[i] = std::max(rMax[i], binMax[j][i]);
+            }
+            if (count == 0 || leftCount[j-1] == 0)
+                continue;
+            double cost = leftArea[j-1] * ((leftCount[j-1] + BLOCK_WIDTH - 1) / BLOCK_WIDTH) +
+                          internal::bvhHalfArea(rMin, rMax) * ((count + BLOCK_WIDTH - 1) / BLOCK_WIDTH);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = j;
+            }
+        }
+        bestCost = internal::BVH_TRAVERSAL_COST + bestCost / internal::bvhHalfArea(current.min, current.max);
+        if (n <= internal::BVH_MAX_LEAF_SIZE && !(bestCost < (n + BLOCK_WIDTH - 1) / BLOCK_WIDTH))
+            return;
+    }
+
+    unsigned int mid = begin;
+    if (bestCost < inf) {
+        double scale = nBins / (cMax[bestAxis] - cMin[bestAxis]);
+        double axisMin = cMin[bestAxis];
+        mid = (unsigned int)(std::partition(
+                    references.begin() + begin, references.begin() + end, [&](const BuildReference& r) {
+            double c = r.box[6 + bestAxis];
+            return std::min(nBins - 1, (unsigned int)((c - axisMin) * scale)) < bestBin;
+        }) - references.begin());
+    }
+    if (mid == begin || mid == end) {
+        //median split on the largest extent of the centroids
+        unsigned int axis = bestAxis;
+        if (!(cMax[axis] > cMin[axis]) && n <= internal::BVH_MAX_LEAF_SIZE)
+            return;
+        mid = begin + n / 2;
+        std::nth_element(
+                    references.begin() + begin, references.begin() + mid, references.begin() + end,
+                    [&](const BuildReference& a, const BuildReference& b) {
+            return a.box[6 + axis] < b.box[6 + axis];
+        });
+    }
+
+    unsigned int left = (unsigned int)nodes.size();
+    nodes.resize(left + 2);
+    nodes[node].offset = left;
+    nodes[node].count = 0;
+    buildNode(left, begin, mid, depth + 1, nodes, references, maxSequentialSize, tasks);
+    buildNode(left + 1, mid, end, depth + 1, nodes, references, maxSequentialSize, tasks);
+}
+
+/**
+ * @brief TriangleBvh::traverse
+ * Traversal of a single ray: the nearest child is visited first, and the
+ * nodes farther than the current hit are pruned. With ANY_HIT, the traversal
+ * stops at the first hit.
+ */
+template <bool ANY_HIT>
+bool TriangleBvh::traverse(const Ray& ray, RayHit& hit) const
+{
+    hit = RayHit();
+    if (nodes.empty())
+        return false;
+    double o[3], d[3], inv[3];
+    internal::bvhRayArrays(ray, o, d, inv);
+    double tMax = ray.tMax;
+    unsigned int stack[internal::BVH_STACK_SIZE];
+    unsigned int sp = 0, node = 0;
+    if (std::isinf(internal::bvhBoxEntry(nodes[0].min, nodes[0].max, o, inv, ray.tMin, tMax)))
+        return false;
+    double t[BLOCK_WIDTH], u[BLOCK_WIDTH], v[BLOCK_WIDTH];
+    while (true) {
+        const Node& n = nodes[node];
+        if (n.count > 0) {
+            unsigned int nBlocks = (n.count + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+            for (unsigned int b = n.offset; b < n.offset + nBlocks; b++) {
+                intersectBlock(b, o, d, ray.tMin, t, u, v);
+                for (unsigned int l = 0; l < BLOCK_WIDTH; l++) {
+                    if (t[l] < tMax) {
+                        tMax = t[l];
+                        hit.t = t[l];
+                        hit.u = u[l];
+                        hit.v = v[l];
+                        hit.triangle = triangleIds[b * BLOCK_WIDTH + l];
+                        if (ANY_HIT) {
+                            hit.face = triangleFaces[hit.triangle];
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        else {
+            const Node& c0 = nodes[n.offset];
+            const Node& c1 = nodes[n.offset + 1];
+            double t0 = internal::bvhBoxEntry(c0.min, c0.max, o, inv, ray.tMin, tMax);
+            double t1 = internal::bvhBoxEntry(c1.min, c1.max, o, inv, ray.tMin, tMax);
+            bool hit0 = !std::isinf(t0), hit1 = !std::isinf(t1);
+            if (hit0 && hit1) {
+                stack[sp++] = t0 <= t1 ? n.offset + 1 : n.offset;
+                node = t0 <= t1 ? n.offset : n.offset + 1;
+                continue;
+            }
+            if (hit0 || hit1) {
+                node = hit0 ? n.offset : n.offset + 1;
+                continue;
+            }
+        }
+        if (sp == 0)
+            break;
+        node = stack[--sp];
+    }
+    if (hit.isHit())
+        hit.face = triangleFaces[hit.triangle];
+    return hit.isHit();
+}
+
+/**
+ * @brief TriangleBvh::traversePacket
+ * Traversal of a packet of rays: every node is tested against all the active
+ * rays, and visited if at least one of them hits it. The children are visited
+ * in the order given by the direction of the first ray.
+ */
+template <bool ANY_HIT>
+void TriangleBvh::traversePacket(const Ray* rays, unsigned int n, RayHit* hits) const
+{
+    assert(n <= MAX_PACKET_SIZE);
+    for (unsigned int r = 0; r < n; r++)
+        hits[r] = RayHit();
+    if (nodes.empty() || n == 0)
+        return;
+    double o[MAX_PACKET_SIZE][3], d[MAX_PACKET_SIZE][3], inv[MAX_PACKET_SIZE][3];
+    bool active[MAX_PACKET_SIZE];
+    RayPacket packet;
+    for (unsigned int r = 0; r < MAX_PACKET_SIZE; r++) {
+        if (r < n)
+            internal::bvhRayArrays(rays[r], o[r], d[r], inv[r]);
+        for (unsigned int i = 0; i < 3; i++) {
+            packet.origin[i][r] = r < n ? o[r][i] : 0;
+            packet.direction[i][r] = r < n ? d[r][i] : 0;
+        }
+        packet.tMin[r] = r < n ? rays[r].tMin : 0;
+        packet.tMax[r] = r < n ? rays[r].tMax : 0;
+        packet.slot[r] = -1;
+        active[r] = r < n;
+    }
+    unsigned int nActive = n;
+    unsigned int stack[internal::BVH_STACK_SIZE];
+    unsigned int sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0 && nActive > 0) {
+        const Node& node = nodes[stack[--sp]];
+        bool visit = false;
+        for (unsigned int r = 0; r < n && !visit; r++)
+            visit = active[r] && !std::isinf(internal::bvhBoxEntry(node.min, node.max, o[r], inv[r], packet.tMin[r], packet.tMax[r]));
+        if (!visit)
+            continue;
+        if (node.count == 0) {
+            //the child nearer to the origins along the first ray is visited first
+            const Node& c0 = nodes[node.offset];
+            const Node& c1 = nodes[node.offset + 1];
+            double s = 0;
+            for (unsigned int i = 0; i < 3; i++)
+                s += (c1.min[i] + c1.max[i] - c0.min[i] - c0.max[i]) * d[0][i];
+            stack[sp++] = s >= 0 ? node.offset + 1 : node.offset;
+            stack[sp++] = s >= 0 ? node.offset : node.offset + 1;
+            continue;
+        }
+        //in any hit traversals, the rays that have a hit are closed by an
+        //empty interval [tMax, tMax], and are not hit anymore
+        unsigned int nBlocks = (node.count + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+        for (unsigned int b = node.offset; b < node.offset + nBlocks; b++)
+            intersectPacket(b, packet);
+        if (ANY_HIT) {
+            for (unsigned int r = 0; r < n; r++) {
+                if (active[r] && packet.slot[r] >= 0) {
+                    active[r] = false;
+                    nActive--;
+                    packet.tMin[r] = packet.tMax[r];
+                }
+            }
+        }
+    }
+    double t[BLOCK_WIDTH], u[BLOCK_WIDTH], v[BLOCK_WIDTH];
+    for (unsigned int r = 0; r < n; r++) {
+        if (packet.slot[r] < 0)
+            continue;
+        //barycentric coordinates of the closest hit
+        unsigned int slot = (unsigned int)packet.slot[r];
+        unsigned int l = slot % BLOCK_WIDTH;
+        intersectBlock(slot / BLOCK_WIDTH, o[r], d[r], rays[r].tMin, t, u, v);
+        hits[r].t = packet.tMax[r];
+        hits[r].u = u[l];
+        hits[r].v = v[l];
+        hits[r].triangle = triangleIds[slot];
+        hits[r].face = triangleFaces[hits[r].triangle];
+    }
+}
+
+/**
+ * @brief TriangleBvh::overlapTasks
+ * Expands the pairs of nodes of the traversal of the hierarchy against
+ * itself, in breadth first order, until there are at least minTasks pairs or
+ * only pairs of leaves are left. The pair (n, n) stands for the pairs of
+ * triangles inside the subtree of n.
+ */
+void TriangleBvh::overlapTasks(
+        unsigned int minTasks,
+        std::vector<std::pair<unsigned int, unsigned int>>& tasks) const
+{
+    typedef std::pair<unsigned int, unsigned int> Pair;
+    tasks.clear();
+    if (nodes.empty())
+        return;
+    tasks.push_back(Pair(0, 0));
+    bool expanded = true;
+    while (tasks.size() < minTasks && expanded) {
+        expanded = false;
+        std::vector<Pair> next;
+        for (const Pair& p : tasks) {
+            const Node& n1 = nodes[p.first];
+            const Node& n2 = nodes[p.second];
+            if (p.first == p.second) {
+                if (n1.count > 0) {
+                    next.push_back(p);
+                    continue;
+                }
+                next.push_back(Pair(n1.offset, n1.offset));
+                next.push_back(Pair(n1.offset + 1, n1.offset + 1));
+                next.push_back(Pair(n1.offset, n1.offset + 1));
+            }
+            else if (n1.count > 0 && n2.count > 0) {
+                next.push_back(p);
+                continue;
+            }
+            else if (nodesOverlap(p.first, p.second)) {
+                //disjoint pairs are dropped, the others are split
+                if (splitFirst(p.first, p.second)) {
+                    next.push_back(Pair(n1.offset, p.second));
+                    next.push_back(Pair(n1.offset + 1, p.second));
+                }
+                else {
+                    next.push_back(Pair(p.first, n2.offset));
+                    next.push_back(Pair(p.first, n2.offset + 1));
+                }
+            }
+            expanded = true;
+        }
+        tasks.swap(next);
+    }
+}
+
+/**
+ * @brief TriangleBvh::nodesOverlap
+ * @return true if the closed boxes of the nodes n1 and n2 overlap
+ */
+bool TriangleBvh::nodesOverlap(unsigned int n1, unsigned int n2) const
+{
+    const Node& a = nodes[n1];
+    const Node& b = nodes[n2];
+    return a.min[0] <= b.max[0] && b.min[0] <= a.max[0] &&
+           a.min[1] <= b.max[1] && b.min[1] <= a.max[1] &&
+           a.min[2] <= b.max[2] && b.min[2] <= a.max[2];
+}
+
+/**
+ * @brief TriangleBvh::splitFirst
+ * @return true if the traversal of the pair of nodes (n1, n2), that are not
+ * both leaves, descends into the children of n1: the larger inner node is
+ * split first
+ */
+bool TriangleBvh::splitFirst(unsigned int n1, unsigned int n2) const
+{
+    const Node& a = nodes[n1];
+    const Node& b = nodes[n2];
+    if (a.count > 0 || b.count > 0)
+        return b.count > 0;
+    return internal::bvhHalfArea(a.min, a.max) >= internal::bvhHalfArea(b.min, b.max);
+}
+
+/**
+ * @brief TriangleBvh::slotBoxes
+ * Computes the bounding box of the triangle of every slot of the blocks, in
+ * single precision and rounded outwards: the boxes contain the exact ones.
+ */
+void TriangleBvh::slotBoxes(std::vector<float>& boxes, const ParallelOptions& options) const
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    boxes.resize(6 * triangleIds.size());
+    parallelFor((size_t)0, triangleIds.size(), [&](size_t s) {
+        float* b = &boxes[6 * s];
+        unsigned int t = triangleIds[s];
+        for (unsigned int i = 0; i < 3; i++) {
+            if (t == RayHit::NO_HIT) {
+                b[i] = inf;
+                b[3+i] = -inf;
+                continue;
+            }
+            double c0 = vertices[triangles[t][0]][i];
+            double c1 = vertices[triangles[t][1]][i];
+            double c2 = vertices[triangles[t][2]][i];
+            double min = std::min(c0, std::min(c1, c2)), max = std::max(c0, std::max(c1, c2));
+            b[i] = (float)min;
+            if (b[i] > min)
+                b[i] = std::nextafter(b[i], -inf);
+            b[3+i] = (float)max;
+            if (b[3+i] < max)
+                b[3+i] = std::nextafter(b[3+i], inf);
+        }
+    }, options);
+}
+
+/**
+ * @brief TriangleBvh::leafOverlaps
+ * Appends to pairs the pairs (i, j), i < j, of triangles of the leaves n1 and
+ * n2 (or of the leaf n1, if n1 == n2) whose boxes overlap.
+ */
+void TriangleBvh::leafOverlaps(
+        unsigned int n1,
+        unsigned int n2,
+        const std::vector<float>& boxes,
+        std::vector<std::pair<unsigned int, unsigned int>>& pairs) const
+{
+    const Node& l1 = nodes[n1];
+    const Node& l2 = nodes[n2];
+    for (unsigned int a = 0; a < l1.count; a++) {
+        unsigned int sa = l1.offset * BLOCK_WIDTH + a;
+        const float* ba = &boxes[6 * (size_t)sa];
+        for (unsigned int b = n1 == n2 ? a + 1 : 0; b < l2.count; b++) {
+            unsigned int sb = l2.offset * BLOCK_WIDTH + b;
+            const float* bb = &boxes[6 * (size_t)sb];
+            if (ba[0] <= bb[3] && bb[0] <= ba[3] &&
+                ba[1] <= bb[4] && bb[1] <= ba[4] &&
+                ba[2] <= bb[5] && bb[2] <= ba[5]) {
+                unsigned int ta = triangleIds[sa], tb = triangleIds[sb];
+                pairs.push_back(std::make_pair(std::min(ta, tb), std::max(ta, tb)));
+            }
+        }
+    }
+}
+
+/**
+ * @brief TriangleBvh::intersectBlock
+ * Moller-Trumbore test of a ray against the triangles of a block, in a loop
+ * on the lanes without branches that the compiler vectorises: the conditions
+ * are combined with bitwise operators, null determinants are replaced by 1
+ * arithmetically and the ray and the results are kept in local variables, so
+ * that no select or alias check is left in the loop. Sets t to infinity on
+ * the lanes that are not hit after tMin (padding lanes have null edges, and
+ * are never hit).
+ */
+void TriangleBvh::intersectBlock(
+        unsigned int block,
+        const double origin[3],
+        const double direction[3],
+        double tMin,
+        double t[BLOCK_WIDTH],
+        double u[BLOCK_WIDTH],
+        double v[BLOCK_WIDTH]) const
+{
+    const TriangleBlock& b = blocks[block];
+    const double inf = std::numeric_limits<double>::infinity();
+    const double eps = internal::BVH_BARYCENTRIC_EPSILON;
+    const double ox = origin[0], oy = origin[1], oz = origin[2];
+    const double dx = direction[0], dy = direction[1], dz = direction[2];
+    double bt[BLOCK_WIDTH], bu[BLOCK_WIDTH], bv[BLOCK_WIDTH];
+    for (unsigned int l = 0; l < BLOCK_WIDTH; l++) {
+        double e1x = b.e1[0][l], e1y = b.e1[1][l], e1z = b.e1[2][l];
+        double e2x = b.e2[0][l], e2y = b.e2[1][l], e2z = b.e2[2][l];
+        double px = dy * e2z - dz * e2y;
+        double py = dz * e2x - dx * e2z;
+        double pz = dx * e2y - dy * e2x;
+        double det = e1x * px + e1y * py + e1z * pz;
+        bool valid = det != 0;
+        double invDet = 1 / (det + (double)(det == 0));
+        double sx = ox - b.p0[0][l], sy = oy - b.p0[1][l], sz = oz - b.p0[2][l];
+        double uu = (sx * px + sy * py + sz * pz) * invDet;
+        double qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+        double vv = (dx * qx + dy * qy + dz * qz) * invDet;
+        double tt = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+        bool hit = valid & (uu >= -eps) & (vv >= -eps) & (uu + vv <= 1 + eps) & (tt > tMin);
+        bt[l] = hit ? tt : inf;
+        bu[l] = uu;
+        bv[l] = vv;
+    }
+    for (unsigned int l = 0; l < BLOCK_WIDTH; l++) {
+        t[l] = bt[l];
+        u[l] = bu[l];
+        v[l] = bv[l];
+    }
+}
+
+/**
+ * @brief TriangleBvh::intersectPacket
+ * Moller-Trumbore test of all the rays of a packet against the triangles of
+ * a block: every triangle is tested against the rays in a loop on the lanes
+ * of the packet without branches, that the compiler vectorises. The lanes of
+ * the packet whose ray hits the triangle between tMin and tMax take the hit
+ * (only its distance and its slot: the barycentric coordinates of the
+ * closest hits are computed at the end of the traversal).
+ */
+void TriangleBvh::intersectPacket(unsigned int block, RayPacket& packet) const
+{
+    const TriangleBlock& b = blocks[block];
+    const double eps = internal::BVH_BARYCENTRIC_EPSILON;
+    for (unsigned int l = 0; l < BLOCK_WIDTH; l++) {
+        double p0x = b.p0[0][l], p0y = b.p0[1][l], p0z = b.p0[2][l];
+        double e1x = b.e1[0][l], e1y = b.e1[1][l], e1z = b.e1[2][l];
+        double e2x = b.e2[0][l], e2y = b.e2[1][l], e2z = b.e2[2][l];
+        double slot = block * BLOCK_WIDTH + l;
+        for (unsigned int r = 0; r < MAX_PACKET_SIZE; r++) {
+            double dx = packet.direction[0][r], dy = packet.direction[1][r], dz = packet.direction[2][r];
+            double px = dy * e2z - dz * e2y;
+            double py = dz * e2x - dx * e2z;
+            double pz = dx * e2y - dy * e2x;
+            double det = e1x * px + e1y * py + e1z * pz;
+            bool valid = det != 0;
+            double invDet = 1 / (det + (double)(det == 0));
+            double sx = packet.origin[0][r] - p0x, sy = packet.origin[1][r] - p0y, sz = packet.origin[2][r] - p0z;
+            double uu = (sx * px + sy * py + sz * pz) * invDet;
+            double qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+            double vv = (dx * qx + dy * qy + dz * qz) * invDet;
+            double tt = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+            bool hit = valid & (uu >= -eps) & (vv >= -eps) & (uu + vv <= 1 + eps) &
+                       (tt > packet.tMin[r]) & (tt < packet.tMax[r]);
+            packet.tMax[r] = hit ? tt : packet.tMax[r];
+            packet.slot[r] = hit ? slot : packet.slot[r];
+        }
+    }
+}
+
+/**
+ * @brief ambientOcclusion
+ * Computes the ambient occlusion of points with the given normals: the
+ * fraction of nRays cosine distributed directions of the hemisphere of the
+ * normal that hit a triangle within maxDistance. Directions are reproducible
+ * for a given seed, and the rays of every point are cast as packets.
+ * @return the occlusion of every point, in [0, 1]
+ */
+std::vector<double> ambientOcclusion(
+        const TriangleBvh& bvh,
+        const std::vector<Pointd>& points,
+        const std::vector<Vec3>& normals,
+        unsigned int nRays,
+        double maxDistance,
+        std::uint64_t seed,
+        const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("ambientOcclusion");
+    const unsigned int packetSize = TriangleBvh::MAX_PACKET_SIZE;
+    std::vector<double> occlusion(points.size(), 0);
+    double eps = 1e-7 * bvh.getBoundingBox().diag();
+    parallelFor((size_t)0, points.size(), [&](size_t i) {
+        if (nRays == 0)
+            return;
+        std::mt19937_64 rng = randomStream(seed, i);
+        Vec3 n = normals[i];
+        n.normalize();
+        Vec3 t1 = std::abs(n.x()) < 0.9 ? Vec3(1, 0, 0).cross(n) : Vec3(0, 1, 0).cross(n);
+        t1.normalize();
+        Vec3 t2 = n.cross(t1);
+        unsigned int nHits = 0;
+        Ray rays[packetSize];
+        bool hits[packetSize];
+        for (unsigned int r = 0; r < nRays; r += packetSize) {
+            unsigned int k = std::min(packetSize, nRays - r);
+            for (unsigned int j = 0; j < k; j++) {
+                double u1 = randomDouble(rng), u2 = randomDouble(rng);
+                double radius = std::sqrt(u1), phi = 2 * M_PI * u2;
+                Vec3 d = t1 * (radius * std::cos(phi)) + t2 * (radius * std::sin(phi)) + n * std::sqrt(1 - u1);
+                rays[j] = Ray(points[i], d, eps, maxDistance);
+            }
+            bvh.anyHitPacket(rays, k, hits);
+            for (unsigned int j = 0; j < k; j++)
+                nHits += hits[j] ? 1 : 0;
+        }
+        occlusion[i] = (double)nHits / nRays;
+    }, options);
+    return occlusion;
+}
+
+}
@@ -0,0 +1,254 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_TRIANGLE_BVH_H
+#define CG3_TRIANGLE_BVH_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <cg3/geometry/bounding_box.h>
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/parallel.h>
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/mesh_traits.h>
+#endif
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3algorithms
+ * @brief A ray origin + t * direction, with t in (tMin, tMax). The direction
+ * does not need to be normalized; t is measured in units of its length.
+ */
+struct Ray
+{
+    Ray();
+    Ray(const Pointd& origin,
+        const Vec3& direction,
+        double tMin = 0,
+        double tMax = std::numeric_limits<double>::infinity());
+
+    Pointd origin;
+    Vec3 direction;
+    double tMin;
+    double tMax;
+};
+
+/**
+ * @ingroup cg3algorithms
+ * @brief Intersection between a ray and a triangle: the hit point is
+ * origin + t * direction = (1 - u - v) p0 + u p1 + v p2, where p0, p1, p2
+ * are the vertices of the hit triangle.
+ */
+struct RayHit
+{
+    static const unsigned int NO_HIT = (unsigned int)-1;
+
+    RayHit();
+    bool isHit() const;
+
+    double t;
+    double u;
+    double v;
+    unsigned int triangle; //index of the triangle in the bvh
+    unsigned int face;     //id of the face of the mesh that contains the triangle
+};
+
+/**
+ * @ingroup cg3algorithms
+ * @brief The TriangleBvh class is a bounding volume hierarchy on the
+ * triangles of a mesh, for ray casting.
+ *
+ * The hierarchy is built with the surface area heuristic evaluated on 16
+ * bins along the largest extent of the centroids, counting the cost of the
+ * triangles in blocks; the top levels are split sequentially, and then the
+ * subtrees are built in parallel. Nodes are stored in a single array, with
+ * the two children of an inner node in consecutive positions. Leaves have at
+ * most 8 triangles, stored in blocks of 4 triangles whose coordinates are in
+ * separate arrays: a ray is tested against a whole block, and a packet of
+ * rays against every triangle of a block, in loops without branches that
+ * the compiler vectorises.
+ *
+ * Queries:
+ * - closestHit and anyHit on a single ray, and on streams of rays, that are
+ *   dispatched in parallel;
+ * - closestHitPacket and anyHitPacket on packets of at most 8 coherent rays,
+ *   that traverse the hierarchy together (castCameraRays uses packets of 4x2
+ *   pixels);
+ * - countHits, the number of triangles intersected by a ray;
+ * - overlappingPairs, the pairs of triangles with overlapping bounding boxes,
+ *   found with a traversal of the hierarchy against itself.
+ *
+ * All the queries are const and can be called concurrently.
+ *
+ * \code{.cpp}
+ * cg3::TriangleBvh bvh(mesh);
+ * cg3::RayHit hit;
+ * if (bvh.closestHit(cg3::Ray(p, dir), hit))
+ *     std::cout << "face " << hit.face << " at " << hit.t << "\n";
+ * std::vector<unsigned char> occluded = bvh.anyHits(shadowRays);
+ * \endcode
+ */
+class TriangleBvh
+{
+public:
+    static const unsigned int MAX_PACKET_SIZE = 8;
+
+    TriangleBvh();
+    TriangleBvh(
+            const std::vector<Pointd>& vertices,
+            const std::vector<std::array<unsigned int, 3>>& triangles,
+            const ParallelOptions& options = ParallelOptions());
+    #ifdef CG3_DCEL_DEFINED
+    template <typename Mesh>
+    TriangleBvh(const Mesh& mesh, const ParallelOptions& options = ParallelOptions());
+    #endif
+
+    void build(
+            const std::vector<Pointd>& vertices,
+            const std::vector<std::array<unsigned int, 3>>& triangles,
+            const std::vector<unsigned int>& triangleFaces = std::vector<unsigned int>(),
+            const ParallelOptions& options = ParallelOptions());
+
+    unsigned int getNumberTriangles() const;
+    unsigned int getNumberNodes() const;
+    BoundingBox getBoundingBox() const;
+    std::array<Pointd, 3> getTriangle(unsigned int t) const;
+    unsigned int getTriangleFace(unsigned int t) const;
+
+    //single rays
+    bool closestHit(const Ray& ray, RayHit& hit) const;
+    bool anyHit(const Ray& ray) const;
+    unsigned int countHits(const Ray& ray) const;
+
+    //packets of coherent rays
+    void closestHitPacket(const Ray* rays, unsigned int n, RayHit* hits) const;
+    void anyHitPacket(const Ray* rays, unsigned int n, bool* hits) const;
+
+    //streams of rays
+    std::vector<RayHit> closestHits(
+            const std::vector<Ray>& rays,
+            const ParallelOptions& options = ParallelOptions()) const;
+    std::vector<unsigned char> anyHits(
+            const std::vector<Ray>& rays,
+            const ParallelOptions& options = ParallelOptions()) const;
+    std::vector<RayHit> castCameraRays(
+            const Pointd& eye,
+            const Pointd& target,
+            const Vec3& up,
+            double fovY,
+            unsigned int width,
+            unsigned int height,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+    //pairs of triangles
+    template <class Test>
+    std::vector<std::pair<unsigned int, unsigned int>> overlappingPairs(
+            Test test,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+protected:
+    static const unsigned int BLOCK_WIDTH = 4;
+
+    /* node of the hierarchy: inner nodes have count == 0 and children in
+     * offset and offset + 1; leaves have count triangles, starting from the
+     * block offset */
+    struct Node
+    {
+        double min[3];
+        double max[3];
+        unsigned int offset;
+        unsigned int count;
+    };
+
+    /* coordinates of BLOCK_WIDTH triangles: first vertex and two edges */
+    struct TriangleBlock
+    {
+        double p0[3][BLOCK_WIDTH];
+        double e1[3][BLOCK_WIDTH];
+        double e2[3][BLOCK_WIDTH];
+    };
+
+    /* rays of a packet, one array per component; the lanes after the last
+     * ray have null directions and are never hit. slot is the slot in the
+     * blocks of the closest hit of every ray, or -1: it is stored as a double
+     * so that it is selected with the same masks of the distances */
+    struct RayPacket
+    {
+        double origin[3][MAX_PACKET_SIZE];
+        double direction[3][MAX_PACKET_SIZE];
+        double tMin[MAX_PACKET_SIZE];
+        double tMax[MAX_PACKET_SIZE];
+        double slot[MAX_PACKET_SIZE];
+    };
+
+    /* bounding box and centroid of a triangle during the build */
+    struct BuildReference
+    {
+        double box[9];
+        unsigned int triangle;
+    };
+
+    void buildNode(
+            unsigned int node,
+            unsigned int begin,
+            unsigned int end,
+            unsigned int depth,
+            std::vector<Node>& nodes,
+            std::vector<BuildReference>& references,
+            unsigned int maxSequentialSize,
+            std::vector<unsigned int>* tasks);
+    template <bool ANY_HIT>
+    bool traverse(const Ray& ray, RayHit& hit) const;
+    template <bool ANY_HIT>
+    void traversePacket(const Ray* rays, unsigned int n, RayHit* hits) const;
+    void overlapTasks(
+            unsigned int minTasks,
+            std::vector<std::pair<unsigned int, unsigned int>>& tasks) const;
+    bool nodesOverlap(unsigned int n1, unsigned int n2) const;
+    bool splitFirst(unsigned int n1, unsigned int n2) const;
+    void slotBoxes(std::vector<float>& boxes, const ParallelOptions& options) const;
+    void leafOverlaps(
+            unsigned int n1,
+            unsigned int n2,
+            const std::vector<float>& boxes,
+            std::vector<std::pair<unsigned int, unsigned int>>& pairs) const;
+    void intersectBlock(
+            unsigned int block,
+            const double origin[3],
+            const double direction[3],
+            double tMin,
+            double t[BLOCK_WIDTH],
+            double u[BLOCK_WIDTH],
+            double v[BLOCK_WIDTH]) const;
+    void intersectPacket(unsigned int block, RayPacket& packet) const;
+
+    std::vector<Node> nodes;
+    std::vector<TriangleBlock> blocks;
+    std::vector<unsigned int> triangleIds; //triangle of every slot of the blocks
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+};
+
+std::vector<double> ambientOcclusion(
+        const TriangleBvh& bvh,
+        const std::vector<Pointd>& points,
+        const std::vector<Vec3>& normals,
+        unsigned int nRays,
+        double maxDistance = std::numeric_limits<double>::infinity(),
+        std::uint64_t seed = 0,
+        const ParallelOptions& options = ParallelOptions());
+
+}
+
+#include "triangle_bvh.tpp"
+
+#endif // CG3_TRIANGLE_BVH_H
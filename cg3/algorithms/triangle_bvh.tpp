@@ -0,0 +1,93 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "triangle_bvh.h"
+
+namespace cg3 {
+
+/**
+ * @brief TriangleBvh::overlappingPairs
+ * Finds the pairs of triangles whose closed bounding boxes overlap and for
+ * which test(i, j) is true (the boxes are rounded outwards to single
+ * precision, so test may receive also pairs of boxes that are at a distance
+ * below the rounding). The hierarchy is traversed against itself: the
+ * top pairs of nodes are expanded sequentially, and then they are traversed
+ * in parallel. The candidates are tested during the traversal and never
+ * stored, so test is called concurrently and must be thread safe.
+ * @return the pairs (i, j), with i < j, of triangle indices, sorted
+ */
+template <class Test>
+std::vector<std::pair<unsigned int, unsigned int>> TriangleBvh::overlappingPairs(
+        Test test,
+        const ParallelOptions& options) const
+{
+    typedef std::pair<unsigned int, unsigned int> Pair;
+    std::vector<float> boxes;
+    slotBoxes(boxes, options);
+    std::vector<Pair> tasks;
+    overlapTasks(16 * internal::parallelThreads(options), tasks);
+    unsigned int nTasks = (unsigned int)tasks.size();
+    std::vector<std::vector<Pair>> taskPairs(nTasks);
+    parallelFor(0u, nTasks, [&](unsigned int k) {
+        std::vector<Pair> stack(1, tasks[k]);
+        std::vector<Pair> candidates;
+        while (!stack.empty()) {
+            Pair p = stack.back();
+            stack.pop_back();
+            const Node& n1 = nodes[p.first];
+            const Node& n2 = nodes[p.second];
+            if (n1.count == 0 && p.first == p.second) {
+                stack.push_back(Pair(n1.offset, n1.offset));
+                stack.push_back(Pair(n1.offset + 1, n1.offset + 1));
+                stack.push_back(Pair(n1.offset, n1.offset + 1));
+                continue;
+            }
+            if (p.first != p.second && !nodesOverlap(p.first, p.second))
+                continue;
+            if (n1.count > 0 && n2.count > 0) {
+                candidates.clear();
+                leafOverlaps(p.first, p.second, boxes, candidates);
+                for (const Pair& c : candidates)
+                    if (test(c.first, c.second))
+                        taskPairs[k].push_back(c);
+            }
+            else if (splitFirst(p.first, p.second)) {
+                stack.push_back(Pair(n1.offset, p.second));
+                stack.push_back(Pair(n1.offset + 1, p.second));
+            }
+            else {
+                stack.push_back(Pair(p.first, n2.offset));
+                stack.push_back(Pair(p.first, n2.offset + 1));
+            }
+        }
+    }, ParallelOptions(options.nThreads, 1));
+
+    std::vector<Pair> pairs;
+    for (const std::vector<Pair>& t : taskPairs)
+        pairs.insert(pairs.end(), t.begin(), t.end());
+    parallelSort(pairs.begin(), pairs.end(), std::less<Pair>(), options);
+    return pairs;
+}
+
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @brief TriangleBvh::TriangleBvh
+ * Builds the hierarchy on any mesh with a MeshTraits specialization (Dcel,
+ * CompactTriMesh, SimpleEigenMesh, EigenMesh). Polygonal faces are fan
+ * triangulated, and the hits report the face ids of the mesh.
+ */
+template <typename Mesh>
+TriangleBvh::TriangleBvh(const Mesh& mesh, const ParallelOptions& options)
+{
+    std::vector<Pointd> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    std::vector<unsigned int> triangleFaces;
+    meshTriangulation(mesh, vertices, triangles, triangleFaces);
+    build(vertices, triangles, triangleFaces, options);
+}
+#endif // CG3_DCEL_DEFINED
+
+}
@@ -0,0 +1,36 @@
+#
+# This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+# This Source Code Form is subject to the terms of the GNU GPL 3.0
+#
+# @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+#
+
+!contains(DEFINES, CG3_CORE_DEFINED){
+    error(Benchmarks module requires Core module!)
+}
+
+!contains(DEFINES, CG3_EIGENMESH_DEFINED){
+    error(Benchmarks module requires Eigenmesh module!)
+}
+
+!contains(DEFINES, CG3_DATA_STRUCTURES_DEFINED){
+    error(Benchmarks module requires DataStructures module!)
+}
+
+!contains(DEFINES, CG3_ALGORITHMS_DEFINED){
+    error(Benchmarks module requires Algorithms module!)
+}
+
+DEFINES += CG3_BENCHMARKS_DEFINED
+MODULES += CG3_BENCHMARKS
+
+HEADERS += \
+    $$PWD/benchmarks/benchmark.h \
+    $$PWD/benchmarks/benchmark.tpp \
+    $$PWD/benchmarks/generators.h
+
+SOURCES += \
+    $$PWD/benchmarks/generators.cpp
+
+DISTFILES += \
+    $$PWD/benchmarks/main.cpp
@@ -0,0 +1,101 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_BENCHMARK_H
+#define CG3_BENCHMARK_H
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace cg3 {
+namespace benchmarks {
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of value.
+ */
+template <typename T>
+void doNotOptimize(const T& value);
+
+/**
+ * @brief Timings of a benchmark, in seconds.
+ */
+struct BenchmarkResult
+{
+    std::string name;
+    unsigned long int size;         /**< @brief size of the input (vertices, points, nodes...) */
+    unsigned int repetitions;
+    double min;
+    double median;
+    double mean;
+    double max;
+};
+
+/**
+ * @brief The BenchmarkSuite class runs and collects timed benchmarks.
+ *
+ * Every benchmark is executed once as warm-up and then timed for the given
+ * number of repetitions. An optional setup function is called before every
+ * repetition and is not timed (e.g. for copying the input of a benchmark
+ * that modifies it).
+ *
+ * The results can be saved in JSON, with the following format:
+ *
+ * \code{.json}
+ * {
+ *   "library": "cg3lib",
+ *   "compiler": "...",
+ *   "build": "release",
+ *   "results": [
+ *     {"name": "dcel/copy", "size": 10000, "repetitions": 5,
+ *      "min_s": ..., "median_s": ..., "mean_s": ..., "max_s": ...},
+ *     ...
+ *   ]
+ * }
+ * \endcode
+ */
+class BenchmarkSuite
+{
+public:
+    BenchmarkSuite(unsigned int repetitions = 5);
+
+    void setRepetitions(unsigned int repetitions);
+    void setFilter(const std::string& filter);
+    void setVerbose(bool verbose);
+
+    bool isEnabled(const std::string& name) const;
+
+    void run(
+            const std::string& name,
+            unsigned long int size,
+            const std::function<void()>& benchmark);
+    void run(
+            const std::string& name,
+            unsigned long int size,
+            const std::function<void()>& setup,
+            const std::function<void()>& benchmark);
+
+    const std::vector<BenchmarkResult>& results() const;
+
+    void printResults(std::ostream& stream = std::cout) const;
+    bool saveJson(const std::string& filename) const;
+    void saveJson(std::ostream& stream) const;
+
+private:
+    unsigned int repetitions;
+    std::string filter;
+    bool verbose;
+    std::vector<BenchmarkResult> res;
+};
+
+} //namespace cg3::benchmarks
+} //namespace cg3
+
+#include "benchmark.tpp"
+
+#endif // CG3_BENCHMARK_H
@@ -0,0 +1,205 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace cg3 {
+namespace benchmarks {
+
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+inline BenchmarkSuite::BenchmarkSuite(unsigned int repetitions) :
+    repetitions(repetitions > 0 ? repetitions : 1),
+    verbose(true)
+{
+}
+
+inline void BenchmarkSuite::setRepetitions(unsigned int repetitions)
+{
+    this->repetitions = repetitions > 0 ? repetitions : 1;
+}
+
+/**
+ * @brief BenchmarkSuite::setFilter
+ * Only the benchmarks whose name contains filter will be executed.
+ * An empty filter enables all the benchmarks.
+ * @param filter
+ */
+inline void BenchmarkSuite::setFilter(const std::string& filter)
+{
+    this->filter = filter;
+}
+
+/**
+ * @brief BenchmarkSuite::setVerbose
+ * If verbose, every result is printed on std::cerr as soon as it is available.
+ * @param verbose
+ */
+inline void BenchmarkSuite::setVerbose(bool verbose)
+{
+    this->verbose = verbose;
+}
+
+/**
+ * @brief BenchmarkSuite::isEnabled
+ * Can be used to skip the generation of the input of filtered benchmarks.
+ * @param name
+ * @return true if the benchmark called name will be executed
+ */
+inline bool BenchmarkSuite::isEnabled(const std::string& name) const
+{
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+inline void BenchmarkSuite::run(
+        const std::string& name,
+        unsigned long int size,
+        const std::function<void()>& benchmark)
+{
+    run(name, size, [](){}, benchmark);
+}
+
+inline void BenchmarkSuite::run(
+        const std::string& name,
+        unsigned long int size,
+        const std::function<void()>& setup,
+        const std::function<void()>& benchmark)
+{
+    if (!isEnabled(name))
+        return;
+    typedef std::chrono::steady_clock Clock;
+
+    //warm-up
+    setup();
+    benchmark();
+
+    std::vector<double> times;
+    times.reserve(repetitions);
+    for (unsigned int i = 0; i < repetitions; i++) {
+        setup();
+        Clock::time_point begin = Clock::now();
+        benchmark();
+        Clock::time_point end = Clock::now();
+        times.push_back(std::chrono::duration<double>(end - begin).count());
+    }
+    std::sort(times.begin(), times.end());
+
+    BenchmarkResult r;
+    r.name = name;
+    r.size = size;
+    r.repetitions = repetitions;
+    r.min = times.front();
+    r.max = times.back();
+    r.median = times.size() % 2 == 1 ?
+                times[times.size()/2] :
+                (times[times.size()/2 - 1] + times[times.size()/2]) / 2;
+    r.mean = 0;
+    for (double t : times)
+        r.mean += t;
+    r.mean /= times.size();
+    res.push_back(r);
+
+    if (verbose) {
+        std::ios::fmtflags flags = std::cerr.flags();
+        std::cerr << std::left << std::setw(40) << name << std::right
+                  << std::setw(10) << size << std::fixed << std::setprecision(3)
+                  << std::setw(12) << r.median * 1e3 << " ms\n";
+        std::cerr.flags(flags);
+    }
+}
+
+inline const std::vector<BenchmarkResult>& BenchmarkSuite::results() const
+{
+    return res;
+}
+
+/**
+ * @brief BenchmarkSuite::printResults
+ * Prints a table with the results. Times are in milliseconds.
+ * @param stream
+ */
+inline void BenchmarkSuite::printResults(std::ostream& stream) const
+{
+    std::ios::fmtflags flags = stream.flags();
+    stream << std::left << std::setw(40) << "benchmark" << std::right
+           << std::setw(10) << "size"
+           << std::setw(12) << "min ms" << std::setw(12) << "median ms"
+           << std::setw(12) << "mean ms" << std::setw(12) << "max ms" << "\n";
+    stream << std::fixed << std::setprecision(3);
+    for (const BenchmarkResult& r : res) {
+        stream << std::left << std::setw(40) << r.name << std::right
+               << std::setw(10) << r.size
+               << std::setw(12) << r.min*1e3 << std::setw(12) << r.median*1e3
+               << std::setw(12) << r.mean*1e3 << std::setw(12) << r.max*1e3 << "\n";
+    }
+    stream.flags(flags);
+}
+
+/**
+ * @brief BenchmarkSuite::saveJson
+ * Saves the results in JSON, see the documentation of the class for the format.
+ * @param filename
+ * @return true if the file has been written
+ */
+inline bool BenchmarkSuite::saveJson(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file.is_open())
+        return false;
+    saveJson(file);
+    return (bool)file;
+}
+
+inline void BenchmarkSuite::saveJson(std::ostream& stream) const
+{
+    std::ios::fmtflags flags = stream.flags();
+    std::streamsize precision = stream.precision();
+    stream << std::scientific << std::setprecision(6);
+    stream << "{\n";
+    stream << "  \"library\": \"cg3lib\",\n";
+    #if defined(__VERSION__)
+    stream << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+    #elif defined(_MSC_VER)
+    stream << "  \"compiler\": \"MSVC " << _MSC_VER << "\",\n";
+    #else
+    stream << "  \"compiler\": \"unknown\",\n";
+    #endif
+    #ifdef NDEBUG
+    stream << "  \"build\": \"release\",\n";
+    #else
+    stream << "  \"build\": \"debug\",\n";
+    #endif
+    stream << "  \"results\": [";
+    for (unsigned int i = 0; i < res.size(); i++) {
+        const BenchmarkResult& r = res[i];
+        stream << (i == 0 ? "\n" : ",\n");
+        stream << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size
+               << ", \"repetitions\": " << r.repetitions
+               << ", \"min_s\": " << r.min << ", \"median_s\": " << r.median
+               << ", \"mean_s\": " << r.mean << ", \"max_s\": " << r.max << "}";
+    }
+    stream << "\n  ]\n}\n";
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+} //namespace cg3::benchmarks
+} //namespace cg3
@@ -0,0 +1,21 @@
+#
+# This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+# This Source Code Form is subject to the terms of the GNU GPL 3.0
+#
+# @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+#
+# Benchmarks of the library. Build in release mode and run:
+#   ./cg3_benchmarks --scales 1000,10000,100000 --output results.json
+#
+
+TEMPLATE = app
+TARGET = cg3_benchmarks
+CONFIG += console
+CONFIG -= app_bundle qt
+CONFIG += release
+
+CONFIG += CG3_CORE CG3_DATA_STRUCTURES CG3_MESHES CG3_ALGORITHMS CG3_BENCHMARKS
+include (../../cg3.pri)
+
+SOURCES += \
+    main.cpp
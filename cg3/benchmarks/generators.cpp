@@ -0,0 +1,162 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "generators.h"
+
+#include <cmath>
+#include <random>
+
+namespace cg3 {
+namespace benchmarks {
+
+/**
+ * @brief randomValues
+ * @return n random values uniformly distributed in [-1, 1]
+ */
+std::vector<double> randomValues(unsigned int n, unsigned int seed)
+{
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<double> values(n);
+    for (unsigned int i = 0; i < n; i++)
+        values[i] = dist(mt);
+    return values;
+}
+
+/**
+ * @brief randomPoints
+ * @return n random points uniformly distributed in the cube [-1, 1]^3
+ */
+std::vector<Pointd> randomPoints(unsigned int n, unsigned int seed)
+{
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<Pointd> points(n);
+    for (unsigned int i = 0; i < n; i++) {
+        double x = dist(mt), y = dist(mt), z = dist(mt);
+        points[i] = Pointd(x, y, z);
+    }
+    return points;
+}
+
+/**
+ * @brief randomPointsOnSphere
+ * @return n random points uniformly distributed on the unit sphere. All the
+ * points lie on the convex hull: it is the worst case for 3D convex hulls.
+ */
+std::vector<Pointd> randomPointsOnSphere(unsigned int n, unsigned int seed)
+{
+    std::mt19937 mt(seed);
+    std::normal_distribution<double> dist;
+    std::vector<Pointd> points(n);
+    for (unsigned int i = 0; i < n; i++) {
+        double x = dist(mt), y = dist(mt), z = dist(mt);
+        Pointd p(x, y, z);
+        p.normalize();
+        points[i] = p;
+    }
+    return points;
+}
+
+/**
+ * @brief randomPoints2D
+ * @return n random points uniformly distributed in the square [-1, 1]^2
+ */
+std::vector<Point2Dd> randomPoints2D(unsigned int n, unsigned int seed)
+{
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<Point2Dd> points(n);
+    for (unsigned int i = 0; i < n; i++) {
+        double x = dist(mt), y = dist(mt);
+        points[i] = Point2Dd(x, y);
+    }
+    return points;
+}
+
+/**
+ * @brief bumpySphere
+ * Generates a closed, manifold, genus 0 triangle mesh with approximately
+ * nVertices vertices: a uv-sphere whose vertices are randomly displaced along
+ * the radial direction, in order to have non-uniform normals.
+ */
+SimpleEigenMesh bumpySphere(unsigned int nVertices, unsigned int seed)
+{
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(0.95, 1.05);
+
+    unsigned int rings = std::max(3u, (unsigned int)std::sqrt(nVertices / 2.0));
+    unsigned int sectors = 2 * rings;
+    unsigned int nv = 2 + (rings - 1) * sectors;
+    unsigned int nf = 2 * sectors * (rings - 1);
+
+    SimpleEigenMesh mesh;
+    mesh.resizeVertices(nv);
+    mesh.resizeFaces(nf);
+
+    mesh.setVertex(0, 0, 0, dist(mt));
+    for (unsigned int r = 1; r < rings; r++) {
+        double theta = M_PI * r / rings;
+        for (unsigned int s = 0; s < sectors; s++) {
+            double phi = 2 * M_PI * s / sectors;
+            double radius = dist(mt);
+            mesh.setVertex(1 + (r-1) * sectors + s,
+                           radius * std::sin(theta) * std::cos(phi),
+                           radius * std::sin(theta) * std::sin(phi),
+                           radius * std::cos(theta));
+        }
+    }
+    mesh.setVertex(nv - 1, 0, 0, -dist(mt));
+
+    unsigned int f = 0;
+    for (unsigned int s = 0; s < sectors; s++) {
+        unsigned int s1 = (s + 1) % sectors;
+        mesh.setFace(f++, 0, 1 + s, 1 + s1);
+        for (unsigned int r = 1; r < rings - 1; r++) {
+            unsigned int a = 1 + (r-1) * sectors + s;
+            unsigned int b = 1 + (r-1) * sectors + s1;
+            unsigned int c = 1 + r * sectors + s;
+            unsigned int d = 1 + r * sectors + s1;
+            mesh.setFace(f++, a, c, d);
+            mesh.setFace(f++, a, d, b);
+        }
+        mesh.setFace(f++, nv - 1, 1 + (rings-2) * sectors + s1, 1 + (rings-2) * sectors + s);
+    }
+    return mesh;
+}
+
+/**
+ * @brief randomGraph
+ * Generates a connected undirected graph with nNodes nodes labelled from 0
+ * to nNodes-1. Every node is connected to the next one (so the graph is
+ * connected) and to (degree-2)/2 random nodes, so that the average degree is
+ * about degree. Edges have random positive weights.
+ */
+Graph<unsigned int> randomGraph(unsigned int nNodes, unsigned int degree, unsigned int seed)
+{
+    std::mt19937 mt(seed);
+    std::uniform_int_distribution<unsigned int> node(0, nNodes > 0 ? nNodes - 1 : 0);
+    std::uniform_real_distribution<double> weight(1, 10);
+
+    Graph<unsigned int> graph(GraphType::UNDIRECTED);
+    for (unsigned int i = 0; i < nNodes; i++)
+        graph.addNode(i);
+    for (unsigned int i = 0; i + 1 < nNodes; i++)
+        graph.addEdge(i, i + 1, weight(mt));
+    unsigned int nRandom = degree > 2 ? (degree - 2) / 2 : 0;
+    for (unsigned int i = 0; i < nNodes; i++) {
+        for (unsigned int j = 0; j < nRandom; j++) {
+            unsigned int n = node(mt);
+            if (n != i)
+                graph.addEdge(i, n, weight(mt));
+        }
+    }
+    return graph;
+}
+
+} //namespace cg3::benchmarks
+} //namespace cg3
@@ -0,0 +1,40 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_BENCHMARK_GENERATORS_H
+#define CG3_BENCHMARK_GENERATORS_H
+
+#include <cg3/geometry/point.h>
+#include <cg3/geometry/2d/point2d.h>
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#include <cg3/data_structures/graphs/graph.h>
+
+namespace cg3 {
+namespace benchmarks {
+
+/*
+ * Deterministic synthetic inputs for the benchmarks: the same size and seed
+ * always give the same input, so that results of different runs can be
+ * compared.
+ */
+
+std::vector<double> randomValues(unsigned int n, unsigned int seed = 0);
+
+std::vector<Pointd> randomPoints(unsigned int n, unsigned int seed = 0);
+
+std::vector<Pointd> randomPointsOnSphere(unsigned int n, unsigned int seed = 0);
+
+std::vector<Point2Dd> randomPoints2D(unsigned int n, unsigned int seed = 0);
+
+SimpleEigenMesh bumpySphere(unsigned int nVertices, unsigned int seed = 0);
+
+Graph<unsigned int> randomGraph(unsigned int nNodes, unsigned int degree = 6, unsigned int seed = 0);
+
+} //namespace cg3::benchmarks
+} //namespace cg3
+
+#endif // CG3_BENCHMARK_GENERATORS_H
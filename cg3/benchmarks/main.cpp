@@ -0,0 +1,361 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+/*
+ * Benchmarks of the hot paths of the library, on synthetic inputs generated at
+ * several scales.
+ *
+ * Usage:
+ *   cg3_benchmarks [--scales 1000,10000,100000] [--repetitions 5]
+ *                  [--filter substring] [--output results.json] [--quiet]
+ *
+ * The results are printed as a table on the standard output and, if --output
+ * is given, saved as JSON (see cg3::benchmarks::BenchmarkSuite).
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include "benchmark.h"
+#include "generators.h"
+
+#include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/eigenmesh/eigenmesh.h>
+#include <cg3/geometry/bounding_box.h>
+#include <cg3/data_structures/trees/aabbtree.h>
+#include <cg3/data_structures/trees/avlleaf.h>
+#include <cg3/data_structures/trees/includes/rangetree_types.h>
+#include <cg3/algorithms/convexhull.h>
+#include <cg3/algorithms/2d/convexhull2d.h>
+#include <cg3/algorithms/graph_algorithms.h>
+#include <cg3/algorithms/sphere_coverage.h>
+#include <cg3/algorithms/global_optimal_rotation_matrix.h>
+
+using namespace cg3;
+using namespace cg3::benchmarks;
+
+namespace {
+
+/* Inputs larger than these limits are skipped by the benchmarks of
+ * algorithms that have a superlinear complexity or memory footprint. */
+const unsigned int MAX_RANGETREE_SIZE = 20000;
+const unsigned int MAX_CONVEXHULL_SIZE = 50000;
+const unsigned int MAX_SPHERE_COVERAGE_SIZE = 100000;
+const unsigned int MAX_ROTATION_SIZE = 100000;
+
+const unsigned int N_QUERIES = 1000;
+
+double boxAABBValueExtractor(
+        const BoundingBox& box,
+        const AABBValueType& valueType,
+        const int& dim)
+{
+    if (valueType == MIN)
+        return box.min()[dim-1];
+    return box.max()[dim-1];
+}
+
+bool boxComparator(const BoundingBox& b1, const BoundingBox& b2)
+{
+    if (b1.min() < b2.min())
+        return true;
+    if (b2.min() < b1.min())
+        return false;
+    return b1.max() < b2.max();
+}
+
+std::vector<BoundingBox> randomBoxes(unsigned int n, double size, unsigned int seed)
+{
+    std::vector<Pointd> p = randomPoints(n, seed);
+    std::vector<BoundingBox> boxes(n);
+    for (unsigned int i = 0; i < n; i++)
+        boxes[i] = BoundingBox(p[i], p[i] + Pointd(size, size, size));
+    return boxes;
+}
+
+void meshBenchmarks(BenchmarkSuite& suite, unsigned int size)
+{
+    const std::string objFile = "cg3_benchmark_tmp.obj";
+    const std::string plyFile = "cg3_benchmark_tmp.ply";
+    const std::string dcelFile = "cg3_benchmark_tmp.dcel";
+
+    SimpleEigenMesh mesh = bumpySphere(size);
+    Dcel dcel(mesh);
+    unsigned long int nv = mesh.getNumberVertices();
+
+    suite.run("io/dcel_save_obj", nv, [&](){
+        dcel.saveOnObjFile(objFile);
+    });
+    suite.run("io/dcel_load_obj", nv, [&](){
+        Dcel d;
+        d.loadFromObjFile(objFile);
+        doNotOptimize(d);
+    });
+    suite.run("io/dcel_save_ply", nv, [&](){
+        dcel.saveOnPlyFile(plyFile);
+    });
+    suite.run("io/dcel_load_ply", nv, [&](){
+        Dcel d;
+        d.loadFromPlyFile(plyFile);
+        doNotOptimize(d);
+    });
+    suite.run("io/eigenmesh_save_obj", nv, [&](){
+        mesh.saveOnObj(objFile);
+    });
+    suite.run("io/eigenmesh_load_obj", nv, [&](){
+        SimpleEigenMesh m;
+        m.readFromObj(objFile);
+        doNotOptimize(m);
+    });
+    suite.run("io/eigenmesh_save_ply", nv, [&](){
+        mesh.saveOnPly(plyFile);
+    });
+    suite.run("io/eigenmesh_load_ply", nv, [&](){
+        SimpleEigenMesh m;
+        m.readFromPly(plyFile);
+        doNotOptimize(m);
+    });
+
+    suite.run("dcel/build_from_eigenmesh", nv, [&](){
+        Dcel d(mesh);
+        doNotOptimize(d);
+    });
+    suite.run("dcel/copy", nv, [&](){
+        Dcel d(dcel);
+        doNotOptimize(d);
+    });
+    suite.run("dcel/update_normals", nv, [&](){
+        dcel.updateFaceNormals();
+        dcel.updateVertexNormals();
+    });
+    suite.run("dcel/serialize", nv, [&](){
+        std::ofstream file(dcelFile, std::ios::out | std::ios::binary);
+        dcel.serialize(file);
+    });
+    suite.run("dcel/deserialize", nv, [&](){
+        Dcel d;
+        std::ifstream file(dcelFile, std::ios::in | std::ios::binary);
+        d.deserialize(file);
+        doNotOptimize(d);
+    });
+    suite.run("dcel/to_eigenmesh", nv, [&](){
+        EigenMesh m(dcel);
+        doNotOptimize(m);
+    });
+
+    EigenMesh eigenMesh(mesh);
+    suite.run("eigenmesh/update_normals", nv, [&](){
+        eigenMesh.updateFacesAndVerticesNormals();
+    });
+
+    if (size <= MAX_ROTATION_SIZE) {
+        suite.run("algorithms/optimal_rotation_100_dirs", nv, [&](){
+            Eigen::Matrix3d m = globalOptimalRotationMatrix(mesh, 100, true);
+            doNotOptimize(m);
+        });
+    }
+
+    std::remove(objFile.c_str());
+    std::remove(plyFile.c_str());
+    std::remove(dcelFile.c_str());
+    std::remove("cg3_benchmark_tmp.mtu"); //material file written with the obj
+}
+
+void treeBenchmarks(BenchmarkSuite& suite, unsigned int size)
+{
+    std::vector<double> values = randomValues(size);
+    std::vector<double> queries = randomValues(N_QUERIES, 1);
+
+    AVLLeaf<double> avl;
+    suite.run("trees/avl_construction", size, [&](){
+        avl.construction(values);
+    });
+    suite.run("trees/avl_find", N_QUERIES, [&](){
+        for (unsigned int i = 0; i < N_QUERIES; i++) {
+            AVLLeaf<double>::iterator it = avl.find(values[i % size]);
+            doNotOptimize(it);
+        }
+    });
+    suite.run("trees/avl_range_query", N_QUERIES, [&](){
+        std::vector<AVLLeaf<double>::iterator> out;
+        for (unsigned int i = 0; i < N_QUERIES; i++) {
+            out.clear();
+            avl.rangeQuery(queries[i], queries[i] + 0.01, std::back_inserter(out));
+        }
+        doNotOptimize(out);
+    });
+
+    std::vector<Pointd> points = randomPoints(size);
+    std::vector<Pointd> queryPoints = randomPoints(N_QUERIES, 1);
+    if (size <= MAX_RANGETREE_SIZE) {
+        RangeTree3D rangeTree;
+        suite.run("trees/rangetree3d_construction", size, [&](){
+            rangeTree.construction(points);
+        });
+        suite.run("trees/rangetree3d_range_query", N_QUERIES, [&](){
+            std::vector<RangeTree3D::iterator> out;
+            for (unsigned int i = 0; i < N_QUERIES; i++) {
+                out.clear();
+                rangeTree.rangeQuery(
+                            queryPoints[i],
+                            queryPoints[i] + Pointd(0.1, 0.1, 0.1),
+                            std::back_inserter(out));
+            }
+            doNotOptimize(out);
+        });
+    }
+
+    //boxes of the size of the average spacing of the points
+    double boxSize = 2.0 / std::cbrt((double)size);
+    std::vector<BoundingBox> boxes = randomBoxes(size, boxSize, 0);
+    std::vector<BoundingBox> queryBoxes = randomBoxes(N_QUERIES, boxSize, 2);
+    typedef bool (*BoxComparator)(const BoundingBox&, const BoundingBox&);
+    typedef AABBTree<3, BoundingBox, BoundingBox, BoxComparator> BoxAABBTree;
+    BoxAABBTree aabbTree(&boxAABBValueExtractor, &boxComparator);
+    suite.run("trees/aabbtree_construction", size, [&](){
+        aabbTree.construction(boxes);
+    });
+    suite.run("trees/aabbtree_overlap_query", N_QUERIES, [&](){
+        std::vector<BoxAABBTree::iterator> out;
+        for (unsigned int i = 0; i < N_QUERIES; i++) {
+            out.clear();
+            aabbTree.aabbOverlapQuery(queryBoxes[i], std::back_inserter(out));
+        }
+        doNotOptimize(out);
+    });
+}
+
+void algorithmBenchmarks(BenchmarkSuite& suite, unsigned int size)
+{
+    if (suite.isEnabled("graph/dijkstra")) {
+        Graph<unsigned int> graph = randomGraph(size);
+        suite.run("graph/dijkstra", size, [&](){
+            DijkstraResult<unsigned int> r = dijkstra(graph, 0u);
+            doNotOptimize(r);
+        });
+    }
+
+    if (size <= MAX_CONVEXHULL_SIZE) {
+        std::vector<Pointd> points = randomPoints(size);
+        suite.run("convexhull/3d_random_cube", size, [&](){
+            Dcel ch = convexHull(points);
+            doNotOptimize(ch);
+        });
+        std::vector<Pointd> pointsOnSphere = randomPointsOnSphere(size);
+        suite.run("convexhull/3d_random_sphere", size, [&](){
+            Dcel ch = convexHull(pointsOnSphere);
+            doNotOptimize(ch);
+        });
+    }
+
+    std::vector<Point2Dd> points2D = randomPoints2D(size);
+    suite.run("convexhull/2d", size, [&](){
+        std::vector<Point2Dd> ch;
+        getConvexHull2D(points2D, ch);
+        doNotOptimize(ch);
+    });
+
+    if (size <= MAX_SPHERE_COVERAGE_SIZE) {
+        suite.run("algorithms/sphere_coverage", size, [&](){
+            std::vector<Pointd> dirs = sphereCoverage(size, true);
+            doNotOptimize(dirs);
+        });
+    }
+}
+
+/* parses a positive integer, made only of digits: returns false on zero,
+ * signs, garbage and values that do not fit an unsigned int */
+bool parsePositive(const std::string& s, unsigned int& value)
+{
+    if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+    unsigned long long int v = 0;
+    for (char c : s) {
+        v = v * 10 + (unsigned long long int)(c - '0');
+        if (v > std::numeric_limits<unsigned int>::max())
+            return false;
+    }
+    value = (unsigned int)v;
+    return value > 0;
+}
+
+bool parseScales(const std::string& s, std::vector<unsigned int>& scales)
+{
+    scales.clear();
+    std::stringstream ss(s);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        unsigned int scale;
+        if (!parsePositive(token, scale))
+            return false;
+        scales.push_back(scale);
+    }
+    return !scales.empty();
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program
+              << " [--scales n1,n2,...] [--repetitions n] [--filter substring]"
+                 " [--output results.json] [--quiet]\n";
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<unsigned int> scales = {1000, 10000, 100000};
+    unsigned int repetitions = 5;
+    std::string filter;
+    std::string output;
+    bool verbose = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        if (arg == "--scales" && hasValue)
+            valid = parseScales(argv[++i], scales);
+        else if (arg == "--repetitions" && hasValue)
+            valid = parsePositive(argv[++i], repetitions);
+        else if (arg == "--filter" && hasValue)
+            filter = argv[++i];
+        else if (arg == "--output" && hasValue)
+            output = argv[++i];
+        else if (arg == "--quiet")
+            verbose = false;
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (!valid) {
+            std::cerr << "Invalid value for " << arg << ": " << argv[i] << "\n";
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    BenchmarkSuite suite(repetitions);
+    suite.setFilter(filter);
+    suite.setVerbose(verbose);
+
+    for (unsigned int size : scales) {
+        meshBenchmarks(suite, size);
+        treeBenchmarks(suite, size);
+        algorithmBenchmarks(suite, size);
+    }
+
+    suite.printResults();
+    if (!output.empty() && !suite.saveJson(output)) {
+        std::cerr << "Unable to write " << output << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -11,6 +11,8 @@
 #include <CGAL/Boolean_set_operations_2.h>
 #include <CGAL/Polygon_2.h>
 
+#include <cg3/utilities/profiler.h>
+
 namespace cg3 {
 
 namespace cgal {
@@ -50,7 +52,7 @@ std::vector<std::vector<Point2Dd> > difference(
         const std::vector<Point2Dd>& polygon1,
         const std::vector<Point2Dd>& polygon2)
 {
-
+    CG3_PROFILE_SCOPE("cgal::difference(polygons)");
     std::vector<std::vector<Point2Dd> > result;
 
     internal::Polygon_2 P1;
@@ -101,7 +103,7 @@ std::vector<std::vector<Point2Dd> > intersection(
         const std::vector<Point2Dd>& polygon1,
         const std::vector<Point2Dd>& polygon2)
 {
-
+    CG3_PROFILE_SCOPE("cgal::intersection(polygons)");
     std::vector<std::vector<Point2Dd> > result;
 
     internal::Polygon_2 P1;
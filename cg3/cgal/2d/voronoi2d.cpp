@@ -7,6 +7,8 @@
 
 #include "voronoi2d.h"
 
+#include <cg3/utilities/flat_hash_map.h>
+
 // standard includes
 #include <iostream>
 #include <fstream>
@@ -93,14 +95,14 @@ void computeVoronoiDiagram2d(
     std::vector<std::vector<cg3::Point2Dd> > vd = computeVoronoiDiagram2d(sites);
     vl.clear();
     fl.clear();
-    std::map<cg3::Point2Dd, unsigned int> vertMap;
+    cg3::FlatHashMap<cg3::Point2Dd, unsigned int> vertMap;
     unsigned int nv = 0;
     fl.reserve(vd.size());
     for (const std::vector<cg3::Point2Dd>& vf : vd){
         std::vector<unsigned int> face;
         face.reserve(vf.size());
         for (const cg3::Point2Dd& p : vf){
-            std::map<cg3::Point2Dd, unsigned int>::iterator vit = vertMap.find(p);
+            cg3::FlatHashMap<cg3::Point2Dd, unsigned int>::iterator vit = vertMap.find(p);
             if (vit == vertMap.end()){ // vertex doesn't exist in the list
                 vertMap[p] = nv;
                 vl.push_back(p);
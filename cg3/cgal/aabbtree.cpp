@@ -392,7 +392,7 @@ void AABBTree::getContainedDcelFaces(
     for (std::list< Tree::Primitive_id >::const_iterator it = trianglesIds.begin(); it != trianglesIds.end(); ++it){
         const Tree::Primitive_id id = *it;
         const CGALTriangle t = *id;
-        std::map<CGALTriangle, const Dcel::Face*, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
+        FlatHashMap<CGALTriangle, const Dcel::Face*, hashCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
         assert(mit != mapCgalTrianglesToDcelFaces.end());
         outputList.push_back(mit->second);
     }
@@ -477,7 +477,7 @@ const Dcel::Face* AABBTree::getNearestDcelFace(const Pointd& p) const
     AABB_triangle_traits::Point_and_primitive_id ppid = tree.closest_point_and_primitive(query);
     const Tree::Primitive_id tp = ppid.second;
     const CGALTriangle t = *tp;
-    std::map<CGALTriangle, const Dcel::Face*, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
+    FlatHashMap<CGALTriangle, const Dcel::Face*, hashCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
     assert(mit != mapCgalTrianglesToDcelFaces.end());
     return mit->second;
 
@@ -524,7 +524,7 @@ void AABBTree::getIntersectEigenFaces(const Pointd& p1, const Pointd &p2, std::v
     for (std::list< Tree::Primitive_id >::const_iterator it = trianglesIds.begin(); it != trianglesIds.end(); ++it){
         const Tree::Primitive_id id = *it;
         const CGALTriangle t = *id;
-        std::map<CGALTriangle, int, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToIdTriangles.find(t);
+        FlatHashMap<CGALTriangle, int, hashCGALTriangle>::const_iterator mit = mapCgalTrianglesToIdTriangles.find(t);
         outputList.push_back(mit->second);
     }
 }
@@ -541,7 +541,7 @@ unsigned int AABBTree::getNearestEigenFace(const Pointd& p) const
     AABB_triangle_traits::Point_and_primitive_id ppid = tree.closest_point_and_primitive(query);
     const Tree::Primitive_id tp = ppid.second;
     const CGALTriangle t = *tp;
-    std::map<CGALTriangle, int, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToIdTriangles.find(t);
+    FlatHashMap<CGALTriangle, int, hashCGALTriangle>::const_iterator mit = mapCgalTrianglesToIdTriangles.find(t);
     assert(mit != mapCgalTrianglesToIdTriangles.end());
     return mit->second;
 }
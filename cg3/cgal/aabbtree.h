@@ -9,6 +9,7 @@
 #define CG3_CGAL_AABBTREE_H
 
 #include <cg3/geometry/bounding_box.h>
+#include <cg3/utilities/flat_hash_map.h>
 
 #ifdef  CG3_DCEL_DEFINED
 #include <cg3/meshes/dcel/dcel.h>
@@ -91,12 +92,18 @@ protected:
 
     typedef AABB_triangle_traits::Bounding_box CGALBoundingBox;
 
-    struct cmpCGALTriangle {
-        bool operator()(const CGALTriangle& a, const CGALTriangle& b) const {
-            if (a == b) return false;
-            if (a[0] == b[0] && a[1] == b[1]) return (a[2] < b[2]);
-            if (a[0] == b[0]) return (a[1] < b[1]);
-            return (a[0] < b[0]);
+    struct hashCGALPoint {
+        size_t operator()(const CGALPoint& p) const {
+            return hashScalars(p.x(), p.y(), p.z());
+        }
+    };
+
+    //CGAL triangles are equal up to a cyclic permutation of their vertices:
+    //the hash must not depend on the order of the vertices
+    struct hashCGALTriangle {
+        size_t operator()(const CGALTriangle& t) const {
+            hashCGALPoint h;
+            return hashMix(h(t[0]) + h(t[1]) + h(t[2]));
         }
     };
 
@@ -106,13 +113,13 @@ protected:
     bool forDistanceQueries;
     TreeType treeType;
     #ifdef CG3_DCEL_DEFINED
-    std::map<const Dcel::Vertex*, CGALPoint> mapDcelVerticesToCgalPoints;
-    std::map<CGALPoint, const Dcel::Vertex*> mapCgalPointsToDcelVertices;
-    std::map<CGALTriangle, const Dcel::Face*, cmpCGALTriangle> mapCgalTrianglesToDcelFaces;
+    FlatHashMap<const Dcel::Vertex*, CGALPoint> mapDcelVerticesToCgalPoints;
+    FlatHashMap<CGALPoint, const Dcel::Vertex*, hashCGALPoint> mapCgalPointsToDcelVertices;
+    FlatHashMap<CGALTriangle, const Dcel::Face*, hashCGALTriangle> mapCgalTrianglesToDcelFaces;
     #endif
     #if defined(TRIMESH_DEFINED) || defined( CG3_EIGENMESH_DEFINED)
-    std::map<int, CGALPoint> mapIdVerticesToCgalPoints;
-    std::map<CGALTriangle, int, cmpCGALTriangle> mapCgalTrianglesToIdTriangles;
+    FlatHashMap<int, CGALPoint> mapIdVerticesToCgalPoints;
+    FlatHashMap<CGALTriangle, int, hashCGALTriangle> mapCgalTrianglesToIdTriangles;
     #endif
     std::list<CGALTriangle> triangles;
     BoundingBox bb;
@@ -7,6 +7,8 @@
 
 #include "signeddistances.h"
 
+#include <cg3/utilities/parallel.h>
+
 namespace cg3 {
 namespace cgal {
 
@@ -24,10 +26,9 @@ std::vector<double> getUnsignedDistances(
     std::vector<double> distances(points.size(), 0);
     size_t size = distances.size();
 
-    #pragma omp parallel for
-    for (unsigned int i = 0; i < size; i++){
+    parallelFor((size_t)0, size, [&](size_t i){
         distances[i] = tree.getSquaredDistance(points[i]);
-    }
+    });
 
     return distances;
 }
@@ -8,6 +8,7 @@
 #include "triangulation.h"
 
 #include <cg3/geometry/transformations.h>
+#include <cg3/utilities/flat_hash_map.h>
 
 namespace cg3 {
 namespace cgal {
@@ -28,7 +29,7 @@ std::vector<std::array<Pointd, 3> > triangulate(
         bool& nonRegularPolygon)
 {
     std::vector<std::array<Pointd, 3> > triangles;
-    std::map<Point2Dd, Pointd> pointsVerticesMap;
+    FlatHashMap<Point2Dd, Pointd> pointsVerticesMap;
 
     //Rotation of the coordinates
     Vec3 zAxis(0,0,1);
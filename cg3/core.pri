@@ -25,6 +25,11 @@ CG3_OPENMP {
     }
 }
 
+#enables the zones of cg3/utilities/profiler.h
+CG3_PROFILER {
+    DEFINES += CG3_WITH_PROFILER
+}
+
 #core
 HEADERS += \
     $$PWD/core/cg3/cg3lib.h
@@ -36,7 +41,9 @@ HEADERS += \
     $$PWD/core/cg3/geometry/line.h \
     $$PWD/core/cg3/geometry/plane.h \
     $$PWD/core/cg3/geometry/point.h \
+    $$PWD/core/cg3/geometry/point_n.h \
     $$PWD/core/cg3/geometry/segment.h \
+    $$PWD/core/cg3/geometry/spatial_hash.h \
     $$PWD/core/cg3/geometry/sphere.h \
     $$PWD/core/cg3/geometry/transformations.h \
     $$PWD/core/cg3/geometry/triangle.h \
@@ -47,6 +54,7 @@ HEADERS += \
     $$PWD/core/cg3/geometry/2d/point2d.h \
     $$PWD/core/cg3/geometry/2d/segment2d.h \
     $$PWD/core/cg3/geometry/2d/triangle2d.h \
+    $$PWD/core/cg3/geometry/2d/uniform_grid2d.h \
     $$PWD/core/cg3/geometry/2d/utils2d.h \
     $$PWD/core/cg3/geometry/2d/triangle2d_utils.h
 
@@ -56,7 +64,9 @@ SOURCES += \
     $$PWD/core/cg3/geometry/line.cpp \
     $$PWD/core/cg3/geometry/plane.cpp \
     $$PWD/core/cg3/geometry/point.tpp \
+    $$PWD/core/cg3/geometry/point_n.tpp \
     $$PWD/core/cg3/geometry/segment.tpp \
+    $$PWD/core/cg3/geometry/spatial_hash.tpp \
     $$PWD/core/cg3/geometry/sphere.cpp \
     $$PWD/core/cg3/geometry/transformations.cpp \
     $$PWD/core/cg3/geometry/triangle.tpp \
@@ -65,6 +75,7 @@ SOURCES += \
     $$PWD/core/cg3/geometry/2d/intersections2d.cpp \
     $$PWD/core/cg3/geometry/2d/line2d.cpp \
     $$PWD/core/cg3/geometry/2d/point2d.tpp \
+    $$PWD/core/cg3/geometry/2d/uniform_grid2d.tpp \
     $$PWD/core/cg3/geometry/2d/utils2d.tpp \
     $$PWD/core/cg3/geometry/2d/triangle2d_utils.tpp
 
@@ -87,14 +98,23 @@ HEADERS += \
     $$PWD/core/cg3/utilities/color.h \
     $$PWD/core/cg3/utilities/comparators.h \
     $$PWD/core/cg3/utilities/const.h \
+    $$PWD/core/cg3/utilities/dynamic_bitset.h \
     $$PWD/core/cg3/utilities/eigen.h \
+    $$PWD/core/cg3/utilities/flat_hash_map.h \
+    $$PWD/core/cg3/utilities/graph_coloring.h \
     $$PWD/core/cg3/utilities/hash.h \
+    $$PWD/core/cg3/utilities/lazy_tokenizer.h \
     $$PWD/core/cg3/utilities/map.h \
     $$PWD/core/cg3/utilities/nested_initializer_lists.h \
     $$PWD/core/cg3/utilities/pair.h \
+    $$PWD/core/cg3/utilities/parallel.h \
+    $$PWD/core/cg3/utilities/profiler.h \
+    $$PWD/core/cg3/utilities/random.h \
     $$PWD/core/cg3/utilities/set.h \
     $$PWD/core/cg3/utilities/string.h \
+    $$PWD/core/cg3/utilities/string_view.h \
     $$PWD/core/cg3/utilities/system.h \
+    $$PWD/core/cg3/utilities/thread_pool.h \
     $$PWD/core/cg3/utilities/timer.h \
     $$PWD/core/cg3/utilities/tokenizer.h \
     $$PWD/core/cg3/utilities/vector.h \
@@ -102,13 +122,22 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/core/cg3/utilities/color.tpp \
+    $$PWD/core/cg3/utilities/dynamic_bitset.tpp \
     $$PWD/core/cg3/utilities/eigen.tpp \
+    $$PWD/core/cg3/utilities/flat_hash_map.tpp \
+    $$PWD/core/cg3/utilities/graph_coloring.tpp \
     $$PWD/core/cg3/utilities/hash.tpp \
+    $$PWD/core/cg3/utilities/lazy_tokenizer.tpp \
     $$PWD/core/cg3/utilities/map.tpp \
     $$PWD/core/cg3/utilities/pair.tpp \
+    $$PWD/core/cg3/utilities/parallel.tpp \
+    $$PWD/core/cg3/utilities/profiler.tpp \
+    $$PWD/core/cg3/utilities/random.tpp \
     $$PWD/core/cg3/utilities/set.tpp \
     $$PWD/core/cg3/utilities/string.tpp \
+    $$PWD/core/cg3/utilities/string_view.tpp \
     $$PWD/core/cg3/utilities/system.tpp \
+    $$PWD/core/cg3/utilities/thread_pool.tpp \
     $$PWD/core/cg3/utilities/timer.tpp \
     $$PWD/core/cg3/utilities/tokenizer.tpp \
     $$PWD/core/cg3/utilities/vector.tpp \
@@ -45,8 +45,9 @@ bool checkSegmentIntersection2D(
         const bool ignoreEndPoints)
 {
     char code;
+    Point2Dd intersectionPoint;
 
-    cg3::checkSegmentIntersection2D(seg1, seg2, code);
+    cg3::checkSegmentIntersection2D(seg1, seg2, code, cg3::CG3_EPSILON, intersectionPoint);
 
     //Intersection found
     if (code == '1')
@@ -13,6 +13,7 @@
 
 #include "../../io/serialize.h"
 #include "../../utilities/hash.h"
+#include "../point_n.h"
 
 #ifdef _WIN32
 #undef min
@@ -30,6 +31,8 @@ namespace cg3 {
  * Specified types with T = int, float or double are already defined as Point2Di,
  * Point2Df and Point2Dd (Vec2).
  *
+ * The coordinates are stored in a PointN<T, 2>, to which the operators are forwarded.
+ *
  * @author Alessandro Muntoni
  */
 template <class T>
@@ -37,6 +40,7 @@ class Point2D : public SerializableObject
 {
 public:
     Point2D(T x = 0.0, T y = 0.0);
+    explicit Point2D(const PointN<T, 2>& p);
     #ifdef CG3_WITH_EIGEN
     Point2D(const Eigen::VectorXd &v);
     #endif
@@ -89,13 +93,19 @@ public:
     void deserialize(std::ifstream& binaryFile);
 
 private:
-    T xCoord, yCoord;
+    PointN<T, 2> coords;
     void rot(T matrix[][2]);
 };
 
 template <class T>
 std::ostream& operator<<(std::ostream& o, const Point2D<T>& p);
 
+template <class T, std::size_t A = internal::PointNAlignment<T, 2>::value>
+PointN<T, 2, A> toPointN(const Point2D<T>& p);
+
+template <class T, std::size_t A>
+Point2D<T> toPoint2D(const PointN<T, 2, A>& p);
+
 /****************
 * Other Methods *
 *****************/
@@ -19,8 +19,18 @@ namespace cg3 {
  */
 template <class T>
 inline Point2D<T>::Point2D(T x, T y):
-    xCoord(x),
-    yCoord(y)
+    coords(x, y)
+{
+}
+
+/**
+ * @brief Constructor, initializes the point with the coordinates of a PointN
+ *
+ * @param p
+ */
+template <class T>
+inline Point2D<T>::Point2D(const PointN<T, 2>& p):
+    coords(p)
 {
 }
 
@@ -31,7 +41,7 @@ inline Point2D<T>::Point2D(T x, T y):
  * @param v
  */
 template <class T>
-Point2D<T>::Point2D(const Eigen::VectorXd& v) : xCoord(v(0)), yCoord(v(1)){
+Point2D<T>::Point2D(const Eigen::VectorXd& v) : coords((T)v(0), (T)v(1)){
 }
 #endif
 
@@ -42,7 +52,7 @@ Point2D<T>::Point2D(const Eigen::VectorXd& v) : xCoord(v(0)), yCoord(v(1)){
 template <class T>
 inline const T& Point2D<T>::x() const
 {
-    return xCoord;
+    return coords.x();
 }
 
 /**
@@ -52,7 +62,7 @@ inline const T& Point2D<T>::x() const
 template <class T>
 inline const T& Point2D<T>::y() const
 {
-    return yCoord;
+    return coords.y();
 }
 
 /**
@@ -64,8 +74,7 @@ inline const T& Point2D<T>::y() const
 template <class T>
 inline double Point2D<T>::dist(const Point2D<T> &otherPoint) const
 {
-    return std::sqrt ( std::pow((xCoord - otherPoint.xCoord), 2) +
-                  std::pow((yCoord - otherPoint.yCoord), 2) );
+    return coords.dist(otherPoint.coords);
 }
 
 /**
@@ -76,8 +85,7 @@ inline double Point2D<T>::dist(const Point2D<T> &otherPoint) const
 template <class T>
 inline double Point2D<T>::dot(const Point2D<T> &otherVector) const
 {
-    return xCoord * otherVector.xCoord +
-           yCoord * otherVector.yCoord;
+    return coords.dot(otherVector.coords);
 }
 
 /**
@@ -88,8 +96,8 @@ inline double Point2D<T>::dot(const Point2D<T> &otherVector) const
 template <class T>
 inline double Point2D<T>::perpendicularDot(const Point2D<T>& otherVector) const
 {
-    return xCoord * otherVector.yCoord -
-           yCoord * otherVector.xCoord;
+    return x() * otherVector.y() -
+           y() * otherVector.x();
 }
 
 /**
@@ -99,7 +107,7 @@ inline double Point2D<T>::perpendicularDot(const Point2D<T>& otherVector) const
 template <class T>
 inline double Point2D<T>::getLength() const
 {
-    return std::sqrt( xCoord*xCoord + yCoord*yCoord );
+    return coords.getLength();
 }
 
 /**
@@ -109,7 +117,7 @@ inline double Point2D<T>::getLength() const
 template <class T>
 inline double Point2D<T>::getLengthSquared() const
 {
-    return xCoord*xCoord + yCoord*yCoord;
+    return coords.getLengthSquared();
 }
 
 /**
@@ -120,8 +128,7 @@ inline double Point2D<T>::getLengthSquared() const
 template <class T>
 inline Point2D<T> Point2D<T>::min(const Point2D<T> &otherPoint) const
 {
-    return Point2D<T>(std::min(x(), otherPoint.xCoord),
-                   std::min(y(), otherPoint.yCoord));
+    return Point2D<T>(coords.min(otherPoint.coords));
 }
 
 /**
@@ -132,8 +139,7 @@ inline Point2D<T> Point2D<T>::min(const Point2D<T> &otherPoint) const
 template <class T>
 inline Point2D<T> Point2D<T>::max(const Point2D<T> &otherPoint) const
 {
-    return Point2D<T>(std::max(x(), otherPoint.xCoord),
-                      std::max(y(), otherPoint.yCoord));
+    return Point2D<T>(coords.max(otherPoint.coords));
 }
 
 /**
@@ -144,12 +150,7 @@ inline Point2D<T> Point2D<T>::max(const Point2D<T> &otherPoint) const
 template <class T>
 const T& Point2D<T>::operator[](unsigned int i) const
 {
-    assert(i < 2);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 /**
@@ -160,12 +161,7 @@ const T& Point2D<T>::operator[](unsigned int i) const
 template <class T>
 const T&Point2D<T>::operator()(unsigned int i) const
 {
-    assert(i < 2);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 /**
@@ -176,9 +172,7 @@ const T&Point2D<T>::operator()(unsigned int i) const
 template <class T>
 inline bool Point2D<T>::operator == (const Point2D<T>& otherPoint) const
 {
-    if ( otherPoint.xCoord != xCoord )	return false;
-    if ( otherPoint.yCoord != yCoord )	return false;
-    return true;
+    return coords == otherPoint.coords;
 }
 
 /**
@@ -189,9 +183,7 @@ inline bool Point2D<T>::operator == (const Point2D<T>& otherPoint) const
 template <class T>
 inline bool Point2D<T>::operator != (const Point2D<T>& otherPoint) const
 {
-    if ( otherPoint.xCoord != xCoord )	return true;
-    if ( otherPoint.yCoord != yCoord )	return true;
-    return false;
+    return coords != otherPoint.coords;
 }
 
 /**
@@ -203,10 +195,7 @@ inline bool Point2D<T>::operator != (const Point2D<T>& otherPoint) const
 template <class T>
 inline bool Point2D<T>::operator < (const Point2D<T>& otherPoint) const
 {
-    if (this->xCoord < otherPoint.xCoord) return true;
-    if (this->xCoord > otherPoint.xCoord) return false;
-    if (this->yCoord < otherPoint.yCoord) return true;
-    return false;
+    return coords < otherPoint.coords;
 }
 
 /**
@@ -218,10 +207,7 @@ inline bool Point2D<T>::operator < (const Point2D<T>& otherPoint) const
 template <class T>
 inline bool Point2D<T>::operator >(const Point2D<T>& otherPoint) const
 {
-    if (this->xCoord < otherPoint.xCoord) return false;
-    if (this->xCoord > otherPoint.xCoord) return true;
-    if (this->yCoord > otherPoint.yCoord) return true;
-    return false;
+    return otherPoint.coords < coords;
 }
 
 /**
@@ -255,7 +241,7 @@ inline bool Point2D<T>::operator >=(const Point2D<T>& otherPoint) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator - () const
 {
-    return Point2D(-xCoord, -yCoord);
+    return Point2D(-coords);
 }
 
 /**
@@ -266,8 +252,7 @@ inline Point2D<T> Point2D<T>::operator - () const
 template <class T>
 Point2D<T> Point2D<T>::operator +(const T& scalar) const
 {
-    return Point2D<T>(xCoord + scalar,
-                      yCoord + scalar);
+    return Point2D<T>(coords + scalar);
 }
 
 /**
@@ -278,8 +263,7 @@ Point2D<T> Point2D<T>::operator +(const T& scalar) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator + (const Point2D<T>& otherPoint) const
 {
-    return Point2D(xCoord + otherPoint.xCoord,
-                    yCoord + otherPoint.yCoord);
+    return Point2D(coords + otherPoint.coords);
 }
 
 /**
@@ -290,8 +274,7 @@ inline Point2D<T> Point2D<T>::operator + (const Point2D<T>& otherPoint) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator - (const Point2D<T>& otherPoint) const
 {
-    return Point2D(xCoord - otherPoint.xCoord,
-                    yCoord - otherPoint.yCoord);
+    return Point2D(coords - otherPoint.coords);
 }
 
 /**
@@ -302,7 +285,7 @@ inline Point2D<T> Point2D<T>::operator - (const Point2D<T>& otherPoint) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator * (const T& scalar) const
 {
-    return Point2D(xCoord * scalar, yCoord * scalar);
+    return Point2D(coords * scalar);
 }
 
 /**
@@ -313,7 +296,7 @@ inline Point2D<T> Point2D<T>::operator * (const T& scalar) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator * (const Point2D<T>& otherPoint) const
 {
-    return Point2D(xCoord * otherPoint.xCoord, yCoord * otherPoint.yCoord);
+    return Point2D(coords * otherPoint.coords);
 }
 
 /**
@@ -324,7 +307,7 @@ inline Point2D<T> Point2D<T>::operator * (const Point2D<T>& otherPoint) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator / (const T& scalar) const
 {
-    return Point2D(xCoord / scalar, yCoord / scalar);
+    return Point2D(coords / scalar);
 }
 
 /**
@@ -335,7 +318,7 @@ inline Point2D<T> Point2D<T>::operator / (const T& scalar) const
 template <class T>
 inline Point2D<T> Point2D<T>::operator / (const Point2D<T>& otherPoint) const
 {
-    return Point2D(xCoord / otherPoint.xCoord, yCoord / otherPoint.yCoord);
+    return Point2D(coords / otherPoint.coords);
 }
 
 /**
@@ -345,7 +328,7 @@ inline Point2D<T> Point2D<T>::operator / (const Point2D<T>& otherPoint) const
 template<class T>
 T&Point2D<T>::x()
 {
-    return xCoord;
+    return coords.x();
 }
 
 /**
@@ -355,7 +338,7 @@ T&Point2D<T>::x()
 template<class T>
 T&Point2D<T>::y()
 {
-    return yCoord;
+    return coords.y();
 }
 
 /**
@@ -366,7 +349,7 @@ T&Point2D<T>::y()
 template <class T>
 inline void Point2D<T>::setXCoord(const T& x)
 {
-    xCoord = x;
+    coords.x() = x;
 }
 
 /**
@@ -377,7 +360,7 @@ inline void Point2D<T>::setXCoord(const T& x)
 template <class T>
 inline void Point2D<T>::setYCoord(const T& y)
 {
-    yCoord = y;
+    coords.y() = y;
 }
 
 /**
@@ -389,8 +372,7 @@ inline void Point2D<T>::setYCoord(const T& y)
 template <class T>
 inline void Point2D<T>::set(const T& x, const T& y)
 {
-    xCoord = x;
-    yCoord = y;
+    coords = PointN<T, 2>(x, y);
 }
 
 /**
@@ -401,10 +383,7 @@ inline void Point2D<T>::set(const T& x, const T& y)
 template <class T>
 inline double Point2D<T>::normalize()
 {
-    double len = getLength();
-    xCoord /= len;
-    yCoord /= len;
-    return len;
+    return coords.normalize();
 }
 
 /**
@@ -430,12 +409,7 @@ inline void Point2D<T>::rotate(T matrix[][2], const Point2D<T>& centroid)
 template <class T>
 T& Point2D<T>::operator[](unsigned int i)
 {
-    assert(i < 2);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 /**
@@ -446,12 +420,7 @@ T& Point2D<T>::operator[](unsigned int i)
 template <class T>
 T& Point2D<T>::operator()(unsigned int i)
 {
-    assert(i < 2);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 /**
@@ -464,8 +433,7 @@ T& Point2D<T>::operator()(unsigned int i)
 template <class T>
 inline Point2D<T> Point2D<T>::operator += (const Point2D<T>& otherPoint)
 {
-    xCoord += otherPoint.xCoord;
-    yCoord += otherPoint.yCoord;
+    coords += otherPoint.coords;
     return *this;
 }
 
@@ -479,8 +447,7 @@ inline Point2D<T> Point2D<T>::operator += (const Point2D<T>& otherPoint)
 template <class T>
 inline Point2D<T> Point2D<T>::operator -= (const Point2D<T>& otherPoint)
 {
-    xCoord -= otherPoint.xCoord;
-    yCoord -= otherPoint.yCoord;
+    coords -= otherPoint.coords;
     return *this;
 }
 
@@ -494,8 +461,7 @@ inline Point2D<T> Point2D<T>::operator -= (const Point2D<T>& otherPoint)
 template <class T>
 inline Point2D<T> Point2D<T>::operator *= (const T& scalar)
 {
-    xCoord *= scalar;
-    yCoord *= scalar;
+    coords *= scalar;
     return *this;
 }
 
@@ -509,8 +475,7 @@ inline Point2D<T> Point2D<T>::operator *= (const T& scalar)
 template <class T>
 inline Point2D<T> Point2D<T>::operator *= (const Point2D<T>& otherPoint)
 {
-    xCoord *= otherPoint.xCoord;
-    yCoord *= otherPoint.yCoord;
+    coords *= otherPoint.coords;
     return *this;
 }
 
@@ -524,8 +489,7 @@ inline Point2D<T> Point2D<T>::operator *= (const Point2D<T>& otherPoint)
 template <class T>
 inline Point2D<T> Point2D<T>::operator /= (const T& scalar)
 {
-    xCoord /= scalar;
-    yCoord /= scalar;
+    coords /= scalar;
     return *this;
 }
 
@@ -539,8 +503,7 @@ inline Point2D<T> Point2D<T>::operator /= (const T& scalar)
 template <class T>
 inline Point2D<T> Point2D<T>::operator /= (const Point2D<T>& otherPoint)
 {
-    xCoord /= otherPoint.xCoord;
-    yCoord /= otherPoint.yCoord;
+    coords /= otherPoint.coords;
     return *this;
 }
 
@@ -552,10 +515,9 @@ template <class T>
 inline void Point2D<T>::rot(T matrix[][2])
 {
     Point2D<T> p;
-    p.setXCoord(matrix[0][0]*xCoord + matrix[0][1]*yCoord);
-    p.setYCoord(matrix[1][0]*xCoord + matrix[1][1]*yCoord);
-    xCoord = p.x();
-    yCoord = p.y();
+    p.setXCoord(matrix[0][0]*x() + matrix[0][1]*y());
+    p.setYCoord(matrix[1][0]*x() + matrix[1][1]*y());
+    coords = p.coords;
 }
 
 /**
@@ -567,7 +529,7 @@ inline void Point2D<T>::rot(T matrix[][2])
 template<class T>
 void Point2D<T>::serialize(std::ofstream& binaryFile) const
 {
-    serializeObjectAttributes("cg3Point2D", binaryFile, xCoord, yCoord);
+    serializeObjectAttributes("cg3Point2D", binaryFile, coords.x(), coords.y());
 }
 
 /**
@@ -579,7 +541,7 @@ void Point2D<T>::serialize(std::ofstream& binaryFile) const
 template<class T>
 void Point2D<T>::deserialize(std::ifstream& binaryFile)
 {
-    deserializeObjectAttributes("cg3Point2D", binaryFile, xCoord, yCoord);
+    deserializeObjectAttributes("cg3Point2D", binaryFile, coords.x(), coords.y());
 }
 
 /**
@@ -596,6 +558,26 @@ std::ostream& operator<<(std::ostream& o, const Point2D<T>& p)
 }
 
 
+/**
+ * @ingroup cg3core
+ * @brief Converts a Point2D to a 2D PointN.
+ */
+template <class T, std::size_t A>
+inline PointN<T, 2, A> toPointN(const Point2D<T>& p)
+{
+    return PointN<T, 2, A>(p.x(), p.y());
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Converts a 2D PointN to a Point2D.
+ */
+template <class T, std::size_t A>
+inline Point2D<T> toPoint2D(const PointN<T, 2, A>& p)
+{
+    return Point2D<T>(p.x(), p.y());
+}
+
 /**
  * @brief operator *
  * multiplies a scalar with a point
@@ -651,7 +633,5 @@ inline double area(const Point2D<T>& p0, const Point2D<T>& p1, const Point2D<T>&
 template<typename T>
 inline std::size_t std::hash<cg3::Point2D<T> >::operator()(const cg3::Point2D<T> &k) const
 {
-    std::size_t h=0;
-    cg3::hashCombine(h, k.x(), k.y());
-    return h;
+    return cg3::hashScalars(k.x(), k.y());
 }
@@ -98,7 +98,7 @@ inline void sortTriangle2DPointsAndReorderCounterClockwise(
  * @return True if the triangles have an overlap.
  */
 template<class T>
-bool triangleOverlap(
+bool areTriangleOverlapping(
         const cg3::Triangle<Point2D<T>>& t1, const cg3::Triangle<Point2D<T>>& t2)
 {
     //TODO more efficient with left/right turns
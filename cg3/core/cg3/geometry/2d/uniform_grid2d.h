@@ -0,0 +1,105 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_UNIFORM_GRID2D_H
+#define CG3_UNIFORM_GRID2D_H
+
+#include <utility>
+#include <vector>
+
+#include "bounding_box2d.h"
+#include "segment2d.h"
+#include "triangle2d.h"
+#include "../../utilities/parallel.h"
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The UniformGrid2D class is a broad phase for collections of 2D
+ * primitives: it bins the bounding boxes of the primitives in the cells of a
+ * uniform grid, and reports the pairs of boxes that overlap without testing
+ * all the O(n^2) pairs.
+ *
+ * Cells are stored in compressed sparse row format (the boxes of a cell are
+ * contiguous in memory), and the grid is built in parallel. Every pair of
+ * overlapping boxes is reported only by the cell that contains the minimum
+ * corner of their intersection, so candidate pairs are unique without any
+ * global deduplication, and cells can be processed in parallel.
+ *
+ * If the cell size is not given, it is chosen such that a cell is about as
+ * large as the average box, and that there are about as many cells as boxes.
+ *
+ * \code{.cpp}
+ * std::vector<cg3::BoundingBox2D> boxes = ...;
+ * cg3::UniformGrid2D grid(boxes);
+ * for (const std::pair<unsigned int, unsigned int>& p : grid.overlappingPairs())
+ *     ...
+ * \endcode
+ *
+ * See also overlappingBoxPairs2D, intersectingSegmentPairs2D and
+ * overlappingTrianglePairs2D, which run the exact tests on the candidate
+ * pairs.
+ */
+class UniformGrid2D
+{
+public:
+    UniformGrid2D();
+    explicit UniformGrid2D(
+            const std::vector<BoundingBox2D>& boxes,
+            double cellSize = 0,
+            const ParallelOptions& options = ParallelOptions());
+
+    void build(
+            const std::vector<BoundingBox2D>& boxes,
+            double cellSize = 0,
+            const ParallelOptions& options = ParallelOptions());
+
+    unsigned int numberBoxes() const;
+    unsigned int resolutionX() const;
+    unsigned int resolutionY() const;
+    double cellSize() const;
+
+    std::vector<std::pair<unsigned int, unsigned int>> overlappingPairs(
+            const ParallelOptions& options = ParallelOptions()) const;
+
+    template <class OutputIterator>
+    void query(const BoundingBox2D& box, OutputIterator out) const;
+
+protected:
+    unsigned int cellX(double x) const;
+    unsigned int cellY(double y) const;
+    static bool overlap(const BoundingBox2D& b1, const BoundingBox2D& b2);
+
+    std::vector<BoundingBox2D> boxes;
+    Point2Dd origin;
+    double size;
+    unsigned int resX, resY;
+
+    /* boxes of the cell c: cellBoxes[cellOffsets[c]], ..., cellBoxes[cellOffsets[c+1]-1] */
+    std::vector<size_t> cellOffsets;
+    std::vector<unsigned int> cellBoxes;
+};
+
+std::vector<std::pair<unsigned int, unsigned int>> overlappingBoxPairs2D(
+        const std::vector<BoundingBox2D>& boxes,
+        const ParallelOptions& options = ParallelOptions());
+
+std::vector<std::pair<unsigned int, unsigned int>> intersectingSegmentPairs2D(
+        const std::vector<Segment2Dd>& segments,
+        bool ignoreEndPoints = false,
+        const ParallelOptions& options = ParallelOptions());
+
+std::vector<std::pair<unsigned int, unsigned int>> overlappingTrianglePairs2D(
+        const std::vector<Triangle2Dd>& triangles,
+        const ParallelOptions& options = ParallelOptions());
+
+} //namespace cg3
+
+#include "uniform_grid2d.tpp"
+
+#endif // CG3_UNIFORM_GRID2D_H
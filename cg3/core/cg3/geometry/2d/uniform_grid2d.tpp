@@ -0,0 +1,336 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "uniform_grid2d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include "intersections2d.h"
+#include "triangle2d_utils.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/* maximum number of cells of a UniformGrid2D, per box */
+const double UNIFORM_GRID2D_CELLS_PER_BOX = 4;
+
+/**
+ * @brief Keeps the candidate pairs for which test(first, second) is true,
+ * running the tests in parallel.
+ */
+template <class Test>
+std::vector<std::pair<unsigned int, unsigned int>> filterPairs2D(
+        std::vector<std::pair<unsigned int, unsigned int>> candidates,
+        Test test,
+        const ParallelOptions& options)
+{
+    std::vector<char> keep(candidates.size());
+    parallelFor((size_t)0, candidates.size(), [&](size_t i) {
+        keep[i] = test(candidates[i].first, candidates[i].second);
+    }, options);
+    size_t k = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (keep[i])
+            candidates[k++] = candidates[i];
+    candidates.resize(k);
+    return candidates;
+}
+
+} //namespace cg3::internal
+
+inline UniformGrid2D::UniformGrid2D() :
+    size(0),
+    resX(0),
+    resY(0),
+    cellOffsets(1, 0)
+{
+}
+
+/**
+ * @brief UniformGrid2D::UniformGrid2D
+ * Builds the grid of the given boxes.
+ * @param boxes
+ * @param cellSize: size of the cells; if it is not positive, it is chosen
+ * automatically
+ * @param options
+ */
+inline UniformGrid2D::UniformGrid2D(
+        const std::vector<BoundingBox2D>& boxes,
+        double cellSize,
+        const ParallelOptions& options) :
+    UniformGrid2D()
+{
+    build(boxes, cellSize, options);
+}
+
+/**
+ * @brief UniformGrid2D::build
+ * Builds the grid of the given boxes, replacing the previous ones.
+ *
+ * The number of cells is bounded to a few cells per box: if cellSize is too
+ * small, it is doubled until the bound holds. Every box is binned in all the
+ * cells it overlaps; the (cell, box) entries are generated and sorted in
+ * parallel.
+ * @param boxes
+ * @param cellSize: size of the cells; if it is not positive, it is chosen
+ * automatically
+ * @param options
+ */
+inline void UniformGrid2D::build(
+        const std::vector<BoundingBox2D>& boxes,
+        double cellSize,
+        const ParallelOptions& options)
+{
+    this->boxes = boxes;
+    unsigned int n = (unsigned int)boxes.size();
+    cellOffsets.assign(1, 0);
+    cellBoxes.clear();
+    resX = resY = 0;
+    size = 0;
+    if (n == 0)
+        return;
+
+    BoundingBox2D bb = parallelReduce(0u, n, BoundingBox2D(), [&](unsigned int i) {
+        return boxes[i];
+    }, [](const BoundingBox2D& b1, const BoundingBox2D& b2) {
+        return BoundingBox2D(b1.min().min(b2.min()), b1.max().max(b2.max()));
+    }, options);
+    origin = bb.min();
+    double lx = bb.lengthX(), ly = bb.lengthY();
+    if (cellSize <= 0) {
+        double avg = parallelReduce(0u, n, 0.0, [&](unsigned int i) {
+            return std::max(boxes[i].lengthX(), boxes[i].lengthY());
+        }, std::plus<double>(), options) / n;
+        cellSize = std::max(avg, std::sqrt(lx * ly / n));
+    }
+    if (!(cellSize > 0))
+        cellSize = std::max(std::max(lx, ly), 1.0);
+    double maxCells = internal::UNIFORM_GRID2D_CELLS_PER_BOX * n + 16;
+    while ((std::floor(lx / cellSize) + 1) * (std::floor(ly / cellSize) + 1) > maxCells)
+        cellSize *= 2;
+    size = cellSize;
+    resX = (unsigned int)std::floor(lx / size) + 1;
+    resY = (unsigned int)std::floor(ly / size) + 1;
+    unsigned int nCells = resX * resY;
+
+    //(cell, box) entries, sorted by cell and then by box; a box can cover
+    //many cells, so the number of entries may not fit an unsigned int
+    std::vector<size_t> counts(n), offsets(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        counts[i] = (size_t)(cellX(boxes[i].max().x()) - cellX(boxes[i].min().x()) + 1) *
+                    (cellY(boxes[i].max().y()) - cellY(boxes[i].min().y()) + 1);
+    }, options);
+    size_t total = parallelExclusiveScan(counts.begin(), counts.end(), offsets.begin(), (size_t)0);
+    std::vector<uint64_t> entries(total);
+    parallelFor(0u, n, [&](unsigned int i) {
+        size_t k = offsets[i];
+        for (unsigned int y = cellY(boxes[i].min().y()); y <= cellY(boxes[i].max().y()); y++)
+            for (unsigned int x = cellX(boxes[i].min().x()); x <= cellX(boxes[i].max().x()); x++)
+                entries[k++] = ((uint64_t)(y * resX + x) << 32) | i;
+    }, options);
+    parallelSort(entries.begin(), entries.end(), std::less<uint64_t>(), options);
+
+    cellBoxes.resize(total);
+    cellOffsets.resize(nCells + 1);
+    parallelFor((size_t)0, total, [&](size_t k) {
+        //the first entry of a cell sets the offsets of the empty cells before it
+        unsigned int c = (unsigned int)(entries[k] >> 32);
+        unsigned int first = k == 0 ? 0 : (unsigned int)(entries[k-1] >> 32) + 1;
+        for (unsigned int cc = first; cc <= c; cc++)
+            cellOffsets[cc] = k;
+        cellBoxes[k] = (unsigned int)entries[k];
+    }, options);
+    for (unsigned int cc = (unsigned int)(entries[total-1] >> 32) + 1; cc <= nCells; cc++)
+        cellOffsets[cc] = total;
+}
+
+inline unsigned int UniformGrid2D::numberBoxes() const
+{
+    return (unsigned int)boxes.size();
+}
+
+inline unsigned int UniformGrid2D::resolutionX() const
+{
+    return resX;
+}
+
+inline unsigned int UniformGrid2D::resolutionY() const
+{
+    return resY;
+}
+
+inline double UniformGrid2D::cellSize() const
+{
+    return size;
+}
+
+/**
+ * @brief UniformGrid2D::overlappingPairs
+ * Computes in parallel the pairs of overlapping boxes (borders included).
+ * @return the pairs (i, j), with i < j, of the indices of the overlapping
+ * boxes, sorted
+ */
+inline std::vector<std::pair<unsigned int, unsigned int>> UniformGrid2D::overlappingPairs(
+        const ParallelOptions& options) const
+{
+    typedef std::pair<unsigned int, unsigned int> Pair;
+    const unsigned int grain = 256;
+    unsigned int nCells = resX * resY;
+    unsigned int nChunks = (nCells + grain - 1) / grain;
+    std::vector<std::vector<Pair>> chunkPairs(nChunks);
+    parallelFor(0u, nChunks, [&](unsigned int chunk) {
+        unsigned int end = std::min(nCells, (chunk + 1) * grain);
+        for (unsigned int c = chunk * grain; c < end; c++) {
+            unsigned int cx = c % resX, cy = c / resX;
+            for (size_t i = cellOffsets[c]; i < cellOffsets[c+1]; i++) {
+                const BoundingBox2D& bi = boxes[cellBoxes[i]];
+                for (size_t j = i + 1; j < cellOffsets[c+1]; j++) {
+                    const BoundingBox2D& bj = boxes[cellBoxes[j]];
+                    //the pair is reported by the cell of the min corner of the intersection
+                    if (overlap(bi, bj) &&
+                            cellX(std::max(bi.min().x(), bj.min().x())) == cx &&
+                            cellY(std::max(bi.min().y(), bj.min().y())) == cy)
+                        chunkPairs[chunk].push_back(Pair(cellBoxes[i], cellBoxes[j]));
+                }
+            }
+        }
+    }, ParallelOptions(options.nThreads, 1));
+
+    std::vector<size_t> sizes(nChunks), offsets(nChunks);
+    for (unsigned int chunk = 0; chunk < nChunks; chunk++)
+        sizes[chunk] = chunkPairs[chunk].size();
+    size_t total = parallelExclusiveScan(sizes.begin(), sizes.end(), offsets.begin(), (size_t)0);
+    std::vector<Pair> pairs(total);
+    parallelFor(0u, nChunks, [&](unsigned int chunk) {
+        std::copy(chunkPairs[chunk].begin(), chunkPairs[chunk].end(), pairs.begin() + offsets[chunk]);
+    }, options);
+    parallelSort(pairs.begin(), pairs.end(), std::less<Pair>(), options);
+    return pairs;
+}
+
+/**
+ * @brief UniformGrid2D::query
+ * Assigns to out the indices of the boxes that overlap box (borders
+ * included), each one once.
+ */
+template <class OutputIterator>
+void UniformGrid2D::query(const BoundingBox2D& box, OutputIterator out) const
+{
+    if (boxes.empty())
+        return;
+    unsigned int x0 = cellX(box.min().x()), x1 = cellX(box.max().x());
+    unsigned int y0 = cellY(box.min().y()), y1 = cellY(box.max().y());
+    for (unsigned int y = y0; y <= y1; y++) {
+        for (unsigned int x = x0; x <= x1; x++) {
+            unsigned int c = y * resX + x;
+            for (size_t i = cellOffsets[c]; i < cellOffsets[c+1]; i++) {
+                const BoundingBox2D& b = boxes[cellBoxes[i]];
+                if (overlap(box, b) &&
+                        std::max(x0, cellX(b.min().x())) == x &&
+                        std::max(y0, cellY(b.min().y())) == y)
+                    *out++ = cellBoxes[i];
+            }
+        }
+    }
+}
+
+/**
+ * @brief UniformGrid2D::cellX
+ * @return the column of the cells containing the abscissa x, clamped to the
+ * grid
+ */
+inline unsigned int UniformGrid2D::cellX(double x) const
+{
+    double c = std::floor((x - origin.x()) / size);
+    return c <= 0 ? 0 : c >= resX - 1 ? resX - 1 : (unsigned int)c;
+}
+
+/**
+ * @brief UniformGrid2D::cellY
+ * @return the row of the cells containing the ordinate y, clamped to the grid
+ */
+inline unsigned int UniformGrid2D::cellY(double y) const
+{
+    double c = std::floor((y - origin.y()) / size);
+    return c <= 0 ? 0 : c >= resY - 1 ? resY - 1 : (unsigned int)c;
+}
+
+inline bool UniformGrid2D::overlap(const BoundingBox2D& b1, const BoundingBox2D& b2)
+{
+    return b1.min().x() <= b2.max().x() && b2.min().x() <= b1.max().x() &&
+           b1.min().y() <= b2.max().y() && b2.min().y() <= b1.max().y();
+}
+
+/**
+ * @ingroup cg3core
+ * @brief overlappingBoxPairs2D
+ * @return the pairs (i, j), with i < j, of the overlapping boxes (borders
+ * included), sorted; computed with a UniformGrid2D
+ */
+inline std::vector<std::pair<unsigned int, unsigned int>> overlappingBoxPairs2D(
+        const std::vector<BoundingBox2D>& boxes,
+        const ParallelOptions& options)
+{
+    UniformGrid2D grid(boxes, 0, options);
+    return grid.overlappingPairs(options);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief intersectingSegmentPairs2D
+ * Finds all the pairs of intersecting segments: the candidate pairs are the
+ * ones with overlapping bounding boxes, found with a UniformGrid2D, and they
+ * are tested in parallel with checkSegmentIntersection2D.
+ * @param segments
+ * @param ignoreEndPoints: passed to checkSegmentIntersection2D
+ * @param options
+ * @return the pairs (i, j), with i < j, of the intersecting segments, sorted
+ */
+inline std::vector<std::pair<unsigned int, unsigned int>> intersectingSegmentPairs2D(
+        const std::vector<Segment2Dd>& segments,
+        bool ignoreEndPoints,
+        const ParallelOptions& options)
+{
+    std::vector<BoundingBox2D> boxes(segments.size());
+    parallelFor((size_t)0, segments.size(), [&](size_t i) {
+        const Segment2Dd& s = segments[i];
+        boxes[i] = BoundingBox2D(s.getP1().min(s.getP2()), s.getP1().max(s.getP2()));
+    }, options);
+    return internal::filterPairs2D(overlappingBoxPairs2D(boxes, options), [&](unsigned int i, unsigned int j) {
+        return checkSegmentIntersection2D(segments[i], segments[j], ignoreEndPoints);
+    }, options);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief overlappingTrianglePairs2D
+ * Finds all the pairs of overlapping triangles: the candidate pairs are the
+ * ones with overlapping bounding boxes, found with a UniformGrid2D, and they
+ * are tested in parallel with areTriangleOverlapping.
+ * @param triangles
+ * @param options
+ * @return the pairs (i, j), with i < j, of the overlapping triangles, sorted
+ */
+inline std::vector<std::pair<unsigned int, unsigned int>> overlappingTrianglePairs2D(
+        const std::vector<Triangle2Dd>& triangles,
+        const ParallelOptions& options)
+{
+    std::vector<BoundingBox2D> boxes(triangles.size());
+    parallelFor((size_t)0, triangles.size(), [&](size_t i) {
+        const Triangle2Dd& t = triangles[i];
+        boxes[i] = BoundingBox2D(t.v1().min(t.v2()).min(t.v3()), t.v1().max(t.v2()).max(t.v3()));
+    }, options);
+    return internal::filterPairs2D(overlappingBoxPairs2D(boxes, options), [&](unsigned int i, unsigned int j) {
+        return areTriangleOverlapping(triangles[i], triangles[j]);
+    }, options);
+}
+
+} //namespace cg3
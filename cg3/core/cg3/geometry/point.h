@@ -12,6 +12,7 @@
 
 #include "../io/serialize.h"
 #include "../utilities/hash.h"
+#include "point_n.h"
 
 #ifdef CG3_CINOLIB_DEFINED
 #ifdef __GNUC__
@@ -41,6 +42,8 @@ namespace cg3 {
  * using the specified types Pointi, Pointf and Pointd.
  * There is also the type Vec3, that is a Pointd, which is a simple sinctactic sugar in order to
  * distinguish between points on a 3D space and vectors.
+ *
+ * The coordinates are stored in a PointN<T, 3>, to which the operators are forwarded.
  */
 template <class T>
 class Point : public SerializableObject
@@ -48,6 +51,7 @@ class Point : public SerializableObject
 public:
 
     Point(T xCoord = 0.0, T yCoord = 0.0, T zCoord = 0.0);
+    explicit Point(const PointN<T, 3>& p);
     #ifdef CG3_WITH_EIGEN
     Point(const Eigen::VectorXd &v);
     #endif
@@ -111,9 +115,7 @@ public:
     Point<T> operator /= (const Point<T>& otherPoint);
 
 protected:
-    T xCoord;
-    T yCoord;
-    T zCoord;
+    PointN<T, 3> coords;
 };
 
 /****************
@@ -134,6 +136,12 @@ Point<T> mul(const Eigen::Matrix3d &m, const Point<T>& point);
 template <class T>
 std::ostream& operator<< (std::ostream& inputStream, const Point<T>& p);
 
+template <class T, std::size_t A = internal::PointNAlignment<T, 3>::value>
+PointN<T, 3, A> toPointN(const Point<T>& p);
+
+template <class T, std::size_t A>
+Point<T> toPoint(const PointN<T, 3, A>& p);
+
 template <class T>
 std::string to_string(const Point<T>& p);
 
@@ -24,18 +24,23 @@ namespace cg3 {
  */
 template <class T>
 inline Point<T>::Point(T x, T y, T z) :
-    xCoord(x),
-    yCoord(y),
-    zCoord(z)
+    coords(x, y, z)
+{
+}
+
+/**
+ * @brief Constructor, initializes the point with the coordinates of a PointN
+ */
+template <class T>
+inline Point<T>::Point(const PointN<T, 3>& p) :
+    coords(p)
 {
 }
 
 #ifdef  CG3_WITH_EIGEN
 template <class T>
 Point<T>::Point(const Eigen::VectorXd& v) :
-    xCoord(v(0)),
-    yCoord(v(1)),
-    zCoord(v(2))
+    coords((T)v(0), (T)v(1), (T)v(2))
 {
 }
 #endif
@@ -43,9 +48,7 @@ Point<T>::Point(const Eigen::VectorXd& v) :
 #ifdef CG3_CINOLIB_DEFINED
 template <class T>
 Point<T>::Point(const cinolib::vec3<T>& v) :
-    xCoord(v.x()),
-    yCoord(v.y()),
-    zCoord(v.z())
+    coords(v.x(), v.y(), v.z())
 {
 }
 #endif
@@ -62,7 +65,7 @@ Point<T>::Point(const cinolib::vec3<T>& v) :
 template <class T>
 inline const T& Point<T>::x() const
 {
-    return this->xCoord;
+    return coords.x();
 }
 
 /**
@@ -72,7 +75,7 @@ inline const T& Point<T>::x() const
 template <class T>
 inline const T& Point<T>::y() const
 {
-    return this->yCoord;
+    return coords.y();
 }
 
 /**
@@ -82,7 +85,7 @@ inline const T& Point<T>::y() const
 template <class T>
 inline const T& Point<T>::z() const
 {
-    return this->zCoord;
+    return coords.z();
 }
 
 /**
@@ -93,9 +96,7 @@ inline const T& Point<T>::z() const
 template <class T>
 inline double Point<T>::dist(const Point<T>& otherPoint) const
 {
-    return sqrt ( std::pow((xCoord - otherPoint.xCoord), 2) +
-                  std::pow((yCoord - otherPoint.yCoord), 2) +
-                  std::pow((zCoord - otherPoint.zCoord), 2) );
+    return coords.dist(otherPoint.coords);
 }
 
 /**
@@ -106,9 +107,7 @@ inline double Point<T>::dist(const Point<T>& otherPoint) const
 template <class T>
 inline double Point<T>::dot(const Point<T>& otherVector) const
 {
-    return xCoord * otherVector.xCoord +
-           yCoord * otherVector.yCoord +
-           zCoord * otherVector.zCoord;
+    return coords.dot(otherVector.coords);
 }
 
 /**
@@ -119,9 +118,7 @@ inline double Point<T>::dot(const Point<T>& otherVector) const
 template <class T>
 inline Point<T> Point<T>::cross(const Point<T>& otherVector) const
 {
-    return Point<T>(yCoord * otherVector.zCoord - zCoord * otherVector.yCoord,
-                 zCoord * otherVector.xCoord - xCoord * otherVector.zCoord,
-                 xCoord * otherVector.yCoord - yCoord * otherVector.xCoord);
+    return Point<T>(coords.cross(otherVector.coords));
 }
 
 /**
@@ -131,7 +128,7 @@ inline Point<T> Point<T>::cross(const Point<T>& otherVector) const
 template <class T>
 inline double Point<T>::getLength() const
 {
-    return sqrt( xCoord*xCoord + yCoord*yCoord + zCoord*zCoord );
+    return coords.getLength();
 }
 
 /**
@@ -142,7 +139,7 @@ inline double Point<T>::getLength() const
 template <class T>
 inline double Point<T>::getLengthSquared() const
 {
-    return xCoord * xCoord + yCoord * yCoord + zCoord * zCoord;
+    return coords.getLengthSquared();
 }
 
 /**
@@ -159,9 +156,7 @@ inline double Point<T>::getLengthSquared() const
 template <class T>
 inline Point<T> Point<T>::min(const Point<T>& otherPoint) const
 {
-    return Point<T>(std::min(x(), otherPoint.x()),
-                    std::min(y(), otherPoint.y()),
-                    std::min(z(), otherPoint.z()));
+    return Point<T>(coords.min(otherPoint.coords));
 }
 
 /**
@@ -178,33 +173,19 @@ inline Point<T> Point<T>::min(const Point<T>& otherPoint) const
 template <class T>
 inline Point<T> Point<T>::max(const Point<T>& otherPoint) const
 {
-    return Point<T>(std::max(x(), otherPoint.x()),
-                    std::max(y(), otherPoint.y()),
-                    std::max(z(), otherPoint.z()));
+    return Point<T>(coords.max(otherPoint.coords));
 }
 
 template <class T>
 inline const T& Point<T>::operator[](unsigned int i) const
 {
-    assert(i < 3);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-        case 2: return zCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 template <class T>
 inline const T& Point<T>::operator()(unsigned int i) const
 {
-    assert(i < 3);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-        case 2: return zCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 /**
@@ -219,10 +200,7 @@ inline const T& Point<T>::operator()(unsigned int i) const
 template <class T>
 inline bool Point<T>::operator == (const Point<T>& otherPoint) const
 {
-    if ( otherPoint.xCoord != xCoord )	return false;
-    if ( otherPoint.yCoord != yCoord )	return false;
-    if ( otherPoint.zCoord != zCoord )	return false;
-    return true;
+    return coords == otherPoint.coords;
 }
 
 /**
@@ -237,10 +215,7 @@ inline bool Point<T>::operator == (const Point<T>& otherPoint) const
 template <class T>
 inline bool Point<T>::operator != (const Point<T>& otherPoint) const
 {
-    if ( otherPoint.xCoord != xCoord )	return true;
-    if ( otherPoint.yCoord != yCoord )	return true;
-    if ( otherPoint.zCoord != zCoord )	return true;
-    return false;
+    return coords != otherPoint.coords;
 }
 
 /**
@@ -257,12 +232,7 @@ inline bool Point<T>::operator != (const Point<T>& otherPoint) const
 template <class T>
 inline bool Point<T>::operator < (const Point<T>& otherPoint) const
 {
-    if (this->xCoord < otherPoint.xCoord) return true;
-    if (this->xCoord > otherPoint.xCoord) return false;
-    if (this->yCoord < otherPoint.yCoord) return true;
-    if (this->yCoord > otherPoint.yCoord) return false;
-    if (this->zCoord < otherPoint.zCoord) return true;
-    return false;
+    return coords < otherPoint.coords;
 }
 
 /**
@@ -273,15 +243,13 @@ inline bool Point<T>::operator < (const Point<T>& otherPoint) const
 template <class T>
 inline Point<T> Point<T>::operator - () const
 {
-    return Point<T>(-xCoord, -yCoord, -zCoord);
+    return Point<T>(-coords);
 }
 
 template <class T>
 inline Point<T> Point<T>::operator +(const T& scalar) const
 {
-    return Point<T>(xCoord + scalar,
-                    yCoord + scalar,
-                    zCoord + scalar);
+    return Point<T>(coords + scalar);
 }
 
 /**
@@ -293,17 +261,13 @@ inline Point<T> Point<T>::operator +(const T& scalar) const
 template <class T>
 inline Point<T> Point<T>::operator + (const Point<T>& otherPoint) const
 {
-    return Point<T>(xCoord + otherPoint.xCoord,
-                    yCoord + otherPoint.yCoord,
-                    zCoord + otherPoint.zCoord);
+    return Point<T>(coords + otherPoint.coords);
 }
 
 template <class T>
 inline Point<T> Point<T>::operator -(const T& scalar) const
 {
-    return Point<T>(xCoord - scalar,
-                    yCoord - scalar,
-                    zCoord - scalar);
+    return Point<T>(coords - scalar);
 }
 
 /**
@@ -315,9 +279,7 @@ inline Point<T> Point<T>::operator -(const T& scalar) const
 template <class T>
 inline Point<T> Point<T>::operator - (const Point<T>& otherPoint) const
 {
-    return Point<T>(xCoord - otherPoint.xCoord,
-                    yCoord - otherPoint.yCoord,
-                    zCoord - otherPoint.zCoord);
+    return Point<T>(coords - otherPoint.coords);
 }
 
 /**
@@ -329,7 +291,7 @@ inline Point<T> Point<T>::operator - (const Point<T>& otherPoint) const
 template <class T>
 inline Point<T> Point<T>::operator * (const T& scalar) const
 {
-    return Point<T>(xCoord * scalar, yCoord * scalar, zCoord * scalar);
+    return Point<T>(coords * scalar);
 }
 
 /**
@@ -341,7 +303,7 @@ inline Point<T> Point<T>::operator * (const T& scalar) const
 template <class T>
 inline Point<T> Point<T>::operator * (const Point<T>& otherPoint) const
 {
-    return Point<T>(xCoord * otherPoint.xCoord, yCoord * otherPoint.yCoord, zCoord * otherPoint.zCoord);
+    return Point<T>(coords * otherPoint.coords);
 }
 
 /**
@@ -353,7 +315,7 @@ inline Point<T> Point<T>::operator * (const Point<T>& otherPoint) const
 template <class T>
 inline Point<T> Point<T>::operator / (const T& scalar) const
 {
-    return Point<T>(xCoord / scalar, yCoord / scalar, zCoord / scalar);
+    return Point<T>(coords / scalar);
 }
 
 /**
@@ -365,7 +327,7 @@ inline Point<T> Point<T>::operator / (const T& scalar) const
 template <class T>
 inline Point<T> Point<T>::operator / (const Point<T>& otherPoint) const
 {
-    return Point<T>(xCoord / otherPoint.xCoord, yCoord / otherPoint.yCoord, zCoord / otherPoint.zCoord);
+    return Point<T>(coords / otherPoint.coords);
 }
 
 /**
@@ -375,7 +337,7 @@ inline Point<T> Point<T>::operator / (const Point<T>& otherPoint) const
 template <class T>
 inline T& Point<T>::x()
 {
-    return this->xCoord;
+    return coords.x();
 }
 
 /**
@@ -385,7 +347,7 @@ inline T& Point<T>::x()
 template <class T>
 inline T& Point<T>::y()
 {
-    return this->yCoord;
+    return coords.y();
 }
 
 /**
@@ -395,7 +357,7 @@ inline T& Point<T>::y()
 template <class T>
 inline T& Point<T>::z()
 {
-    return this->zCoord;
+    return coords.z();
 }
 
 /**
@@ -406,7 +368,7 @@ inline T& Point<T>::z()
 template <class T>
 inline void Point<T>::setX(const T& x)
 {
-    xCoord = x;
+    coords.x() = x;
 }
 
 /**
@@ -417,7 +379,7 @@ inline void Point<T>::setX(const T& x)
 template <class T>
 inline void Point<T>::setY(const T& y)
 {
-    yCoord = y;
+    coords.y() = y;
 }
 
 /**
@@ -428,7 +390,7 @@ inline void Point<T>::setY(const T& y)
 template <class T>
 inline void Point<T>::setZ(const T& z)
 {
-    zCoord = z;
+    coords.z() = z;
 }
 
 /**
@@ -441,9 +403,7 @@ inline void Point<T>::setZ(const T& z)
 template <class T>
 inline void Point<T>::set(const T& x, const T& y, const T& z)
 {
-    xCoord = x;
-    yCoord = y;
-    zCoord = z;
+    coords = PointN<T, 3>(x, y, z);
 }
 
 /**
@@ -454,11 +414,7 @@ inline void Point<T>::set(const T& x, const T& y, const T& z)
 template <class T>
 inline double Point<T>::normalize()
 {
-    double len = getLength();
-    xCoord /= len;
-    yCoord /= len;
-    zCoord /= len;
-    return len;
+    return coords.normalize();
 }
 
 #ifdef CG3_WITH_EIGEN
@@ -488,37 +444,25 @@ inline void Point<T>::rotate(double matrix[3][3], const Point<T>& centroid)
 template<class T>
 void Point<T>::serialize(std::ofstream& binaryFile) const
 {
-    serializeObjectAttributes("cg3Point3D", binaryFile, xCoord, yCoord, zCoord);
+    serializeObjectAttributes("cg3Point3D", binaryFile, coords.x(), coords.y(), coords.z());
 }
 
 template<class T>
 void Point<T>::deserialize(std::ifstream& binaryFile)
 {
-    deserializeObjectAttributes("cg3Point3D", binaryFile, xCoord, yCoord, zCoord);
+    deserializeObjectAttributes("cg3Point3D", binaryFile, coords.x(), coords.y(), coords.z());
 }
 
 template <class T>
 inline T& Point<T>::operator[](unsigned int i)
 {
-    assert(i < 3);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-        case 2: return zCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 template <class T>
 inline T& Point<T>::operator()(unsigned int i)
 {
-    assert(i < 3);
-    switch (i){
-        case 0: return xCoord;
-        case 1: return yCoord;
-        case 2: return zCoord;
-    }
-    return xCoord;
+    return coords[i];
 }
 
 /**
@@ -533,9 +477,7 @@ inline T& Point<T>::operator()(unsigned int i)
 template <class T>
 inline Point<T> Point<T>::operator += (const Point<T>& otherPoint)
 {
-    xCoord += otherPoint.xCoord;
-    yCoord += otherPoint.yCoord;
-    zCoord += otherPoint.zCoord;
+    coords += otherPoint.coords;
     return *this;
 }
 
@@ -551,9 +493,7 @@ inline Point<T> Point<T>::operator += (const Point<T>& otherPoint)
 template <class T>
 inline Point<T> Point<T>::operator -= (const Point<T>& otherPoint)
 {
-    xCoord -= otherPoint.xCoord;
-    yCoord -= otherPoint.yCoord;
-    zCoord -= otherPoint.zCoord;
+    coords -= otherPoint.coords;
     return *this;
 }
 
@@ -569,9 +509,7 @@ inline Point<T> Point<T>::operator -= (const Point<T>& otherPoint)
 template <class T>
 inline Point<T> Point<T>::operator *= (const T& scalar)
 {
-    xCoord *= scalar;
-    yCoord *= scalar;
-    zCoord *= scalar;
+    coords *= scalar;
     return *this;
 }
 
@@ -587,9 +525,7 @@ inline Point<T> Point<T>::operator *= (const T& scalar)
 template <class T>
 inline Point<T> Point<T>::operator *= (const Point<T>& otherPoint)
 {
-    xCoord *= otherPoint.xCoord;
-    yCoord *= otherPoint.yCoord;
-    zCoord *= otherPoint.zCoord;
+    coords *= otherPoint.coords;
     return *this;
 }
 
@@ -605,9 +541,7 @@ inline Point<T> Point<T>::operator *= (const Point<T>& otherPoint)
 template <class T>
 inline Point<T> Point<T>::operator /= (const T& scalar)
 {
-    xCoord /= scalar;
-    yCoord /= scalar;
-    zCoord /= scalar;
+    coords /= scalar;
     return *this;
 }
 
@@ -623,9 +557,7 @@ inline Point<T> Point<T>::operator /= (const T& scalar)
 template <class T>
 inline Point<T> Point<T>::operator /= (const Point<T>& otherPoint)
 {
-    xCoord /= otherPoint.xCoord;
-    yCoord /= otherPoint.yCoord;
-    zCoord /= otherPoint.zCoord;
+    coords /= otherPoint.coords;
     return *this;
 }
 
@@ -682,6 +614,26 @@ inline std::ostream& operator<<(std::ostream& inputStream, const Point<T>& p)
     return inputStream;
 }
 
+/**
+ * @ingroup cg3core
+ * @brief Converts a Point to a 3D PointN.
+ */
+template <class T, std::size_t A>
+inline PointN<T, 3, A> toPointN(const Point<T>& p)
+{
+    return PointN<T, 3, A>(p.x(), p.y(), p.z());
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Converts a 3D PointN to a Point.
+ */
+template <class T, std::size_t A>
+inline Point<T> toPoint(const PointN<T, 3, A>& p)
+{
+    return Point<T>(p.x(), p.y(), p.z());
+}
+
 template<class T>
 inline std::string to_string(const Point<T> &p)
 {
@@ -694,7 +646,5 @@ inline std::string to_string(const Point<T> &p)
 template<typename T>
 inline std::size_t std::hash<cg3::Point<T> >::operator()(const cg3::Point<T>& k) const
 {
-    std::size_t h=0;
-    cg3::hashCombine(h, k.x(), k.y(), k.z());
-    return h;
+    return cg3::hashScalars(k.x(), k.y(), k.z());
 }
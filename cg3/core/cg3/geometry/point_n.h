@@ -0,0 +1,197 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_POINT_N_H
+#define CG3_POINT_N_H
+
+#include <cstddef>
+#include <string>
+
+#include "../io/serialize.h"
+#include "../utilities/hash.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Number of coordinates stored by a PointN<T, D>: 3D points are padded
+ * to 4 coordinates, in order to fill a SIMD register.
+ */
+template <unsigned int D>
+struct PointNStorageSize
+{
+    static const unsigned int value = D == 3 ? 4 : D;
+};
+
+/**
+ * @brief Default alignment of a PointN<T, D>: if the size of its coordinates
+ * is a power of two, the size itself, up to 16 bytes (the alignment
+ * guaranteed by operator new), otherwise the alignment of T.
+ */
+template <class T, unsigned int D>
+struct PointNAlignment
+{
+    static const std::size_t size = sizeof(T) * PointNStorageSize<D>::value;
+    static const std::size_t value =
+            (size & (size - 1)) == 0 && size > alignof(T) ? (size < 16 ? size : 16) : alignof(T);
+};
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3core
+ * @class PointN
+ * @brief The PointN class models a point or a vector with D coordinates of
+ * type T.
+ *
+ * Unlike Point and Point2D, PointN is a trivially copyable value type: it has
+ * no virtual functions, its coordinates are stored in an aligned array (3D
+ * points are padded to 4 coordinates, and the padding is always zero), and
+ * all the operators are element-wise loops on the whole array, that the
+ * compiler turns into SIMD instructions. It is meant to be used in arrays
+ * processed by tight loops (bounding boxes, transformations, predicates):
+ *
+ * \code{.cpp}
+ * std::vector<cg3::PointN3d> points = ...;
+ * cg3::PointN3d min = points[0], max = points[0];
+ * for (const cg3::PointN3d& p : points) {
+ *     min = min.min(p);
+ *     max = max.max(p);
+ * }
+ * \endcode
+ *
+ * The alignment can be increased with the template parameter Align (e.g. 32
+ * for AVX loads of PointN<double, 3>); over-aligned points stored in
+ * std::vector require C++17 or an aligned allocator.
+ *
+ * Point and Point2D store their coordinates in a PointN<T, 3> and in a
+ * PointN<T, 2>, and forward their operators to it; they can be converted to
+ * and from PointN with toPointN(), toPoint() and toPoint2D().
+ */
+template <class T, unsigned int D, std::size_t Align = internal::PointNAlignment<T, D>::value>
+class PointN
+{
+public:
+    static const unsigned int DIM = D;
+    static const unsigned int STORAGE_SIZE = internal::PointNStorageSize<D>::value;
+
+    PointN();
+    explicit PointN(const T& value);
+    template <typename... Args>
+    PointN(const T& c0, const T& c1, const Args&... others);
+
+    static constexpr unsigned int dim() { return D; }
+
+    const T& x() const;
+    const T& y() const;
+    const T& z() const;
+    const T& w() const;
+    const T* data() const;
+    T dot(const PointN& otherVector) const;
+    PointN cross(const PointN& otherVector) const;
+    double dist(const PointN& otherPoint) const;
+    T distSquared(const PointN& otherPoint) const;
+    double getLength() const;
+    T getLengthSquared() const;
+    PointN normalized() const;
+    PointN min(const PointN& otherPoint) const;
+    PointN max(const PointN& otherPoint) const;
+    PointN abs() const;
+    T minCoord() const;
+    T maxCoord() const;
+
+    const T& operator[](unsigned int i) const;
+    const T& operator()(unsigned int i) const;
+    bool operator==(const PointN& otherPoint) const;
+    bool operator!=(const PointN& otherPoint) const;
+    bool operator<(const PointN& otherPoint) const;
+    PointN operator-() const;
+    PointN operator+(const T& scalar) const;
+    PointN operator+(const PointN& otherPoint) const;
+    PointN operator-(const T& scalar) const;
+    PointN operator-(const PointN& otherPoint) const;
+    PointN operator*(const T& scalar) const;
+    PointN operator*(const PointN& otherPoint) const;
+    PointN operator/(const T& scalar) const;
+    PointN operator/(const PointN& otherPoint) const;
+
+    T& x();
+    T& y();
+    T& z();
+    T& w();
+    void set(unsigned int i, const T& value);
+    double normalize();
+
+    T& operator[](unsigned int i);
+    T& operator()(unsigned int i);
+    PointN& operator+=(const T& scalar);
+    PointN& operator+=(const PointN& otherPoint);
+    PointN& operator-=(const T& scalar);
+    PointN& operator-=(const PointN& otherPoint);
+    PointN& operator*=(const T& scalar);
+    PointN& operator*=(const PointN& otherPoint);
+    PointN& operator/=(const T& scalar);
+    PointN& operator/=(const PointN& otherPoint);
+
+protected:
+    void setCoords(unsigned int) {}
+    template <typename... Args>
+    void setCoords(unsigned int i, const T& c, const Args&... others);
+
+    alignas(Align) T coords[STORAGE_SIZE];
+};
+
+/****************
+* Other Methods *
+*****************/
+
+template <class T, unsigned int D, std::size_t A>
+PointN<T, D, A> operator*(const T& scalar, const PointN<T, D, A>& point);
+
+template <class T, unsigned int D, std::size_t A>
+void serialize(const PointN<T, D, A>& p, std::ofstream& binaryFile);
+
+template <class T, unsigned int D, std::size_t A>
+void deserialize(PointN<T, D, A>& p, std::ifstream& binaryFile);
+
+template <class T, unsigned int D, std::size_t A>
+std::ostream& operator<<(std::ostream& inputStream, const PointN<T, D, A>& p);
+
+template <class T, unsigned int D, std::size_t A>
+std::string to_string(const PointN<T, D, A>& p);
+
+/**************
+* Other Types *
+***************/
+
+typedef PointN<double, 2> PointN2d; /**< @brief 2D PointN composed of double components */
+typedef PointN<float, 2>  PointN2f; /**< @brief 2D PointN composed of float components */
+typedef PointN<int, 2>    PointN2i; /**< @brief 2D PointN composed of integer components */
+typedef PointN<double, 3> PointN3d; /**< @brief 3D PointN composed of double components */
+typedef PointN<float, 3>  PointN3f; /**< @brief 3D PointN composed of float components */
+typedef PointN<int, 3>    PointN3i; /**< @brief 3D PointN composed of integer components */
+
+} //namespace cg3
+
+//hash specialization
+namespace std {
+
+template <typename T, unsigned int D, std::size_t A>
+struct hash<cg3::PointN<T, D, A>> {
+    size_t operator()(const cg3::PointN<T, D, A>& k) const;
+};
+
+} //namespace std
+
+#include "point_n.tpp"
+
+//Point and Point2D are built on PointN, and declare the conversions
+#include "point.h"
+#include "2d/point2d.h"
+
+#endif // CG3_POINT_N_H
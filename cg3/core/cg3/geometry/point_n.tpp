@@ -0,0 +1,523 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "point_n.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace cg3 {
+
+template <class T, unsigned int D, std::size_t A>
+const unsigned int PointN<T, D, A>::DIM;
+
+template <class T, unsigned int D, std::size_t A>
+const unsigned int PointN<T, D, A>::STORAGE_SIZE;
+
+/**
+ * @brief Creates a point with all the coordinates equal to zero.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>::PointN()
+{
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        coords[i] = 0;
+}
+
+/**
+ * @brief Creates a point with all the coordinates equal to value.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>::PointN(const T& value)
+{
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        coords[i] = i < D ? value : 0;
+}
+
+/**
+ * @brief Creates a point with the given coordinates, which must be D.
+ *
+ * \code{.cpp}
+ * cg3::PointN3d p(1, 2, 3);
+ * \endcode
+ */
+template <class T, unsigned int D, std::size_t A>
+template <typename... Args>
+inline PointN<T, D, A>::PointN(const T& c0, const T& c1, const Args&... others)
+{
+    static_assert(sizeof...(Args) + 2 == D, "PointN: wrong number of coordinates");
+    for (unsigned int i = D; i < STORAGE_SIZE; i++)
+        coords[i] = 0;
+    setCoords(0, c0, c1, others...);
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline const T& PointN<T, D, A>::x() const
+{
+    return coords[0];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline const T& PointN<T, D, A>::y() const
+{
+    static_assert(D > 1, "PointN: y() requires at least 2 dimensions");
+    return coords[1];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline const T& PointN<T, D, A>::z() const
+{
+    static_assert(D > 2, "PointN: z() requires at least 3 dimensions");
+    return coords[2];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline const T& PointN<T, D, A>::w() const
+{
+    static_assert(D > 3, "PointN: w() requires at least 4 dimensions");
+    return coords[3];
+}
+
+/**
+ * @brief Returns the array of the coordinates, followed by the padding
+ * (STORAGE_SIZE values).
+ */
+template <class T, unsigned int D, std::size_t A>
+inline const T* PointN<T, D, A>::data() const
+{
+    return coords;
+}
+
+/**
+ * @brief Dot product between this and otherVector. The padding is zero, so
+ * the sum is made on the whole storage.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline T PointN<T, D, A>::dot(const PointN& otherVector) const
+{
+    T res = 0;
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        res += coords[i] * otherVector.coords[i];
+    return res;
+}
+
+/**
+ * @brief Cross product between this and otherVector, for 3D vectors.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::cross(const PointN& otherVector) const
+{
+    static_assert(D == 3, "PointN: cross() requires 3 dimensions");
+    const T* o = otherVector.coords;
+    return PointN(coords[1] * o[2] - coords[2] * o[1],
+                  coords[2] * o[0] - coords[0] * o[2],
+                  coords[0] * o[1] - coords[1] * o[0]);
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline double PointN<T, D, A>::dist(const PointN& otherPoint) const
+{
+    return std::sqrt((double)distSquared(otherPoint));
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T PointN<T, D, A>::distSquared(const PointN& otherPoint) const
+{
+    T res = 0;
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++) {
+        T d = coords[i] - otherPoint.coords[i];
+        res += d * d;
+    }
+    return res;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline double PointN<T, D, A>::getLength() const
+{
+    return std::sqrt((double)getLengthSquared());
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T PointN<T, D, A>::getLengthSquared() const
+{
+    return dot(*this);
+}
+
+/**
+ * @brief Returns the vector with the same direction of this and unit length.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::normalized() const
+{
+    PointN p = *this;
+    p.normalize();
+    return p;
+}
+
+/**
+ * @brief Returns the element-wise minimum between this and otherPoint.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::min(const PointN& otherPoint) const
+{
+    PointN p;
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        p.coords[i] = otherPoint.coords[i] < coords[i] ? otherPoint.coords[i] : coords[i];
+    return p;
+}
+
+/**
+ * @brief Returns the element-wise maximum between this and otherPoint.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::max(const PointN& otherPoint) const
+{
+    PointN p;
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        p.coords[i] = coords[i] < otherPoint.coords[i] ? otherPoint.coords[i] : coords[i];
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::abs() const
+{
+    PointN p;
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        p.coords[i] = coords[i] < 0 ? -coords[i] : coords[i];
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T PointN<T, D, A>::minCoord() const
+{
+    return *std::min_element(coords, coords + D);
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T PointN<T, D, A>::maxCoord() const
+{
+    return *std::max_element(coords, coords + D);
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline const T& PointN<T, D, A>::operator[](unsigned int i) const
+{
+    assert(i < D);
+    return coords[i];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline const T& PointN<T, D, A>::operator()(unsigned int i) const
+{
+    assert(i < D);
+    return coords[i];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline bool PointN<T, D, A>::operator==(const PointN& otherPoint) const
+{
+    for (unsigned int i = 0; i < D; i++)
+        if (coords[i] != otherPoint.coords[i])
+            return false;
+    return true;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline bool PointN<T, D, A>::operator!=(const PointN& otherPoint) const
+{
+    return !(*this == otherPoint);
+}
+
+/**
+ * @brief Lexicographic order of the coordinates.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline bool PointN<T, D, A>::operator<(const PointN& otherPoint) const
+{
+    for (unsigned int i = 0; i < D; i++) {
+        if (coords[i] < otherPoint.coords[i])
+            return true;
+        if (otherPoint.coords[i] < coords[i])
+            return false;
+    }
+    return false;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator-() const
+{
+    PointN p;
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        p.coords[i] = -coords[i];
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator+(const T& scalar) const
+{
+    PointN p = *this;
+    p += scalar;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator+(const PointN& otherPoint) const
+{
+    PointN p = *this;
+    p += otherPoint;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator-(const T& scalar) const
+{
+    PointN p = *this;
+    p -= scalar;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator-(const PointN& otherPoint) const
+{
+    PointN p = *this;
+    p -= otherPoint;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator*(const T& scalar) const
+{
+    PointN p = *this;
+    p *= scalar;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator*(const PointN& otherPoint) const
+{
+    PointN p = *this;
+    p *= otherPoint;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator/(const T& scalar) const
+{
+    PointN p = *this;
+    p /= scalar;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> PointN<T, D, A>::operator/(const PointN& otherPoint) const
+{
+    PointN p = *this;
+    p /= otherPoint;
+    return p;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T& PointN<T, D, A>::x()
+{
+    return coords[0];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T& PointN<T, D, A>::y()
+{
+    static_assert(D > 1, "PointN: y() requires at least 2 dimensions");
+    return coords[1];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T& PointN<T, D, A>::z()
+{
+    static_assert(D > 2, "PointN: z() requires at least 3 dimensions");
+    return coords[2];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T& PointN<T, D, A>::w()
+{
+    static_assert(D > 3, "PointN: w() requires at least 4 dimensions");
+    return coords[3];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline void PointN<T, D, A>::set(unsigned int i, const T& value)
+{
+    assert(i < D);
+    coords[i] = value;
+}
+
+/**
+ * @brief Normalizes the vector. As in operator/=, the padding is not
+ * divided: it stays zero also when the vector is null.
+ * @return the length of the vector before the normalization
+ */
+template <class T, unsigned int D, std::size_t A>
+inline double PointN<T, D, A>::normalize()
+{
+    double len = getLength();
+    for (unsigned int i = 0; i < D; i++)
+        coords[i] = (T)(coords[i] / len);
+    return len;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T& PointN<T, D, A>::operator[](unsigned int i)
+{
+    assert(i < D);
+    return coords[i];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline T& PointN<T, D, A>::operator()(unsigned int i)
+{
+    assert(i < D);
+    return coords[i];
+}
+
+/**
+ * @brief Adds scalar to all the coordinates; the padding stays zero.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator+=(const T& scalar)
+{
+    for (unsigned int i = 0; i < D; i++)
+        coords[i] += scalar;
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator+=(const PointN& otherPoint)
+{
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        coords[i] += otherPoint.coords[i];
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator-=(const T& scalar)
+{
+    for (unsigned int i = 0; i < D; i++)
+        coords[i] -= scalar;
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator-=(const PointN& otherPoint)
+{
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        coords[i] -= otherPoint.coords[i];
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator*=(const T& scalar)
+{
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        coords[i] *= scalar;
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator*=(const PointN& otherPoint)
+{
+    for (unsigned int i = 0; i < STORAGE_SIZE; i++)
+        coords[i] *= otherPoint.coords[i];
+    return *this;
+}
+
+/**
+ * @brief Divides all the coordinates by scalar; the padding is not divided,
+ * in order to keep it zero.
+ */
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator/=(const T& scalar)
+{
+    for (unsigned int i = 0; i < D; i++)
+        coords[i] /= scalar;
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A>& PointN<T, D, A>::operator/=(const PointN& otherPoint)
+{
+    for (unsigned int i = 0; i < D; i++)
+        coords[i] /= otherPoint.coords[i];
+    return *this;
+}
+
+template <class T, unsigned int D, std::size_t A>
+template <typename... Args>
+inline void PointN<T, D, A>::setCoords(unsigned int i, const T& c, const Args&... others)
+{
+    coords[i] = c;
+    setCoords(i + 1, others...);
+}
+
+/****************
+* Other Methods *
+*****************/
+
+template <class T, unsigned int D, std::size_t A>
+inline PointN<T, D, A> operator*(const T& scalar, const PointN<T, D, A>& point)
+{
+    return point * scalar;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline void serialize(const PointN<T, D, A>& p, std::ofstream& binaryFile)
+{
+    std::array<T, D> c;
+    std::copy(p.data(), p.data() + D, c.begin());
+    serializeObjectAttributes("cg3PointN", binaryFile, c);
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline void deserialize(PointN<T, D, A>& p, std::ifstream& binaryFile)
+{
+    std::array<T, D> c;
+    deserializeObjectAttributes("cg3PointN", binaryFile, c);
+    for (unsigned int i = 0; i < D; i++)
+        p[i] = c[i];
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline std::ostream& operator<<(std::ostream& inputStream, const PointN<T, D, A>& p)
+{
+    inputStream << "[";
+    for (unsigned int i = 0; i < D; i++)
+        inputStream << (i > 0 ? ", " : "") << p[i];
+    inputStream << "]";
+    return inputStream;
+}
+
+template <class T, unsigned int D, std::size_t A>
+inline std::string to_string(const PointN<T, D, A>& p)
+{
+    std::string s = "[";
+    for (unsigned int i = 0; i < D; i++)
+        s += (i > 0 ? ", " : "") + std::to_string(p[i]);
+    return s + "]";
+}
+
+} //namespace cg3
+
+//hash specialization
+template <typename T, unsigned int D, std::size_t A>
+inline std::size_t std::hash<cg3::PointN<T, D, A>>::operator()(const cg3::PointN<T, D, A>& k) const
+{
+    //same hash of hashScalars on the coordinates
+    std::uint64_t h = 0;
+    for (unsigned int i = 0; i < D; i++)
+        h = (h + cg3::hashScalar(k[i])) * 0x9e3779b97f4a7c15ULL;
+    return cg3::hashMix(h);
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_SPATIAL_HASH_H
+#define CG3_SPATIAL_HASH_H
+
+#include "point.h"
+#include "2d/point2d.h"
+#include "../utilities/const.h"
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The SpatialHash class hashes points quantised on a uniform grid
+ * with cells of size epsilon. Together with SpatialEqual, it can be used as
+ * hasher of std::unordered_map or cg3::FlatHashMap in order to merge points
+ * that are closer than epsilon (e.g. duplicated vertices of a triangle soup):
+ *
+ * \code{.cpp}
+ * cg3::SpatialHash hash(1e-6);
+ * cg3::SpatialEqual equal(1e-6);
+ * cg3::FlatHashMap<cg3::Pointd, unsigned int, cg3::SpatialHash, cg3::SpatialEqual> ids(0, hash, equal);
+ * \endcode
+ *
+ * Two points are considered equal if they fall in the same cell: points that
+ * are closer than epsilon but that lie on different sides of a cell boundary
+ * are still considered different.
+ */
+class SpatialHash
+{
+public:
+    explicit SpatialHash(double epsilon = CG3_EPSILON);
+
+    double epsilon() const;
+
+    template <typename T>
+    Point<long long int> cell(const Point<T>& p) const;
+    template <typename T>
+    Point2D<long long int> cell(const Point2D<T>& p) const;
+
+    template <typename T>
+    size_t operator()(const Point<T>& p) const;
+    template <typename T>
+    size_t operator()(const Point2D<T>& p) const;
+
+protected:
+    long long int quantise(double v) const;
+
+    double eps;
+    double invEpsilon;
+};
+
+/**
+ * @ingroup cg3core
+ * @brief The SpatialEqual class compares points quantised on a uniform grid
+ * with cells of size epsilon, consistently with SpatialHash.
+ */
+class SpatialEqual : public SpatialHash
+{
+public:
+    explicit SpatialEqual(double epsilon = CG3_EPSILON);
+
+    template <typename T>
+    bool operator()(const Point<T>& p1, const Point<T>& p2) const;
+    template <typename T>
+    bool operator()(const Point2D<T>& p1, const Point2D<T>& p2) const;
+};
+
+} //namespace cg3
+
+#include "spatial_hash.tpp"
+
+#endif // CG3_SPATIAL_HASH_H
@@ -0,0 +1,85 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "spatial_hash.h"
+
+#include <cmath>
+#include "../utilities/hash.h"
+
+namespace cg3 {
+
+inline SpatialHash::SpatialHash(double epsilon) :
+    eps(epsilon),
+    invEpsilon(1.0 / epsilon)
+{
+}
+
+inline double SpatialHash::epsilon() const
+{
+    return eps;
+}
+
+/**
+ * @brief SpatialHash::cell
+ * @param p
+ * @return the integer coordinates of the cell that contains p
+ */
+template <typename T>
+inline Point<long long int> SpatialHash::cell(const Point<T>& p) const
+{
+    return Point<long long int>(quantise(p.x()), quantise(p.y()), quantise(p.z()));
+}
+
+/**
+ * @brief SpatialHash::cell
+ * @param p
+ * @return the integer coordinates of the cell that contains p
+ */
+template <typename T>
+inline Point2D<long long int> SpatialHash::cell(const Point2D<T>& p) const
+{
+    return Point2D<long long int>(quantise(p.x()), quantise(p.y()));
+}
+
+template <typename T>
+inline size_t SpatialHash::operator()(const Point<T>& p) const
+{
+    return hashScalars(quantise(p.x()), quantise(p.y()), quantise(p.z()));
+}
+
+template <typename T>
+inline size_t SpatialHash::operator()(const Point2D<T>& p) const
+{
+    return hashScalars(quantise(p.x()), quantise(p.y()));
+}
+
+inline long long int SpatialHash::quantise(double v) const
+{
+    return (long long int)std::floor(v * invEpsilon + 0.5);
+}
+
+inline SpatialEqual::SpatialEqual(double epsilon) :
+    SpatialHash(epsilon)
+{
+}
+
+template <typename T>
+inline bool SpatialEqual::operator()(const Point<T>& p1, const Point<T>& p2) const
+{
+    return quantise(p1.x()) == quantise(p2.x()) &&
+           quantise(p1.y()) == quantise(p2.y()) &&
+           quantise(p1.z()) == quantise(p2.z());
+}
+
+template <typename T>
+inline bool SpatialEqual::operator()(const Point2D<T>& p1, const Point2D<T>& p2) const
+{
+    return quantise(p1.x()) == quantise(p2.x()) &&
+           quantise(p1.y()) == quantise(p2.y());
+}
+
+} //namespace cg3
@@ -47,6 +47,9 @@ public:
     double perimeter() const;
     T barycenter() const;
 
+    bool operator == (const Triangle<T>& otherTriangle) const;
+    bool operator != (const Triangle<T>& otherTriangle) const;
+
 
     // SerializableObject interface
     void serialize(std::ofstream& binaryFile) const;
@@ -67,6 +70,16 @@ typedef Triangle3D<int> Triangle3Di;
 
 } // namespace cg3
 
+//hash specialization
+namespace std {
+
+template <typename T>
+struct hash<cg3::Triangle<T>> {
+    size_t operator()(const cg3::Triangle<T>& k) const;
+};
+
+} //namespace std
+
 #include "triangle.tpp"
 
 #endif // CG3_TRIANGLE_H
@@ -152,6 +152,24 @@ inline T Triangle<T>::barycenter() const
     return (_v1 + _v2 +_v3) / 3;
 }
 
+/**
+ * @brief Triangle::operator ==
+ * Two triangles are equal if they have the same vertices in the same order.
+ * @param otherTriangle
+ * @return
+ */
+template<class T>
+inline bool Triangle<T>::operator ==(const Triangle<T>& otherTriangle) const
+{
+    return _v1 == otherTriangle._v1 && _v2 == otherTriangle._v2 && _v3 == otherTriangle._v3;
+}
+
+template<class T>
+inline bool Triangle<T>::operator !=(const Triangle<T>& otherTriangle) const
+{
+    return !(*this == otherTriangle);
+}
+
 template<class T>
 inline void Triangle<T>::serialize(std::ofstream& binaryFile) const
 {
@@ -165,3 +183,12 @@ inline void Triangle<T>::deserialize(std::ifstream& binaryFile)
 }
 
 } //namespace cg3
+
+//hash specialization
+template<typename T>
+inline std::size_t std::hash<cg3::Triangle<T> >::operator()(const cg3::Triangle<T>& k) const
+{
+    std::size_t h = 0;
+    cg3::hashCombine(h, k.v1(), k.v2(), k.v3());
+    return h;
+}
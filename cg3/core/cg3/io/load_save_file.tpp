@@ -6,7 +6,8 @@
  */
 
 #include "load_save_file.h"
-#include "../utilities/tokenizer.h"
+#include "../utilities/lazy_tokenizer.h"
+#include "../utilities/profiler.h"
 
 namespace cg3 {
 namespace internal {
@@ -69,33 +70,31 @@ inline bool loadMtlFile(
         const std::string &mtuFile,
         std::map<std::string, Color> &mapColors)
 {
+    CG3_PROFILE_SCOPE("loadMtlFile");
     std::ifstream mtufile(mtuFile.c_str());
     std::string line;
     if (mtufile.is_open()){
         while(std::getline(mtufile,line)) {
-            cg3::Tokenizer spaceTokenizer(line, ' ');
+            cg3::LazyTokenizer spaceTokenizer(line, " \t\r");
 
-            if (spaceTokenizer.begin() != spaceTokenizer.end()){
+            if (!spaceTokenizer.empty()){
 
-                cg3::Tokenizer::iterator token = spaceTokenizer.begin();
+                cg3::LazyTokenizer::iterator token = spaceTokenizer.begin();
                 if (*token == "newmtl"){
                     ++token;
-                    std::string colorname = *token;
-                    do {
-                        std::getline(mtufile,line);
-                        spaceTokenizer = Tokenizer(line, ' ');
+                    std::string colorname = token->toString();
+                    bool found = false;
+                    while (!found && std::getline(mtufile,line)) {
+                        spaceTokenizer = LazyTokenizer(line, " \t\r");
                         token = spaceTokenizer.begin();
-                    } while (*token != "Kd");
-                    std::string r = *(++token);
-                    std::string g = *(++token);
-                    std::string b = *(++token);
-
-                    std::istringstream rstr(r), gstr(g), bstr(b);
-                    float  rf, gf, bf;
-                    rstr >> rf;
-                    gstr >> gf;
-                    bstr >> bf;
-                    mapColors[colorname] = Color(rf*255, gf*255, bf*255);
+                        found = token != spaceTokenizer.end() && *token == "Kd";
+                    }
+                    if (found) {
+                        float rf = cg3::stof(*(++token));
+                        float gf = cg3::stof(*(++token));
+                        float bf = cg3::stof(*(++token));
+                        mapColors[colorname] = Color(rf*255, gf*255, bf*255);
+                    }
                 }
             }
         }
@@ -179,6 +178,7 @@ bool saveMeshOnObj(
         const V faceColors[],
         const W polygonSizes[])
 {
+    CG3_PROFILE_SCOPE("saveMeshOnObj");
     std::string objfilename, mtufilename, mtufilenopath;
     std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
     std::ofstream fp, fmtu;
@@ -302,6 +302,7 @@ inline bool saveMeshOnPly(
         const V faceColors[],
         const W polygonSizes[])
 {
+    CG3_PROFILE_SCOPE("saveMeshOnPly");
     std::string plyfilename;
     std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
     std::ofstream fp;
@@ -437,6 +438,7 @@ bool loadMeshFromObj(
         std::list<Color> &faceColors,
         std::list<W> &faceSizes)
 {
+    CG3_PROFILE_SCOPE("loadMeshFromObj");
     std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     static std::string vertex = "v";
@@ -462,17 +464,17 @@ bool loadMeshFromObj(
     }
     while(std::getline(file,line)) {
 
-        cg3::Tokenizer spaceTokenizer(line, ' ');
+        cg3::LazyTokenizer spaceTokenizer(line, " \t\r");
 
-        if (spaceTokenizer.begin() != spaceTokenizer.end()) {
+        if (!spaceTokenizer.empty()) {
 
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            std::string header = *token;
+            cg3::LazyTokenizer::iterator token = spaceTokenizer.begin();
+            cg3::StringView header = *token;
 
             if (header == "mtllib"){
                 modality |= io::COLOR_FACES;
                 usemtu = true;
-                std::string mtufilename = *(++token);
+                std::string mtufilename = (++token)->toString();
                 size_t lastSlash = filename.find_last_of("/");
                 if (lastSlash < filename.size()){
                     std::string path = filename.substr(0, lastSlash);
@@ -484,13 +486,9 @@ bool loadMeshFromObj(
 
             if (header == vertexNormal) {
                 modality |= io::NORMAL_VERTICES;
-                std::string x = *(++token);
-                std::string y = *(++token);
-                std::string z = *(++token);
-
-                verticesNormals.push_back(std::stod(x));
-                verticesNormals.push_back(std::stod(y));
-                verticesNormals.push_back(std::stod(z));
+                verticesNormals.push_back(cg3::stod(*(++token)));
+                verticesNormals.push_back(cg3::stod(*(++token)));
+                verticesNormals.push_back(cg3::stod(*(++token)));
             }
 
             // Handle
@@ -498,27 +496,23 @@ bool loadMeshFromObj(
             // v 0.123 0.234 0.345
             // v 0.123 0.234 0.345 1.0
             if (header == vertex) {
-                std::string x = *(++token);
-                std::string y = *(++token);
-                std::string z = *(++token);
-
-                coords.push_back(std::stod(x));
-                coords.push_back(std::stod(y));
-                coords.push_back(std::stod(z));
+                coords.push_back(cg3::stod(*(++token)));
+                coords.push_back(cg3::stod(*(++token)));
+                coords.push_back(cg3::stod(*(++token)));
 
                 ++token;
 
                 if (token != spaceTokenizer.end()){
                     modality |= io::COLOR_VERTICES;
-                    std::string r = *(token);
-                    std::string g = *(++token);
-                    std::string b = *(++token);
+                    double r = cg3::stod(*(token));
+                    double g = cg3::stod(*(++token));
+                    double b = cg3::stod(*(++token));
                     ++token;
                     double alpha = 255;
                     if (token != spaceTokenizer.end()){
-                        alpha = std::stoi(*token);
+                        alpha = cg3::stoi(*token);
                     }
-                    Color c(std::stod(r)*255, std::stod(g)*255, std::stod(b)*255, alpha);
+                    Color c(r*255, g*255, b*255, alpha);
                     verticesColors.push_back(c);
                 }
             }
@@ -529,13 +523,13 @@ bool loadMeshFromObj(
             // f 6/4/1 3/5/3 7/6/5
 
             else if (header == face) {
-                std::vector<std::string> dummy;
-                token++;
-                for (unsigned int i = 0; token != spaceTokenizer.end(); i++) {
-                    dummy.push_back(*(token));
-                    token++;
+                unsigned int nVert = 0;
+                for (++token; token != spaceTokenizer.end(); ++token) {
+                    //the vertex id is the first of the slash separated ids
+                    cg3::LazyTokenizer slashTokenizer(*token, "/");
+                    faces.push_back(cg3::stoi(*slashTokenizer.begin())-1);
+                    nVert++;
                 }
-                unsigned int nVert = (unsigned int)dummy.size();
                 faceSizes.push_back(nVert);
 
                 if (first == true){
@@ -554,23 +548,12 @@ bool loadMeshFromObj(
                         meshType = io::POLYGON_MESH;
                 }
 
-                std::vector<cg3::Tokenizer> slashTokenizer;
-                for (unsigned int i=0; i<dummy.size(); i++){
-                    cg3::Tokenizer t(dummy[i], ' ');
-                    slashTokenizer.push_back(t);
-                }
-
-                for (unsigned int i=0; i<dummy.size(); i++){
-                    std::string ids = *(slashTokenizer[i].begin());
-                    faces.push_back(std::stoi(ids)-1);
-                }
-
                 if (usemtu){
                     faceColors.push_back(actualColor);
                 }
             }
             else if (header == "usemtl" && usemtu){
-                std::string color = *(++token);
+                std::string color = (++token)->toString();
                 assert(mapColors.find(color) != mapColors.end());
                 actualColor = mapColors[color];
             }
@@ -838,6 +821,7 @@ bool loadMeshFromPly(
         std::list<Color>& faceColors,
         std::list<W>& faceSizes)
 {
+    CG3_PROFILE_SCOPE("loadMeshFromPly");
     typedef enum {VERTEX, FACE, OTHER} ElementType;
     typedef enum {unknown = -1, x, y, z, nx, ny, nz, red, green, blue, alpha, list} PropertyName;
     typedef enum {UCHAR, FLOAT} PropertyType;
@@ -869,26 +853,26 @@ bool loadMeshFromPly(
     do {
         error = !(std::getline(file,line));
         if (!error){
-            cg3::Tokenizer spaceTokenizer(line, ' ');
-            if (spaceTokenizer.begin() == spaceTokenizer.end()) continue;
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            headerLine = *token;
+            cg3::LazyTokenizer spaceTokenizer(line, " \t\r");
+            if (spaceTokenizer.empty()) continue;
+            cg3::LazyTokenizer::iterator token = spaceTokenizer.begin();
+            headerLine = token->toString();
             if (headerLine == "element") { //new type of element read
-                std::string s = *(++token);
+                cg3::StringView s = *(++token);
                 if (s == "vertex"){
                     elementType = VERTEX;
-                    nVer = std::stoi(*(++token));
+                    nVer = cg3::stoi(*(++token));
                 }
                 else if (s == "face"){
                     elementType = FACE;
-                    nFac = std::stoi(*(++token));
+                    nFac = cg3::stoi(*(++token));
                 }
                 else elementType = OTHER;
             }
             else if (headerLine == "property"){
                 Property p;
-                std::string type = *(++token);
-                std::string name = *(++token);
+                cg3::StringView type = *(++token);
+                cg3::StringView name = *(++token);
                 p.name = unknown;
                 if (name == "x") p.name = x;
                 if (name == "y") p.name = y;
@@ -940,13 +924,14 @@ bool loadMeshFromPly(
         return false;
     }
 
+    std::vector<int> indices; //reused for every face
     while(std::getline(file,line)) {
-        cg3::Tokenizer spaceTokenizer(line, ' ');
+        cg3::LazyTokenizer spaceTokenizer(line, " \t\r");
 
-        if (spaceTokenizer.begin() == spaceTokenizer.end()) continue;
+        if (spaceTokenizer.empty()) continue;
 
         if (nv < nVer){ //reading vertices
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
+            cg3::LazyTokenizer::iterator token = spaceTokenizer.begin();
             std::array<double, 6> cnv;
             Color c;
 
@@ -955,33 +940,33 @@ bool loadMeshFromPly(
                 if (token == spaceTokenizer.end())
                     return false;
                 if (p.name >= 0 && p.name < 6){
-                    cnv[p.name] = std::stod(*token);
+                    cnv[p.name] = cg3::stod(*token);
                 }
                 else if (p.name >= 6 && p.name < 10){
                     switch (p.name) {
                         case red:
                             if (p.type == UCHAR)
-                                c.setRed(std::stoi(*token));
+                                c.setRed(cg3::stoi(*token));
                             else
-                                c.setRedF(std::stof(*token));
+                                c.setRedF(cg3::stof(*token));
                             break;
                         case green:
                             if (p.type == UCHAR)
-                                c.setGreen(std::stoi(*token));
+                                c.setGreen(cg3::stoi(*token));
                             else
-                                c.setGreenF(std::stof(*token));
+                                c.setGreenF(cg3::stof(*token));
                             break;
                         case blue:
                             if (p.type == UCHAR)
-                                c.setBlue(std::stoi(*token));
+                                c.setBlue(cg3::stoi(*token));
                             else
-                                c.setBlueF(std::stof(*token));
+                                c.setBlueF(cg3::stof(*token));
                             break;
                         case alpha:
                             if (p.type == UCHAR)
-                                c.setAlpha(std::stoi(*token));
+                                c.setAlpha(cg3::stoi(*token));
                             else
-                                c.setAlphaF(std::stof(*token));
+                                c.setAlphaF(cg3::stof(*token));
                             break;
                         default:
                             ;
@@ -1009,8 +994,8 @@ bool loadMeshFromPly(
             nv++;
         }
         else if (nf < nFac){ //reading faces
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            std::vector<int> indices;
+            cg3::LazyTokenizer::iterator token = spaceTokenizer.begin();
+            indices.clear();
             Color c;
 
             //manage properties of face
@@ -1018,40 +1003,40 @@ bool loadMeshFromPly(
                 if (token == spaceTokenizer.end())
                     return false;
                 if (p.name == list){
-                    int size = std::stoi(*(token));
+                    int size = cg3::stoi(*(token));
                     indices.resize(size);
                     for (int i = 0; i < size; i++){
                         token++;
                         if (token == spaceTokenizer.end())
                             return false;
-                        indices[i] = std::stoi(*token);
+                        indices[i] = cg3::stoi(*token);
                     }
                 }
                 else {
                     switch (p.name) {
                         case red:
                             if (p.type == UCHAR)
-                                c.setRed(std::stoi(*token));
+                                c.setRed(cg3::stoi(*token));
                             else
-                                c.setRedF(std::stof(*token));
+                                c.setRedF(cg3::stof(*token));
                             break;
                         case green:
                             if (p.type == UCHAR)
-                                c.setGreen(std::stoi(*token));
+                                c.setGreen(cg3::stoi(*token));
                             else
-                                c.setGreenF(std::stof(*token));
+                                c.setGreenF(cg3::stof(*token));
                             break;
                         case blue:
                             if (p.type == UCHAR)
-                                c.setBlue(std::stoi(*token));
+                                c.setBlue(cg3::stoi(*token));
                             else
-                                c.setBlueF(std::stof(*token));
+                                c.setBlueF(cg3::stof(*token));
                             break;
                         case alpha:
                             if (p.type == UCHAR)
-                                c.setAlpha(std::stoi(*token));
+                                c.setAlpha(cg3::stoi(*token));
                             else
-                                c.setAlphaF(std::stof(*token));
+                                c.setAlphaF(cg3::stof(*token));
                             break;
                         default:
                             ;
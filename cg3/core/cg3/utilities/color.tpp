@@ -450,7 +450,5 @@ inline void Color::deserialize(std::ifstream& binaryFile)
 
 inline std::size_t std::hash<cg3::Color>::operator()(const cg3::Color &k) const
 {
-    std::size_t seed = 0;
-    cg3::hashCombine(seed, k.red(), k.green(), k.blue(), k.alpha());
-    return seed;
+    return cg3::hashScalars(k.red(), k.green(), k.blue(), k.alpha());
 }
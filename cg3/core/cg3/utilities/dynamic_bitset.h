@@ -0,0 +1,187 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_DYNAMIC_BITSET_H
+#define CG3_DYNAMIC_BITSET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The DynamicBitset class is a resizable array of bits, packed in 64
+ * bit words.
+ *
+ * It is meant to be used as a set of indices in [0, size()): membership tests
+ * and insertions are a shift and a mask, set algebra works on whole words, and
+ * count() uses the popcount instruction. Iterating a DynamicBitset visits the
+ * indices of the set bits in increasing order, skipping the empty words:
+ *
+ * \code{.cpp}
+ * cg3::DynamicBitset visited(n);
+ * visited.set(3);
+ * if (!visited.testAndSet(i))
+ *     stack.push_back(i);
+ * for (size_t i : visited)
+ *     std::cout << i << " ";
+ * \endcode
+ *
+ * Binary operators require bitsets of the same size.
+ */
+class DynamicBitset
+{
+public:
+    class ConstIterator;
+    typedef ConstIterator const_iterator;
+    typedef ConstIterator iterator;
+
+    static const size_t npos = (size_t)-1;
+
+    DynamicBitset();
+    explicit DynamicBitset(size_t size, bool value = false);
+
+    size_t size() const;
+    void resize(size_t size, bool value = false);
+    void clear();
+
+    bool test(size_t i) const;
+    bool operator[](size_t i) const;
+    void set(size_t i);
+    void set(size_t i, bool value);
+    void reset(size_t i);
+    void flip(size_t i);
+    bool testAndSet(size_t i);
+
+    void setAll();
+    void resetAll();
+    void flipAll();
+
+    size_t count() const;
+    bool any() const;
+    bool none() const;
+    bool all() const;
+    bool intersects(const DynamicBitset& other) const;
+    bool isSubsetOf(const DynamicBitset& other) const;
+
+    size_t findFirst() const;
+    size_t findNext(size_t i) const;
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    DynamicBitset& operator&=(const DynamicBitset& other);
+    DynamicBitset& operator|=(const DynamicBitset& other);
+    DynamicBitset& operator^=(const DynamicBitset& other);
+    DynamicBitset& operator-=(const DynamicBitset& other);
+    DynamicBitset operator~() const;
+    bool operator==(const DynamicBitset& other) const;
+    bool operator!=(const DynamicBitset& other) const;
+
+    const std::vector<uint64_t>& getWords() const;
+
+    void swap(DynamicBitset& other);
+
+protected:
+    static size_t wordIndex(size_t i);
+    static uint64_t bitMask(size_t i);
+    static size_t numberWords(size_t size);
+    void clearUnusedBits();
+
+    std::vector<uint64_t> words;
+    size_t nBits;
+};
+
+/**
+ * @brief Forward iterator on the indices of the set bits of a DynamicBitset.
+ */
+class DynamicBitset::ConstIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const size_t* pointer;
+    typedef size_t reference;
+
+    ConstIterator();
+    ConstIterator(const DynamicBitset* bitset, size_t pos);
+
+    size_t operator*() const;
+    ConstIterator& operator++();
+    ConstIterator operator++(int);
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+
+private:
+    const DynamicBitset* bitset;
+    size_t pos;
+};
+
+/**
+ * @ingroup cg3core
+ * @brief The ConcurrentBitset class is a fixed size array of bits that can be
+ * set by multiple threads at the same time.
+ *
+ * Bits are set with an atomic fetch-or on their word, so that testAndSet()
+ * returns false to exactly one of the threads that set the same bit: it is
+ * meant to mark the visited elements in parallel visits.
+ *
+ * \code{.cpp}
+ * cg3::ConcurrentBitset visited(n);
+ * cg3::parallelFor(0u, n, [&](unsigned int i) {
+ *     if (!visited.testAndSet(next(i)))
+ *         ...
+ * });
+ * \endcode
+ */
+class ConcurrentBitset
+{
+public:
+    explicit ConcurrentBitset(size_t size = 0);
+
+    size_t size() const;
+    bool test(size_t i) const;
+    bool testAndSet(size_t i);
+    void reset(size_t i);
+    void resetAll();
+    size_t count() const;
+
+    DynamicBitset toDynamicBitset() const;
+
+private:
+    ConcurrentBitset(const ConcurrentBitset&);
+    ConcurrentBitset& operator=(const ConcurrentBitset&);
+
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    size_t nWords;
+    size_t nBits;
+};
+
+DynamicBitset operator&(DynamicBitset a, const DynamicBitset& b);
+DynamicBitset operator|(DynamicBitset a, const DynamicBitset& b);
+DynamicBitset operator^(DynamicBitset a, const DynamicBitset& b);
+DynamicBitset operator-(DynamicBitset a, const DynamicBitset& b);
+
+void swap(DynamicBitset& a, DynamicBitset& b);
+
+namespace internal {
+
+unsigned int popcount(uint64_t w);
+unsigned int countTrailingZeros(uint64_t w);
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#include "dynamic_bitset.tpp"
+
+#endif // CG3_DYNAMIC_BITSET_H
@@ -0,0 +1,506 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "dynamic_bitset.h"
+
+#include <algorithm>
+#include <cassert>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace cg3 {
+
+/* ----- DynamicBitset ----- */
+
+inline DynamicBitset::DynamicBitset() :
+    nBits(0)
+{
+}
+
+/**
+ * @brief DynamicBitset::DynamicBitset
+ * @param size: number of bits
+ * @param value: initial value of all the bits
+ */
+inline DynamicBitset::DynamicBitset(size_t size, bool value) :
+    words(numberWords(size), value ? ~(uint64_t)0 : 0),
+    nBits(size)
+{
+    clearUnusedBits();
+}
+
+inline size_t DynamicBitset::size() const
+{
+    return nBits;
+}
+
+/**
+ * @brief DynamicBitset::resize
+ * Resizes the bitset: the bits in [0, min(size(), size)) are kept, and the new
+ * bits are set to value.
+ */
+inline void DynamicBitset::resize(size_t size, bool value)
+{
+    size_t oldSize = nBits;
+    words.resize(numberWords(size), value ? ~(uint64_t)0 : 0);
+    nBits = size;
+    if (value && size > oldSize && oldSize % 64 != 0)
+        words[wordIndex(oldSize)] |= ~(uint64_t)0 << (oldSize % 64);
+    clearUnusedBits();
+}
+
+/**
+ * @brief DynamicBitset::clear
+ * Removes all the bits: the size of the bitset becomes 0.
+ */
+inline void DynamicBitset::clear()
+{
+    words.clear();
+    nBits = 0;
+}
+
+inline bool DynamicBitset::test(size_t i) const
+{
+    assert(i < nBits);
+    return (words[wordIndex(i)] & bitMask(i)) != 0;
+}
+
+inline bool DynamicBitset::operator[](size_t i) const
+{
+    return test(i);
+}
+
+inline void DynamicBitset::set(size_t i)
+{
+    assert(i < nBits);
+    words[wordIndex(i)] |= bitMask(i);
+}
+
+inline void DynamicBitset::set(size_t i, bool value)
+{
+    if (value)
+        set(i);
+    else
+        reset(i);
+}
+
+inline void DynamicBitset::reset(size_t i)
+{
+    assert(i < nBits);
+    words[wordIndex(i)] &= ~bitMask(i);
+}
+
+inline void DynamicBitset::flip(size_t i)
+{
+    assert(i < nBits);
+    words[wordIndex(i)] ^= bitMask(i);
+}
+
+/**
+ * @brief DynamicBitset::testAndSet
+ * Sets the i-th bit.
+ * @return the value of the i-th bit before the call
+ */
+inline bool DynamicBitset::testAndSet(size_t i)
+{
+    assert(i < nBits);
+    uint64_t& w = words[wordIndex(i)];
+    bool old = (w & bitMask(i)) != 0;
+    w |= bitMask(i);
+    return old;
+}
+
+inline void DynamicBitset::setAll()
+{
+    std::fill(words.begin(), words.end(), ~(uint64_t)0);
+    clearUnusedBits();
+}
+
+inline void DynamicBitset::resetAll()
+{
+    std::fill(words.begin(), words.end(), 0);
+}
+
+inline void DynamicBitset::flipAll()
+{
+    for (uint64_t& w : words)
+        w = ~w;
+    clearUnusedBits();
+}
+
+/**
+ * @brief DynamicBitset::count
+ * @return the number of set bits
+ */
+inline size_t DynamicBitset::count() const
+{
+    size_t c = 0;
+    for (uint64_t w : words)
+        c += internal::popcount(w);
+    return c;
+}
+
+inline bool DynamicBitset::any() const
+{
+    for (uint64_t w : words)
+        if (w != 0)
+            return true;
+    return false;
+}
+
+inline bool DynamicBitset::none() const
+{
+    return !any();
+}
+
+inline bool DynamicBitset::all() const
+{
+    return count() == nBits;
+}
+
+/**
+ * @brief DynamicBitset::intersects
+ * @return true if a bit is set both in this bitset and in other
+ */
+inline bool DynamicBitset::intersects(const DynamicBitset& other) const
+{
+    assert(nBits == other.nBits);
+    for (size_t i = 0; i < words.size(); i++)
+        if ((words[i] & other.words[i]) != 0)
+            return true;
+    return false;
+}
+
+/**
+ * @brief DynamicBitset::isSubsetOf
+ * @return true if all the bits set in this bitset are set in other
+ */
+inline bool DynamicBitset::isSubsetOf(const DynamicBitset& other) const
+{
+    assert(nBits == other.nBits);
+    for (size_t i = 0; i < words.size(); i++)
+        if ((words[i] & ~other.words[i]) != 0)
+            return false;
+    return true;
+}
+
+/**
+ * @brief DynamicBitset::findFirst
+ * @return the index of the first set bit, npos if there are no set bits
+ */
+inline size_t DynamicBitset::findFirst() const
+{
+    for (size_t i = 0; i < words.size(); i++)
+        if (words[i] != 0)
+            return i * 64 + internal::countTrailingZeros(words[i]);
+    return npos;
+}
+
+/**
+ * @brief DynamicBitset::findNext
+ * @return the index of the first set bit after i, npos if there are no set
+ * bits after i
+ */
+inline size_t DynamicBitset::findNext(size_t i) const
+{
+    i++;
+    if (i >= nBits)
+        return npos;
+    size_t wi = wordIndex(i);
+    uint64_t w = words[wi] & (~(uint64_t)0 << (i % 64));
+    while (w == 0) {
+        if (++wi == words.size())
+            return npos;
+        w = words[wi];
+    }
+    return wi * 64 + internal::countTrailingZeros(w);
+}
+
+inline DynamicBitset::ConstIterator DynamicBitset::begin() const
+{
+    return ConstIterator(this, findFirst());
+}
+
+inline DynamicBitset::ConstIterator DynamicBitset::end() const
+{
+    return ConstIterator(this, npos);
+}
+
+inline DynamicBitset& DynamicBitset::operator&=(const DynamicBitset& other)
+{
+    assert(nBits == other.nBits);
+    for (size_t i = 0; i < words.size(); i++)
+        words[i] &= other.words[i];
+    return *this;
+}
+
+inline DynamicBitset& DynamicBitset::operator|=(const DynamicBitset& other)
+{
+    assert(nBits == other.nBits);
+    for (size_t i = 0; i < words.size(); i++)
+        words[i] |= other.words[i];
+    return *this;
+}
+
+inline DynamicBitset& DynamicBitset::operator^=(const DynamicBitset& other)
+{
+    assert(nBits == other.nBits);
+    for (size_t i = 0; i < words.size(); i++)
+        words[i] ^= other.words[i];
+    return *this;
+}
+
+/**
+ * @brief DynamicBitset::operator -=
+ * Set difference: resets the bits that are set in other.
+ */
+inline DynamicBitset& DynamicBitset::operator-=(const DynamicBitset& other)
+{
+    assert(nBits == other.nBits);
+    for (size_t i = 0; i < words.size(); i++)
+        words[i] &= ~other.words[i];
+    return *this;
+}
+
+inline DynamicBitset DynamicBitset::operator~() const
+{
+    DynamicBitset b(*this);
+    b.flipAll();
+    return b;
+}
+
+inline bool DynamicBitset::operator==(const DynamicBitset& other) const
+{
+    return nBits == other.nBits && words == other.words;
+}
+
+inline bool DynamicBitset::operator!=(const DynamicBitset& other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * @brief DynamicBitset::getWords
+ * @return the words of the bitset: the i-th bit is the (i%64)-th bit of the
+ * (i/64)-th word, and the bits after size() are zero
+ */
+inline const std::vector<uint64_t>& DynamicBitset::getWords() const
+{
+    return words;
+}
+
+inline void DynamicBitset::swap(DynamicBitset& other)
+{
+    words.swap(other.words);
+    std::swap(nBits, other.nBits);
+}
+
+inline size_t DynamicBitset::wordIndex(size_t i)
+{
+    return i / 64;
+}
+
+inline uint64_t DynamicBitset::bitMask(size_t i)
+{
+    return (uint64_t)1 << (i % 64);
+}
+
+inline size_t DynamicBitset::numberWords(size_t size)
+{
+    return (size + 63) / 64;
+}
+
+inline void DynamicBitset::clearUnusedBits()
+{
+    if (nBits % 64 != 0)
+        words.back() &= ~(~(uint64_t)0 << (nBits % 64));
+}
+
+/* ----- ConstIterator ----- */
+
+inline DynamicBitset::ConstIterator::ConstIterator() :
+    bitset(nullptr),
+    pos(npos)
+{
+}
+
+inline DynamicBitset::ConstIterator::ConstIterator(const DynamicBitset* bitset, size_t pos) :
+    bitset(bitset),
+    pos(pos)
+{
+}
+
+inline size_t DynamicBitset::ConstIterator::operator*() const
+{
+    return pos;
+}
+
+inline DynamicBitset::ConstIterator& DynamicBitset::ConstIterator::operator++()
+{
+    pos = bitset->findNext(pos);
+    return *this;
+}
+
+inline DynamicBitset::ConstIterator DynamicBitset::ConstIterator::operator++(int)
+{
+    ConstIterator old = *this;
+    ++(*this);
+    return old;
+}
+
+inline bool DynamicBitset::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return pos == other.pos;
+}
+
+inline bool DynamicBitset::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return pos != other.pos;
+}
+
+/* ----- ConcurrentBitset ----- */
+
+inline ConcurrentBitset::ConcurrentBitset(size_t size) :
+    words(new std::atomic<uint64_t>[(size + 63) / 64]),
+    nWords((size + 63) / 64),
+    nBits(size)
+{
+    resetAll();
+}
+
+inline size_t ConcurrentBitset::size() const
+{
+    return nBits;
+}
+
+inline bool ConcurrentBitset::test(size_t i) const
+{
+    assert(i < nBits);
+    return (words[i / 64].load(std::memory_order_relaxed) & ((uint64_t)1 << (i % 64))) != 0;
+}
+
+/**
+ * @brief ConcurrentBitset::testAndSet
+ * Atomically sets the i-th bit.
+ * @return the value of the i-th bit before the call
+ */
+inline bool ConcurrentBitset::testAndSet(size_t i)
+{
+    assert(i < nBits);
+    uint64_t mask = (uint64_t)1 << (i % 64);
+    return (words[i / 64].fetch_or(mask, std::memory_order_relaxed) & mask) != 0;
+}
+
+inline void ConcurrentBitset::reset(size_t i)
+{
+    assert(i < nBits);
+    words[i / 64].fetch_and(~((uint64_t)1 << (i % 64)), std::memory_order_relaxed);
+}
+
+/**
+ * @brief ConcurrentBitset::resetAll
+ * Resets all the bits; it must not be called while other threads use the
+ * bitset.
+ */
+inline void ConcurrentBitset::resetAll()
+{
+    for (size_t i = 0; i < nWords; i++)
+        words[i].store(0, std::memory_order_relaxed);
+}
+
+inline size_t ConcurrentBitset::count() const
+{
+    size_t c = 0;
+    for (size_t i = 0; i < nWords; i++)
+        c += internal::popcount(words[i].load(std::memory_order_relaxed));
+    return c;
+}
+
+inline DynamicBitset ConcurrentBitset::toDynamicBitset() const
+{
+    DynamicBitset b(nBits);
+    for (size_t i = 0; i < nWords; i++) {
+        uint64_t w = words[i].load(std::memory_order_relaxed);
+        while (w != 0) {
+            b.set(i * 64 + internal::countTrailingZeros(w));
+            w &= w - 1;
+        }
+    }
+    return b;
+}
+
+/* ----- Non member functions ----- */
+
+inline DynamicBitset operator&(DynamicBitset a, const DynamicBitset& b)
+{
+    a &= b;
+    return a;
+}
+
+inline DynamicBitset operator|(DynamicBitset a, const DynamicBitset& b)
+{
+    a |= b;
+    return a;
+}
+
+inline DynamicBitset operator^(DynamicBitset a, const DynamicBitset& b)
+{
+    a ^= b;
+    return a;
+}
+
+inline DynamicBitset operator-(DynamicBitset a, const DynamicBitset& b)
+{
+    a -= b;
+    return a;
+}
+
+inline void swap(DynamicBitset& a, DynamicBitset& b)
+{
+    a.swap(b);
+}
+
+namespace internal {
+
+inline unsigned int popcount(uint64_t w)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_popcountll(w);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+    return (unsigned int)__popcnt64(w);
+    #else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned int)((w * 0x0101010101010101ULL) >> 56);
+    #endif
+}
+
+/**
+ * @brief countTrailingZeros
+ * @param w: a non zero word
+ * @return the index of the least significant set bit of w
+ */
+inline unsigned int countTrailingZeros(uint64_t w)
+{
+    assert(w != 0);
+    #if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctzll(w);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, w);
+    return (unsigned int)i;
+    #else
+    return popcount((w & (~w + 1)) - 1);
+    #endif
+}
+
+} //namespace cg3::internal
+
+} //namespace cg3
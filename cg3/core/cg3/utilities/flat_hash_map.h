@@ -0,0 +1,213 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_FLAT_HASH_MAP_H
+#define CG3_FLAT_HASH_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hash.h"
+
+namespace cg3 {
+
+namespace internal {
+
+template <typename K>
+struct FlatHashSetKeyOf
+{
+    static const K& get(const K& v) { return v; }
+};
+
+template <typename K, typename V>
+struct FlatHashMapKeyOf
+{
+    static const K& get(const std::pair<K, V>& v) { return v.first; }
+};
+
+/**
+ * @brief Open addressing hash table with linear probing, shared by
+ * FlatHashMap and FlatHashSet.
+ *
+ * Values are stored contiguously in a power of two array, with a byte per slot
+ * marking the used slots. Elements are removed with backward shift deletion,
+ * so there are no tombstones and probe sequences stay short also after many
+ * erasures.
+ */
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Equal>
+class FlatHashTable
+{
+public:
+    template <bool Const>
+    class Iterator;
+
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    explicit FlatHashTable(
+            size_t bucketCount = 0,
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal());
+
+    size_t size() const;
+    bool empty() const;
+    size_t bucketCount() const;
+    double loadFactor() const;
+
+    void clear();
+    void reserve(size_t n);
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+    size_t count(const Key& key) const;
+
+    std::pair<iterator, bool> insert(const Value& value);
+    std::pair<iterator, bool> insert(Value&& value);
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last);
+
+    size_t erase(const Key& key);
+
+    void swap(FlatHashTable& other);
+
+protected:
+    static const size_t NOT_FOUND = (size_t)-1;
+
+    size_t bucket(const Key& key) const;
+    size_t findIndex(const Key& key) const;
+    std::pair<size_t, bool> findOrReserve(const Key& key);
+    void rehash(size_t bucketCount);
+
+    std::vector<Value> slots;
+    std::vector<unsigned char> used;
+    size_t nElements;
+    size_t mask;
+    Hash hasher;
+    Equal equal;
+};
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Equal>
+template <bool Const>
+class FlatHashTable<Value, Key, KeyOf, Hash, Equal>::Iterator
+{
+    friend class FlatHashTable<Value, Key, KeyOf, Hash, Equal>;
+    typedef typename std::conditional<Const, const FlatHashTable, FlatHashTable>::type Table;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const Value*, Value*>::type pointer;
+    typedef typename std::conditional<Const, const Value&, Value&>::type reference;
+
+    Iterator();
+    Iterator(const Iterator<false>& it);
+
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    Iterator operator++(int);
+    bool operator==(const Iterator& other) const;
+    bool operator!=(const Iterator& other) const;
+
+private:
+    template <bool> friend class Iterator;
+    Iterator(Table* table, size_t index);
+    void skipUnused();
+
+    Table* table;
+    size_t index;
+};
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3core
+ * @brief The FlatHashMap class is an open addressing hash map, with an
+ * interface similar to std::unordered_map.
+ *
+ * Keys and values are stored in a single contiguous array and looked up
+ * with linear probing: lookups touch one or two cache lines instead of
+ * following the node pointers of std::map and std::unordered_map. It is
+ * well suited for small keys with a cheap hash, like points (see the
+ * std::hash specializations of cg3::Point and cg3::Point2D, and
+ * cg3::SpatialHash for epsilon-quantised keys).
+ *
+ * Differences with std::unordered_map:
+ * - keys and values must be default constructible and movable;
+ * - insertions and erasures invalidate all the iterators, pointers and
+ *   references to the elements;
+ * - the value type is std::pair<K, V>: the key must not be modified through an
+ *   iterator.
+ *
+ * \code{.cpp}
+ * cg3::FlatHashMap<cg3::Pointd, unsigned int> ids;
+ * ids[p] = 3;
+ * auto it = ids.find(q);
+ * if (it != ids.end())
+ *     std::cout << it->second;
+ * \endcode
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+class FlatHashMap :
+        public internal::FlatHashTable<std::pair<K, V>, K, internal::FlatHashMapKeyOf<K, V>, Hash, Equal>
+{
+    typedef internal::FlatHashTable<std::pair<K, V>, K, internal::FlatHashMapKeyOf<K, V>, Hash, Equal> Base;
+
+public:
+    typedef V mapped_type;
+
+    explicit FlatHashMap(
+            size_t bucketCount = 0,
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal());
+    FlatHashMap(std::initializer_list<std::pair<K, V>> list);
+
+    V& operator[](const K& key);
+    V& at(const K& key);
+    const V& at(const K& key) const;
+};
+
+/**
+ * @ingroup cg3core
+ * @brief The FlatHashSet class is an open addressing hash set, with an
+ * interface similar to std::unordered_set. See FlatHashMap for the details.
+ *
+ * Elements must not be modified through an iterator.
+ */
+template <typename K, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+class FlatHashSet :
+        public internal::FlatHashTable<K, K, internal::FlatHashSetKeyOf<K>, Hash, Equal>
+{
+    typedef internal::FlatHashTable<K, K, internal::FlatHashSetKeyOf<K>, Hash, Equal> Base;
+
+public:
+    explicit FlatHashSet(
+            size_t bucketCount = 0,
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal());
+    FlatHashSet(std::initializer_list<K> list);
+};
+
+} //namespace cg3
+
+#include "flat_hash_map.tpp"
+
+#endif // CG3_FLAT_HASH_MAP_H
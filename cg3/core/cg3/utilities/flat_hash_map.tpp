@@ -0,0 +1,456 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "flat_hash_map.h"
+
+#include <stdexcept>
+
+#define CG3_FLAT_HASH_TABLE_TEMPLATE template <typename Value, typename Key, typename KeyOf, typename Hash, typename Equal>
+#define CG3_FLAT_HASH_TABLE FlatHashTable<Value, Key, KeyOf, Hash, Equal>
+
+namespace cg3 {
+
+namespace internal {
+
+/* ----- FlatHashTable ----- */
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline CG3_FLAT_HASH_TABLE::FlatHashTable(
+        size_t bucketCount,
+        const Hash& hash,
+        const Equal& equal) :
+    nElements(0),
+    mask(0),
+    hasher(hash),
+    equal(equal)
+{
+    if (bucketCount > 0)
+        reserve(bucketCount);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline size_t CG3_FLAT_HASH_TABLE::size() const
+{
+    return nElements;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline bool CG3_FLAT_HASH_TABLE::empty() const
+{
+    return nElements == 0;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline size_t CG3_FLAT_HASH_TABLE::bucketCount() const
+{
+    return slots.size();
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline double CG3_FLAT_HASH_TABLE::loadFactor() const
+{
+    return slots.empty() ? 0 : (double)nElements / slots.size();
+}
+
+/**
+ * @brief FlatHashTable::clear
+ * Removes all the elements. The allocated memory is kept.
+ */
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline void CG3_FLAT_HASH_TABLE::clear()
+{
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (used[i]) {
+            slots[i] = Value();
+            used[i] = 0;
+        }
+    }
+    nElements = 0;
+}
+
+/**
+ * @brief FlatHashTable::reserve
+ * Allocates enough space for n elements, so that inserting up to n elements
+ * does not cause a rehash.
+ * @param n
+ */
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline void CG3_FLAT_HASH_TABLE::reserve(size_t n)
+{
+    //maximum load factor is 3/4
+    size_t needed = n + n / 3 + 1;
+    size_t capacity = 16;
+    while (capacity < needed)
+        capacity *= 2;
+    if (capacity > slots.size())
+        rehash(capacity);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::iterator CG3_FLAT_HASH_TABLE::begin()
+{
+    iterator it(this, 0);
+    it.skipUnused();
+    return it;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::iterator CG3_FLAT_HASH_TABLE::end()
+{
+    return iterator(this, slots.size());
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::const_iterator CG3_FLAT_HASH_TABLE::begin() const
+{
+    const_iterator it(this, 0);
+    it.skipUnused();
+    return it;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::const_iterator CG3_FLAT_HASH_TABLE::end() const
+{
+    return const_iterator(this, slots.size());
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::const_iterator CG3_FLAT_HASH_TABLE::cbegin() const
+{
+    return begin();
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::const_iterator CG3_FLAT_HASH_TABLE::cend() const
+{
+    return end();
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::iterator CG3_FLAT_HASH_TABLE::find(const Key& key)
+{
+    size_t i = findIndex(key);
+    return i == NOT_FOUND ? end() : iterator(this, i);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline typename CG3_FLAT_HASH_TABLE::const_iterator CG3_FLAT_HASH_TABLE::find(const Key& key) const
+{
+    size_t i = findIndex(key);
+    return i == NOT_FOUND ? end() : const_iterator(this, i);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline size_t CG3_FLAT_HASH_TABLE::count(const Key& key) const
+{
+    return findIndex(key) == NOT_FOUND ? 0 : 1;
+}
+
+/**
+ * @brief FlatHashTable::insert
+ * Inserts value if its key is not already contained in the table.
+ * @param value
+ * @return an iterator to the element with the key of value, and true if the
+ * insertion took place
+ */
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline std::pair<typename CG3_FLAT_HASH_TABLE::iterator, bool> CG3_FLAT_HASH_TABLE::insert(const Value& value)
+{
+    std::pair<size_t, bool> r = findOrReserve(KeyOf::get(value));
+    if (r.second)
+        slots[r.first] = value;
+    return std::make_pair(iterator(this, r.first), r.second);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline std::pair<typename CG3_FLAT_HASH_TABLE::iterator, bool> CG3_FLAT_HASH_TABLE::insert(Value&& value)
+{
+    std::pair<size_t, bool> r = findOrReserve(KeyOf::get(value));
+    if (r.second)
+        slots[r.first] = std::move(value);
+    return std::make_pair(iterator(this, r.first), r.second);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <typename InputIterator>
+inline void CG3_FLAT_HASH_TABLE::insert(InputIterator first, InputIterator last)
+{
+    for (; first != last; ++first)
+        insert(*first);
+}
+
+/**
+ * @brief FlatHashTable::erase
+ * Removes the element with the given key, if present. The following elements
+ * of the probe sequence are shifted back, hence all the iterators are
+ * invalidated.
+ * @param key
+ * @return the number of removed elements (0 or 1)
+ */
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline size_t CG3_FLAT_HASH_TABLE::erase(const Key& key)
+{
+    size_t i = findIndex(key);
+    if (i == NOT_FOUND)
+        return 0;
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!used[j])
+            break;
+        size_t ideal = bucket(KeyOf::get(slots[j]));
+        //the element in j can be moved in i only if its ideal bucket is not in (i, j]
+        bool stays = i <= j ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+        if (!stays) {
+            slots[i] = std::move(slots[j]);
+            i = j;
+        }
+    }
+    slots[i] = Value();
+    used[i] = 0;
+    nElements--;
+    return 1;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline void CG3_FLAT_HASH_TABLE::swap(FlatHashTable& other)
+{
+    std::swap(slots, other.slots);
+    std::swap(used, other.used);
+    std::swap(nElements, other.nElements);
+    std::swap(mask, other.mask);
+    std::swap(hasher, other.hasher);
+    std::swap(equal, other.equal);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline size_t CG3_FLAT_HASH_TABLE::bucket(const Key& key) const
+{
+    //mixed again: std::hash of integers is the identity
+    return hashMix(hasher(key)) & mask;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline size_t CG3_FLAT_HASH_TABLE::findIndex(const Key& key) const
+{
+    if (nElements == 0)
+        return NOT_FOUND;
+    for (size_t i = bucket(key); used[i]; i = (i + 1) & mask) {
+        if (equal(KeyOf::get(slots[i]), key))
+            return i;
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * @brief FlatHashTable::findOrReserve
+ * @return the index of the element with the given key and false if the key
+ * is already in the table; otherwise, the index of a slot (marked as used)
+ * where the element must be written, and true.
+ */
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline std::pair<size_t, bool> CG3_FLAT_HASH_TABLE::findOrReserve(const Key& key)
+{
+    if ((nElements + 1) * 4 > slots.size() * 3)
+        rehash(slots.empty() ? 16 : slots.size() * 2);
+    size_t i = bucket(key);
+    for (; used[i]; i = (i + 1) & mask) {
+        if (equal(KeyOf::get(slots[i]), key))
+            return std::make_pair(i, false);
+    }
+    used[i] = 1;
+    nElements++;
+    return std::make_pair(i, true);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+inline void CG3_FLAT_HASH_TABLE::rehash(size_t bucketCount)
+{
+    std::vector<Value> oldSlots(bucketCount);
+    std::vector<unsigned char> oldUsed(bucketCount, 0);
+    oldSlots.swap(slots);
+    oldUsed.swap(used);
+    mask = bucketCount - 1;
+    for (size_t j = 0; j < oldSlots.size(); j++) {
+        if (oldUsed[j]) {
+            size_t i = bucket(KeyOf::get(oldSlots[j]));
+            while (used[i])
+                i = (i + 1) & mask;
+            slots[i] = std::move(oldSlots[j]);
+            used[i] = 1;
+        }
+    }
+}
+
+/* ----- FlatHashTable::Iterator ----- */
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline CG3_FLAT_HASH_TABLE::Iterator<Const>::Iterator() :
+    table(nullptr),
+    index(0)
+{
+}
+
+/**
+ * @brief Conversion from iterator to const_iterator
+ */
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline CG3_FLAT_HASH_TABLE::Iterator<Const>::Iterator(const Iterator<false>& it) :
+    table(it.table),
+    index(it.index)
+{
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline CG3_FLAT_HASH_TABLE::Iterator<Const>::Iterator(Table* table, size_t index) :
+    table(table),
+    index(index)
+{
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline typename CG3_FLAT_HASH_TABLE::template Iterator<Const>::reference
+CG3_FLAT_HASH_TABLE::Iterator<Const>::operator*() const
+{
+    return table->slots[index];
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline typename CG3_FLAT_HASH_TABLE::template Iterator<Const>::pointer
+CG3_FLAT_HASH_TABLE::Iterator<Const>::operator->() const
+{
+    return &table->slots[index];
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline typename CG3_FLAT_HASH_TABLE::template Iterator<Const>&
+CG3_FLAT_HASH_TABLE::Iterator<Const>::operator++()
+{
+    index++;
+    skipUnused();
+    return *this;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline typename CG3_FLAT_HASH_TABLE::template Iterator<Const>
+CG3_FLAT_HASH_TABLE::Iterator<Const>::operator++(int)
+{
+    Iterator old = *this;
+    ++(*this);
+    return old;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline bool CG3_FLAT_HASH_TABLE::Iterator<Const>::operator==(const Iterator& other) const
+{
+    return index == other.index && table == other.table;
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline bool CG3_FLAT_HASH_TABLE::Iterator<Const>::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+CG3_FLAT_HASH_TABLE_TEMPLATE
+template <bool Const>
+inline void CG3_FLAT_HASH_TABLE::Iterator<Const>::skipUnused()
+{
+    while (index < table->used.size() && !table->used[index])
+        index++;
+}
+
+} //namespace cg3::internal
+
+/* ----- FlatHashMap ----- */
+
+template <typename K, typename V, typename Hash, typename Equal>
+inline FlatHashMap<K, V, Hash, Equal>::FlatHashMap(
+        size_t bucketCount,
+        const Hash& hash,
+        const Equal& equal) :
+    Base(bucketCount, hash, equal)
+{
+}
+
+template <typename K, typename V, typename Hash, typename Equal>
+inline FlatHashMap<K, V, Hash, Equal>::FlatHashMap(std::initializer_list<std::pair<K, V>> list) :
+    Base(list.size())
+{
+    Base::insert(list.begin(), list.end());
+}
+
+/**
+ * @brief FlatHashMap::operator []
+ * @param key
+ * @return a reference to the value associated to key, which is default
+ * constructed and inserted if key is not in the map.
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+inline V& FlatHashMap<K, V, Hash, Equal>::operator[](const K& key)
+{
+    std::pair<size_t, bool> r = Base::findOrReserve(key);
+    if (r.second)
+        Base::slots[r.first].first = key;
+    return Base::slots[r.first].second;
+}
+
+/**
+ * @brief FlatHashMap::at
+ * @param key
+ * @throws std::out_of_range if key is not in the map
+ * @return a reference to the value associated to key
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+inline V& FlatHashMap<K, V, Hash, Equal>::at(const K& key)
+{
+    size_t i = Base::findIndex(key);
+    if (i == Base::NOT_FOUND)
+        throw std::out_of_range("cg3::FlatHashMap::at");
+    return Base::slots[i].second;
+}
+
+template <typename K, typename V, typename Hash, typename Equal>
+inline const V& FlatHashMap<K, V, Hash, Equal>::at(const K& key) const
+{
+    size_t i = Base::findIndex(key);
+    if (i == Base::NOT_FOUND)
+        throw std::out_of_range("cg3::FlatHashMap::at");
+    return Base::slots[i].second;
+}
+
+/* ----- FlatHashSet ----- */
+
+template <typename K, typename Hash, typename Equal>
+inline FlatHashSet<K, Hash, Equal>::FlatHashSet(
+        size_t bucketCount,
+        const Hash& hash,
+        const Equal& equal) :
+    Base(bucketCount, hash, equal)
+{
+}
+
+template <typename K, typename Hash, typename Equal>
+inline FlatHashSet<K, Hash, Equal>::FlatHashSet(std::initializer_list<K> list) :
+    Base(list.size())
+{
+    Base::insert(list.begin(), list.end());
+}
+
+} //namespace cg3
+
+#undef CG3_FLAT_HASH_TABLE_TEMPLATE
+#undef CG3_FLAT_HASH_TABLE
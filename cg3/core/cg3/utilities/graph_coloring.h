@@ -0,0 +1,48 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_GRAPH_COLORING_H
+#define CG3_GRAPH_COLORING_H
+
+#include <vector>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief Options of greedyColoring and parallelGreedyColoring.
+ */
+struct ColoringOptions
+{
+    ColoringOptions(unsigned int maxColors = (unsigned int)-1, bool largestDegreeFirst = false);
+
+    /** @brief maximum number of colors: nodes that cannot be colored with
+     *  maxColors colors get color -1. */
+    unsigned int maxColors;
+
+    /** @brief if true, nodes with higher degree are colored first, which
+     *  usually reduces the number of used colors. */
+    bool largestDegreeFirst;
+};
+
+std::vector<int> greedyColoring(
+        const std::vector<unsigned int>& offsets,
+        const std::vector<unsigned int>& adjacencies,
+        const ColoringOptions& options = ColoringOptions());
+
+std::vector<int> parallelGreedyColoring(
+        const std::vector<unsigned int>& offsets,
+        const std::vector<unsigned int>& adjacencies,
+        const ColoringOptions& options = ColoringOptions());
+
+unsigned int numberOfColors(const std::vector<int>& colors);
+
+} //namespace cg3
+
+#include "graph_coloring.tpp"
+
+#endif // CG3_GRAPH_COLORING_H
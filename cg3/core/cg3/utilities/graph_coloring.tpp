@@ -0,0 +1,191 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "graph_coloring.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "dynamic_bitset.h"
+#include "hash.h"
+#include "parallel.h"
+
+namespace cg3 {
+
+namespace internal {
+
+inline unsigned int maxDegree(const std::vector<unsigned int>& offsets)
+{
+    unsigned int n = (unsigned int)offsets.size() - 1;
+    return parallelReduce(0u, n, 0u, [&](unsigned int i) {
+        return offsets[i+1] - offsets[i];
+    }, [](unsigned int a, unsigned int b) {
+        return std::max(a, b);
+    });
+}
+
+/**
+ * @brief smallestFreeColor
+ * @param used: bitset with a bit for every color, all reset; it is reset
+ * again before returning
+ * @return the smallest color, lower than maxColors, not used by the colored
+ * adjacent nodes of i, -1 if there is not such a color
+ */
+inline int smallestFreeColor(
+        unsigned int i,
+        const std::vector<unsigned int>& offsets,
+        const std::vector<unsigned int>& adjacencies,
+        const std::vector<int>& colors,
+        unsigned int maxColors,
+        DynamicBitset& used)
+{
+    for (unsigned int j = offsets[i]; j < offsets[i+1]; j++) {
+        int c = colors[adjacencies[j]];
+        if (c >= 0 && (size_t)c < used.size())
+            used.set(c);
+    }
+    size_t c = 0;
+    while (c < used.size() && used.test(c))
+        c++;
+    for (unsigned int j = offsets[i]; j < offsets[i+1]; j++) {
+        int a = colors[adjacencies[j]];
+        if (a >= 0 && (size_t)a < used.size())
+            used.reset(a);
+    }
+    return c < maxColors ? (int)c : -1;
+}
+
+} //namespace cg3::internal
+
+inline ColoringOptions::ColoringOptions(unsigned int maxColors, bool largestDegreeFirst) :
+    maxColors(maxColors),
+    largestDegreeFirst(largestDegreeFirst)
+{
+}
+
+/**
+ * @ingroup cg3core
+ * @brief greedyColoring
+ * Colors the nodes of a graph such that adjacent nodes have different colors:
+ * every node, in order of index (or of decreasing degree if
+ * options.largestDegreeFirst), takes the smallest color not used by its
+ * adjacent nodes. The graph is given in compressed sparse row format: the
+ * nodes adjacent to the node i are adjacencies[offsets[i]], ...,
+ * adjacencies[offsets[i+1]-1], and adjacencies must be symmetric.
+ * @return the color of every node, in [0, options.maxColors), or -1 for the
+ * nodes that cannot be colored
+ */
+inline std::vector<int> greedyColoring(
+        const std::vector<unsigned int>& offsets,
+        const std::vector<unsigned int>& adjacencies,
+        const ColoringOptions& options)
+{
+    assert(!offsets.empty());
+    unsigned int n = (unsigned int)offsets.size() - 1;
+    std::vector<int> colors(n, -1);
+    std::vector<unsigned int> order(n);
+    for (unsigned int i = 0; i < n; i++)
+        order[i] = i;
+    if (options.largestDegreeFirst) {
+        std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+            return offsets[a+1] - offsets[a] > offsets[b+1] - offsets[b];
+        });
+    }
+    DynamicBitset used(internal::maxDegree(offsets) + 1);
+    for (unsigned int i : order)
+        colors[i] = internal::smallestFreeColor(i, offsets, adjacencies, colors, options.maxColors, used);
+    return colors;
+}
+
+/**
+ * @ingroup cg3core
+ * @brief parallelGreedyColoring
+ * Parallel version of greedyColoring, with the Jones-Plassmann algorithm:
+ * every node has a priority (a hash of its index, preceded by its degree if
+ * options.largestDegreeFirst), and at every round the nodes whose priority is
+ * higher than the priority of all their uncolored adjacent nodes take, in
+ * parallel, the smallest color not used by their adjacent nodes. The result
+ * does not depend on the number of threads, but it is in general different
+ * from the one of greedyColoring.
+ * @return the color of every node, in [0, options.maxColors), or -1 for the
+ * nodes that cannot be colored
+ */
+inline std::vector<int> parallelGreedyColoring(
+        const std::vector<unsigned int>& offsets,
+        const std::vector<unsigned int>& adjacencies,
+        const ColoringOptions& options)
+{
+    assert(!offsets.empty());
+    unsigned int n = (unsigned int)offsets.size() - 1;
+    std::vector<int> colors(n, -1);
+    std::vector<char> done(n, false);
+    std::vector<uint64_t> priorities(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        uint64_t h = hashMix(i) & 0xFFFFFFFF;
+        if (options.largestDegreeFirst)
+            h |= (uint64_t)(offsets[i+1] - offsets[i]) << 32;
+        priorities[i] = h;
+    });
+    auto higher = [&](unsigned int a, unsigned int b) {
+        return priorities[a] > priorities[b] || (priorities[a] == priorities[b] && a > b);
+    };
+
+    size_t colorsSize = internal::maxDegree(offsets) + 1;
+    std::vector<unsigned int> remaining(n);
+    for (unsigned int i = 0; i < n; i++)
+        remaining[i] = i;
+    std::vector<char> isSelected(n, false);
+    while (!remaining.empty()) {
+        //nodes with the highest priority among their uncolored neighbours
+        parallelFor((size_t)0, remaining.size(), [&](size_t k) {
+            unsigned int i = remaining[k];
+            bool max = true;
+            for (unsigned int j = offsets[i]; j < offsets[i+1] && max; j++) {
+                unsigned int a = adjacencies[j];
+                if (!done[a] && a != i && higher(a, i))
+                    max = false;
+            }
+            isSelected[k] = max;
+        });
+        //selected nodes are an independent set: they are colored in parallel
+        const size_t grain = 1024;
+        parallelFor((size_t)0, (remaining.size() + grain - 1) / grain, [&](size_t chunk) {
+            DynamicBitset used(colorsSize);
+            size_t end = std::min(remaining.size(), (chunk + 1) * grain);
+            for (size_t k = chunk * grain; k < end; k++) {
+                unsigned int i = remaining[k];
+                if (isSelected[k])
+                    colors[i] = internal::smallestFreeColor(i, offsets, adjacencies, colors, options.maxColors, used);
+            }
+        });
+        std::vector<unsigned int> next;
+        for (size_t k = 0; k < remaining.size(); k++) {
+            if (isSelected[k])
+                done[remaining[k]] = true;
+            else
+                next.push_back(remaining[k]);
+        }
+        remaining.swap(next);
+    }
+    return colors;
+}
+
+/**
+ * @ingroup cg3core
+ * @brief numberOfColors
+ * @return the number of colors used by a coloring computed by greedyColoring
+ * or parallelGreedyColoring
+ */
+inline unsigned int numberOfColors(const std::vector<int>& colors)
+{
+    int max = -1;
+    for (int c : colors)
+        max = std::max(max, c);
+    return (unsigned int)(max + 1);
+}
+
+} //namespace cg3
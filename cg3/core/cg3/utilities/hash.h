@@ -12,6 +12,7 @@
 #include <set>
 #include <list>
 #include <array>
+#include <cstdint>
 #include "../cg3lib.h"
 
 namespace cg3 {
@@ -21,6 +22,14 @@ inline void hashCombine(std::size_t& seed);
 template <typename T, typename... Rest>
 inline void hashCombine(std::size_t& seed, const T& v, Rest... rest);
 
+std::size_t hashMix(std::uint64_t h);
+
+template <typename T>
+std::uint64_t hashScalar(const T& v);
+
+template <typename T, typename... Rest>
+std::size_t hashScalars(const T& v, const Rest&... rest);
+
 } //namespace cg3
 
 namespace std {
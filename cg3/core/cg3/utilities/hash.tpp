@@ -7,6 +7,9 @@
 
 #include "hash.h"
 
+#include <cstring>
+#include <type_traits>
+
 namespace cg3 {
 
 inline void hashCombine(std::size_t& seed)
@@ -33,6 +36,99 @@ inline void hashCombine(std::size_t& seed, const T& v, Rest... rest)
     hashCombine(seed, rest...);
 }
 
+/**
+ * @ingroup cg3core
+ * @brief hashMix
+ * Finalization step of MurmurHash3: every bit of the input affects every bit
+ * of the output. It makes good hashes out of values with poor entropy on the
+ * low bits (e.g. the bit patterns of floating point numbers).
+ * @param h
+ * @return the mixed hash
+ */
+inline std::size_t hashMix(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (std::size_t)h;
+}
+
+namespace internal {
+
+template <typename T>
+inline std::uint64_t hashScalarHelper(const T& v, std::true_type)
+{
+    //0.0 and -0.0 are equal, but have different bit patterns
+    if (v == 0)
+        return 0;
+    double d = v;
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+inline std::uint64_t hashScalarHelper(const T& v, std::false_type)
+{
+    return (std::uint64_t)v;
+}
+
+inline std::uint64_t hashScalarsHelper(std::uint64_t h)
+{
+    return h;
+}
+
+template <typename T, typename... Rest>
+inline std::uint64_t hashScalarsHelper(std::uint64_t h, const T& v, const Rest&... rest);
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3core
+ * @brief hashScalar
+ * Returns the bit pattern of an arithmetic value, to be combined with
+ * hashScalars or hashMix. Floating point values equal to zero (0.0 and -0.0)
+ * return the same value.
+ * @param v
+ * @return
+ */
+template <typename T>
+inline std::uint64_t hashScalar(const T& v)
+{
+    return internal::hashScalarHelper(v, std::integral_constant<bool, std::is_floating_point<T>::value>());
+}
+
+/**
+ * @ingroup cg3core
+ * @brief hashScalars
+ * Fast hash of a sequence of arithmetic values: the bit patterns of the values
+ * are combined with multiplications by an odd constant, and mixed once at the
+ * end. It is much cheaper than combining std::hash values with hashCombine,
+ * and it is used by the hash specializations of points and colors.
+ *
+ * \code{.cpp}
+ * std::size_t h = hashScalars(p.x(), p.y(), p.z());
+ * \endcode
+ * @return the hash of the values
+ */
+template <typename T, typename... Rest>
+inline std::size_t hashScalars(const T& v, const Rest&... rest)
+{
+    return hashMix(internal::hashScalarsHelper(0, v, rest...));
+}
+
+namespace internal {
+
+template <typename T, typename... Rest>
+inline std::uint64_t hashScalarsHelper(std::uint64_t h, const T& v, const Rest&... rest)
+{
+    return hashScalarsHelper((h + hashScalar(v)) * 0x9e3779b97f4a7c15ULL, rest...);
+}
+
+} //namespace cg3::internal
+
 } //namespace cg3
 
 namespace std {
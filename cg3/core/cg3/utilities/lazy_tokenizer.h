@@ -0,0 +1,98 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_LAZY_TOKENIZER_H
+#define CG3_LAZY_TOKENIZER_H
+
+#include <array>
+#include <iterator>
+
+#include "string_view.h"
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The LazyTokenizer class splits a string into tokens without
+ * allocating memory.
+ *
+ * Differently from cg3::Tokenizer, tokens are not copied into a vector of
+ * strings: they are computed while iterating and returned as cg3::StringView
+ * objects that refer to the input buffer, which must outlive the tokenizer
+ * and its tokens. It is possible to specify more than one separator; sequences
+ * of consecutive separators are collapsed, so empty tokens are never returned.
+ *
+ * \code{.cpp}
+ * std::string line = "v 0.5\t1.0  2.0";
+ * cg3::LazyTokenizer tokenizer(line, " \t");
+ * cg3::LazyTokenizer::iterator token = tokenizer.begin();
+ * if (*token == "v") {
+ *     double x = cg3::stod(*(++token)); //0.5
+ *     ...
+ * }
+ * \endcode
+ */
+class LazyTokenizer
+{
+public:
+    class iterator;
+    typedef iterator const_iterator;
+
+    LazyTokenizer();
+    LazyTokenizer(const char* string, const char* separators = " ");
+    LazyTokenizer(const std::string& string, const char* separators = " ");
+    LazyTokenizer(const StringView& string, const char* separators = " ");
+
+    iterator begin() const;
+    iterator end() const;
+    bool empty() const;
+
+    unsigned long int size() const;
+
+private:
+    bool isSeparator(char c) const;
+    void setSeparators(const char* separators);
+
+    StringView string;
+    std::array<bool, 256> separatorTable;
+};
+
+/**
+ * @brief Forward iterator on the tokens of a LazyTokenizer.
+ */
+class LazyTokenizer::iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef StringView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const StringView* pointer;
+    typedef const StringView& reference;
+
+    iterator();
+
+    reference operator*() const;
+    pointer operator->() const;
+    iterator& operator++();
+    iterator operator++(int);
+    bool operator==(const iterator& other) const;
+    bool operator!=(const iterator& other) const;
+
+private:
+    friend class LazyTokenizer;
+    iterator(const LazyTokenizer* tokenizer, const char* position);
+    void findToken(const char* from);
+
+    const LazyTokenizer* tokenizer;
+    StringView token;
+};
+
+} //namespace cg3
+
+#include "lazy_tokenizer.tpp"
+
+#endif // CG3_LAZY_TOKENIZER_H
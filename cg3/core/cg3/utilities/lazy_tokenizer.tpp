@@ -0,0 +1,136 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "lazy_tokenizer.h"
+
+namespace cg3 {
+
+inline LazyTokenizer::LazyTokenizer()
+{
+    setSeparators("");
+}
+
+inline LazyTokenizer::LazyTokenizer(const char* string, const char* separators) :
+    string(string)
+{
+    setSeparators(separators);
+}
+
+inline LazyTokenizer::LazyTokenizer(const std::string& string, const char* separators) :
+    string(string)
+{
+    setSeparators(separators);
+}
+
+inline LazyTokenizer::LazyTokenizer(const StringView& string, const char* separators) :
+    string(string)
+{
+    setSeparators(separators);
+}
+
+inline LazyTokenizer::iterator LazyTokenizer::begin() const
+{
+    return iterator(this, string.begin());
+}
+
+inline LazyTokenizer::iterator LazyTokenizer::end() const
+{
+    return iterator(this, string.end());
+}
+
+inline bool LazyTokenizer::empty() const
+{
+    return begin() == end();
+}
+
+/**
+ * @brief LazyTokenizer::size
+ * @return the number of tokens. It requires a full scan of the string.
+ */
+inline unsigned long LazyTokenizer::size() const
+{
+    unsigned long int n = 0;
+    for (iterator it = begin(); it != end(); ++it)
+        n++;
+    return n;
+}
+
+inline bool LazyTokenizer::isSeparator(char c) const
+{
+    return separatorTable[(unsigned char)c];
+}
+
+inline void LazyTokenizer::setSeparators(const char* separators)
+{
+    separatorTable.fill(false);
+    for (const char* s = separators; *s != '\0'; ++s)
+        separatorTable[(unsigned char)*s] = true;
+}
+
+inline LazyTokenizer::iterator::iterator() :
+    tokenizer(nullptr)
+{
+}
+
+inline LazyTokenizer::iterator::iterator(const LazyTokenizer* tokenizer, const char* position) :
+    tokenizer(tokenizer)
+{
+    findToken(position);
+}
+
+/**
+ * @brief LazyTokenizer::iterator::findToken
+ * Skips the separators starting from the given position and sets the current
+ * token to the next maximal sequence of non-separator characters. When the
+ * end of the string is reached, the token is the empty view at the end of the
+ * string, which is the past-the-end iterator.
+ */
+inline void LazyTokenizer::iterator::findToken(const char* from)
+{
+    const char* last = tokenizer->string.end();
+    while (from != last && tokenizer->isSeparator(*from))
+        ++from;
+    const char* to = from;
+    while (to != last && !tokenizer->isSeparator(*to))
+        ++to;
+    token = StringView(from, to);
+}
+
+inline LazyTokenizer::iterator::reference LazyTokenizer::iterator::operator*() const
+{
+    return token;
+}
+
+inline LazyTokenizer::iterator::pointer LazyTokenizer::iterator::operator->() const
+{
+    return &token;
+}
+
+inline LazyTokenizer::iterator& LazyTokenizer::iterator::operator++()
+{
+    findToken(token.end());
+    return *this;
+}
+
+inline LazyTokenizer::iterator LazyTokenizer::iterator::operator++(int)
+{
+    iterator old = *this;
+    ++(*this);
+    return old;
+}
+
+inline bool LazyTokenizer::iterator::operator==(const iterator& other) const
+{
+    return token.data() == other.token.data();
+}
+
+inline bool LazyTokenizer::iterator::operator!=(const iterator& other) const
+{
+    return !(*this == other);
+}
+
+} //namespace cg3
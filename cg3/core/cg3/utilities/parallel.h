@@ -0,0 +1,102 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_PARALLEL_H
+#define CG3_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+#include "thread_pool.h"
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief Per-call options of the parallel algorithms.
+ */
+struct ParallelOptions
+{
+    ParallelOptions(unsigned int nThreads = 0, size_t grainSize = 0, bool deterministic = true);
+
+    /** @brief maximum number of threads used by the call; 0 means the
+     *  concurrency of the global pool (see cg3::setNumberOfThreads). */
+    unsigned int nThreads;
+
+    /** @brief minimum number of elements processed by a task; 0 means that it
+     *  is chosen automatically. */
+    size_t grainSize;
+
+    /** @brief if true, reductions and scans split the input in the same
+     *  chunks and combine the partial results in the same order regardless of
+     *  the number of threads and of the scheduling: results on floating point
+     *  values are reproducible bit by bit. If false, the partial results of
+     *  every thread are combined in an unspecified order, which is faster for
+     *  cheap operations. */
+    bool deterministic;
+};
+
+void setNumberOfThreads(unsigned int nThreads);
+unsigned int numberOfThreads();
+
+template <typename Index, typename F>
+void parallelFor(
+        Index begin,
+        Index end,
+        F f,
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename T, typename Index, typename Map, typename Combine>
+T parallelReduce(
+        Index begin,
+        Index end,
+        const T& identity,
+        Map map,
+        Combine combine,
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename RandomIt, typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+void parallelSort(
+        RandomIt first,
+        RandomIt last,
+        Compare comp = Compare(),
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename RandomIt1, typename RandomIt2, typename OutputIt, typename Compare = std::less<typename std::iterator_traits<RandomIt1>::value_type>>
+OutputIt parallelMerge(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        OutputIt out,
+        Compare comp = Compare(),
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp = std::plus<T>>
+T parallelScan(
+        RandomIt first,
+        RandomIt last,
+        OutputIt out,
+        const T& init,
+        BinaryOp op = BinaryOp(),
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp = std::plus<T>>
+T parallelExclusiveScan(
+        RandomIt first,
+        RandomIt last,
+        OutputIt out,
+        const T& init,
+        BinaryOp op = BinaryOp(),
+        const ParallelOptions& options = ParallelOptions());
+
+} //namespace cg3
+
+#include "parallel.tpp"
+
+#endif // CG3_PARALLEL_H
@@ -0,0 +1,479 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+/* number of chunks of deterministic reductions and scans, which does not
+ * depend on the number of threads */
+const size_t PARALLEL_DETERMINISTIC_CHUNKS = 1024;
+const size_t PARALLEL_DETERMINISTIC_MIN_GRAIN = 64;
+
+/* minimum sizes of the ranges that are sorted or merged by a single task */
+const size_t PARALLEL_SORT_MIN_GRAIN = 4096;
+const size_t PARALLEL_MERGE_MIN_GRAIN = 8192;
+
+inline unsigned int parallelThreads(const ParallelOptions& options)
+{
+    unsigned int n = ThreadPool::instance().concurrency();
+    if (options.nThreads > 0 && options.nThreads < n)
+        n = options.nThreads;
+    return n;
+}
+
+/**
+ * @brief Calls f(chunk, participant) for every chunk in [0, nChunks), using
+ * at most nThreads threads (the calling thread included). Chunks are
+ * distributed dynamically through an atomic counter; participant is an index
+ * in [0, nThreads) that identifies the thread that executes the chunk.
+ */
+template <typename F>
+void parallelChunks(size_t nChunks, unsigned int nThreads, F f)
+{
+    if (nChunks == 0)
+        return;
+    if (nThreads <= 1 || nChunks == 1) {
+        for (size_t c = 0; c < nChunks; c++)
+            f(c, 0u);
+        return;
+    }
+    unsigned int nParticipants = nThreads < nChunks ? nThreads : (unsigned int)nChunks;
+    std::atomic<size_t> next(0);
+    auto participant = [&next, nChunks, &f](unsigned int p) {
+        for (size_t c = next.fetch_add(1); c < nChunks; c = next.fetch_add(1))
+            f(c, p);
+    };
+    TaskGroup group;
+    for (unsigned int p = 1; p < nParticipants; p++)
+        group.run([&participant, p]() { participant(p); });
+    participant(0);
+    group.wait();
+}
+
+inline size_t chunkGrain(size_t n, unsigned int nThreads, const ParallelOptions& options)
+{
+    if (options.grainSize > 0)
+        return options.grainSize;
+    size_t nChunks = (size_t)nThreads * 8;
+    return std::max((size_t)1, (n + nChunks - 1) / nChunks);
+}
+
+inline size_t deterministicGrain(size_t n, const ParallelOptions& options)
+{
+    if (options.grainSize > 0)
+        return options.grainSize;
+    return std::max(PARALLEL_DETERMINISTIC_MIN_GRAIN,
+                    (n + PARALLEL_DETERMINISTIC_CHUNKS - 1) / PARALLEL_DETERMINISTIC_CHUNKS);
+}
+
+/**
+ * @brief Returns the number of elements of the first range that are among
+ * the first k elements of the stable merge of the two ranges.
+ */
+template <typename RandomIt1, typename RandomIt2, typename Compare>
+size_t mergeCoRank(
+        size_t k,
+        RandomIt1 first1, size_t n1,
+        RandomIt2 first2, size_t n2,
+        Compare& comp)
+{
+    size_t lo = k > n2 ? k - n2 : 0;
+    size_t hi = k < n1 ? k : n1;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        if (i == n1 || j == 0 || comp(first2[j-1], first1[i]))
+            hi = i;
+        else
+            lo = i + 1;
+    }
+    return lo;
+}
+
+/**
+ * @brief Merges every pair of adjacent sorted runs of src (runs of width
+ * chunks, boundaries in bounds) into dst.
+ */
+template <typename SrcIt, typename DstIt, typename Compare>
+void parallelMergeRound(
+        SrcIt src,
+        DstIt dst,
+        const std::vector<size_t>& bounds,
+        size_t width,
+        Compare& comp,
+        const ParallelOptions& options)
+{
+    size_t nChunks = bounds.size() - 1;
+    for (size_t i = 0; i < nChunks; i += 2 * width) {
+        size_t lo = bounds[i];
+        size_t mid = bounds[std::min(i + width, nChunks)];
+        size_t hi = bounds[std::min(i + 2 * width, nChunks)];
+        parallelMerge(
+                    std::make_move_iterator(src + lo), std::make_move_iterator(src + mid),
+                    std::make_move_iterator(src + mid), std::make_move_iterator(src + hi),
+                    dst + lo, comp, options);
+    }
+}
+
+template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp>
+T parallelScanHelper(
+        RandomIt first,
+        RandomIt last,
+        OutputIt out,
+        const T& init,
+        BinaryOp& op,
+        bool inclusive,
+        const ParallelOptions& options)
+{
+    size_t n = (size_t)(last - first);
+    if (n == 0)
+        return init;
+    unsigned int nThreads = parallelThreads(options);
+    size_t grain = options.deterministic ?
+                deterministicGrain(n, options) :
+                chunkGrain(n, nThreads, options);
+    size_t nChunks = (n + grain - 1) / grain;
+
+    //partial results of the chunks
+    std::vector<T> partials(nChunks, init);
+    if (nChunks > 1) {
+        parallelChunks(nChunks - 1, nThreads, [&](size_t c, unsigned int) {
+            size_t b = c * grain, e = std::min(n, b + grain);
+            T acc = first[b];
+            for (size_t i = b + 1; i < e; i++)
+                acc = op(acc, first[i]);
+            partials[c] = acc;
+        });
+    }
+
+    //offsets of the chunks
+    std::vector<T> offsets;
+    offsets.reserve(nChunks);
+    offsets.push_back(init);
+    for (size_t c = 0; c + 1 < nChunks; c++)
+        offsets.push_back(op(offsets[c], partials[c]));
+
+    T total = init;
+    parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int) {
+        size_t b = c * grain, e = std::min(n, b + grain);
+        T acc = offsets[c];
+        for (size_t i = b; i < e; i++) {
+            if (inclusive) {
+                acc = op(acc, first[i]);
+                out[i] = acc;
+            }
+            else {
+                T value = first[i]; //first and out may be the same range
+                out[i] = acc;
+                acc = op(acc, value);
+            }
+        }
+        if (c == nChunks - 1)
+            total = acc;
+    });
+    return total;
+}
+
+} //namespace cg3::internal
+
+inline ParallelOptions::ParallelOptions(unsigned int nThreads, size_t grainSize, bool deterministic) :
+    nThreads(nThreads),
+    grainSize(grainSize),
+    deterministic(deterministic)
+{
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Sets the number of threads used by the parallel algorithms of the
+ * library. It must not be called while parallel algorithms are running.
+ * @param nThreads: if 0, the number of hardware threads (or the value of the
+ * CG3_NUM_THREADS environment variable) is used.
+ */
+inline void setNumberOfThreads(unsigned int nThreads)
+{
+    ThreadPool::instance().resize(nThreads);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Returns the number of threads used by the parallel algorithms of the
+ * library.
+ */
+inline unsigned int numberOfThreads()
+{
+    return ThreadPool::instance().concurrency();
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Calls f(i) for every i in [begin, end), in parallel.
+ *
+ * The range is split in chunks of consecutive indices which are dynamically
+ * distributed among the threads. Calls of f on different indices must not
+ * conflict. The calling thread takes part in the computation, and f can
+ * call other parallel algorithms.
+ *
+ * \code{.cpp}
+ * cg3::parallelFor(0u, mesh.numberFaces(), [&](unsigned int f) {
+ *     normals[f] = computeNormal(f);
+ * });
+ * \endcode
+ *
+ * @param begin, end: range of integer indices
+ * @param f
+ * @param options
+ */
+template <typename Index, typename F>
+void parallelFor(
+        Index begin,
+        Index end,
+        F f,
+        const ParallelOptions& options)
+{
+    if (!(begin < end))
+        return;
+    size_t n = (size_t)(end - begin);
+    unsigned int nThreads = internal::parallelThreads(options);
+    size_t grain = internal::chunkGrain(n, nThreads, options);
+    size_t nChunks = (n + grain - 1) / grain;
+    internal::parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int) {
+        size_t b = c * grain, e = std::min(n, b + grain);
+        for (size_t i = b; i < e; i++)
+            f((Index)(begin + (Index)i));
+    });
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Computes combine(...combine(combine(identity, map(begin)), map(begin+1))..., map(end-1))
+ * in parallel.
+ *
+ * combine must be associative and identity must be its identity element.
+ * If options.deterministic is true (default), the result does not depend
+ * on the number of threads (but it can differ from the result of a
+ * sequential loop when combine is not exactly associative, e.g. sums of
+ * floating point values).
+ *
+ * \code{.cpp}
+ * double area = cg3::parallelReduce(0u, mesh.numberFaces(), 0.0,
+ *     [&](unsigned int f) { return mesh.faceArea(f); },
+ *     [](double a, double b) { return a + b; });
+ * \endcode
+ *
+ * @param begin, end: range of integer indices
+ * @param identity
+ * @param map: function that takes an index and returns a T
+ * @param combine: function that takes two T and returns a T
+ * @param options
+ * @return the reduction of the mapped values
+ */
+template <typename T, typename Index, typename Map, typename Combine>
+T parallelReduce(
+        Index begin,
+        Index end,
+        const T& identity,
+        Map map,
+        Combine combine,
+        const ParallelOptions& options)
+{
+    if (!(begin < end))
+        return identity;
+    size_t n = (size_t)(end - begin);
+    unsigned int nThreads = internal::parallelThreads(options);
+    if (options.deterministic) {
+        size_t grain = internal::deterministicGrain(n, options);
+        size_t nChunks = (n + grain - 1) / grain;
+        std::vector<T> partials(nChunks, identity);
+        internal::parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int) {
+            size_t b = c * grain, e = std::min(n, b + grain);
+            T acc = identity;
+            for (size_t i = b; i < e; i++)
+                acc = combine(acc, map((Index)(begin + (Index)i)));
+            partials[c] = acc;
+        });
+        T result = identity;
+        for (const T& p : partials)
+            result = combine(result, p);
+        return result;
+    }
+    else {
+        size_t grain = internal::chunkGrain(n, nThreads, options);
+        size_t nChunks = (n + grain - 1) / grain;
+        std::vector<T> partials(nThreads, identity);
+        internal::parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int p) {
+            size_t b = c * grain, e = std::min(n, b + grain);
+            T acc = partials[p];
+            for (size_t i = b; i < e; i++)
+                acc = combine(acc, map((Index)(begin + (Index)i)));
+            partials[p] = acc;
+        });
+        T result = identity;
+        for (const T& p : partials)
+            result = combine(result, p);
+        return result;
+    }
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Sorts [first, last) in parallel. The sort is stable, hence the
+ * result does not depend on the number of threads.
+ *
+ * The range is split in sorted runs, one for each thread, which are merged
+ * pairwise with parallelMerge. The value type must be default constructible
+ * and movable.
+ *
+ * @param first, last: random access iterators
+ * @param comp
+ * @param options
+ */
+template <typename RandomIt, typename Compare>
+void parallelSort(
+        RandomIt first,
+        RandomIt last,
+        Compare comp,
+        const ParallelOptions& options)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    size_t n = (size_t)(last - first);
+    unsigned int nThreads = internal::parallelThreads(options);
+    size_t minGrain = options.grainSize > 0 ? options.grainSize : internal::PARALLEL_SORT_MIN_GRAIN;
+    size_t nChunks = 1;
+    while (nChunks < nThreads && n / (nChunks * 2) >= minGrain)
+        nChunks *= 2;
+    if (nChunks == 1) {
+        std::stable_sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds(nChunks + 1);
+    for (size_t c = 0; c <= nChunks; c++)
+        bounds[c] = n * c / nChunks;
+    internal::parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int) {
+        std::stable_sort(first + bounds[c], first + bounds[c+1], comp);
+    });
+
+    std::vector<T> buffer(n);
+    bool inBuffer = false;
+    for (size_t width = 1; width < nChunks; width *= 2) {
+        if (inBuffer)
+            internal::parallelMergeRound(buffer.begin(), first, bounds, width, comp, options);
+        else
+            internal::parallelMergeRound(first, buffer.begin(), bounds, width, comp, options);
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer) {
+        parallelFor((size_t)0, n, [&](size_t i) {
+            first[i] = std::move(buffer[i]);
+        }, ParallelOptions(options.nThreads, std::max(minGrain, options.grainSize)));
+    }
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Merges the sorted ranges [first1, last1) and [first2, last2) into
+ * the range starting at out, in parallel. The merge is stable: equivalent
+ * elements of the first range precede the ones of the second range.
+ *
+ * The output range is split in pieces; the boundaries of every piece on the
+ * input ranges are found with a binary search, then the pieces are merged
+ * independently. The output range must not overlap the input ranges.
+ *
+ * @return the end of the output range
+ */
+template <typename RandomIt1, typename RandomIt2, typename OutputIt, typename Compare>
+OutputIt parallelMerge(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        OutputIt out,
+        Compare comp,
+        const ParallelOptions& options)
+{
+    size_t n1 = (size_t)(last1 - first1);
+    size_t n2 = (size_t)(last2 - first2);
+    size_t n = n1 + n2;
+    unsigned int nThreads = internal::parallelThreads(options);
+    size_t minGrain = options.grainSize > 0 ? options.grainSize : internal::PARALLEL_MERGE_MIN_GRAIN;
+    if (nThreads <= 1 || n < 2 * minGrain)
+        return std::merge(first1, last1, first2, last2, out, comp);
+
+    size_t nPieces = std::min((size_t)nThreads * 4, n / minGrain);
+    internal::parallelChunks(nPieces, nThreads, [&](size_t p, unsigned int) {
+        size_t k0 = n * p / nPieces;
+        size_t k1 = n * (p + 1) / nPieces;
+        size_t i0 = internal::mergeCoRank(k0, first1, n1, first2, n2, comp);
+        size_t i1 = internal::mergeCoRank(k1, first1, n1, first2, n2, comp);
+        std::merge(first1 + i0, first1 + i1,
+                   first2 + (k0 - i0), first2 + (k1 - i1),
+                   out + k0, comp);
+    });
+    return out + n;
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Computes the inclusive prefix scan of [first, last) in parallel:
+ * out[i] = op(...op(op(init, first[0]), first[1])..., first[i]).
+ *
+ * op must be associative. out can be equal to first. If options.deterministic
+ * is true (default), the result does not depend on the number of threads.
+ *
+ * @return the reduction of all the elements (the last value of the scan, or
+ * init for an empty range)
+ */
+template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp>
+T parallelScan(
+        RandomIt first,
+        RandomIt last,
+        OutputIt out,
+        const T& init,
+        BinaryOp op,
+        const ParallelOptions& options)
+{
+    return internal::parallelScanHelper(first, last, out, init, op, true, options);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Computes the exclusive prefix scan of [first, last) in parallel:
+ * out[0] = init, out[i] = op(out[i-1], first[i-1]).
+ *
+ * Typical usage is the computation of the offsets of variable sized blocks
+ * from their sizes:
+ *
+ * \code{.cpp}
+ * std::vector<unsigned int> offsets(sizes.size());
+ * unsigned int total = cg3::parallelExclusiveScan(sizes.begin(), sizes.end(), offsets.begin(), 0u);
+ * \endcode
+ *
+ * op must be associative. out can be equal to first. If options.deterministic
+ * is true (default), the result does not depend on the number of threads.
+ *
+ * @return the reduction of all the elements
+ */
+template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp>
+T parallelExclusiveScan(
+        RandomIt first,
+        RandomIt last,
+        OutputIt out,
+        const T& init,
+        BinaryOp op,
+        const ParallelOptions& options)
+{
+    return internal::parallelScanHelper(first, last, out, init, op, false, options);
+}
+
+} //namespace cg3
@@ -0,0 +1,204 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_PROFILER_H
+#define CG3_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @def CG3_PROFILE_SCOPE(name)
+ * @ingroup cg3core
+ * @brief Opens a profiling zone called name (a string literal) which is closed at
+ * the end of the enclosing scope.
+ *
+ * Zones opened inside other zones are nested: the statistics returned by
+ * cg3::Profiler are aggregated for every path of nested zones.
+ *
+ * \code{.cpp}
+ * void foo()
+ * {
+ *     CG3_PROFILE_SCOPE("foo");
+ *     ...
+ *     {
+ *         CG3_PROFILE_SCOPE("foo inner loop");
+ *         ...
+ *     }
+ * }
+ * \endcode
+ *
+ * Zones are recorded only if the library is compiled with CG3_WITH_PROFILER
+ * defined (CONFIG += CG3_PROFILER in qmake): otherwise the macro expands to
+ * nothing and has no cost.
+ *
+ * @def CG3_PROFILE_FUNCTION()
+ * @ingroup cg3core
+ * @brief Same as CG3_PROFILE_SCOPE, using the name of the enclosing function.
+ */
+#ifdef CG3_WITH_PROFILER
+#define CG3_PROFILE_CONCAT2(a, b) a##b
+#define CG3_PROFILE_CONCAT(a, b) CG3_PROFILE_CONCAT2(a, b)
+#define CG3_PROFILE_SCOPE(name) cg3::ProfileScope CG3_PROFILE_CONCAT(cg3ProfileScope, __LINE__)(name)
+#define CG3_PROFILE_FUNCTION() CG3_PROFILE_SCOPE(__func__)
+#else
+#define CG3_PROFILE_SCOPE(name)
+#define CG3_PROFILE_FUNCTION()
+#endif
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief A closed profiling zone. Times are in nanoseconds from the
+ * creation of the Profiler.
+ */
+struct ProfileEvent
+{
+    const char* name;
+    long long int begin;
+    long long int end;
+    unsigned int depth;
+};
+
+/**
+ * @brief Append-only buffer of events written by a single thread.
+ *
+ * Events are stored in fixed size chunks: the owner thread is the only
+ * writer, and publishes every event with an atomic release store of the chunk
+ * size. Readers can therefore visit the buffer while the owner is recording,
+ * without locks.
+ */
+class ProfileEventBuffer
+{
+public:
+    ProfileEventBuffer(unsigned int threadId);
+    ~ProfileEventBuffer();
+
+    void push(const ProfileEvent& e);
+    template <typename F>
+    void forEach(F f) const;
+    void clear();
+
+    unsigned int threadId() const;
+    unsigned int& depth();
+
+private:
+    static const size_t CHUNK_SIZE = 4096;
+    struct Chunk {
+        Chunk();
+        ProfileEvent events[CHUNK_SIZE];
+        std::atomic<size_t> size;
+        std::atomic<Chunk*> next;
+    };
+
+    ProfileEventBuffer(const ProfileEventBuffer&);
+    ProfileEventBuffer& operator=(const ProfileEventBuffer&);
+
+    Chunk* head;
+    Chunk* tail;
+    unsigned int tid;
+    unsigned int openZones;
+};
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3core
+ * @brief Aggregated statistics of a profiling zone, for a path of nested zones.
+ * Times are in seconds.
+ */
+struct ProfileZoneStatistics
+{
+    std::string name;   /**< @brief name of the zone */
+    std::string path;   /**< @brief names of the enclosing zones and of the zone, separated by " > " */
+    unsigned int depth; /**< @brief nesting level of the zone, 0 for root zones */
+    unsigned long int count;
+    double total;
+    double self;        /**< @brief total time minus the time spent in nested zones */
+    double min;
+    double max;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+};
+
+/**
+ * @ingroup cg3core
+ * @brief The Profiler class collects the zones opened with CG3_PROFILE_SCOPE.
+ *
+ * Every thread records its zones on its own buffer, without any
+ * synchronization with the other threads. The collected zones can be
+ * aggregated with statistics() / printStatistics(), or exported with
+ * saveChromeTrace() in the Chrome Trace Event JSON format, which can be opened
+ * with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * \code{.cpp}
+ * cg3::Dcel d("bunny.obj");
+ * ...
+ * cg3::Profiler::instance().printStatistics();
+ * cg3::Profiler::instance().saveChromeTrace("trace.json");
+ * \endcode
+ */
+class Profiler
+{
+public:
+    static Profiler& instance();
+
+    std::vector<ProfileZoneStatistics> statistics() const;
+    void printStatistics(std::ostream& stream = std::cout) const;
+    bool saveChromeTrace(const std::string& filename) const;
+    void saveChromeTrace(std::ostream& stream) const;
+    void clear();
+
+    long long int now() const;
+    internal::ProfileEventBuffer& threadBuffer();
+
+private:
+    Profiler();
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+    std::chrono::steady_clock::time_point origin;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<internal::ProfileEventBuffer>> buffers;
+};
+
+/**
+ * @ingroup cg3core
+ * @brief RAII object that records a profiling zone from its construction to
+ * its destruction. Use the CG3_PROFILE_SCOPE macro instead of using it
+ * directly.
+ */
+class ProfileScope
+{
+public:
+    ProfileScope(const char* name);
+    ~ProfileScope();
+
+private:
+    ProfileScope(const ProfileScope&);
+    ProfileScope& operator=(const ProfileScope&);
+
+    const char* name;
+    internal::ProfileEventBuffer& buffer;
+    long long int begin;
+    unsigned int depth;
+};
+
+} //namespace cg3
+
+#include "profiler.tpp"
+
+#endif // CG3_PROFILER_H
@@ -0,0 +1,376 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+namespace cg3 {
+
+namespace internal {
+
+inline ProfileEventBuffer::Chunk::Chunk() :
+    size(0),
+    next(nullptr)
+{
+}
+
+inline ProfileEventBuffer::ProfileEventBuffer(unsigned int threadId) :
+    head(new Chunk()),
+    tail(head),
+    tid(threadId),
+    openZones(0)
+{
+}
+
+inline ProfileEventBuffer::~ProfileEventBuffer()
+{
+    Chunk* c = head;
+    while (c != nullptr) {
+        Chunk* n = c->next.load(std::memory_order_relaxed);
+        delete c;
+        c = n;
+    }
+}
+
+/**
+ * @brief ProfileEventBuffer::push
+ * Appends an event. Must be called only by the owner thread of the buffer.
+ * @param e
+ */
+inline void ProfileEventBuffer::push(const ProfileEvent& e)
+{
+    size_t n = tail->size.load(std::memory_order_relaxed);
+    if (n == CHUNK_SIZE) {
+        Chunk* c = new Chunk();
+        tail->next.store(c, std::memory_order_release);
+        tail = c;
+        n = 0;
+    }
+    tail->events[n] = e;
+    tail->size.store(n+1, std::memory_order_release);
+}
+
+/**
+ * @brief ProfileEventBuffer::forEach
+ * Calls f on every event published on the buffer. It can be called from any
+ * thread, also while the owner thread is recording.
+ * @param f
+ */
+template <typename F>
+void ProfileEventBuffer::forEach(F f) const
+{
+    for (const Chunk* c = head; c != nullptr; c = c->next.load(std::memory_order_acquire)) {
+        size_t n = c->size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n; ++i)
+            f(c->events[i]);
+    }
+}
+
+/**
+ * @brief ProfileEventBuffer::clear
+ * Removes all the events. It must not be called while the owner thread is
+ * recording.
+ */
+inline void ProfileEventBuffer::clear()
+{
+    Chunk* c = head->next.load(std::memory_order_relaxed);
+    while (c != nullptr) {
+        Chunk* n = c->next.load(std::memory_order_relaxed);
+        delete c;
+        c = n;
+    }
+    head->next.store(nullptr, std::memory_order_relaxed);
+    head->size.store(0, std::memory_order_release);
+    tail = head;
+}
+
+inline unsigned int ProfileEventBuffer::threadId() const
+{
+    return tid;
+}
+
+/**
+ * @brief ProfileEventBuffer::depth
+ * @return the number of zones currently opened by the owner thread
+ */
+inline unsigned int& ProfileEventBuffer::depth()
+{
+    return openZones;
+}
+
+inline std::string jsonEscape(const char* s)
+{
+    std::string r;
+    for (; *s != '\0'; ++s) {
+        switch (*s) {
+        case '"': r += "\\\""; break;
+        case '\\': r += "\\\\"; break;
+        case '\n': r += "\\n"; break;
+        case '\t': r += "\\t"; break;
+        default:
+            if ((unsigned char)*s >= 0x20)
+                r += *s;
+        }
+    }
+    return r;
+}
+
+inline double percentile(const std::vector<long long int>& sorted, double p)
+{
+    size_t rank = (size_t)std::ceil(p * sorted.size());
+    return (double)sorted[rank > 0 ? rank-1 : 0];
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief Profiler::instance
+ * @return the unique instance of the profiler
+ */
+inline Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+inline Profiler::Profiler() :
+    origin(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * @brief Profiler::statistics
+ *
+ * Reconstructs the nesting of the zones recorded by every thread and
+ * aggregates them by path: the same zone opened inside two different zones
+ * gives two different entries.
+ *
+ * @return the statistics of every path of zones, sorted by path (every zone
+ * is followed by its nested zones).
+ */
+inline std::vector<ProfileZoneStatistics> Profiler::statistics() const
+{
+    struct Accumulator {
+        std::string name;
+        unsigned int depth;
+        std::vector<long long int> durations;
+        long long int childTime;
+    };
+    std::map<std::string, Accumulator> zones;
+
+    //the events are copied under the lock, that excludes a concurrent clear
+    std::vector<std::vector<internal::ProfileEvent>> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.resize(buffers.size());
+        for (unsigned int i = 0; i < buffers.size(); i++) {
+            std::vector<internal::ProfileEvent>& events = threads[i];
+            buffers[i]->forEach([&events](const internal::ProfileEvent& e) {
+                events.push_back(e);
+            });
+        }
+    }
+
+    for (std::vector<internal::ProfileEvent>& events : threads) {
+        //parents begin before their children
+        std::sort(events.begin(), events.end(),
+                  [](const internal::ProfileEvent& e1, const internal::ProfileEvent& e2) {
+            return e1.begin < e2.begin || (e1.begin == e2.begin && e1.depth < e2.depth);
+        });
+
+        struct OpenZone {
+            const internal::ProfileEvent* event;
+            Accumulator* zone;
+            std::string path;
+        };
+        std::vector<OpenZone> stack;
+        for (const internal::ProfileEvent& e : events) {
+            while (!stack.empty() &&
+                   !(e.depth > stack.back().event->depth && e.end <= stack.back().event->end))
+                stack.pop_back();
+            long long int duration = e.end - e.begin;
+            std::string path = e.name;
+            if (!stack.empty()) {
+                path = stack.back().path + " > " + path;
+                stack.back().zone->childTime += duration;
+            }
+            std::map<std::string, Accumulator>::iterator it = zones.find(path);
+            if (it == zones.end()) {
+                Accumulator acc;
+                acc.name = e.name;
+                acc.depth = (unsigned int)stack.size();
+                acc.childTime = 0;
+                it = zones.insert(std::make_pair(path, acc)).first;
+            }
+            it->second.durations.push_back(duration);
+            OpenZone z = {&e, &it->second, path};
+            stack.push_back(z);
+        }
+    }
+
+    std::vector<ProfileZoneStatistics> stats;
+    stats.reserve(zones.size());
+    for (std::pair<const std::string, Accumulator>& z : zones) {
+        std::vector<long long int>& d = z.second.durations;
+        std::sort(d.begin(), d.end());
+        long long int total = 0;
+        for (long long int t : d)
+            total += t;
+        ProfileZoneStatistics s;
+        s.name = z.second.name;
+        s.path = z.first;
+        s.depth = z.second.depth;
+        s.count = (unsigned long int)d.size();
+        s.total = total * 1e-9;
+        s.self = (total - z.second.childTime) * 1e-9;
+        s.min = d.front() * 1e-9;
+        s.max = d.back() * 1e-9;
+        s.mean = s.total / s.count;
+        s.p50 = internal::percentile(d, 0.50) * 1e-9;
+        s.p90 = internal::percentile(d, 0.90) * 1e-9;
+        s.p99 = internal::percentile(d, 0.99) * 1e-9;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+/**
+ * @brief Profiler::printStatistics
+ * Prints a table with the statistics of every path of zones, indented by
+ * nesting level. Times are in milliseconds.
+ * @param stream
+ */
+inline void Profiler::printStatistics(std::ostream& stream) const
+{
+    std::vector<ProfileZoneStatistics> stats = statistics();
+    std::ios::fmtflags flags = stream.flags();
+    stream << std::left << std::setw(48) << "zone" << std::right
+           << std::setw(10) << "count"
+           << std::setw(12) << "total ms" << std::setw(12) << "self ms"
+           << std::setw(12) << "min ms" << std::setw(12) << "max ms"
+           << std::setw(12) << "p50 ms" << std::setw(12) << "p90 ms"
+           << std::setw(12) << "p99 ms" << "\n";
+    stream << std::fixed << std::setprecision(3);
+    for (const ProfileZoneStatistics& s : stats) {
+        stream << std::left << std::setw(48) << (std::string(2*s.depth, ' ') + s.name) << std::right
+               << std::setw(10) << s.count
+               << std::setw(12) << s.total*1e3 << std::setw(12) << s.self*1e3
+               << std::setw(12) << s.min*1e3 << std::setw(12) << s.max*1e3
+               << std::setw(12) << s.p50*1e3 << std::setw(12) << s.p90*1e3
+               << std::setw(12) << s.p99*1e3 << "\n";
+    }
+    stream.flags(flags);
+}
+
+/**
+ * @brief Profiler::saveChromeTrace
+ * Saves all the recorded zones in the Chrome Trace Event JSON format, which
+ * can be loaded by chrome://tracing and by the Perfetto UI.
+ * @param filename
+ * @return true if the file has been written
+ */
+inline bool Profiler::saveChromeTrace(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file.is_open())
+        return false;
+    saveChromeTrace(file);
+    return (bool)file;
+}
+
+inline void Profiler::saveChromeTrace(std::ostream& stream) const
+{
+    //the lock excludes a concurrent clear for the whole walk of the buffers
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ios::fmtflags flags = stream.flags();
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const std::unique_ptr<internal::ProfileEventBuffer>& b : buffers) {
+        unsigned int tid = b->threadId();
+        if (!first)
+            stream << ",";
+        first = false;
+        stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+               << ",\"args\":{\"name\":\"cg3 thread " << tid << "\"}}";
+        b->forEach([&stream, tid](const internal::ProfileEvent& e) {
+            stream << ",\n{\"name\":\"" << internal::jsonEscape(e.name)
+                   << "\",\"cat\":\"cg3\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                   << ",\"ts\":" << e.begin * 1e-3
+                   << ",\"dur\":" << (e.end - e.begin) * 1e-3 << "}";
+        });
+    }
+    stream << "\n]}\n";
+    stream.flags(flags);
+}
+
+/**
+ * @brief Profiler::clear
+ * Removes all the recorded zones. It must not be called while other threads
+ * are inside profiled zones; it can be called concurrently with statistics()
+ * and saveChromeTrace(), that read the buffers under the same lock.
+ */
+inline void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::unique_ptr<internal::ProfileEventBuffer>& b : buffers)
+        b->clear();
+}
+
+/**
+ * @brief Profiler::now
+ * @return the nanoseconds elapsed from the creation of the profiler
+ */
+inline long long int Profiler::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - origin).count();
+}
+
+/**
+ * @brief Profiler::threadBuffer
+ * @return the event buffer of the calling thread. The buffer is created and
+ * registered the first time a thread calls this function; it is owned by the
+ * profiler and survives the thread.
+ */
+inline internal::ProfileEventBuffer& Profiler::threadBuffer()
+{
+    static thread_local internal::ProfileEventBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(std::unique_ptr<internal::ProfileEventBuffer>(
+                              new internal::ProfileEventBuffer((unsigned int)buffers.size())));
+        buffer = buffers.back().get();
+    }
+    return *buffer;
+}
+
+inline ProfileScope::ProfileScope(const char* name) :
+    name(name),
+    buffer(Profiler::instance().threadBuffer()),
+    depth(buffer.depth()++)
+{
+    begin = Profiler::instance().now();
+}
+
+inline ProfileScope::~ProfileScope()
+{
+    internal::ProfileEvent e;
+    e.name = name;
+    e.begin = begin;
+    e.end = Profiler::instance().now();
+    e.depth = depth;
+    buffer.depth()--;
+    buffer.push(e);
+}
+
+} //namespace cg3
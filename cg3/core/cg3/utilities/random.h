@@ -0,0 +1,58 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_RANDOM_H
+#define CG3_RANDOM_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace cg3 {
+
+std::mt19937_64 randomStream(std::uint64_t seed, std::uint64_t stream);
+
+template <class RNG>
+double randomDouble(RNG& rng);
+
+/**
+ * @ingroup cg3core
+ * @brief The AliasTable class samples indices in [0, n) with probabilities
+ * proportional to a vector of non negative weights, in constant time per
+ * sample (Vose's alias method).
+ *
+ * \code{.cpp}
+ * cg3::AliasTable table(faceAreas);
+ * std::mt19937_64 rng = cg3::randomStream(seed, 0);
+ * unsigned int f = table.sample(rng);
+ * \endcode
+ */
+class AliasTable
+{
+public:
+    AliasTable();
+    explicit AliasTable(const std::vector<double>& weights);
+
+    void build(const std::vector<double>& weights);
+
+    unsigned int size() const;
+    double probability(unsigned int i) const;
+
+    template <class RNG>
+    unsigned int sample(RNG& rng) const;
+
+protected:
+    std::vector<double> prob;
+    std::vector<unsigned int> alias;
+    std::vector<double> probabilities;
+};
+
+} //namespace cg3
+
+#include "random.tpp"
+
+#endif // CG3_RANDOM_H
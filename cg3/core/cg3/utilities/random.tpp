@@ -0,0 +1,135 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "random.h"
+
+#include <cassert>
+
+#include "hash.h"
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief randomStream
+ * Returns a random generator seeded with a hash of (seed, stream). Parallel
+ * algorithms that need random numbers split their work in a fixed number of
+ * chunks, and use the stream of every chunk: the results depend only on the
+ * seed, and not on the number of threads or on the scheduling.
+ *
+ * \code{.cpp}
+ * cg3::parallelFor(0u, nChunks, [&](unsigned int c) {
+ *     std::mt19937_64 rng = cg3::randomStream(seed, c);
+ *     ...
+ * });
+ * \endcode
+ */
+inline std::mt19937_64 randomStream(std::uint64_t seed, std::uint64_t stream)
+{
+    return std::mt19937_64(hashMix(hashMix(seed) + stream * 0x9e3779b97f4a7c15ULL));
+}
+
+/**
+ * @ingroup cg3core
+ * @brief randomDouble
+ * @return a uniform random number in [0, 1), made of the 53 high bits of a
+ * 64 bit random number: unlike std::uniform_real_distribution, the result is
+ * the same on every standard library
+ */
+template <class RNG>
+inline double randomDouble(RNG& rng)
+{
+    static_assert(RNG::max() - RNG::min() == 0xFFFFFFFFFFFFFFFFULL,
+                  "randomDouble requires a 64 bit generator");
+    return (double)((rng() - RNG::min()) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+inline AliasTable::AliasTable()
+{
+}
+
+inline AliasTable::AliasTable(const std::vector<double>& weights)
+{
+    build(weights);
+}
+
+/**
+ * @brief AliasTable::build
+ * Builds the table of the given weights, in O(n) time. If all the weights
+ * are zero, indices are sampled uniformly.
+ */
+inline void AliasTable::build(const std::vector<double>& weights)
+{
+    unsigned int n = (unsigned int)weights.size();
+    prob.assign(n, 1);
+    alias.resize(n);
+    probabilities.assign(n, n > 0 ? 1.0 / n : 0);
+    double sum = 0;
+    for (double w : weights) {
+        assert(w >= 0);
+        sum += w;
+    }
+    if (n == 0 || !(sum > 0))
+        return;
+
+    std::vector<unsigned int> small, large;
+    for (unsigned int i = 0; i < n; i++) {
+        probabilities[i] = weights[i] / sum;
+        prob[i] = probabilities[i] * n;
+        alias[i] = i;
+        if (prob[i] < 1)
+            small.push_back(i);
+        else
+            large.push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        unsigned int s = small.back(), l = large.back();
+        small.pop_back();
+        alias[s] = l;
+        prob[l] = (prob[l] + prob[s]) - 1;
+        if (prob[l] < 1) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    //remaining probabilities are 1 up to rounding errors
+    for (unsigned int i : small)
+        prob[i] = 1;
+    for (unsigned int i : large)
+        prob[i] = 1;
+}
+
+inline unsigned int AliasTable::size() const
+{
+    return (unsigned int)prob.size();
+}
+
+/**
+ * @brief AliasTable::probability
+ * @return the probability of sampling the index i
+ */
+inline double AliasTable::probability(unsigned int i) const
+{
+    return probabilities[i];
+}
+
+/**
+ * @brief AliasTable::sample
+ * @return a random index, sampled with two random numbers of rng
+ */
+template <class RNG>
+inline unsigned int AliasTable::sample(RNG& rng) const
+{
+    assert(size() > 0);
+    unsigned int n = size();
+    unsigned int i = (unsigned int)(randomDouble(rng) * n);
+    if (i >= n)
+        i = n - 1;
+    return randomDouble(rng) < prob[i] ? i : alias[i];
+}
+
+} //namespace cg3
@@ -8,8 +8,11 @@
 #ifndef CG3_SET_H
 #define CG3_SET_H
 
+#include <iterator>
 #include <set>
 
+#include "parallel.h"
+
 namespace cg3 {
 
 template<typename T>
@@ -32,6 +35,71 @@ bool isSubset(
         const std::set<T> &a,
         const std::set<T> &b);
 
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Compare = std::less<typename std::iterator_traits<InputIt1>::value_type>>
+OutputIt sortedIntersection(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        OutputIt out,
+        Compare comp = Compare());
+
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Compare = std::less<typename std::iterator_traits<InputIt1>::value_type>>
+OutputIt sortedUnion(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        OutputIt out,
+        Compare comp = Compare());
+
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Compare = std::less<typename std::iterator_traits<InputIt1>::value_type>>
+OutputIt sortedDifference(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        OutputIt out,
+        Compare comp = Compare());
+
+template <typename InputIt1, typename InputIt2, typename Compare = std::less<typename std::iterator_traits<InputIt1>::value_type>>
+bool sortedIncludes(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        Compare comp = Compare());
+
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare = std::less<typename std::iterator_traits<RandomIt1>::value_type>>
+RandomOutputIt parallelSortedIntersection(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare comp = Compare(),
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare = std::less<typename std::iterator_traits<RandomIt1>::value_type>>
+RandomOutputIt parallelSortedUnion(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare comp = Compare(),
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare = std::less<typename std::iterator_traits<RandomIt1>::value_type>>
+RandomOutputIt parallelSortedDifference(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare comp = Compare(),
+        const ParallelOptions& options = ParallelOptions());
+
 } //namespace cg3
 
 #include "set.tpp"
@@ -7,8 +7,162 @@
 
 #include "set.h"
 
+#include <algorithm>
+
 namespace cg3 {
 
+namespace internal {
+
+/* ratio between the sizes of two ranges above which the set operations on
+ * sorted ranges gallop in the larger range */
+const size_t SORTED_SET_GALLOP_RATIO = 16;
+
+/* minimum total size of the ranges split among threads by the parallel set
+ * operations on sorted ranges */
+const size_t SORTED_SET_PARALLEL_MIN_SIZE = 8192;
+
+/**
+ * @brief Lower bound of value in the sorted range [first, last), searched
+ * with exponentially growing steps from first: it takes O(log k) comparisons,
+ * where k is the distance between first and the result.
+ */
+template <typename It, typename T, typename Compare>
+It gallopLowerBound(It first, It last, const T& value, Compare& comp)
+{
+    if (first == last || !comp(*first, value))
+        return first;
+    size_t n = std::distance(first, last);
+    size_t lo = 0, step = 1;
+    while (lo + step < n && comp(*std::next(first, lo + step), value)) {
+        lo += step;
+        step *= 2;
+    }
+    return std::lower_bound(
+                std::next(first, lo + 1),
+                std::next(first, std::min(n, lo + step)),
+                value, comp);
+}
+
+/**
+ * @brief Output iterator that counts the assigned elements.
+ */
+class CountingOutputIterator
+{
+public:
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+
+    CountingOutputIterator() : n(0) {}
+    template <typename T>
+    CountingOutputIterator& operator=(const T&) { n++; return *this; }
+    CountingOutputIterator& operator*() { return *this; }
+    CountingOutputIterator& operator++() { return *this; }
+    CountingOutputIterator& operator++(int) { return *this; }
+    size_t count() const { return n; }
+
+private:
+    size_t n;
+};
+
+struct SortedIntersectionOp
+{
+    template <typename It1, typename It2, typename Out, typename Compare>
+    Out operator()(It1 first1, It1 last1, It2 first2, It2 last2, Out out, Compare& comp) const
+    {
+        return sortedIntersection(first1, last1, first2, last2, out, comp);
+    }
+};
+
+struct SortedUnionOp
+{
+    template <typename It1, typename It2, typename Out, typename Compare>
+    Out operator()(It1 first1, It1 last1, It2 first2, It2 last2, Out out, Compare& comp) const
+    {
+        return sortedUnion(first1, last1, first2, last2, out, comp);
+    }
+};
+
+struct SortedDifferenceOp
+{
+    template <typename It1, typename It2, typename Out, typename Compare>
+    Out operator()(It1 first1, It1 last1, It2 first2, It2 last2, Out out, Compare& comp) const
+    {
+        return sortedDifference(first1, last1, first2, last2, out, comp);
+    }
+};
+
+/**
+ * @brief Splits the larger of two sorted ranges in pieces of about the same
+ * size, moving every split point at the beginning of its run of equivalent
+ * elements, and splits the other range at the lower bounds of the split
+ * values: equivalent elements of both ranges end up in the same piece, so the
+ * pieces can be processed independently. Every piece is processed twice: the
+ * first time its output is counted, the second time it is written at its
+ * offset.
+ */
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare, typename Op>
+RandomOutputIt parallelSortedOperation(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare& comp,
+        const ParallelOptions& options,
+        Op op)
+{
+    size_t n1 = last1 - first1, n2 = last2 - first2;
+    unsigned int nThreads = parallelThreads(options);
+    if (nThreads <= 1 || n1 + n2 < SORTED_SET_PARALLEL_MIN_SIZE)
+        return op(first1, last1, first2, last2, out, comp);
+
+    size_t nPieces = std::min(
+                (size_t)4 * nThreads,
+                (std::max(n1, n2) + SORTED_SET_PARALLEL_MIN_SIZE - 1) / SORTED_SET_PARALLEL_MIN_SIZE);
+    std::vector<size_t> splits1(nPieces + 1), splits2(nPieces + 1);
+    splits1[0] = splits2[0] = 0;
+    splits1[nPieces] = n1;
+    splits2[nPieces] = n2;
+    for (size_t p = 1; p < nPieces; p++) {
+        if (n1 >= n2) {
+            size_t i = std::max(splits1[p-1], p * n1 / nPieces);
+            i = std::lower_bound(first1 + splits1[p-1], first1 + i, first1[i], comp) - first1;
+            splits1[p] = i;
+            splits2[p] = std::lower_bound(first2 + splits2[p-1], last2, first1[i], comp) - first2;
+        }
+        else {
+            size_t j = std::max(splits2[p-1], p * n2 / nPieces);
+            j = std::lower_bound(first2 + splits2[p-1], first2 + j, first2[j], comp) - first2;
+            splits2[p] = j;
+            splits1[p] = std::lower_bound(first1 + splits1[p-1], last1, first2[j], comp) - first1;
+        }
+    }
+
+    std::vector<size_t> sizes(nPieces);
+    parallelChunks(nPieces, nThreads, [&](size_t p, unsigned int) {
+        sizes[p] = op(first1 + splits1[p], first1 + splits1[p+1],
+                      first2 + splits2[p], first2 + splits2[p+1],
+                      CountingOutputIterator(), comp).count();
+    });
+    size_t total = 0;
+    for (size_t p = 0; p < nPieces; p++) {
+        size_t s = sizes[p];
+        sizes[p] = total;
+        total += s;
+    }
+    parallelChunks(nPieces, nThreads, [&](size_t p, unsigned int) {
+        op(first1 + splits1[p], first1 + splits1[p+1],
+           first2 + splits2[p], first2 + splits2[p+1],
+           out + sizes[p], comp);
+    });
+    return out + total;
+}
+
+} //namespace cg3::internal
+
 /**
  * @ingroup cg3core
  * @brief intersection
@@ -78,4 +232,261 @@ inline bool isSubset(
     return std::includes(b.begin(), b.end(), a.begin(), a.end());
 }
 
+/**
+ * @ingroup cg3core
+ * @brief sortedIntersection
+ * Writes in out the intersection of the sorted ranges [first1, last1) and
+ * [first2, last2), with the same semantics of std::set_intersection: if an
+ * element is m times in the first range and n times in the second, the first
+ * min(m, n) of them are copied from the first range.
+ *
+ * Ranges are sorted vectors used as sets: if one of them is much larger than
+ * the other, the larger one is searched with exponential steps (galloping),
+ * which takes O(n log(m/n)) comparisons instead of O(n + m). Galloping is
+ * effective on random access iterators.
+ *
+ * @return the end of the output range
+ */
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+inline OutputIt sortedIntersection(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        OutputIt out,
+        Compare comp)
+{
+    size_t n1 = std::distance(first1, last1), n2 = std::distance(first2, last2);
+    if (n1 > internal::SORTED_SET_GALLOP_RATIO * n2) {
+        while (first2 != last2) {
+            first1 = internal::gallopLowerBound(first1, last1, *first2, comp);
+            if (first1 == last1)
+                break;
+            if (!comp(*first2, *first1))
+                *out++ = *first1++;
+            ++first2;
+        }
+        return out;
+    }
+    if (n2 > internal::SORTED_SET_GALLOP_RATIO * n1) {
+        while (first1 != last1) {
+            first2 = internal::gallopLowerBound(first2, last2, *first1, comp);
+            if (first2 == last2)
+                break;
+            if (!comp(*first1, *first2)) {
+                *out++ = *first1;
+                ++first2;
+            }
+            ++first1;
+        }
+        return out;
+    }
+    return std::set_intersection(first1, last1, first2, last2, out, comp);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief sortedUnion
+ * Writes in out the union of the sorted ranges [first1, last1) and
+ * [first2, last2), with the same semantics of std::set_union: if an element
+ * is m times in the first range and n times in the second, it is copied
+ * max(m, n) times, first from the first range. Runs of the larger range that
+ * are not interleaved with the smaller one are found by galloping and copied
+ * as a block.
+ *
+ * @return the end of the output range
+ */
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+inline OutputIt sortedUnion(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        OutputIt out,
+        Compare comp)
+{
+    size_t n1 = std::distance(first1, last1), n2 = std::distance(first2, last2);
+    if (n1 > internal::SORTED_SET_GALLOP_RATIO * n2) {
+        while (first2 != last2) {
+            InputIt1 mid = internal::gallopLowerBound(first1, last1, *first2, comp);
+            out = std::copy(first1, mid, out);
+            first1 = mid;
+            if (first1 == last1)
+                return std::copy(first2, last2, out);
+            if (comp(*first2, *first1)) {
+                *out++ = *first2++;
+            }
+            else {
+                *out++ = *first1++;
+                ++first2;
+            }
+        }
+        return std::copy(first1, last1, out);
+    }
+    if (n2 > internal::SORTED_SET_GALLOP_RATIO * n1) {
+        while (first1 != last1) {
+            InputIt2 mid = internal::gallopLowerBound(first2, last2, *first1, comp);
+            out = std::copy(first2, mid, out);
+            first2 = mid;
+            if (first2 == last2)
+                return std::copy(first1, last1, out);
+            if (!comp(*first1, *first2))
+                ++first2;
+            *out++ = *first1++;
+        }
+        return std::copy(first2, last2, out);
+    }
+    return std::set_union(first1, last1, first2, last2, out, comp);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief sortedDifference
+ * Writes in out the elements of the sorted range [first1, last1) that are not
+ * in the sorted range [first2, last2), with the same semantics of
+ * std::set_difference: if an element is m times in the first range and n
+ * times in the second, the last max(m - n, 0) of them are copied. Uses
+ * galloping if the ranges have very different sizes.
+ *
+ * @return the end of the output range
+ */
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+inline OutputIt sortedDifference(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        OutputIt out,
+        Compare comp)
+{
+    size_t n1 = std::distance(first1, last1), n2 = std::distance(first2, last2);
+    if (n1 > internal::SORTED_SET_GALLOP_RATIO * n2) {
+        while (first2 != last2) {
+            InputIt1 mid = internal::gallopLowerBound(first1, last1, *first2, comp);
+            out = std::copy(first1, mid, out);
+            first1 = mid;
+            if (first1 == last1)
+                return out;
+            if (!comp(*first2, *first1))
+                ++first1;
+            ++first2;
+        }
+        return std::copy(first1, last1, out);
+    }
+    if (n2 > internal::SORTED_SET_GALLOP_RATIO * n1) {
+        while (first1 != last1) {
+            first2 = internal::gallopLowerBound(first2, last2, *first1, comp);
+            if (first2 == last2)
+                return std::copy(first1, last1, out);
+            if (comp(*first1, *first2))
+                *out++ = *first1;
+            else
+                ++first2;
+            ++first1;
+        }
+        return out;
+    }
+    return std::set_difference(first1, last1, first2, last2, out, comp);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief sortedIncludes
+ * @return true if every element of the sorted range [first2, last2) is in the
+ * sorted range [first1, last1), with the same semantics of std::includes; uses
+ * galloping if the first range is much larger than the second
+ */
+template <typename InputIt1, typename InputIt2, typename Compare>
+inline bool sortedIncludes(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        InputIt2 last2,
+        Compare comp)
+{
+    size_t n1 = std::distance(first1, last1), n2 = std::distance(first2, last2);
+    if (n2 > n1)
+        return false;
+    if (n1 > internal::SORTED_SET_GALLOP_RATIO * n2) {
+        for (; first2 != last2; ++first2, ++first1) {
+            first1 = internal::gallopLowerBound(first1, last1, *first2, comp);
+            if (first1 == last1 || comp(*first2, *first1))
+                return false;
+        }
+        return true;
+    }
+    return std::includes(first1, last1, first2, last2, comp);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief parallelSortedIntersection
+ * Parallel version of sortedIntersection: the ranges are split in pieces that
+ * are intersected in parallel. The output is the same of sortedIntersection,
+ * and must be a random access iterator to a range large enough to contain it.
+ *
+ * @return the end of the output range
+ */
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare>
+inline RandomOutputIt parallelSortedIntersection(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare comp,
+        const ParallelOptions& options)
+{
+    return internal::parallelSortedOperation(
+                first1, last1, first2, last2, out, comp, options,
+                internal::SortedIntersectionOp());
+}
+
+/**
+ * @ingroup cg3core
+ * @brief parallelSortedUnion
+ * Parallel version of sortedUnion. The output is the same of sortedUnion,
+ * and must be a random access iterator to a range large enough to contain it.
+ *
+ * @return the end of the output range
+ */
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare>
+inline RandomOutputIt parallelSortedUnion(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare comp,
+        const ParallelOptions& options)
+{
+    return internal::parallelSortedOperation(
+                first1, last1, first2, last2, out, comp, options,
+                internal::SortedUnionOp());
+}
+
+/**
+ * @ingroup cg3core
+ * @brief parallelSortedDifference
+ * Parallel version of sortedDifference. The output is the same of
+ * sortedDifference, and must be a random access iterator to a range large
+ * enough to contain it.
+ *
+ * @return the end of the output range
+ */
+template <typename RandomIt1, typename RandomIt2, typename RandomOutputIt, typename Compare>
+inline RandomOutputIt parallelSortedDifference(
+        RandomIt1 first1,
+        RandomIt1 last1,
+        RandomIt2 first2,
+        RandomIt2 last2,
+        RandomOutputIt out,
+        Compare comp,
+        const ParallelOptions& options)
+{
+    return internal::parallelSortedOperation(
+                first1, last1, first2, last2, out, comp, options,
+                internal::SortedDifferenceOp());
+}
+
 } //namespace cg3
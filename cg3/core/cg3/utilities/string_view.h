@@ -0,0 +1,84 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_STRING_VIEW_H
+#define CG3_STRING_VIEW_H
+
+#include <string>
+#include <ostream>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The StringView class is a non-owning, read-only reference to a
+ * contiguous sequence of characters.
+ *
+ * It is a minimal C++11 counterpart of std::string_view: it stores only a
+ * pointer and a size, so it can be copied and passed around without
+ * allocating. The referenced buffer must outlive the StringView.
+ *
+ * Numbers can be parsed directly from a StringView using cg3::stoi,
+ * cg3::stol, cg3::stoul, cg3::stof and cg3::stod, which behave like their
+ * std:: counterparts (leading whitespaces are skipped, trailing characters
+ * are ignored, std::invalid_argument is thrown if no conversion could be
+ * performed and std::out_of_range if the value is not representable).
+ */
+class StringView
+{
+public:
+    typedef const char* const_iterator;
+
+    StringView();
+    StringView(const char* string);
+    StringView(const char* string, size_t size);
+    StringView(const char* begin, const char* end);
+    StringView(const std::string& string);
+
+    const char* data()                                  const;
+    size_t size()                                       const;
+    size_t length()                                     const;
+    bool empty()                                        const;
+    const_iterator begin()                              const;
+    const_iterator end()                                const;
+    const char& front()                                 const;
+    const char& back()                                  const;
+    StringView substr(size_t pos, size_t count = npos)  const;
+    size_t find(char c, size_t pos = 0)                 const;
+    int compare(const StringView& other)                const;
+    std::string toString()                              const;
+
+    const char& operator[](size_t i)                    const;
+    bool operator == (const StringView& other)          const;
+    bool operator != (const StringView& other)          const;
+    bool operator < (const StringView& other)           const;
+
+    static const size_t npos = static_cast<size_t>(-1);
+
+private:
+    const char* str;
+    size_t sz;
+};
+
+bool operator == (const char* s, const StringView& v);
+bool operator != (const char* s, const StringView& v);
+bool operator == (const std::string& s, const StringView& v);
+bool operator != (const std::string& s, const StringView& v);
+
+std::ostream& operator<< (std::ostream& stream, const StringView& v);
+
+int stoi(const StringView& v);
+long stol(const StringView& v);
+unsigned long stoul(const StringView& v);
+float stof(const StringView& v);
+double stod(const StringView& v);
+
+} //namespace cg3
+
+#include "string_view.tpp"
+
+#endif // CG3_STRING_VIEW_H
@@ -0,0 +1,330 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "string_view.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <limits>
+#include <stdexcept>
+
+namespace cg3 {
+
+inline StringView::StringView() :
+    str(""),
+    sz(0)
+{
+}
+
+inline StringView::StringView(const char* string) :
+    str(string),
+    sz(std::strlen(string))
+{
+}
+
+inline StringView::StringView(const char* string, size_t size) :
+    str(string),
+    sz(size)
+{
+}
+
+inline StringView::StringView(const char* begin, const char* end) :
+    str(begin),
+    sz((size_t)(end - begin))
+{
+}
+
+inline StringView::StringView(const std::string& string) :
+    str(string.data()),
+    sz(string.size())
+{
+}
+
+inline const char* StringView::data() const
+{
+    return str;
+}
+
+inline size_t StringView::size() const
+{
+    return sz;
+}
+
+inline size_t StringView::length() const
+{
+    return sz;
+}
+
+inline bool StringView::empty() const
+{
+    return sz == 0;
+}
+
+inline StringView::const_iterator StringView::begin() const
+{
+    return str;
+}
+
+inline StringView::const_iterator StringView::end() const
+{
+    return str + sz;
+}
+
+inline const char& StringView::front() const
+{
+    return str[0];
+}
+
+inline const char& StringView::back() const
+{
+    return str[sz-1];
+}
+
+/**
+ * @brief StringView::substr
+ * @param pos
+ * @param count
+ * @return a view of the characters in [pos, pos+count), clamped to the size
+ * of the view. No characters are copied.
+ */
+inline StringView StringView::substr(size_t pos, size_t count) const
+{
+    if (pos > sz)
+        throw std::out_of_range("cg3::StringView::substr");
+    size_t n = sz - pos < count ? sz - pos : count;
+    return StringView(str + pos, n);
+}
+
+/**
+ * @brief StringView::find
+ * @param c
+ * @param pos
+ * @return the position of the first occurrence of c starting from pos,
+ * StringView::npos if c is not found
+ */
+inline size_t StringView::find(char c, size_t pos) const
+{
+    if (pos >= sz)
+        return npos;
+    const void* p = std::memchr(str + pos, c, sz - pos);
+    return p == nullptr ? npos : (size_t)((const char*)p - str);
+}
+
+/**
+ * @brief StringView::compare
+ * Lexicographical comparison, same semantic of std::string::compare.
+ * @param other
+ * @return
+ */
+inline int StringView::compare(const StringView& other) const
+{
+    size_t n = sz < other.sz ? sz : other.sz;
+    int c = n == 0 ? 0 : std::memcmp(str, other.str, n);
+    if (c != 0)
+        return c;
+    if (sz == other.sz)
+        return 0;
+    return sz < other.sz ? -1 : 1;
+}
+
+/**
+ * @brief StringView::toString
+ * @return an owning copy of the referenced characters
+ */
+inline std::string StringView::toString() const
+{
+    return std::string(str, sz);
+}
+
+inline const char& StringView::operator[](size_t i) const
+{
+    return str[i];
+}
+
+inline bool StringView::operator ==(const StringView& other) const
+{
+    return sz == other.sz && (sz == 0 || std::memcmp(str, other.str, sz) == 0);
+}
+
+inline bool StringView::operator !=(const StringView& other) const
+{
+    return !(*this == other);
+}
+
+inline bool StringView::operator <(const StringView& other) const
+{
+    return compare(other) < 0;
+}
+
+inline bool operator ==(const char* s, const StringView& v)
+{
+    return v == StringView(s);
+}
+
+inline bool operator !=(const char* s, const StringView& v)
+{
+    return v != StringView(s);
+}
+
+inline bool operator ==(const std::string& s, const StringView& v)
+{
+    return v == StringView(s);
+}
+
+inline bool operator !=(const std::string& s, const StringView& v)
+{
+    return v != StringView(s);
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const StringView& v)
+{
+    stream.write(v.data(), (std::streamsize)v.size());
+    return stream;
+}
+
+namespace internal {
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief parses an integer from the view, without copying it.
+ * Leading whitespaces are skipped, characters after the last digit are
+ * ignored.
+ */
+template <typename T>
+T parseInteger(const StringView& v, const char* caller)
+{
+    const char* p = v.begin();
+    const char* end = v.end();
+    while (p != end && isSpace(*p))
+        ++p;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    if (p == end || *p < '0' || *p > '9')
+        throw std::invalid_argument(caller);
+
+    // accumulated as an unsigned magnitude, checked against the limits of T
+    typedef unsigned long long int Magnitude;
+    const Magnitude limit = negative ?
+                (Magnitude)std::numeric_limits<T>::max() + (std::numeric_limits<T>::is_signed ? 1 : 0) :
+                (Magnitude)std::numeric_limits<T>::max();
+    Magnitude value = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+        unsigned int digit = (unsigned int)(*p - '0');
+        if (value > (limit - digit) / 10)
+            throw std::out_of_range(caller);
+        value = value * 10 + digit;
+    }
+    if (negative) {
+        if (!std::numeric_limits<T>::is_signed) //unsigned, same wrap-around of std::stoul
+            return (T)(0 - value);
+        if (value == limit)
+            return std::numeric_limits<T>::min();
+        return -(T)value;
+    }
+    return (T)value;
+}
+
+/**
+ * @brief parses a floating point number from the view.
+ * strtod/strtof require a null terminated string: the (short) view is
+ * copied on a stack buffer, longer views fall back on a std::string.
+ */
+template <typename T, typename F>
+T parseFloating(const StringView& v, F function, const char* caller)
+{
+    char buffer[64];
+    std::string longBuffer;
+    const char* s;
+    if (v.size() < sizeof(buffer)) {
+        std::memcpy(buffer, v.data(), v.size());
+        buffer[v.size()] = '\0';
+        s = buffer;
+    }
+    else {
+        longBuffer = v.toString();
+        s = longBuffer.c_str();
+    }
+    char* last;
+    int savedErrno = errno;
+    errno = 0;
+    T value = function(s, &last);
+    if (last == s) {
+        errno = savedErrno;
+        throw std::invalid_argument(caller);
+    }
+    if (errno == ERANGE)
+        throw std::out_of_range(caller);
+    errno = savedErrno;
+    return value;
+}
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3core
+ * @brief Converts the characters of the view into an int, without allocating.
+ * @param v
+ * @return
+ */
+inline int stoi(const StringView& v)
+{
+    return internal::parseInteger<int>(v, "cg3::stoi");
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Converts the characters of the view into a long, without allocating.
+ * @param v
+ * @return
+ */
+inline long stol(const StringView& v)
+{
+    return internal::parseInteger<long>(v, "cg3::stol");
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Converts the characters of the view into an unsigned long, without allocating.
+ * @param v
+ * @return
+ */
+inline unsigned long stoul(const StringView& v)
+{
+    return internal::parseInteger<unsigned long>(v, "cg3::stoul");
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Converts the characters of the view into a float, without allocating.
+ * @param v
+ * @return
+ */
+inline float stof(const StringView& v)
+{
+    return internal::parseFloating<float>(v, &std::strtof, "cg3::stof");
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Converts the characters of the view into a double, without allocating.
+ * @param v
+ * @return
+ */
+inline double stod(const StringView& v)
+{
+    return internal::parseFloating<double>(v, &std::strtod, "cg3::stod");
+}
+
+} //namespace cg3
@@ -0,0 +1,132 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_THREAD_POOL_H
+#define CG3_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The ThreadPool class is a work-stealing pool of worker threads.
+ *
+ * Every worker owns a queue of tasks: tasks submitted by a worker are pushed
+ * on its own queue and are executed in LIFO order (the most recent task is
+ * still hot in cache), while idle workers steal the oldest tasks from the
+ * other queues. Tasks submitted by threads that are not workers of the pool
+ * are pushed on a shared queue.
+ *
+ * A pool with concurrency n has n-1 workers: the thread that waits on a
+ * TaskGroup executes pending tasks while waiting, and counts as the n-th
+ * thread. Therefore a pool with concurrency 1 has no workers, and all the
+ * tasks are executed by the waiting thread.
+ *
+ * The library algorithms use the global pool returned by ThreadPool::instance()
+ * through the functions declared in cg3/utilities/parallel.h. Its concurrency
+ * is the value of the CG3_NUM_THREADS environment variable if set, the number
+ * of hardware threads otherwise, and can be changed with
+ * cg3::setNumberOfThreads().
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned int concurrency = 0);
+    ~ThreadPool();
+
+    static ThreadPool& instance();
+
+    unsigned int concurrency() const;
+    void resize(unsigned int concurrency);
+
+    void submit(std::function<void()> task);
+    bool runPendingTask();
+
+    bool isWorkerThread() const;
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void start(unsigned int concurrency);
+    void stop();
+    void workerLoop(unsigned int index);
+    bool popTask(int workerIndex, std::function<void()>& task);
+    int workerIndex() const;
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<TaskQueue>> queues; //one per worker
+    TaskQueue sharedQueue;
+    std::atomic<size_t> nPendingTasks;
+    std::atomic<bool> stopped;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    unsigned int nThreads;
+};
+
+/**
+ * @ingroup cg3core
+ * @brief The TaskGroup class runs a group of tasks on a ThreadPool and waits
+ * for their completion.
+ *
+ * The thread that calls wait() executes pending tasks of the pool while
+ * waiting: tasks can therefore create and wait other TaskGroups (nested
+ * parallelism) without deadlocks.
+ *
+ * If a task throws an exception, the first exception is rethrown by wait().
+ * The destructor waits for the completion of all the tasks.
+ *
+ * \code{.cpp}
+ * cg3::TaskGroup group;
+ * group.run([&](){ left = foo(a); });
+ * group.run([&](){ right = foo(b); });
+ * group.wait();
+ * \endcode
+ */
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::instance());
+    ~TaskGroup();
+
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    TaskGroup(const TaskGroup&);
+    TaskGroup& operator=(const TaskGroup&);
+
+    struct State {
+        std::atomic<size_t> nRunningTasks;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::exception_ptr exception;
+    };
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
+};
+
+} //namespace cg3
+
+#include "thread_pool.tpp"
+
+#endif // CG3_THREAD_POOL_H
@@ -0,0 +1,310 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "thread_pool.h"
+
+#include <chrono>
+#include <cstdlib>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Identifies the pool and the index of the worker running on the
+ * calling thread, index -1 if the calling thread is not a worker.
+ */
+struct ThreadPoolWorkerInfo {
+    const void* pool;
+    int index;
+};
+
+inline ThreadPoolWorkerInfo& threadPoolWorkerInfo()
+{
+    static thread_local ThreadPoolWorkerInfo info = {nullptr, -1};
+    return info;
+}
+
+inline unsigned int defaultConcurrency()
+{
+    const char* env = std::getenv("CG3_NUM_THREADS");
+    if (env != nullptr) {
+        int n = std::atoi(env);
+        if (n > 0)
+            return (unsigned int)n;
+    }
+    unsigned int n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief ThreadPool::ThreadPool
+ * @param concurrency: maximum number of threads that execute tasks at the same
+ * time (workers plus the waiting thread). If 0, the default concurrency is
+ * used (CG3_NUM_THREADS environment variable or hardware threads).
+ */
+inline ThreadPool::ThreadPool(unsigned int concurrency) :
+    nPendingTasks(0),
+    stopped(false),
+    nThreads(1)
+{
+    start(concurrency);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+/**
+ * @brief ThreadPool::instance
+ * @return the global thread pool used by the library algorithms
+ */
+inline ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+inline unsigned int ThreadPool::concurrency() const
+{
+    return nThreads;
+}
+
+/**
+ * @brief ThreadPool::resize
+ * Changes the concurrency of the pool. Pending tasks are executed before
+ * stopping the current workers. It must not be called while tasks of the
+ * pool are running.
+ * @param concurrency: if 0, the default concurrency is used
+ */
+inline void ThreadPool::resize(unsigned int concurrency)
+{
+    if (concurrency == 0)
+        concurrency = internal::defaultConcurrency();
+    if (concurrency == nThreads)
+        return;
+    while (runPendingTask());
+    stop();
+    start(concurrency);
+}
+
+/**
+ * @brief ThreadPool::submit
+ * Schedules the execution of a task. Tasks submitted by this function must
+ * not throw: use a TaskGroup in order to wait the tasks and to get their
+ * exceptions.
+ * @param task
+ */
+inline void ThreadPool::submit(std::function<void()> task)
+{
+    int index = workerIndex();
+    TaskQueue& queue = index >= 0 ? *queues[index] : sharedQueue;
+    //counted before being visible, so that the counter never underflows
+    nPendingTasks.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    if (!workers.empty()) {
+        //avoids lost wake-ups of workers that are going to sleep
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        sleepCondition.notify_one();
+    }
+}
+
+/**
+ * @brief ThreadPool::runPendingTask
+ * Executes on the calling thread a pending task, if there is one.
+ * @return true if a task has been executed
+ */
+inline bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    if (!popTask(workerIndex(), task))
+        return false;
+    task();
+    return true;
+}
+
+/**
+ * @brief ThreadPool::isWorkerThread
+ * @return true if the calling thread is a worker of this pool
+ */
+inline bool ThreadPool::isWorkerThread() const
+{
+    return workerIndex() >= 0;
+}
+
+inline void ThreadPool::start(unsigned int concurrency)
+{
+    if (concurrency == 0)
+        concurrency = internal::defaultConcurrency();
+    nThreads = concurrency;
+    stopped = false;
+    queues.clear();
+    for (unsigned int i = 0; i + 1 < concurrency; i++)
+        queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+    for (unsigned int i = 0; i + 1 < concurrency; i++)
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+}
+
+inline void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopped = true;
+    }
+    sleepCondition.notify_all();
+    for (std::thread& t : workers)
+        t.join();
+    workers.clear();
+}
+
+inline void ThreadPool::workerLoop(unsigned int index)
+{
+    internal::ThreadPoolWorkerInfo& info = internal::threadPoolWorkerInfo();
+    info.pool = this;
+    info.index = (int)index;
+
+    std::function<void()> task;
+    for (;;) {
+        if (popTask((int)index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this](){
+            return stopped || nPendingTasks.load() > 0;
+        });
+        if (stopped && nPendingTasks.load() == 0)
+            break;
+    }
+
+    info.pool = nullptr;
+    info.index = -1;
+}
+
+/**
+ * @brief ThreadPool::popTask
+ * Takes a task from, in order: the queue of the worker (newest task), the
+ * shared queue (oldest task), the queues of the other workers (oldest task).
+ */
+inline bool ThreadPool::popTask(int workerIndex, std::function<void()>& task)
+{
+    if (nPendingTasks.load() == 0)
+        return false;
+    if (workerIndex >= 0) {
+        TaskQueue& own = *queues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            nPendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sharedQueue.mutex);
+        if (!sharedQueue.tasks.empty()) {
+            task = std::move(sharedQueue.tasks.front());
+            sharedQueue.tasks.pop_front();
+            nPendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+    size_t n = queues.size();
+    size_t first = workerIndex >= 0 ? (size_t)workerIndex + 1 : 0;
+    for (size_t i = 0; i < n; i++) {
+        TaskQueue& victim = *queues[(first + i) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            nPendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline int ThreadPool::workerIndex() const
+{
+    const internal::ThreadPoolWorkerInfo& info = internal::threadPoolWorkerInfo();
+    return info.pool == this ? info.index : -1;
+}
+
+inline TaskGroup::TaskGroup(ThreadPool& pool) :
+    pool(pool),
+    state(new State())
+{
+    state->nRunningTasks = 0;
+}
+
+inline TaskGroup::~TaskGroup()
+{
+    try {
+        wait();
+    }
+    catch (...) {
+    }
+}
+
+/**
+ * @brief TaskGroup::run
+ * Schedules the execution of task on the pool of the group.
+ * @param task
+ */
+inline void TaskGroup::run(std::function<void()> task)
+{
+    state->nRunningTasks.fetch_add(1);
+    std::shared_ptr<State> s = state;
+    pool.submit([s, task]() {
+        try {
+            task();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (!s->exception)
+                s->exception = std::current_exception();
+        }
+        if (s->nRunningTasks.fetch_sub(1) == 1) {
+            { std::lock_guard<std::mutex> lock(s->mutex); }
+            s->condition.notify_all();
+        }
+    });
+}
+
+/**
+ * @brief TaskGroup::wait
+ * Waits the completion of all the tasks of the group, executing pending tasks
+ * of the pool in the meantime. Rethrows the first exception thrown by a task.
+ */
+inline void TaskGroup::wait()
+{
+    while (state->nRunningTasks.load() > 0) {
+        if (!pool.runPendingTask()) {
+            //the remaining tasks are running on other threads
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->condition.wait_for(lock, std::chrono::microseconds(100), [this](){
+                return state->nRunningTasks.load() == 0;
+            });
+        }
+    }
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        std::swap(e, state->exception);
+    }
+    if (e)
+        std::rethrow_exception(e);
+}
+
+} //namespace cg3
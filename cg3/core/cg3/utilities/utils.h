@@ -8,6 +8,7 @@
 #ifndef CG3_UTILS_H
 #define CG3_UTILS_H
 
+#include <map>
 #include <vector>
 #include <memory>
 #include <type_traits>
@@ -21,6 +22,7 @@
 #include "../geometry/2d/point2d.h"
 #include "../utilities/color.h"
 #include "const.h"
+#include "graph_coloring.h"
 
 namespace cg3 {
 
@@ -106,10 +106,16 @@ inline bool isInBounds(const T& value, const R& low, const R& high, Comparator c
 /**
  * @ingroup cg3core
  * @brief smartColoring
+ * Assigns to every element a color such that adjacent elements have different
+ * colors: elements, in order, take the first color of colors not used by
+ * their adjacent elements, or black if all the colors are used. The
+ * adjacencies are collected once in a compressed sparse row graph, which is
+ * colored with greedyColoring.
  * @param elements
- * @param comp
+ * @param comp: a structure with a method getAdjacences(T) that returns an
+ * iterable container of the elements adjacent to an element
  * @param colors
- * @return
+ * @return the color of every element
  */
 template <typename T, typename AdjComparator>
 inline std::map<T, Color> smartColoring(
@@ -117,33 +123,29 @@ inline std::map<T, Color> smartColoring(
         AdjComparator comp,
         const std::vector<Color> &colors)
 {
-    std::set<T> colored;
-    std::map<T, Color> colorMap;
-    for (const T i : elements){
-        if (colored.find(i) == colored.end()){
-            std::set<Color> adjColors;
-            std::set<T> adjacences = comp.getAdjacences(i);
-            for (T adj : adjacences){
-                if (colored.find(adj) != colored.end())
-                    adjColors.insert(colorMap[adj]);
-            }
+    //index of every distinct element, in order of first occurrence
+    std::map<T, unsigned int> indices;
+    std::vector<T> nodes;
+    for (const T& e : elements)
+        if (indices.insert(std::make_pair(e, (unsigned int)nodes.size())).second)
+            nodes.push_back(e);
 
-            Color color;
-            bool finded = false;
-            for (unsigned int k = 0; k < colors.size() && !finded; k++){
-                if (adjColors.find(colors[k]) == adjColors.end()){
-                    finded = true;
-                    color = colors[k];
-                }
-            }
-            if (finded){
-                colorMap[i] = color;
-                colored.insert(i);
-            }
-            else
-                colorMap[i] = Color(0,0,0);
+    std::vector<unsigned int> offsets(1, 0), adjacencies;
+    offsets.reserve(nodes.size() + 1);
+    for (const T& e : nodes) {
+        for (const T& adj : comp.getAdjacences(e)) {
+            typename std::map<T, unsigned int>::const_iterator it = indices.find(adj);
+            if (it != indices.end())
+                adjacencies.push_back(it->second);
         }
+        offsets.push_back((unsigned int)adjacencies.size());
     }
+
+    std::vector<int> nodeColors =
+            greedyColoring(offsets, adjacencies, ColoringOptions((unsigned int)colors.size()));
+    std::map<T, Color> colorMap;
+    for (unsigned int i = 0; i < nodes.size(); i++)
+        colorMap[nodes[i]] = nodeColors[i] >= 0 ? colors[nodeColors[i]] : Color(0,0,0);
     return colorMap;
 }
 
@@ -10,6 +10,8 @@
 
 #include <vector>
 
+#include "parallel.h"
+
 namespace cg3 {
 
 template <typename T>
@@ -18,6 +20,17 @@ int binarySearch(const T &n, const std::vector<T> &v);
 template <typename T>
 std::vector<size_t> sortIndexes(const std::vector<T> &v);
 
+template <typename T, typename Compare = std::less<T>>
+std::vector<size_t> parallelSortIndexes(
+        const std::vector<T>& v,
+        Compare comp = Compare(),
+        const ParallelOptions& options = ParallelOptions());
+
+template <typename T>
+std::vector<size_t> radixSortIndexes(
+        const std::vector<T>& v,
+        const ParallelOptions& options = ParallelOptions());
+
 } //namespace cg3
 
 #include "vector.tpp"
@@ -7,8 +7,64 @@
 
 #include "vector.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
 namespace cg3 {
 
+namespace internal {
+
+/* minimum size of the ranges sorted with radixSortIndexes */
+const size_t RADIX_SORT_MIN_SIZE = 2048;
+
+template <size_t Size> struct RadixUnsigned;
+template <> struct RadixUnsigned<1> { typedef uint8_t type; };
+template <> struct RadixUnsigned<2> { typedef uint16_t type; };
+template <> struct RadixUnsigned<4> { typedef uint32_t type; };
+template <> struct RadixUnsigned<8> { typedef uint64_t type; };
+
+/**
+ * @brief Maps an arithmetic value to an unsigned key with the same order:
+ * the sign bit of signed integers is flipped, negative floating point numbers
+ * are complemented and the sign bit of the positive ones is set.
+ */
+template <typename T>
+struct RadixKey
+{
+    static_assert(std::is_arithmetic<T>::value, "radixSortIndexes requires arithmetic values");
+    static_assert(sizeof(T) <= 8, "radixSortIndexes supports values of at most 64 bits");
+    typedef typename RadixUnsigned<sizeof(T)>::type Key;
+    static const Key SIGN_BIT = (Key)((Key)1 << (sizeof(T) * 8 - 1));
+
+    static Key key(const T& v)
+    {
+        return key(v, std::integral_constant<int,
+                   std::is_floating_point<T>::value ? 2 : std::is_signed<T>::value ? 1 : 0>());
+    }
+
+    static Key key(const T& v, std::integral_constant<int, 0>) //unsigned
+    {
+        return (Key)v;
+    }
+
+    static Key key(const T& v, std::integral_constant<int, 1>) //signed
+    {
+        return (Key)((Key)v ^ SIGN_BIT);
+    }
+
+    static Key key(const T& v, std::integral_constant<int, 2>) //floating point
+    {
+        Key k;
+        std::memcpy(&k, &v, sizeof(T));
+        return (k & SIGN_BIT) ? (Key)~k : (Key)(k | SIGN_BIT);
+    }
+};
+
+} //namespace cg3::internal
+
 /**
  * @ingroup cg3core
  * @brief This function computes a binary search of an element on a sorted std::vector
@@ -51,4 +107,112 @@ inline std::vector<size_t> sortIndexes(const std::vector<T> &v)
     return idx;
 }
 
+/**
+ * @ingroup cg3core
+ * @brief Parallel version of sortIndexes, with cg3::parallelSort.
+ *
+ * The sort is stable: indices of equivalent values are in increasing order.
+ *
+ * @param v
+ * @param comp: comparator of the values of v
+ * @param options
+ * @return the indices of the elements of v, in order of value
+ */
+template <typename T, typename Compare>
+inline std::vector<size_t> parallelSortIndexes(
+        const std::vector<T>& v,
+        Compare comp,
+        const ParallelOptions& options)
+{
+    std::vector<size_t> idx(v.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    parallelSort(idx.begin(), idx.end(), [&v, &comp](size_t i1, size_t i2) {
+        return comp(v[i1], v[i2]);
+    }, options);
+    return idx;
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Sorts the indices of a vector of arithmetic values (integers or
+ * floating point numbers) with a parallel least significant digit radix sort.
+ *
+ * Values are mapped to unsigned keys with the same order, which are sorted
+ * one byte at a time: every pass counts the digits of contiguous chunks in
+ * parallel, and then scatters the chunks in parallel; passes in which all the
+ * keys have the same digit are skipped. The sort takes linear time and is
+ * stable: indices of equal values are in increasing order. NaNs are sorted
+ * after the positive infinity (or before the negative one, if their sign bit
+ * is set), and -0.0 precedes 0.0.
+ *
+ * @param v
+ * @param options
+ * @return the indices of the elements of v, in increasing order of value
+ */
+template <typename T>
+inline std::vector<size_t> radixSortIndexes(
+        const std::vector<T>& v,
+        const ParallelOptions& options)
+{
+    typedef internal::RadixKey<T> Radix;
+    typedef typename Radix::Key Key;
+    size_t n = v.size();
+    std::vector<Key> keys(n);
+    std::vector<size_t> idx(n);
+    parallelFor((size_t)0, n, [&](size_t i) {
+        keys[i] = Radix::key(v[i]);
+        idx[i] = i;
+    }, options);
+    if (n < internal::RADIX_SORT_MIN_SIZE) {
+        std::stable_sort(idx.begin(), idx.end(), [&keys](size_t i1, size_t i2) {
+            return keys[i1] < keys[i2];
+        });
+        return idx;
+    }
+
+    unsigned int nThreads = internal::parallelThreads(options);
+    size_t grain = std::max(internal::RADIX_SORT_MIN_SIZE, (n + 4 * nThreads - 1) / (4 * nThreads));
+    size_t nChunks = (n + grain - 1) / grain;
+    std::vector<Key> tmpKeys(n);
+    std::vector<size_t> tmpIdx(n);
+    std::vector<size_t> counts(nChunks * 256);
+    for (unsigned int shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+        std::fill(counts.begin(), counts.end(), 0);
+        internal::parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int) {
+            size_t* count = &counts[c * 256];
+            for (size_t i = c * grain; i < std::min(n, (c + 1) * grain); i++)
+                count[(keys[i] >> shift) & 0xFF]++;
+        });
+
+        //offsets of every digit in every chunk: digits in order, and chunks in
+        //order inside every digit, to keep the sort stable
+        bool skip = false;
+        size_t offset = 0;
+        for (unsigned int d = 0; d < 256 && !skip; d++) {
+            size_t digitCount = 0;
+            for (size_t c = 0; c < nChunks; c++) {
+                size_t cnt = counts[c * 256 + d];
+                counts[c * 256 + d] = offset;
+                offset += cnt;
+                digitCount += cnt;
+            }
+            skip = digitCount == n;
+        }
+        if (skip)
+            continue;
+
+        internal::parallelChunks(nChunks, nThreads, [&](size_t c, unsigned int) {
+            size_t* pos = &counts[c * 256];
+            for (size_t i = c * grain; i < std::min(n, (c + 1) * grain); i++) {
+                size_t p = pos[(keys[i] >> shift) & 0xFF]++;
+                tmpKeys[p] = keys[i];
+                tmpIdx[p] = idx[i];
+            }
+        });
+        keys.swap(tmpKeys);
+        idx.swap(tmpIdx);
+    }
+    return idx;
+}
+
 } //namespace cg3
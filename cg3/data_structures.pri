@@ -134,3 +134,11 @@ HEADERS += \
 SOURCES += \
     $$PWD/data_structures/trees/aabbtree.tpp \
     $$PWD/data_structures/trees/includes/nodes/aabb_node.tpp
+
+
+# Kd tree
+HEADERS += \
+    $$PWD/data_structures/trees/kdtree.h
+
+SOURCES += \
+    $$PWD/data_structures/trees/kdtree.tpp
@@ -14,6 +14,7 @@
 #include "includes/avl_helpers.h"
 
 #include "cg3/utilities/const.h"
+#include "cg3/utilities/profiler.h"
 
 namespace cg3 {
 
@@ -155,6 +156,7 @@ void AABBTree<D,K,T,C>::construction(const std::vector<K>& vec)
 template <int D, class K, class T, class C>
 void AABBTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 {
+    CG3_PROFILE_SCOPE("AABBTree::construction");
     this->clear();
 
     if (vec.size() == 0)
@@ -406,6 +408,7 @@ void AABBTree<D,K,T,C>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
+    CG3_PROFILE_SCOPE("AABBTree::rangeQuery");
     //Output
     std::vector<Node*> nodeOutput;
 
@@ -431,6 +434,7 @@ void AABBTree<D,K,T,C>::aabbOverlapQuery(
         OutputIterator out,
         KeyOverlapChecker keyOverlapChecker)
 {
+    CG3_PROFILE_SCOPE("AABBTree::aabbOverlapQuery");
     //Get the AABB
     typename Node::AABB aabb;
     this->setAABBFromKeyHelper(key, aabb, aabbValueExtractor);
@@ -458,6 +462,7 @@ bool AABBTree<D,K,T,C>::aabbOverlapCheck(
         const K& key,
         KeyOverlapChecker keyOverlapChecker)
 {
+    CG3_PROFILE_SCOPE("AABBTree::aabbOverlapCheck");
     //Get the AABB
     typename Node::AABB aabb;
     this->setAABBFromKeyHelper(key, aabb, aabbValueExtractor);
@@ -13,6 +13,8 @@
 #include "includes/bstinner_helpers.h"
 #include "includes/avl_helpers.h"
 
+#include "cg3/utilities/profiler.h"
+
 namespace cg3 {
 
 
@@ -139,6 +141,7 @@ void AVLInner<K,T,C>::construction(const std::vector<K>& vec)
 template <class K, class T, class C>
 void AVLInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 {
+    CG3_PROFILE_SCOPE("AVLInner::construction");
     this->clear();
 
     if (vec.size() == 0)
@@ -417,6 +420,7 @@ void AVLInner<K,T,C>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
+    CG3_PROFILE_SCOPE("AVLInner::rangeQuery");
     //Output
     std::vector<Node*> nodeOutput;
 
@@ -13,6 +13,8 @@
 #include "includes/bstleaf_helpers.h"
 #include "includes/avl_helpers.h"
 
+#include "cg3/utilities/profiler.h"
+
 namespace cg3 {
 
 
@@ -138,6 +140,7 @@ void AVLLeaf<K,T,C>::construction(const std::vector<K>& vec)
 template <class K, class T, class C>
 void AVLLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 {
+    CG3_PROFILE_SCOPE("AVLLeaf::construction");
     this->clear();
 
     if (vec.size() == 0)
@@ -413,6 +416,7 @@ void AVLLeaf<K,T,C>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
+    CG3_PROFILE_SCOPE("AVLLeaf::rangeQuery");
     //Output
     std::vector<Node*> nodeOutput;
 
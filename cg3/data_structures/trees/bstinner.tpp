@@ -8,6 +8,8 @@
 
 #include "includes/bstinner_helpers.h"
 
+#include "cg3/utilities/profiler.h"
+
 #include <stdexcept>
 #include <algorithm>
 #include <utility>
@@ -137,6 +139,7 @@ void BSTInner<K,T,C>::construction(const std::vector<K>& vec)
 template <class K, class T, class C>
 void BSTInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 {
+    CG3_PROFILE_SCOPE("BSTInner::construction");
     this->clear();
 
     if (vec.size() == 0)
@@ -397,6 +400,7 @@ void BSTInner<K,T,C>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
+    CG3_PROFILE_SCOPE("BSTInner::rangeQuery");
     //Output
     std::vector<Node*> nodeOutput;
 
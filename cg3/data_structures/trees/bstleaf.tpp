@@ -8,6 +8,8 @@
 
 #include "includes/bstleaf_helpers.h"
 
+#include "cg3/utilities/profiler.h"
+
 #include <stdexcept>
 #include <algorithm>
 #include <utility>
@@ -137,6 +139,7 @@ void BSTLeaf<K,T,C>::construction(const std::vector<K>& vec)
 template <class K, class T, class C>
 void BSTLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 {
+    CG3_PROFILE_SCOPE("BSTLeaf::construction");
     this->clear();
 
     if (vec.size() == 0)
@@ -394,6 +397,7 @@ void BSTLeaf<K,T,C>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
+    CG3_PROFILE_SCOPE("BSTLeaf::rangeQuery");
     //Output
     std::vector<Node*> nodeOutput;
 
@@ -0,0 +1,198 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_KDTREE_H
+#define CG3_KDTREE_H
+
+#include <vector>
+
+#include "cg3/geometry/point.h"
+#include "cg3/geometry/2d/point2d.h"
+#include "cg3/utilities/parallel.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Default coordinate accessor of KdTree: the coordinate dim of a key
+ * is key[dim].
+ */
+template <class K>
+struct KdTreeDefaultAccessor
+{
+    double operator()(const K& key, unsigned int dim) const { return key[dim]; }
+};
+
+} //namespace cg3::internal
+
+/**
+ * @brief Static kd-tree on a set of D-dimensional points, for nearest
+ * neighbour, k nearest neighbours and radius queries.
+ *
+ * The tree is built once on a vector of keys, and queries return indices in
+ * that vector. Keys may be of any type: their coordinates are read by an
+ * accessor functor A, called as accessor(key, dim), which by default returns
+ * key[dim] (Point, Point2D and PointN work out of the box).
+ *
+ * Nodes are stored in a single array in preorder, and the leaves are buckets
+ * of at most bucketSize points whose coordinates are contiguous in memory:
+ * queries scan the buckets linearly and prune the nodes by the distance from
+ * their bounding boxes. The construction splits at the median of the largest
+ * dimension, and builds the subtrees in parallel.
+ *
+ * All the query methods are const and can be called concurrently; the batch
+ * methods run a set of queries in parallel. The k nearest neighbours and the
+ * nearest neighbour queries accept an approximation factor eps: the returned
+ * points are at most (1 + eps) times farther than the exact ones.
+ *
+ * \code{.cpp}
+ * std::vector<cg3::Pointd> points = ...;
+ * cg3::KdTree3D tree(points);
+ * unsigned int nearest = tree.nearestNeighbor(cg3::Pointd(0, 0, 0));
+ * std::vector<unsigned int> knn = tree.kNearestNeighbors(points[0], 8);
+ * std::vector<unsigned int> inRadius;
+ * tree.radiusSearch(points[0], 0.1, std::back_inserter(inRadius));
+ * \endcode
+ */
+template <int D, class K, class A = internal::KdTreeDefaultAccessor<K>>
+class KdTree
+{
+public:
+
+    static const unsigned int npos = (unsigned int)-1;
+
+    /* Constructors */
+
+    KdTree(const A& accessor = A(), unsigned int bucketSize = 16);
+    explicit KdTree(
+            const std::vector<K>& keys,
+            const A& accessor = A(),
+            unsigned int bucketSize = 16,
+            const ParallelOptions& options = ParallelOptions());
+
+    /* Public methods */
+
+    void construction(
+            const std::vector<K>& keys,
+            const ParallelOptions& options = ParallelOptions());
+
+    unsigned int size() const;
+    bool empty() const;
+    void clear();
+
+    unsigned int nearestNeighbor(
+            const K& query,
+            double* squaredDistance = nullptr,
+            double eps = 0) const;
+
+    std::vector<unsigned int> kNearestNeighbors(
+            const K& query,
+            unsigned int k,
+            double eps = 0) const;
+    void kNearestNeighbors(
+            const K& query,
+            unsigned int k,
+            std::vector<unsigned int>& neighbors,
+            std::vector<double>& squaredDistances,
+            double eps = 0) const;
+
+    template <class OutputIterator>
+    void radiusSearch(
+            const K& query,
+            double radius,
+            OutputIterator out) const;
+
+    /* Batch queries */
+
+    std::vector<unsigned int> batchNearestNeighbor(
+            const std::vector<K>& queries,
+            double eps = 0,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+    std::vector<unsigned int> batchKNearestNeighbors(
+            const std::vector<K>& queries,
+            unsigned int k,
+            double eps = 0,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+    void batchRadiusSearch(
+            const std::vector<K>& queries,
+            double radius,
+            std::vector<unsigned int>& offsets,
+            std::vector<unsigned int>& neighbors,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+protected:
+
+    /* Node of the tree: the left child of an inner node is the next node, the
+     * right child is the node right; leaves have right == 0 */
+    struct Node
+    {
+        double min[D];
+        double max[D];
+        unsigned int begin;
+        unsigned int end;
+        unsigned int right;
+    };
+
+    typedef std::pair<double, unsigned int> Neighbor;
+
+    /* Construction helpers */
+
+    unsigned int numberNodes(unsigned int n) const;
+    void buildNode(
+            unsigned int node,
+            unsigned int begin,
+            unsigned int end,
+            const std::vector<double>& keyCoords,
+            unsigned int maxSequentialSize,
+            std::vector<unsigned int>* tasks);
+
+    /* Query helpers */
+
+    void queryCoords(const K& query, double q[D]) const;
+    double squaredBoxDistance(const Node& node, const double q[D]) const;
+    void kNearestNeighbors(
+            unsigned int node,
+            const double q[D],
+            unsigned int k,
+            double epsFactor,
+            std::vector<Neighbor>& heap) const;
+    template <class OutputIterator>
+    void radiusSearch(
+            unsigned int node,
+            const double q[D],
+            double squaredRadius,
+            OutputIterator& out) const;
+
+    A accessor;
+    unsigned int bucketSize;
+
+    std::vector<Node> nodes;
+
+    /* indices of the keys, in the order of the leaves */
+    std::vector<unsigned int> indices;
+
+    /* coordinates of the keys, in the order of the leaves */
+    std::vector<double> coords;
+};
+
+/**
+ * Kd-tree of 2D points (double components)
+ */
+typedef KdTree<2, Point2Dd> KdTree2D;
+
+/**
+ * Kd-tree of 3D points (double components)
+ */
+typedef KdTree<3, Pointd> KdTree3D;
+
+} //namespace cg3
+
+#include "kdtree.tpp"
+
+#endif // CG3_KDTREE_H
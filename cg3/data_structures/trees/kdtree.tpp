@@ -0,0 +1,487 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "kdtree.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace cg3 {
+
+template <int D, class K, class A>
+const unsigned int KdTree<D,K,A>::npos;
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Constructor of an empty kd-tree
+ * @param[in] accessor Functor that returns the coordinates of the keys
+ * @param[in] bucketSize Maximum number of points in a leaf
+ */
+template <int D, class K, class A>
+KdTree<D,K,A>::KdTree(const A& accessor, unsigned int bucketSize) :
+    accessor(accessor),
+    bucketSize(std::max(bucketSize, 1u))
+{
+}
+
+/**
+ * @brief Constructor of a kd-tree of the given keys
+ * @param[in] keys Keys of the tree
+ * @param[in] accessor Functor that returns the coordinates of the keys
+ * @param[in] bucketSize Maximum number of points in a leaf
+ * @param[in] options Options of the parallel construction
+ */
+template <int D, class K, class A>
+KdTree<D,K,A>::KdTree(
+        const std::vector<K>& keys,
+        const A& accessor,
+        unsigned int bucketSize,
+        const ParallelOptions& options) :
+    KdTree(accessor, bucketSize)
+{
+    construction(keys, options);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Builds the tree on the given keys, replacing the previous ones.
+ *
+ * The top levels of the tree are split sequentially until every subtree has
+ * at most n / (4 * nThreads) points; then the subtrees are built in parallel.
+ * Since the median split makes the size of every subtree depend only on the
+ * number of its points, the position of every subtree in the array of the
+ * nodes is known in advance, and subtrees are written in place.
+ *
+ * @param[in] keys Keys of the tree
+ * @param[in] options Options of the parallel construction
+ */
+template <int D, class K, class A>
+void KdTree<D,K,A>::construction(
+        const std::vector<K>& keys,
+        const ParallelOptions& options)
+{
+    unsigned int n = (unsigned int)keys.size();
+    std::vector<double> keyCoords((size_t)n * D);
+    indices.resize(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        for (int d = 0; d < D; d++)
+            keyCoords[(size_t)i * D + d] = accessor(keys[i], d);
+        indices[i] = i;
+    }, options);
+    nodes.resize(numberNodes(n));
+    coords.resize((size_t)n * D);
+    if (n == 0)
+        return;
+
+    unsigned int nThreads = internal::parallelThreads(options);
+    unsigned int maxSequentialSize = std::max(bucketSize, n / (4 * nThreads));
+    std::vector<unsigned int> tasks;
+    buildNode(0, 0, n, keyCoords, maxSequentialSize, n > maxSequentialSize ? &tasks : nullptr);
+    parallelFor((size_t)0, tasks.size() / 3, [&](size_t t) {
+        buildNode(tasks[3*t], tasks[3*t+1], tasks[3*t+2], keyCoords, maxSequentialSize, nullptr);
+    }, ParallelOptions(options.nThreads, 1));
+
+    parallelFor(0u, n, [&](unsigned int i) {
+        for (int d = 0; d < D; d++)
+            coords[(size_t)i * D + d] = keyCoords[(size_t)indices[i] * D + d];
+    }, options);
+}
+
+/**
+ * @brief Get the number of points in the tree
+ */
+template <int D, class K, class A>
+unsigned int KdTree<D,K,A>::size() const
+{
+    return (unsigned int)indices.size();
+}
+
+/**
+ * @brief Check if the tree is empty
+ */
+template <int D, class K, class A>
+bool KdTree<D,K,A>::empty() const
+{
+    return indices.empty();
+}
+
+/**
+ * @brief Clear the tree
+ */
+template <int D, class K, class A>
+void KdTree<D,K,A>::clear()
+{
+    nodes.clear();
+    indices.clear();
+    coords.clear();
+}
+
+/**
+ * @brief Nearest neighbour query
+ * @param[in] query Query point
+ * @param[out] squaredDistance If not nullptr, it is set to the squared distance
+ * between the query and its nearest neighbour
+ * @param[in] eps Approximation factor: the returned point is at most (1 + eps)
+ * times farther than the nearest one
+ * @return The index of the nearest key, npos if the tree is empty
+ */
+template <int D, class K, class A>
+unsigned int KdTree<D,K,A>::nearestNeighbor(
+        const K& query,
+        double* squaredDistance,
+        double eps) const
+{
+    if (empty())
+        return npos;
+    double q[D];
+    queryCoords(query, q);
+    std::vector<Neighbor> heap;
+    heap.reserve(1);
+    kNearestNeighbors(0, q, 1, (1 + eps) * (1 + eps), heap);
+    if (squaredDistance != nullptr)
+        *squaredDistance = heap[0].first;
+    return heap[0].second;
+}
+
+/**
+ * @brief K nearest neighbours query
+ * @param[in] query Query point
+ * @param[in] k Number of neighbours
+ * @param[in] eps Approximation factor: the i-th returned point is at most
+ * (1 + eps) times farther than the exact i-th nearest neighbour
+ * @return The indices of the min(k, size()) nearest keys, sorted by distance
+ */
+template <int D, class K, class A>
+std::vector<unsigned int> KdTree<D,K,A>::kNearestNeighbors(
+        const K& query,
+        unsigned int k,
+        double eps) const
+{
+    std::vector<unsigned int> neighbors;
+    std::vector<double> squaredDistances;
+    kNearestNeighbors(query, k, neighbors, squaredDistances, eps);
+    return neighbors;
+}
+
+/**
+ * @brief K nearest neighbours query
+ * @param[in] query Query point
+ * @param[in] k Number of neighbours
+ * @param[out] neighbors The indices of the min(k, size()) nearest keys, sorted
+ * by distance (equidistant keys are sorted by index)
+ * @param[out] squaredDistances The squared distances of the nearest keys
+ * @param[in] eps Approximation factor
+ */
+template <int D, class K, class A>
+void KdTree<D,K,A>::kNearestNeighbors(
+        const K& query,
+        unsigned int k,
+        std::vector<unsigned int>& neighbors,
+        std::vector<double>& squaredDistances,
+        double eps) const
+{
+    neighbors.clear();
+    squaredDistances.clear();
+    if (empty() || k == 0)
+        return;
+    double q[D];
+    queryCoords(query, q);
+    std::vector<Neighbor> heap;
+    heap.reserve(k);
+    kNearestNeighbors(0, q, k, (1 + eps) * (1 + eps), heap);
+    std::sort_heap(heap.begin(), heap.end());
+    neighbors.resize(heap.size());
+    squaredDistances.resize(heap.size());
+    for (unsigned int i = 0; i < heap.size(); i++) {
+        squaredDistances[i] = heap[i].first;
+        neighbors[i] = heap[i].second;
+    }
+}
+
+/**
+ * @brief Radius query
+ * @param[in] query Query point
+ * @param[in] radius Radius of the query
+ * @param[out] out Output iterator, to which are assigned the indices of the
+ * keys whose distance from the query is at most radius
+ */
+template <int D, class K, class A>
+template <class OutputIterator>
+void KdTree<D,K,A>::radiusSearch(
+        const K& query,
+        double radius,
+        OutputIterator out) const
+{
+    if (empty())
+        return;
+    double q[D];
+    queryCoords(query, q);
+    radiusSearch(0, q, radius * radius, out);
+}
+
+
+
+/* --------- BATCH QUERIES --------- */
+
+/**
+ * @brief Nearest neighbour queries of a set of points, in parallel
+ * @param[in] queries Query points
+ * @param[in] eps Approximation factor
+ * @param[in] options Options of the parallel execution
+ * @return The index of the nearest key of every query
+ */
+template <int D, class K, class A>
+std::vector<unsigned int> KdTree<D,K,A>::batchNearestNeighbor(
+        const std::vector<K>& queries,
+        double eps,
+        const ParallelOptions& options) const
+{
+    std::vector<unsigned int> res(queries.size());
+    parallelFor((size_t)0, queries.size(), [&](size_t i) {
+        res[i] = nearestNeighbor(queries[i], nullptr, eps);
+    }, options);
+    return res;
+}
+
+/**
+ * @brief K nearest neighbours queries of a set of points, in parallel
+ * @param[in] queries Query points
+ * @param[in] k Number of neighbours
+ * @param[in] eps Approximation factor
+ * @param[in] options Options of the parallel execution
+ * @return A vector of queries.size() * k indices: the neighbours of the i-th
+ * query, sorted by distance, are in [i * k, (i + 1) * k), followed by npos if
+ * the tree has less than k points
+ */
+template <int D, class K, class A>
+std::vector<unsigned int> KdTree<D,K,A>::batchKNearestNeighbors(
+        const std::vector<K>& queries,
+        unsigned int k,
+        double eps,
+        const ParallelOptions& options) const
+{
+    std::vector<unsigned int> res(queries.size() * k, npos);
+    parallelFor((size_t)0, queries.size(), [&](size_t i) {
+        std::vector<unsigned int> knn;
+        std::vector<double> squaredDistances;
+        kNearestNeighbors(queries[i], k, knn, squaredDistances, eps);
+        std::copy(knn.begin(), knn.end(), res.begin() + i * k);
+    }, options);
+    return res;
+}
+
+/**
+ * @brief Radius queries of a set of points, in parallel
+ * @param[in] queries Query points
+ * @param[in] radius Radius of the queries
+ * @param[out] offsets queries.size() + 1 offsets: the results of the i-th query
+ * are neighbors[offsets[i]], ..., neighbors[offsets[i+1]-1]
+ * @param[out] neighbors Indices of the keys in the radius of every query
+ * @param[in] options Options of the parallel execution
+ */
+template <int D, class K, class A>
+void KdTree<D,K,A>::batchRadiusSearch(
+        const std::vector<K>& queries,
+        double radius,
+        std::vector<unsigned int>& offsets,
+        std::vector<unsigned int>& neighbors,
+        const ParallelOptions& options) const
+{
+    std::vector<std::vector<unsigned int>> res(queries.size());
+    parallelFor((size_t)0, queries.size(), [&](size_t i) {
+        radiusSearch(queries[i], radius, std::back_inserter(res[i]));
+    }, options);
+    std::vector<unsigned int> sizes(queries.size());
+    for (size_t i = 0; i < queries.size(); i++)
+        sizes[i] = (unsigned int)res[i].size();
+    offsets.resize(queries.size() + 1);
+    offsets[queries.size()] = parallelExclusiveScan(sizes.begin(), sizes.end(), offsets.begin(), 0u);
+    neighbors.resize(offsets[queries.size()]);
+    parallelFor((size_t)0, queries.size(), [&](size_t i) {
+        std::copy(res[i].begin(), res[i].end(), neighbors.begin() + offsets[i]);
+    }, options);
+}
+
+
+
+/* --------- CONSTRUCTION HELPERS --------- */
+
+/**
+ * @brief Number of nodes of a tree of n points
+ */
+template <int D, class K, class A>
+unsigned int KdTree<D,K,A>::numberNodes(unsigned int n) const
+{
+    if (n == 0)
+        return 0;
+    if (n <= bucketSize)
+        return 1;
+    return 1 + numberNodes(n / 2) + numberNodes(n - n / 2);
+}
+
+/**
+ * @brief Builds the subtree rooted in node, on the points in [begin, end).
+ * If tasks is not nullptr, subtrees with at most maxSequentialSize points are
+ * not built, and they are appended to tasks as (node, begin, end).
+ */
+template <int D, class K, class A>
+void KdTree<D,K,A>::buildNode(
+        unsigned int node,
+        unsigned int begin,
+        unsigned int end,
+        const std::vector<double>& keyCoords,
+        unsigned int maxSequentialSize,
+        std::vector<unsigned int>* tasks)
+{
+    Node& n = nodes[node];
+    n.begin = begin;
+    n.end = end;
+    n.right = 0;
+    for (int d = 0; d < D; d++) {
+        n.min[d] = std::numeric_limits<double>::max();
+        n.max[d] = std::numeric_limits<double>::lowest();
+    }
+    for (unsigned int i = begin; i < end; i++) {
+        const double* c = &keyCoords[(size_t)indices[i] * D];
+        for (int d = 0; d < D; d++) {
+            n.min[d] = std::min(n.min[d], c[d]);
+            n.max[d] = std::max(n.max[d], c[d]);
+        }
+    }
+    if (end - begin <= bucketSize)
+        return;
+
+    //median split on the dimension with the largest extent
+    int dim = 0;
+    for (int d = 1; d < D; d++)
+        if (n.max[d] - n.min[d] > n.max[dim] - n.min[dim])
+            dim = d;
+    unsigned int mid = begin + (end - begin) / 2;
+    std::nth_element(
+                indices.begin() + begin, indices.begin() + mid, indices.begin() + end,
+                [&](unsigned int a, unsigned int b) {
+        return keyCoords[(size_t)a * D + dim] < keyCoords[(size_t)b * D + dim];
+    });
+
+    unsigned int left = node + 1;
+    n.right = left + numberNodes(mid - begin);
+    unsigned int right = n.right;
+    unsigned int children[2][3] = {{left, begin, mid}, {right, mid, end}};
+    for (unsigned int c = 0; c < 2; c++) {
+        if (tasks != nullptr && children[c][2] - children[c][1] <= maxSequentialSize)
+            tasks->insert(tasks->end(), children[c], children[c] + 3);
+        else
+            buildNode(children[c][0], children[c][1], children[c][2], keyCoords, maxSequentialSize, tasks);
+    }
+}
+
+
+
+/* --------- QUERY HELPERS --------- */
+
+template <int D, class K, class A>
+void KdTree<D,K,A>::queryCoords(const K& query, double q[D]) const
+{
+    for (int d = 0; d < D; d++)
+        q[d] = accessor(query, d);
+}
+
+/**
+ * @brief Squared distance between q and the bounding box of node (zero if q
+ * is inside the box)
+ */
+template <int D, class K, class A>
+double KdTree<D,K,A>::squaredBoxDistance(const Node& node, const double q[D]) const
+{
+    double dist = 0;
+    for (int d = 0; d < D; d++) {
+        double diff = q[d] < node.min[d] ? node.min[d] - q[d] :
+                      q[d] > node.max[d] ? q[d] - node.max[d] : 0;
+        dist += diff * diff;
+    }
+    return dist;
+}
+
+/**
+ * @brief Visits the subtree rooted in node, keeping in heap (a max heap of
+ * at most k (squared distance, index) pairs) the nearest points found so far.
+ * Nodes whose box is farther than the farthest point in the heap, divided by
+ * (1 + eps), are skipped; epsFactor is (1 + eps)^2.
+ */
+template <int D, class K, class A>
+void KdTree<D,K,A>::kNearestNeighbors(
+        unsigned int node,
+        const double q[D],
+        unsigned int k,
+        double epsFactor,
+        std::vector<Neighbor>& heap) const
+{
+    const Node& n = nodes[node];
+    if (n.right == 0) {
+        for (unsigned int i = n.begin; i < n.end; i++) {
+            const double* c = &coords[(size_t)i * D];
+            double dist = 0;
+            for (int d = 0; d < D; d++)
+                dist += (c[d] - q[d]) * (c[d] - q[d]);
+            Neighbor nb(dist, indices[i]);
+            if (heap.size() < k) {
+                heap.push_back(nb);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (nb < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = nb;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+
+    //nearest child first
+    unsigned int children[2] = {node + 1, n.right};
+    double dists[2] = {squaredBoxDistance(nodes[children[0]], q), squaredBoxDistance(nodes[children[1]], q)};
+    if (dists[1] < dists[0]) {
+        std::swap(children[0], children[1]);
+        std::swap(dists[0], dists[1]);
+    }
+    for (unsigned int c = 0; c < 2; c++) {
+        if (heap.size() < k || dists[c] * epsFactor <= heap.front().first)
+            kNearestNeighbors(children[c], q, k, epsFactor, heap);
+    }
+}
+
+template <int D, class K, class A>
+template <class OutputIterator>
+void KdTree<D,K,A>::radiusSearch(
+        unsigned int node,
+        const double q[D],
+        double squaredRadius,
+        OutputIterator& out) const
+{
+    const Node& n = nodes[node];
+    if (squaredBoxDistance(n, q) > squaredRadius)
+        return;
+    if (n.right == 0) {
+        for (unsigned int i = n.begin; i < n.end; i++) {
+            const double* c = &coords[(size_t)i * D];
+            double dist = 0;
+            for (int d = 0; d < D; d++)
+                dist += (c[d] - q[d]) * (c[d] - q[d]);
+            if (dist <= squaredRadius)
+                *out++ = indices[i];
+        }
+        return;
+    }
+    radiusSearch(node + 1, q, squaredRadius, out);
+    radiusSearch(n.right, q, squaredRadius, out);
+}
+
+} //namespace cg3
@@ -11,6 +11,8 @@
 #include "includes/bstleaf_helpers.h"
 #include "includes/avl_helpers.h"
 
+#include "cg3/utilities/profiler.h"
+
 namespace cg3 {
 
 
@@ -152,6 +154,7 @@ void RangeTree<K,T,C>::construction(const std::vector<K>& vec)
 template <class K, class T, class C>
 void RangeTree<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 {
+    CG3_PROFILE_SCOPE("RangeTree::construction");
     this->clear();
 
     if (vec.size() == 0)
@@ -406,6 +409,7 @@ void RangeTree<K,T,C>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
+    CG3_PROFILE_SCOPE("RangeTree::rangeQuery");
     //Output
     std::vector<Node*> nodeOutput;
 
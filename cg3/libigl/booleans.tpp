@@ -10,6 +10,7 @@
 #ifdef CG3_CGAL_DEFINED
 #include "internal/eigenmesh_libigl_algorithms.h"
 #include "internal/booleans_algorithms.h"
+#include <cg3/utilities/profiler.h>
 
 namespace cg3 {
 namespace libigl {
@@ -50,6 +51,7 @@ inline SimpleEigenMesh CSGTreeToEigenMesh(const CSGTree& tree)
  */
 inline CSGTree intersection(const CSGTree& c1, const CSGTree& c2)
 {
+    CG3_PROFILE_SCOPE("libigl::intersection(CSGTree)");
     return internal::intersection(c1, c2);
 }
 
@@ -62,6 +64,7 @@ inline CSGTree intersection(const CSGTree& c1, const CSGTree& c2)
  */
 inline SimpleEigenMesh intersection(const SimpleEigenMesh& m1, const SimpleEigenMesh& m2)
 {
+    CG3_PROFILE_SCOPE("libigl::intersection(SimpleEigenMesh)");
     return internal::EigenMeshLibIglAlgorithms::intersection(m1, m2);
 }
 
@@ -74,6 +77,7 @@ inline SimpleEigenMesh intersection(const SimpleEigenMesh& m1, const SimpleEigen
  */
 inline EigenMesh intersection(const EigenMesh& m1, const EigenMesh& m2)
 {
+    CG3_PROFILE_SCOPE("libigl::intersection(EigenMesh)");
     return internal::EigenMeshLibIglAlgorithms::intersection(m1, m2);
 }
 
@@ -127,6 +131,7 @@ inline void intersection(EigenMesh& result, const EigenMesh& m1, const EigenMesh
  */
 inline CSGTree difference(const CSGTree& c1, const CSGTree& c2)
 {
+    CG3_PROFILE_SCOPE("libigl::difference(CSGTree)");
     return internal::difference(c1, c2);
 }
 
@@ -141,6 +146,7 @@ inline SimpleEigenMesh difference(
         const SimpleEigenMesh& m1,
         const SimpleEigenMesh& m2)
 {
+    CG3_PROFILE_SCOPE("libigl::difference(SimpleEigenMesh)");
     return internal::EigenMeshLibIglAlgorithms::difference(m1, m2);
 }
 
@@ -153,6 +159,7 @@ inline SimpleEigenMesh difference(
  */
 inline EigenMesh difference(const EigenMesh& m1, const EigenMesh& m2)
 {
+    CG3_PROFILE_SCOPE("libigl::difference(EigenMesh)");
     return internal::EigenMeshLibIglAlgorithms::difference(m1, m2);
 }
 
@@ -207,6 +214,7 @@ inline void difference(EigenMesh& result, const EigenMesh& m1, const EigenMesh&
  */
 inline CSGTree union_(const CSGTree& c1, const CSGTree& c2)
 {
+    CG3_PROFILE_SCOPE("libigl::union_(CSGTree)");
     return internal::union_(c1, c2);
 }
 
@@ -219,6 +227,7 @@ inline CSGTree union_(const CSGTree& c1, const CSGTree& c2)
  */
 inline SimpleEigenMesh union_(const SimpleEigenMesh& m1, const SimpleEigenMesh& m2)
 {
+    CG3_PROFILE_SCOPE("libigl::union_(SimpleEigenMesh)");
     return internal::EigenMeshLibIglAlgorithms::union_(m1, m2);
 }
 
@@ -231,6 +240,7 @@ inline SimpleEigenMesh union_(const SimpleEigenMesh& m1, const SimpleEigenMesh&
  */
 inline EigenMesh union_(const EigenMesh& m1, const EigenMesh& m2)
 {
+    CG3_PROFILE_SCOPE("libigl::union_(EigenMesh)");
     return internal::EigenMeshLibIglAlgorithms::union_(m1, m2);
 }
 
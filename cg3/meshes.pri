@@ -14,17 +14,24 @@ DEFINES += CG3_DCEL_DEFINED
 MODULES += CG3_MESHES
 
 HEADERS += \
+    $$PWD/meshes/compact_trimesh/compact_trimesh.h \
     $$PWD/meshes/dcel/dcel.h \
     $$PWD/meshes/dcel/dcel_face.h \
     $$PWD/meshes/dcel/dcel_face_iterators.h \
     $$PWD/meshes/dcel/dcel_half_edge.h \
     $$PWD/meshes/dcel/dcel_iterators.h \
+    $$PWD/meshes/dcel/dcel_properties.h \
+    $$PWD/meshes/dcel/dcel_selection.h \
     $$PWD/meshes/dcel/dcel_struct.h \
     $$PWD/meshes/dcel/dcel_vertex.h \
     $$PWD/meshes/dcel/dcel_vertex_iterators.h \
-    $$PWD/meshes/dcel/algorithms/dcel_algorithms.h
+    $$PWD/meshes/dcel/algorithms/dcel_algorithms.h \
+    $$PWD/meshes/point_cloud/point_cloud.h \
+    $$PWD/meshes/mesh_traits.h
 
 SOURCES += \
+    $$PWD/meshes/compact_trimesh/compact_trimesh.cpp \
+    $$PWD/meshes/dcel/dcel_euler_operators.cpp \
     $$PWD/meshes/dcel/dcel_face.cpp \
     $$PWD/meshes/dcel/dcel_half_edge.cpp \
     $$PWD/meshes/dcel/dcel_vertex.cpp \
@@ -34,9 +41,15 @@ SOURCES += \
     $$PWD/meshes/dcel/dcel_half_edge_inline.tpp \
     $$PWD/meshes/dcel/dcel_face_iterators_inline.tpp \
     $$PWD/meshes/dcel/dcel_iterators_inline.tpp \
+    $$PWD/meshes/dcel/dcel_properties_inline.tpp \
+    $$PWD/meshes/dcel/dcel_selection_inline.tpp \
     $$PWD/meshes/dcel/dcel_vertex_inline.tpp \
     $$PWD/meshes/dcel/dcel_vertex_iterators_inline.tpp \
-    $$PWD/meshes/dcel/dcel_face_inline.tpp
+    $$PWD/meshes/dcel/dcel_face_inline.tpp \
+    $$PWD/meshes/compact_trimesh/compact_trimesh_inline.tpp \
+    $$PWD/meshes/point_cloud/point_cloud.cpp \
+    $$PWD/meshes/point_cloud/point_cloud_inline.tpp \
+    $$PWD/meshes/mesh_traits_inline.tpp
 
 contains(DEFINES, CG3_WITH_EIGEN) {
 
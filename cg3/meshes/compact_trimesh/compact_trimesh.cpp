@@ -0,0 +1,303 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "compact_trimesh.h"
+
+#include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/dcel/algorithms/dcel_algorithms.h>
+#include <cg3/utilities/parallel.h>
+#include <cg3/utilities/profiler.h>
+
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/eigenmesh.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+
+namespace cg3 {
+
+const unsigned int CompactTriMesh::NULL_ID;
+
+CompactTriMesh::CompactTriMesh()
+{
+}
+
+/**
+ * @brief CompactTriMesh::CompactTriMesh
+ * @param coordinates: coordinates of the vertices, three for every vertex
+ * @param triangles: vertices of the faces, three for every face
+ */
+CompactTriMesh::CompactTriMesh(
+        const std::vector<double>& coordinates,
+        const std::vector<unsigned int>& triangles)
+{
+    build(coordinates, triangles);
+}
+
+/**
+ * @brief CompactTriMesh::CompactTriMesh
+ * Builds a CompactTriMesh from a Dcel, keeping normals and colors. Vertices and
+ * faces are numbered following the order of their ids (see
+ * dcelAlgorithms::DenseIndex); faces that are not triangles are triangulated
+ * with a fan, and the triangles take normal and color of their face.
+ * @param dcel
+ */
+CompactTriMesh::CompactTriMesh(const Dcel& dcel)
+{
+    CG3_PROFILE_SCOPE("CompactTriMesh::CompactTriMesh(const Dcel&)");
+    dcelAlgorithms::DenseIndex index(dcel);
+    std::vector<unsigned int> offsets, faceVertices;
+    index.getFacesCSR(offsets, faceVertices);
+
+    //fan triangulation: a face with n vertices becomes n-2 triangles
+    std::vector<unsigned int> nTriangles(index.getNumberFaces());
+    parallelFor(0u, index.getNumberFaces(), [&](unsigned int i) {
+        unsigned int n = offsets[i+1] - offsets[i];
+        nTriangles[i] = n >= 3 ? n - 2 : 0;
+    });
+    std::vector<unsigned int> triangleOffsets(index.getNumberFaces() + 1);
+    unsigned int nt = parallelExclusiveScan(nTriangles.begin(), nTriangles.end(), triangleOffsets.begin(), 0u);
+    triangleOffsets[index.getNumberFaces()] = nt;
+
+    std::vector<double> coords(3 * index.getNumberVertices());
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        Pointd p = index.vertex(i)->getCoordinate();
+        coords[3*i] = p.x(); coords[3*i+1] = p.y(); coords[3*i+2] = p.z();
+    });
+    std::vector<unsigned int> tris(3 * nt);
+    parallelFor(0u, index.getNumberFaces(), [&](unsigned int i) {
+        unsigned int t = triangleOffsets[i];
+        for (unsigned int j = offsets[i] + 1; j + 1 < offsets[i+1]; j++, t++) {
+            tris[3*t] = faceVertices[offsets[i]];
+            tris[3*t+1] = faceVertices[j];
+            tris[3*t+2] = faceVertices[j+1];
+        }
+    });
+    build(coords, tris);
+
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        setVertexNormal(i, index.vertex(i)->getNormal());
+        setVertexColor(i, index.vertex(i)->getColor());
+    });
+    parallelFor(0u, index.getNumberFaces(), [&](unsigned int i) {
+        for (unsigned int t = triangleOffsets[i]; t < triangleOffsets[i+1]; t++) {
+            setFaceNormal(t, index.face(i)->getNormal());
+            setFaceColor(t, index.face(i)->getColor());
+        }
+    });
+}
+
+#ifdef CG3_EIGENMESH_DEFINED
+CompactTriMesh::CompactTriMesh(const SimpleEigenMesh& mesh)
+{
+    std::vector<double> coords(3 * mesh.getNumberVertices());
+    std::vector<unsigned int> tris(3 * mesh.getNumberFaces());
+    parallelFor(0u, mesh.getNumberVertices(), [&](unsigned int i) {
+        Pointd p = mesh.getVertex(i);
+        coords[3*i] = p.x(); coords[3*i+1] = p.y(); coords[3*i+2] = p.z();
+    });
+    parallelFor(0u, mesh.getNumberFaces(), [&](unsigned int i) {
+        Pointi f = mesh.getFace(i);
+        tris[3*i] = f.x(); tris[3*i+1] = f.y(); tris[3*i+2] = f.z();
+    });
+    build(coords, tris);
+}
+
+/**
+ * @brief CompactTriMesh::CompactTriMesh
+ * Builds a CompactTriMesh from an EigenMesh, keeping normals and colors.
+ * @param mesh
+ */
+CompactTriMesh::CompactTriMesh(const EigenMesh& mesh) :
+    CompactTriMesh((const SimpleEigenMesh&)mesh)
+{
+    parallelFor(0u, mesh.getNumberVertices(), [&](unsigned int i) {
+        setVertexNormal(i, mesh.getVertexNormal(i));
+        setVertexColor(i, mesh.getVertexColor(i));
+    });
+    parallelFor(0u, mesh.getNumberFaces(), [&](unsigned int i) {
+        setFaceNormal(i, mesh.getFaceNormal(i));
+        setFaceColor(i, mesh.getFaceColor(i));
+    });
+}
+#endif // CG3_EIGENMESH_DEFINED
+
+/**
+ * @brief CompactTriMesh::build
+ * Builds the mesh from the coordinates of the vertices and the vertices of the
+ * faces. Twins and incident half edges are computed, normals are computed and
+ * colors are set to grey.
+ * @param coordinates: coordinates of the vertices, three for every vertex
+ * @param triangles: vertices of the faces, three for every face
+ */
+void CompactTriMesh::build(
+        const std::vector<double>& coordinates,
+        const std::vector<unsigned int>& triangles)
+{
+    CG3_PROFILE_SCOPE("CompactTriMesh::build");
+    assert(coordinates.size() % 3 == 0);
+    assert(triangles.size() % 3 == 0);
+    this->coordinates = coordinates;
+    this->triangles = triangles;
+    unsigned int nv = (unsigned int)coordinates.size() / 3;
+    unsigned int nf = (unsigned int)triangles.size() / 3;
+    vertexNormals.assign(3 * nv, 0.0f);
+    vertexColors.assign(4 * nv, 128);
+    faceNormals.assign(3 * nf, 0.0f);
+    faceColors.assign(4 * nf, 128);
+    parallelFor(0u, nv, [&](unsigned int v) { vertexColors[4*v+3] = 255; });
+    parallelFor(0u, nf, [&](unsigned int f) { faceColors[4*f+3] = 255; });
+    vertexHalfEdges.assign(nv, NULL_ID);
+
+    buildTwins();
+    buildIncidentHalfEdges();
+    updateFaceNormals();
+    updateVertexNormals();
+    updateBoundingBox();
+}
+
+void CompactTriMesh::clear()
+{
+    triangles.clear();
+    twins.clear();
+    vertexHalfEdges.clear();
+    coordinates.clear();
+    vertexNormals.clear();
+    vertexColors.clear();
+    faceNormals.clear();
+    faceColors.clear();
+    boundingBox = BoundingBox();
+}
+
+/**
+ * @brief CompactTriMesh::getCardinality
+ * @return the number of faces incident to v
+ */
+unsigned int CompactTriMesh::getCardinality(unsigned int v) const
+{
+    unsigned int n = 0;
+    for (unsigned int f : incidentFaceIterator(v)) {
+        (void)f;
+        n++;
+    }
+    return n;
+}
+
+double CompactTriMesh::getFaceArea(unsigned int f) const
+{
+    Pointd v1 = getVertex(getFaceVertex(f, 0));
+    Pointd v2 = getVertex(getFaceVertex(f, 1));
+    Pointd v3 = getVertex(getFaceVertex(f, 2));
+    return (v2 - v1).cross(v3 - v1).getLength() / 2;
+}
+
+void CompactTriMesh::setVertexColors(const Color& c)
+{
+    parallelFor(0u, getNumberVertices(), [&](unsigned int v) {
+        setVertexColor(v, c);
+    });
+}
+
+void CompactTriMesh::setFaceColors(const Color& c)
+{
+    parallelFor(0u, getNumberFaces(), [&](unsigned int f) {
+        setFaceColor(f, c);
+    });
+}
+
+void CompactTriMesh::updateFaceNormals()
+{
+    parallelFor(0u, getNumberFaces(), [&](unsigned int f) {
+        Pointd v1 = getVertex(getFaceVertex(f, 0));
+        Pointd v2 = getVertex(getFaceVertex(f, 1));
+        Pointd v3 = getVertex(getFaceVertex(f, 2));
+        Vec3 n = (v2 - v1).cross(v3 - v1);
+        n.normalize();
+        setFaceNormal(f, n);
+    });
+}
+
+/**
+ * @brief CompactTriMesh::updateVertexNormals
+ * The normal of a vertex is the normalized sum of the normals of its incident
+ * faces, like Dcel::Vertex::updateNormal().
+ */
+void CompactTriMesh::updateVertexNormals()
+{
+    parallelFor(0u, getNumberVertices(), [&](unsigned int v) {
+        Vec3 n;
+        for (unsigned int f : incidentFaceIterator(v))
+            n += getFaceNormal(f);
+        n.normalize();
+        setVertexNormal(v, n);
+    });
+}
+
+void CompactTriMesh::updateBoundingBox()
+{
+    if (getNumberVertices() == 0) {
+        boundingBox = BoundingBox();
+        return;
+    }
+    Pointd min = getVertex(0), max = getVertex(0);
+    for (unsigned int i = 3; i < coordinates.size(); i += 3) {
+        for (unsigned int j = 0; j < 3; j++) {
+            min[j] = std::min(min[j], coordinates[i+j]);
+            max[j] = std::max(max[j], coordinates[i+j]);
+        }
+    }
+    boundingBox.setMin(min);
+    boundingBox.setMax(max);
+}
+
+/**
+ * @brief CompactTriMesh::buildTwins
+ * Sorts the half edges by their undirected edge, and makes twins the pairs of
+ * half edges with opposite directions that are the only two half edges of
+ * their edge.
+ */
+void CompactTriMesh::buildTwins()
+{
+    unsigned int nhe = getNumberHalfEdges();
+    twins.assign(nhe, NULL_ID);
+    std::vector<std::pair<uint64_t, unsigned int>> edges(nhe);
+    parallelFor(0u, nhe, [&](unsigned int he) {
+        uint64_t a = getFromVertex(he), b = getToVertex(he);
+        if (a > b)
+            std::swap(a, b);
+        edges[he] = std::make_pair((a << 32) | b, he);
+    });
+    parallelSort(edges.begin(), edges.end());
+    parallelFor(0u, nhe, [&](unsigned int i) {
+        if (i > 0 && edges[i-1].first == edges[i].first)
+            return;
+        if (i + 1 < nhe && edges[i+1].first == edges[i].first &&
+                (i + 2 == nhe || edges[i+2].first != edges[i].first)) {
+            unsigned int h1 = edges[i].second, h2 = edges[i+1].second;
+            if (getFromVertex(h1) == getToVertex(h2)) {
+                twins[h1] = h2;
+                twins[h2] = h1;
+            }
+        }
+    });
+}
+
+/**
+ * @brief CompactTriMesh::buildIncidentHalfEdges
+ * Sets an outgoing half edge for every vertex, preferring boundary half edges.
+ */
+void CompactTriMesh::buildIncidentHalfEdges()
+{
+    for (unsigned int he = 0; he < getNumberHalfEdges(); he++) {
+        unsigned int& vhe = vertexHalfEdges[getFromVertex(he)];
+        if (vhe == NULL_ID || isBoundaryHalfEdge(he))
+            vhe = he;
+    }
+}
+
+} //namespace cg3
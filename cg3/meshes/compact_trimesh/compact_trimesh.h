@@ -0,0 +1,230 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_COMPACT_TRIMESH_H
+#define CG3_COMPACT_TRIMESH_H
+
+#include <vector>
+
+#include <cg3/geometry/bounding_box.h>
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+class Dcel;
+#ifdef CG3_EIGENMESH_DEFINED
+class SimpleEigenMesh;
+class EigenMesh;
+#endif
+
+/**
+ * @ingroup cg3meshes
+ * @brief The CompactTriMesh class is a memory compact half edge data
+ * structure for triangle meshes.
+ *
+ * Half edges are implicit: the half edges of the face f are 3f, 3f+1 and 3f+2,
+ * and the half edge 3f+i goes from the i-th to the (i+1)-th vertex of f. Next,
+ * prev and face of an half edge are therefore computed with arithmetic, and
+ * the only stored topological relations are:
+ * - the from vertex of every half edge (that is, the vertices of the faces);
+ * - the twin of every half edge, NULL_ID on the boundary;
+ * - an outgoing half edge for every vertex; on boundary vertices, it is the
+ *   boundary outgoing half edge, so the circulators visit the whole fan.
+ *
+ * Attributes are stored in a separate array each (coordinates in double,
+ * normals in float, colors in RGBA bytes). A CompactTriMesh takes about 40
+ * bytes per face plus 44 bytes per vertex, against several hundreds bytes per
+ * face of a Dcel.
+ *
+ * Elements are identified by contiguous indices: vertices are numbered from
+ * 0 to getNumberVertices()-1 and faces from 0 to getNumberFaces()-1. The
+ * circulators of vertices and faces correspond to the iterators of
+ * Dcel::Vertex and Dcel::Face, and visit the elements in counterclockwise
+ * order:
+ *
+ * \code{.cpp}
+ * for (unsigned int f : mesh.incidentFaceIterator(v))
+ *     area += mesh.getFaceArea(f);
+ * \endcode
+ *
+ * Edges shared by more than two faces or by two faces with incoherent
+ * orientation are treated as boundary edges; around non manifold vertices
+ * the circulators visit only the fan of the outgoing half edge of the vertex.
+ */
+class CompactTriMesh
+{
+public:
+    static const unsigned int NULL_ID = (unsigned int)-1;
+
+    class VertexCirculator;
+    class FaceCirculator;
+    template <typename Circulator>
+    class CirculatorRange;
+
+    CompactTriMesh();
+    CompactTriMesh(
+            const std::vector<double>& coordinates,
+            const std::vector<unsigned int>& triangles);
+    CompactTriMesh(const Dcel& dcel);
+    #ifdef CG3_EIGENMESH_DEFINED
+    CompactTriMesh(const SimpleEigenMesh& mesh);
+    CompactTriMesh(const EigenMesh& mesh);
+    #endif
+
+    void build(
+            const std::vector<double>& coordinates,
+            const std::vector<unsigned int>& triangles);
+    void clear();
+
+    unsigned int getNumberVertices() const;
+    unsigned int getNumberFaces() const;
+    unsigned int getNumberHalfEdges() const;
+
+    //topology
+    static unsigned int getFace(unsigned int he);
+    static unsigned int getNext(unsigned int he);
+    static unsigned int getPrev(unsigned int he);
+    static unsigned int getHalfEdge(unsigned int f, unsigned int i);
+    unsigned int getTwin(unsigned int he) const;
+    unsigned int getFromVertex(unsigned int he) const;
+    unsigned int getToVertex(unsigned int he) const;
+    unsigned int getFaceVertex(unsigned int f, unsigned int i) const;
+    unsigned int getIncidentHalfEdge(unsigned int v) const;
+    bool isBoundaryHalfEdge(unsigned int he) const;
+    bool isBoundaryVertex(unsigned int v) const;
+    unsigned int getCardinality(unsigned int v) const;
+
+    //attributes
+    Pointd getVertex(unsigned int v) const;
+    Vec3 getVertexNormal(unsigned int v) const;
+    Color getVertexColor(unsigned int v) const;
+    Vec3 getFaceNormal(unsigned int f) const;
+    Color getFaceColor(unsigned int f) const;
+    double getFaceArea(unsigned int f) const;
+    const BoundingBox& getBoundingBox() const;
+    const std::vector<double>& getCoordinates() const;
+    const std::vector<unsigned int>& getTriangles() const;
+
+    void setVertex(unsigned int v, const Pointd& p);
+    void setVertexNormal(unsigned int v, const Vec3& n);
+    void setVertexColor(unsigned int v, const Color& c);
+    void setFaceNormal(unsigned int f, const Vec3& n);
+    void setFaceColor(unsigned int f, const Color& c);
+    void setVertexColors(const Color& c);
+    void setFaceColors(const Color& c);
+
+    void updateFaceNormals();
+    void updateVertexNormals();
+    void updateBoundingBox();
+
+    //circulators
+    CirculatorRange<VertexCirculator> outgoingHalfEdgeIterator(unsigned int v) const;
+    CirculatorRange<VertexCirculator> incomingHalfEdgeIterator(unsigned int v) const;
+    CirculatorRange<VertexCirculator> adjacentVertexIterator(unsigned int v) const;
+    CirculatorRange<VertexCirculator> incidentFaceIterator(unsigned int v) const;
+    CirculatorRange<FaceCirculator> incidentHalfEdgeIterator(unsigned int f) const;
+    CirculatorRange<FaceCirculator> incidentVertexIterator(unsigned int f) const;
+    CirculatorRange<FaceCirculator> adjacentFaceIterator(unsigned int f) const;
+
+protected:
+    void buildTwins();
+    void buildIncidentHalfEdges();
+
+    //topology
+    std::vector<unsigned int> triangles;     //from vertex of every half edge
+    std::vector<unsigned int> twins;         //twin of every half edge
+    std::vector<unsigned int> vertexHalfEdges; //outgoing half edge of every vertex
+
+    //attributes
+    std::vector<double> coordinates;         //3 per vertex
+    std::vector<float> vertexNormals;        //3 per vertex
+    std::vector<unsigned char> vertexColors; //4 per vertex
+    std::vector<float> faceNormals;          //3 per face
+    std::vector<unsigned char> faceColors;   //4 per face
+    BoundingBox boundingBox;
+};
+
+/**
+ * @brief Circulator on the one-ring of a vertex of a CompactTriMesh.
+ *
+ * Visits the outgoing half edges of the vertex in counterclockwise order, and
+ * returns, depending on its type, the outgoing or incoming half edges, the
+ * adjacent vertices or the incident faces.
+ */
+class CompactTriMesh::VertexCirculator
+{
+public:
+    enum Type {OUTGOING_HALF_EDGE, INCOMING_HALF_EDGE, ADJACENT_VERTEX, INCIDENT_FACE};
+
+    VertexCirculator();
+    VertexCirculator(const CompactTriMesh* mesh, unsigned int start, Type type);
+
+    unsigned int operator * () const;
+    VertexCirculator& operator ++ ();
+    VertexCirculator operator ++ (int);
+    bool operator == (const VertexCirculator& right) const;
+    bool operator != (const VertexCirculator& right) const;
+
+private:
+    const CompactTriMesh* mesh;
+    unsigned int start;
+    unsigned int pos;
+    Type type;
+    bool last; //the last adjacent vertex of a boundary vertex
+};
+
+/**
+ * @brief Circulator on the three half edges of a face of a CompactTriMesh.
+ *
+ * Returns, depending on its type, the half edges, the vertices or the adjacent
+ * faces of the face. Adjacent faces are not visited on boundary half edges.
+ */
+class CompactTriMesh::FaceCirculator
+{
+public:
+    enum Type {INCIDENT_HALF_EDGE, INCIDENT_VERTEX, ADJACENT_FACE};
+
+    FaceCirculator();
+    FaceCirculator(const CompactTriMesh* mesh, unsigned int he, Type type);
+
+    unsigned int operator * () const;
+    FaceCirculator& operator ++ ();
+    FaceCirculator operator ++ (int);
+    bool operator == (const FaceCirculator& right) const;
+    bool operator != (const FaceCirculator& right) const;
+
+private:
+    void skipBoundary();
+
+    const CompactTriMesh* mesh;
+    unsigned int he;
+    unsigned int end;
+    Type type;
+};
+
+/**
+ * @brief Range of a circulator, usable in range based for loops.
+ */
+template <typename Circulator>
+class CompactTriMesh::CirculatorRange
+{
+public:
+    CirculatorRange(const Circulator& b);
+
+    Circulator begin() const;
+    Circulator end() const;
+
+private:
+    Circulator b;
+};
+
+} //namespace cg3
+
+#include "compact_trimesh_inline.tpp"
+
+#endif // CG3_COMPACT_TRIMESH_H
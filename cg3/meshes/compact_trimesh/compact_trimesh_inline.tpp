@@ -0,0 +1,416 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "compact_trimesh.h"
+
+#include <cassert>
+
+namespace cg3 {
+
+inline unsigned int CompactTriMesh::getNumberVertices() const
+{
+    return (unsigned int)vertexHalfEdges.size();
+}
+
+inline unsigned int CompactTriMesh::getNumberFaces() const
+{
+    return (unsigned int)(triangles.size() / 3);
+}
+
+inline unsigned int CompactTriMesh::getNumberHalfEdges() const
+{
+    return (unsigned int)triangles.size();
+}
+
+/**
+ * @brief CompactTriMesh::getFace
+ * @return the face of the half edge he
+ */
+inline unsigned int CompactTriMesh::getFace(unsigned int he)
+{
+    return he / 3;
+}
+
+inline unsigned int CompactTriMesh::getNext(unsigned int he)
+{
+    return he % 3 == 2 ? he - 2 : he + 1;
+}
+
+inline unsigned int CompactTriMesh::getPrev(unsigned int he)
+{
+    return he % 3 == 0 ? he + 2 : he - 1;
+}
+
+/**
+ * @brief CompactTriMesh::getHalfEdge
+ * @return the half edge of f that goes from its i-th to its (i+1)-th vertex
+ */
+inline unsigned int CompactTriMesh::getHalfEdge(unsigned int f, unsigned int i)
+{
+    assert(i < 3);
+    return 3 * f + i;
+}
+
+/**
+ * @brief CompactTriMesh::getTwin
+ * @return the twin of he, NULL_ID if he is a boundary half edge
+ */
+inline unsigned int CompactTriMesh::getTwin(unsigned int he) const
+{
+    assert(he < twins.size());
+    return twins[he];
+}
+
+inline unsigned int CompactTriMesh::getFromVertex(unsigned int he) const
+{
+    assert(he < triangles.size());
+    return triangles[he];
+}
+
+inline unsigned int CompactTriMesh::getToVertex(unsigned int he) const
+{
+    return getFromVertex(getNext(he));
+}
+
+inline unsigned int CompactTriMesh::getFaceVertex(unsigned int f, unsigned int i) const
+{
+    return getFromVertex(getHalfEdge(f, i));
+}
+
+/**
+ * @brief CompactTriMesh::getIncidentHalfEdge
+ * @return an outgoing half edge of v (the boundary one if v is a boundary
+ * vertex), NULL_ID if v is isolated
+ */
+inline unsigned int CompactTriMesh::getIncidentHalfEdge(unsigned int v) const
+{
+    assert(v < vertexHalfEdges.size());
+    return vertexHalfEdges[v];
+}
+
+inline bool CompactTriMesh::isBoundaryHalfEdge(unsigned int he) const
+{
+    return getTwin(he) == NULL_ID;
+}
+
+inline bool CompactTriMesh::isBoundaryVertex(unsigned int v) const
+{
+    unsigned int he = getIncidentHalfEdge(v);
+    return he != NULL_ID && isBoundaryHalfEdge(he);
+}
+
+inline Pointd CompactTriMesh::getVertex(unsigned int v) const
+{
+    assert(v < getNumberVertices());
+    return Pointd(coordinates[3*v], coordinates[3*v+1], coordinates[3*v+2]);
+}
+
+inline Vec3 CompactTriMesh::getVertexNormal(unsigned int v) const
+{
+    assert(v < getNumberVertices());
+    return Vec3(vertexNormals[3*v], vertexNormals[3*v+1], vertexNormals[3*v+2]);
+}
+
+inline Color CompactTriMesh::getVertexColor(unsigned int v) const
+{
+    assert(v < getNumberVertices());
+    return Color(vertexColors[4*v], vertexColors[4*v+1], vertexColors[4*v+2], vertexColors[4*v+3]);
+}
+
+inline Vec3 CompactTriMesh::getFaceNormal(unsigned int f) const
+{
+    assert(f < getNumberFaces());
+    return Vec3(faceNormals[3*f], faceNormals[3*f+1], faceNormals[3*f+2]);
+}
+
+inline Color CompactTriMesh::getFaceColor(unsigned int f) const
+{
+    assert(f < getNumberFaces());
+    return Color(faceColors[4*f], faceColors[4*f+1], faceColors[4*f+2], faceColors[4*f+3]);
+}
+
+inline const BoundingBox& CompactTriMesh::getBoundingBox() const
+{
+    return boundingBox;
+}
+
+/**
+ * @brief CompactTriMesh::getCoordinates
+ * @return the coordinates of the vertices, three for every vertex
+ */
+inline const std::vector<double>& CompactTriMesh::getCoordinates() const
+{
+    return coordinates;
+}
+
+/**
+ * @brief CompactTriMesh::getTriangles
+ * @return the vertices of the faces, three for every face
+ */
+inline const std::vector<unsigned int>& CompactTriMesh::getTriangles() const
+{
+    return triangles;
+}
+
+inline void CompactTriMesh::setVertex(unsigned int v, const Pointd& p)
+{
+    assert(v < getNumberVertices());
+    coordinates[3*v] = p.x();
+    coordinates[3*v+1] = p.y();
+    coordinates[3*v+2] = p.z();
+}
+
+inline void CompactTriMesh::setVertexNormal(unsigned int v, const Vec3& n)
+{
+    assert(v < getNumberVertices());
+    vertexNormals[3*v] = (float)n.x();
+    vertexNormals[3*v+1] = (float)n.y();
+    vertexNormals[3*v+2] = (float)n.z();
+}
+
+inline void CompactTriMesh::setVertexColor(unsigned int v, const Color& c)
+{
+    assert(v < getNumberVertices());
+    vertexColors[4*v] = (unsigned char)c.red();
+    vertexColors[4*v+1] = (unsigned char)c.green();
+    vertexColors[4*v+2] = (unsigned char)c.blue();
+    vertexColors[4*v+3] = (unsigned char)c.alpha();
+}
+
+inline void CompactTriMesh::setFaceNormal(unsigned int f, const Vec3& n)
+{
+    assert(f < getNumberFaces());
+    faceNormals[3*f] = (float)n.x();
+    faceNormals[3*f+1] = (float)n.y();
+    faceNormals[3*f+2] = (float)n.z();
+}
+
+inline void CompactTriMesh::setFaceColor(unsigned int f, const Color& c)
+{
+    assert(f < getNumberFaces());
+    faceColors[4*f] = (unsigned char)c.red();
+    faceColors[4*f+1] = (unsigned char)c.green();
+    faceColors[4*f+2] = (unsigned char)c.blue();
+    faceColors[4*f+3] = (unsigned char)c.alpha();
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::VertexCirculator>
+CompactTriMesh::outgoingHalfEdgeIterator(unsigned int v) const
+{
+    return VertexCirculator(this, getIncidentHalfEdge(v), VertexCirculator::OUTGOING_HALF_EDGE);
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::VertexCirculator>
+CompactTriMesh::incomingHalfEdgeIterator(unsigned int v) const
+{
+    return VertexCirculator(this, getIncidentHalfEdge(v), VertexCirculator::INCOMING_HALF_EDGE);
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::VertexCirculator>
+CompactTriMesh::adjacentVertexIterator(unsigned int v) const
+{
+    return VertexCirculator(this, getIncidentHalfEdge(v), VertexCirculator::ADJACENT_VERTEX);
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::VertexCirculator>
+CompactTriMesh::incidentFaceIterator(unsigned int v) const
+{
+    return VertexCirculator(this, getIncidentHalfEdge(v), VertexCirculator::INCIDENT_FACE);
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::FaceCirculator>
+CompactTriMesh::incidentHalfEdgeIterator(unsigned int f) const
+{
+    return FaceCirculator(this, getHalfEdge(f, 0), FaceCirculator::INCIDENT_HALF_EDGE);
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::FaceCirculator>
+CompactTriMesh::incidentVertexIterator(unsigned int f) const
+{
+    return FaceCirculator(this, getHalfEdge(f, 0), FaceCirculator::INCIDENT_VERTEX);
+}
+
+inline CompactTriMesh::CirculatorRange<CompactTriMesh::FaceCirculator>
+CompactTriMesh::adjacentFaceIterator(unsigned int f) const
+{
+    return FaceCirculator(this, getHalfEdge(f, 0), FaceCirculator::ADJACENT_FACE);
+}
+
+/**
+ * VertexCirculator
+ */
+
+inline CompactTriMesh::VertexCirculator::VertexCirculator() :
+    mesh(nullptr),
+    start(NULL_ID),
+    pos(NULL_ID),
+    type(OUTGOING_HALF_EDGE),
+    last(false)
+{
+}
+
+inline CompactTriMesh::VertexCirculator::VertexCirculator(
+        const CompactTriMesh* mesh,
+        unsigned int start,
+        Type type) :
+    mesh(mesh),
+    start(start),
+    pos(start),
+    type(type),
+    last(false)
+{
+}
+
+inline unsigned int CompactTriMesh::VertexCirculator::operator *() const
+{
+    switch (type) {
+    case OUTGOING_HALF_EDGE:
+        return pos;
+    case INCOMING_HALF_EDGE:
+        return getPrev(pos);
+    case ADJACENT_VERTEX:
+        return last ? mesh->getFromVertex(getPrev(pos)) : mesh->getToVertex(pos);
+    default:
+        return getFace(pos);
+    }
+}
+
+/**
+ * @brief Moves the circulator to the next outgoing half edge in
+ * counterclockwise order.
+ */
+inline CompactTriMesh::VertexCirculator& CompactTriMesh::VertexCirculator::operator ++()
+{
+    unsigned int next = mesh->getTwin(getPrev(pos));
+    if (next == NULL_ID) {
+        //boundary: the last adjacent vertex is the from vertex of the incoming half edge
+        if (type == ADJACENT_VERTEX && !last) {
+            last = true;
+        }
+        else {
+            pos = NULL_ID;
+            last = false;
+        }
+    }
+    else if (next == start) {
+        pos = NULL_ID;
+    }
+    else {
+        pos = next;
+    }
+    return *this;
+}
+
+inline CompactTriMesh::VertexCirculator CompactTriMesh::VertexCirculator::operator ++(int)
+{
+    VertexCirculator old = *this;
+    ++(*this);
+    return old;
+}
+
+inline bool CompactTriMesh::VertexCirculator::operator ==(const VertexCirculator& right) const
+{
+    return pos == right.pos && last == right.last;
+}
+
+inline bool CompactTriMesh::VertexCirculator::operator !=(const VertexCirculator& right) const
+{
+    return !(*this == right);
+}
+
+/**
+ * FaceCirculator
+ */
+
+inline CompactTriMesh::FaceCirculator::FaceCirculator() :
+    mesh(nullptr),
+    he(NULL_ID),
+    end(NULL_ID),
+    type(INCIDENT_HALF_EDGE)
+{
+}
+
+inline CompactTriMesh::FaceCirculator::FaceCirculator(
+        const CompactTriMesh* mesh,
+        unsigned int he,
+        Type type) :
+    mesh(mesh),
+    he(he),
+    end(he + 3),
+    type(type)
+{
+    skipBoundary();
+}
+
+inline unsigned int CompactTriMesh::FaceCirculator::operator *() const
+{
+    switch (type) {
+    case INCIDENT_HALF_EDGE:
+        return he;
+    case INCIDENT_VERTEX:
+        return mesh->getFromVertex(he);
+    default:
+        return getFace(mesh->getTwin(he));
+    }
+}
+
+inline CompactTriMesh::FaceCirculator& CompactTriMesh::FaceCirculator::operator ++()
+{
+    ++he;
+    skipBoundary();
+    return *this;
+}
+
+inline CompactTriMesh::FaceCirculator CompactTriMesh::FaceCirculator::operator ++(int)
+{
+    FaceCirculator old = *this;
+    ++(*this);
+    return old;
+}
+
+inline bool CompactTriMesh::FaceCirculator::operator ==(const FaceCirculator& right) const
+{
+    return he == right.he;
+}
+
+inline bool CompactTriMesh::FaceCirculator::operator !=(const FaceCirculator& right) const
+{
+    return he != right.he;
+}
+
+inline void CompactTriMesh::FaceCirculator::skipBoundary()
+{
+    if (type == ADJACENT_FACE)
+        while (he != end && mesh->isBoundaryHalfEdge(he))
+            ++he;
+    if (he == end)
+        he = NULL_ID;
+}
+
+/**
+ * CirculatorRange
+ */
+
+template <typename Circulator>
+inline CompactTriMesh::CirculatorRange<Circulator>::CirculatorRange(const Circulator& b) :
+    b(b)
+{
+}
+
+template <typename Circulator>
+inline Circulator CompactTriMesh::CirculatorRange<Circulator>::begin() const
+{
+    return b;
+}
+
+template <typename Circulator>
+inline Circulator CompactTriMesh::CirculatorRange<Circulator>::end() const
+{
+    return Circulator();
+}
+
+} //namespace cg3
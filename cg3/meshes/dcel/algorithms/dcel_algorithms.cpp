@@ -7,6 +7,10 @@
 
 #include "dcel_algorithms.h"
 #include <cg3/utilities//utils.h>
+#include <cg3/utilities/parallel.h>
+#include <cg3/utilities/profiler.h>
+
+#include <cstdint>
 
 namespace cg3 {
 
@@ -33,6 +37,230 @@ void dcelAlgorithms::getVectorFaces(std::vector<Dcel::Face*>& vector, Dcel& d)
     }
 }
 
+dcelAlgorithms::DenseIndex::DenseIndex()
+{
+}
+
+dcelAlgorithms::DenseIndex::DenseIndex(const Dcel& d)
+{
+    build(d);
+}
+
+/**
+ * @brief DenseIndex::build
+ * Numbers the vertices and the faces of d. The index must be built again
+ * after any insertion or deletion of elements of d.
+ * @param d
+ */
+void dcelAlgorithms::DenseIndex::build(const Dcel& d)
+{
+    vertexPointers.clear();
+    facePointers.clear();
+    vertexIds.clear();
+    vertexPointers.reserve(d.getNumberVertices());
+    facePointers.reserve(d.getNumberFaces());
+
+    bool compact = true;
+    for (const Dcel::Vertex* v : d.vertexIterator()) {
+        compact = compact && v->getId() == vertexPointers.size();
+        vertexPointers.push_back(v);
+    }
+    for (const Dcel::Face* f : d.faceIterator())
+        facePointers.push_back(f);
+
+    if (!compact) {
+        vertexIds.resize(vertexPointers.back()->getId() + 1, (unsigned int)-1);
+        parallelFor((size_t)0, vertexPointers.size(), [&](size_t i) {
+            vertexIds[vertexPointers[i]->getId()] = (unsigned int)i;
+        });
+    }
+}
+
+/**
+ * @brief DenseIndex::getFacesCSR
+ * Computes the faces of the indexed Dcel in compressed sparse row format: the
+ * dense indices of the vertices of the i-th face (outer border only) are
+ * faceVertices[faceOffsets[i]], ..., faceVertices[faceOffsets[i+1]-1].
+ * @param[out] faceOffsets: getNumberFaces()+1 offsets
+ * @param[out] faceVertices
+ */
+void dcelAlgorithms::DenseIndex::getFacesCSR(
+        std::vector<unsigned int>& faceOffsets,
+        std::vector<unsigned int>& faceVertices) const
+{
+    size_t nf = facePointers.size();
+    std::vector<unsigned int> sizes(nf);
+    parallelFor((size_t)0, nf, [&](size_t i) {
+        unsigned int n = 0;
+        for (Dcel::Face::ConstIncidentHalfEdgeIterator it = facePointers[i]->incidentHalfEdgeBegin(), end = facePointers[i]->incidentHalfEdgeEnd(); it != end; ++it)
+            n++;
+        sizes[i] = n;
+    });
+
+    faceOffsets.resize(nf + 1);
+    faceOffsets[nf] = parallelExclusiveScan(sizes.begin(), sizes.end(), faceOffsets.begin(), 0u);
+
+    faceVertices.resize(faceOffsets[nf]);
+    parallelFor((size_t)0, nf, [&](size_t i) {
+        unsigned int j = faceOffsets[i];
+        for (const Dcel::Vertex* v : facePointers[i]->incidentVertexIterator())
+            faceVertices[j++] = vertexIndex(v);
+    });
+}
+
+dcelAlgorithms::TopologyInfo::TopologyInfo() :
+    nEdges(0),
+    nComponents(0),
+    eulerCharacteristic(0)
+{
+}
+
+dcelAlgorithms::TopologyInfo::TopologyInfo(const Dcel& d)
+{
+    build(d);
+}
+
+/**
+ * @brief TopologyInfo::build
+ * Computes the analysis of d.
+ * @param d
+ */
+void dcelAlgorithms::TopologyInfo::build(const Dcel& d)
+{
+    CG3_PROFILE_SCOPE("dcelAlgorithms::TopologyInfo::build");
+    boundaryLoops.clear();
+    nonManifoldHalfEdges.clear();
+    nonManifoldVertices.clear();
+    unsigned int nhe = d.getNumberHalfEdgeIds();
+    unsigned int nv = d.getNumberVertexIds();
+
+    //half edges sorted by undirected edge: every group with the same key is
+    //an edge
+    const uint64_t NO_EDGE = (uint64_t)-1;
+    std::vector<std::pair<uint64_t, unsigned int>> edges(nhe);
+    std::unique_ptr<std::atomic<unsigned int>[]> outDegrees(new std::atomic<unsigned int>[nv]);
+    parallelFor(0u, nv, [&](unsigned int i) {
+        outDegrees[i].store(0, std::memory_order_relaxed);
+    });
+    parallelFor(0u, nhe, [&](unsigned int i) {
+        const Dcel::HalfEdge* he = d.getHalfEdge(i);
+        if (he == nullptr) {
+            edges[i] = std::make_pair(NO_EDGE, i);
+            return;
+        }
+        uint64_t a = he->getFromVertex()->getId(), b = he->getToVertex()->getId();
+        outDegrees[a].fetch_add(1, std::memory_order_relaxed);
+        if (a > b)
+            std::swap(a, b);
+        edges[i] = std::make_pair((a << 32) | b, i);
+    });
+    parallelSort(edges.begin(), edges.end());
+
+    std::vector<char> nonManifoldEdge(nhe, false);
+    nEdges = parallelReduce(0u, nhe, 0u, [&](unsigned int i) {
+        if (edges[i].first == NO_EDGE || (i > 0 && edges[i-1].first == edges[i].first))
+            return 0u;
+        unsigned int j = i + 1;
+        while (j < nhe && edges[j].first == edges[i].first)
+            j++;
+        const Dcel::HalfEdge* h1 = d.getHalfEdge(edges[i].second);
+        bool nonManifold = j - i > 2 ||
+                (j - i == 2 && h1->getFromVertex() == d.getHalfEdge(edges[i+1].second)->getFromVertex());
+        if (nonManifold)
+            for (unsigned int k = i; k < j; k++)
+                nonManifoldEdge[edges[k].second] = true;
+        return 1u;
+    }, std::plus<unsigned int>());
+
+    //next boundary half edge of every boundary half edge, found rotating
+    //around its to vertex
+    std::vector<const Dcel::HalfEdge*> nextBoundary(nhe, nullptr);
+    parallelFor(0u, nhe, [&](unsigned int i) {
+        const Dcel::HalfEdge* he = d.getHalfEdge(i);
+        if (he == nullptr || he->getTwin() != nullptr)
+            return;
+        unsigned int maxSteps = outDegrees[he->getToVertex()->getId()].load(std::memory_order_relaxed);
+        const Dcel::HalfEdge* h = he->getNext();
+        for (unsigned int k = 0; h != nullptr && h->getTwin() != nullptr && k < maxSteps; k++)
+            h = h->getTwin()->getNext();
+        if (h != nullptr && h->getTwin() == nullptr)
+            nextBoundary[i] = h;
+    });
+
+    //a vertex is manifold if the fan of its incident half edge contains all
+    //its outgoing half edges
+    std::vector<char> nonManifoldVertex(nv, false);
+    parallelFor(0u, nv, [&](unsigned int i) {
+        const Dcel::Vertex* v = d.getVertex(i);
+        if (v == nullptr)
+            return;
+        unsigned int degree = outDegrees[i].load(std::memory_order_relaxed);
+        const Dcel::HalfEdge* start = v->getIncidentHalfEdge();
+        if (degree == 0)
+            return;
+        if (start == nullptr || start->getFromVertex() != v) {
+            nonManifoldVertex[i] = true;
+            return;
+        }
+        unsigned int fan = 1;
+        bool boundary = false;
+        const Dcel::HalfEdge* h = start;
+        while (fan <= degree) {
+            if (h->getPrev() == nullptr || h->getPrev()->getTwin() == nullptr) {
+                boundary = true;
+                break;
+            }
+            h = h->getPrev()->getTwin();
+            if (h == start)
+                break;
+            fan++;
+        }
+        h = start;
+        while (boundary && h->getTwin() != nullptr && fan <= degree) {
+            h = h->getTwin()->getNext();
+            if (h == nullptr || h == start)
+                break;
+            fan++;
+        }
+        nonManifoldVertex[i] = fan != degree;
+    });
+
+    for (unsigned int i = 0; i < nhe; i++)
+        if (nonManifoldEdge[i])
+            nonManifoldHalfEdges.push_back(d.getHalfEdge(i));
+    for (unsigned int i = 0; i < nv; i++)
+        if (nonManifoldVertex[i])
+            nonManifoldVertices.push_back(d.getVertex(i));
+
+    //boundary loops: chains of next boundary half edges; open chains, left by
+    //an inconsistent Dcel, are visited from their first half edge
+    DynamicBitset visited(nhe);
+    std::vector<unsigned int> previous(nhe, (unsigned int)-1);
+    for (unsigned int i = 0; i < nhe; i++)
+        if (nextBoundary[i] != nullptr)
+            previous[nextBoundary[i]->getId()] = i;
+    for (unsigned int i = 0; i < nhe; i++) {
+        const Dcel::HalfEdge* he = d.getHalfEdge(i);
+        if (he == nullptr || he->getTwin() != nullptr || visited.test(i))
+            continue;
+        unsigned int first = i;
+        while (previous[first] != (unsigned int)-1 && previous[first] != i && !visited.test(previous[first]))
+            first = previous[first];
+        std::vector<const Dcel::HalfEdge*> loop;
+        for (const Dcel::HalfEdge* h = d.getHalfEdge(first); h != nullptr && !visited.testAndSet(h->getId()); h = nextBoundary[h->getId()])
+            loop.push_back(h);
+        boundaryLoops.push_back(loop);
+    }
+
+    //components: faces connected by edges, and isolated vertices
+    labelConnectedComponents(d, [](const Dcel::Face*) { return true; }, nComponents);
+    for (unsigned int i = 0; i < nv; i++)
+        if (d.getVertex(i) != nullptr && outDegrees[i].load(std::memory_order_relaxed) == 0)
+            nComponents++;
+
+    eulerCharacteristic = (int)d.getNumberVertices() - (int)nEdges + (int)d.getNumberFaces();
+}
+
 void dcelAlgorithms::getVectorMesh(
         std::vector<Pointd>& coords,
         std::vector<std::vector<int> >& faces,
@@ -40,48 +268,96 @@ void dcelAlgorithms::getVectorMesh(
         std::vector<const Dcel::Vertex*>& mappingVertices,
         std::vector<const Dcel::Face*>& mappingFaces)
 {
-    std::map<const Dcel::Vertex*, int> vertices;
-    int nv = 0, nf = 0;
-    coords.resize(d.getNumberVertices());
-    mappingVertices.resize(d.getNumberVertices());
-    faces.resize(d.getNumberFaces());
-    mappingFaces.resize(d.getNumberFaces());
+    DenseIndex index(d);
+    std::vector<unsigned int> faceOffsets, faceVertices;
+    index.getFacesCSR(faceOffsets, faceVertices);
 
-    for (const Dcel::Vertex* v : d.vertexIterator()) {
-        coords[nv] = v->getCoordinate();
-        mappingVertices[nv] = v;
-        vertices[v] = nv++;
-    }
+    coords.resize(index.getNumberVertices());
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        coords[i] = index.vertex(i)->getCoordinate();
+    });
 
-    for (const Dcel::Face* f : d.faceIterator()) {
-        std::vector<int> face;
-        for (const Dcel::Vertex* inc : f->incidentVertexIterator()){
-            face.push_back(vertices[inc]);
-        }
-        faces[nf] = face;
-        mappingFaces[nf++] = f;
-    }
+    faces.resize(index.getNumberFaces());
+    parallelFor(0u, index.getNumberFaces(), [&](unsigned int i) {
+        faces[i].assign(faceVertices.begin() + faceOffsets[i], faceVertices.begin() + faceOffsets[i+1]);
+    });
+
+    mappingVertices = index.vertices();
+    mappingFaces = index.faces();
 }
 
+/**
+ * @brief dcelAlgorithms::getVectorMesh
+ * Exports the vertices and the faces of d in contiguous vectors. Faces are
+ * stored in compressed sparse row format (see DenseIndex::getFacesCSR).
+ * @param[out] coords
+ * @param[out] faceOffsets
+ * @param[out] faceVertices
+ * @param[in] d
+ * @param[out] mappingVertices: the Dcel vertex of every exported vertex
+ * @param[out] mappingFaces: the Dcel face of every exported face
+ */
+void dcelAlgorithms::getVectorMesh(
+        std::vector<Pointd>& coords,
+        std::vector<unsigned int>& faceOffsets,
+        std::vector<unsigned int>& faceVertices,
+        const Dcel& d,
+        std::vector<const Dcel::Vertex*>& mappingVertices,
+        std::vector<const Dcel::Face*>& mappingFaces)
+{
+    DenseIndex index(d);
+    index.getFacesCSR(faceOffsets, faceVertices);
+
+    coords.resize(index.getNumberVertices());
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        coords[i] = index.vertex(i)->getCoordinate();
+    });
+
+    mappingVertices = index.vertices();
+    mappingFaces = index.faces();
+}
+
+/**
+ * @brief DcelAlgorithms::smartColoring
+ * Colors the faces of d such that adjacent faces have different colors, taken
+ * from cg3::PASTEL_COLORS. The adjacency graph of the faces is built and
+ * colored in parallel (see cg3::parallelGreedyColoring).
+ * @param d
+ */
 void dcelAlgorithms::smartColoring(Dcel& d)
 {
-    struct adjComp {
-        std::set<Dcel::Face*> getAdjacences(Dcel::Face* f){
-            std::set<Dcel::Face*> adjacents;
-            for (Dcel::Face* adj : f->adjacentFaceIterator()){
-                adjacents.insert(adj);
-            }
-            return adjacents;
-        }
+    CG3_PROFILE_SCOPE("dcelAlgorithms::smartColoring");
+    unsigned int nf = d.getNumberFaceIds();
+    auto adjacentFace = [](const Dcel::HalfEdge* he) -> const Dcel::Face* {
+        return he->getTwin() != nullptr ? he->getTwin()->getFace() : nullptr;
     };
 
-    std::vector<Dcel::Face*> vectorFaces;
-    getVectorFaces(vectorFaces, d);
-    std::map<Dcel::Face*, Color> mapColors = smartColoring(vectorFaces, adjComp());
+    //adjacency graph of the faces, indexed by id
+    std::vector<unsigned int> sizes(nf, 0), offsets(nf + 1);
+    parallelFor(0u, nf, [&](unsigned int i) {
+        const Dcel::Face* f = d.getFace(i);
+        if (f != nullptr)
+            for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator())
+                sizes[i] += adjacentFace(he) != nullptr;
+    });
+    offsets[nf] = parallelExclusiveScan(sizes.begin(), sizes.end(), offsets.begin(), 0u);
+    std::vector<unsigned int> adjacencies(offsets[nf]);
+    parallelFor(0u, nf, [&](unsigned int i) {
+        const Dcel::Face* f = d.getFace(i);
+        unsigned int j = offsets[i];
+        if (f != nullptr)
+            for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator())
+                if (adjacentFace(he) != nullptr)
+                    adjacencies[j++] = adjacentFace(he)->getId();
+    });
 
-    for (std::pair<Dcel::Face*, Color> p : mapColors){
-        (p.first)->setColor(p.second);
-    }
+    std::vector<int> colors = parallelGreedyColoring(
+                offsets, adjacencies, ColoringOptions((unsigned int)PASTEL_COLORS.size()));
+    parallelFor(0u, nf, [&](unsigned int i) {
+        Dcel::Face* f = d.getFace(i);
+        if (f != nullptr)
+            f->setColor(colors[i] >= 0 ? PASTEL_COLORS[colors[i]] : Color(0,0,0));
+    });
 }
 
 } //namespace cg3
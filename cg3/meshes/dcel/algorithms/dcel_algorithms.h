@@ -9,12 +9,110 @@
 #define DCEL_ALGORITHMS_H
 
 #include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/dcel/dcel_selection.h>
+#include <cg3/utilities/parallel.h>
+#include <cg3/utilities/profiler.h>
 #include <cg3/utilities/set.h>
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+
 namespace cg3 {
 
 namespace dcelAlgorithms {
 
+/**
+ * @brief Dense numbering of the vertices and of the faces of a Dcel.
+ *
+ * After deletions, the ids of a Dcel are not contiguous. The DenseIndex
+ * numbers the vertices and the faces from 0 to getNumberVertices()-1 and
+ * getNumberFaces()-1, following the order of the ids, and it is used to
+ * export a Dcel in contiguous buffers (see getVectorMesh, the EigenMesh
+ * constructor from a Dcel and DrawableDcel::update).
+ *
+ * The dense index of a vertex is looked up in a vector indexed by id, which
+ * is not even allocated when the vertex ids are already contiguous.
+ */
+class DenseIndex
+{
+public:
+    DenseIndex();
+    DenseIndex(const Dcel& d);
+
+    void build(const Dcel& d);
+
+    unsigned int getNumberVertices() const;
+    unsigned int getNumberFaces() const;
+    bool isCompact() const;
+
+    unsigned int vertexIndex(const Dcel::Vertex* v) const;
+    const Dcel::Vertex* vertex(unsigned int i) const;
+    const Dcel::Face* face(unsigned int i) const;
+    const std::vector<const Dcel::Vertex*>& vertices() const;
+    const std::vector<const Dcel::Face*>& faces() const;
+
+    void getFacesCSR(
+            std::vector<unsigned int>& faceOffsets,
+            std::vector<unsigned int>& faceVertices) const;
+
+private:
+    std::vector<const Dcel::Vertex*> vertexPointers;
+    std::vector<const Dcel::Face*> facePointers;
+    std::vector<unsigned int> vertexIds; //dense index of every vertex id, empty if compact
+};
+
+/**
+ * @brief Topological analysis of a Dcel.
+ *
+ * Computes in a single parallel pass on the half edges and the vertices of a
+ * Dcel:
+ * - the boundary loops, as ordered lists of the half edges without twin;
+ * - the non manifold edges: edges with more than two half edges, or with two
+ *   half edges with the same orientation (which therefore cannot be twins);
+ * - the non manifold vertices: vertices whose incident faces form more than
+ *   one fan;
+ * - the number of edges and of connected components, the Euler
+ *   characteristic and the genus.
+ *
+ * \code{.cpp}
+ * dcelAlgorithms::TopologyInfo topology(dcel);
+ * if (!topology.isClosed())
+ *     for (const std::vector<const Dcel::HalfEdge*>& loop : topology.getBoundaryLoops())
+ *         fillHole(loop);
+ * \endcode
+ *
+ * The analysis must be computed again after any change of the Dcel.
+ */
+class TopologyInfo
+{
+public:
+    TopologyInfo();
+    TopologyInfo(const Dcel& d);
+
+    void build(const Dcel& d);
+
+    const std::vector<std::vector<const Dcel::HalfEdge*>>& getBoundaryLoops() const;
+    const std::vector<const Dcel::HalfEdge*>& getNonManifoldHalfEdges() const;
+    const std::vector<const Dcel::Vertex*>& getNonManifoldVertices() const;
+    unsigned int getNumberBoundaryLoops() const;
+    unsigned int getNumberEdges() const;
+    unsigned int getNumberComponents() const;
+    int getEulerCharacteristic() const;
+    int getGenus() const;
+    bool isClosed() const;
+    bool isManifold() const;
+
+private:
+    std::vector<std::vector<const Dcel::HalfEdge*>> boundaryLoops;
+    std::vector<const Dcel::HalfEdge*> nonManifoldHalfEdges;
+    std::vector<const Dcel::Vertex*> nonManifoldVertices;
+    unsigned int nEdges;
+    unsigned int nComponents;
+    int eulerCharacteristic;
+};
+
 void getVectorFaces(std::vector<const Dcel::Face*> &vector, const Dcel& d);
 void getVectorFaces(std::vector<Dcel::Face*> &vector, Dcel& d);
 
@@ -26,6 +124,13 @@ void getVectorMesh(
         const Dcel &d,
         std::vector<const Dcel::Vertex*> &mappingVertices = dummymv,
         std::vector<const Dcel::Face*> &mappingFaces = dummymf);
+void getVectorMesh(
+        std::vector<Pointd>& coords,
+        std::vector<unsigned int>& faceOffsets,
+        std::vector<unsigned int>& faceVertices,
+        const Dcel& d,
+        std::vector<const Dcel::Vertex*>& mappingVertices = dummymv,
+        std::vector<const Dcel::Face*>& mappingFaces = dummymf);
 
 void smartColoring(Dcel &d);
 
@@ -38,11 +143,189 @@ std::set<const Dcel::Face*> flood(const Dcel::Face* seed, Comp c);
 template <typename Comp>
 std::set<unsigned int> flood(const Dcel& d, unsigned int seed, Comp c);
 
+template <typename Comp>
+DcelFaceSelection growRegion(const Dcel& d, const Dcel::Face* seed, Comp c);
+
+template <typename Comp>
+DcelFaceSelection growRegion(const DcelFaceSelection& seeds, Comp c);
+
 template <typename InputIterator>
 std::vector< std::set<const Dcel::Face*> > getConnectedComponents(
         InputIterator first,
         InputIterator last);
 
+template <typename Comp>
+std::vector<int> parallelFlood(const Dcel& d, const Dcel::Face* seed, Comp c);
+
+template <typename Comp>
+std::vector<int> parallelFlood(
+        const Dcel& d,
+        const std::vector<const Dcel::Face*>& seeds,
+        Comp c);
+
+template <typename Comp>
+std::vector<int> labelConnectedComponents(
+        const Dcel& d,
+        Comp c,
+        unsigned int& nComponents);
+
+}
+
+namespace internal {
+
+template <typename Comp>
+void dcelFlood(
+        std::vector<const Dcel::Face*>& stack,
+        DynamicBitset& visited,
+        Comp c,
+        std::vector<const Dcel::Face*>* faces = nullptr);
+
+template <typename Comp>
+std::vector<unsigned int> dcelParallelExpand(
+        const Dcel& d,
+        const std::vector<unsigned int>& frontier,
+        ConcurrentBitset& visited,
+        Comp c);
+
+unsigned int dcelFindRoot(std::atomic<unsigned int>* parents, unsigned int i);
+void dcelUnite(std::atomic<unsigned int>* parents, unsigned int i, unsigned int j);
+
+} //namespace cg3::internal
+
+inline unsigned int dcelAlgorithms::DenseIndex::getNumberVertices() const
+{
+    return (unsigned int)vertexPointers.size();
+}
+
+inline unsigned int dcelAlgorithms::DenseIndex::getNumberFaces() const
+{
+    return (unsigned int)facePointers.size();
+}
+
+/**
+ * @brief DenseIndex::isCompact
+ * @return true if the dense index of every vertex is its id
+ */
+inline bool dcelAlgorithms::DenseIndex::isCompact() const
+{
+    return vertexIds.empty();
+}
+
+/**
+ * @brief DenseIndex::vertexIndex
+ * @param v: a vertex of the indexed Dcel
+ * @return the dense index of v
+ */
+inline unsigned int dcelAlgorithms::DenseIndex::vertexIndex(const Dcel::Vertex* v) const
+{
+    return vertexIds.empty() ? v->getId() : vertexIds[v->getId()];
+}
+
+inline const Dcel::Vertex* dcelAlgorithms::DenseIndex::vertex(unsigned int i) const
+{
+    return vertexPointers[i];
+}
+
+inline const Dcel::Face* dcelAlgorithms::DenseIndex::face(unsigned int i) const
+{
+    return facePointers[i];
+}
+
+inline const std::vector<const Dcel::Vertex*>& dcelAlgorithms::DenseIndex::vertices() const
+{
+    return vertexPointers;
+}
+
+inline const std::vector<const Dcel::Face*>& dcelAlgorithms::DenseIndex::faces() const
+{
+    return facePointers;
+}
+
+/**
+ * @brief TopologyInfo::getBoundaryLoops
+ * @return the boundary loops: every loop is a list of half edges without twin,
+ * in which every half edge ends on the from vertex of the next one. A loop
+ * that cannot be closed because of an inconsistent Dcel is returned open.
+ */
+inline const std::vector<std::vector<const Dcel::HalfEdge*>>& dcelAlgorithms::TopologyInfo::getBoundaryLoops() const
+{
+    return boundaryLoops;
+}
+
+/**
+ * @brief TopologyInfo::getNonManifoldHalfEdges
+ * @return all the half edges of the non manifold edges, in order of id
+ */
+inline const std::vector<const Dcel::HalfEdge*>& dcelAlgorithms::TopologyInfo::getNonManifoldHalfEdges() const
+{
+    return nonManifoldHalfEdges;
+}
+
+/**
+ * @brief TopologyInfo::getNonManifoldVertices
+ * @return the non manifold vertices, in order of id
+ */
+inline const std::vector<const Dcel::Vertex*>& dcelAlgorithms::TopologyInfo::getNonManifoldVertices() const
+{
+    return nonManifoldVertices;
+}
+
+inline unsigned int dcelAlgorithms::TopologyInfo::getNumberBoundaryLoops() const
+{
+    return (unsigned int)boundaryLoops.size();
+}
+
+/**
+ * @brief TopologyInfo::getNumberEdges
+ * @return the number of edges: half edges that join the same two vertices
+ * are counted once
+ */
+inline unsigned int dcelAlgorithms::TopologyInfo::getNumberEdges() const
+{
+    return nEdges;
+}
+
+/**
+ * @brief TopologyInfo::getNumberComponents
+ * @return the number of components of faces connected by edges, plus the
+ * number of isolated vertices
+ */
+inline unsigned int dcelAlgorithms::TopologyInfo::getNumberComponents() const
+{
+    return nComponents;
+}
+
+/**
+ * @brief TopologyInfo::getEulerCharacteristic
+ * @return #vertices - #edges + #faces
+ */
+inline int dcelAlgorithms::TopologyInfo::getEulerCharacteristic() const
+{
+    return eulerCharacteristic;
+}
+
+/**
+ * @brief TopologyInfo::getGenus
+ * @return the total genus of the components, computed from the Euler
+ * characteristic of an orientable surface with boundary:
+ * chi = 2*components - 2*genus - boundaryLoops; -1 if the Dcel is not
+ * manifold
+ */
+inline int dcelAlgorithms::TopologyInfo::getGenus() const
+{
+    if (!isManifold())
+        return -1;
+    return (2 * (int)nComponents - (int)boundaryLoops.size() - eulerCharacteristic) / 2;
+}
+
+inline bool dcelAlgorithms::TopologyInfo::isClosed() const
+{
+    return boundaryLoops.empty();
+}
+
+inline bool dcelAlgorithms::TopologyInfo::isManifold() const
+{
+    return nonManifoldHalfEdges.empty() && nonManifoldVertices.empty();
 }
 
 template <typename InputIterator>
@@ -77,85 +360,318 @@ BoundingBox dcelAlgorithms::getBoundingBoxOfFaces(
 template <typename Comp>
 std::set<const Dcel::Face*> dcelAlgorithms::flood(const Dcel::Face* seed, Comp c)
 {
-    std::set<const Dcel::Face*> faces;
-    std::vector<const Dcel::Face *> stack_faces; // only triangles with same label of
-                                                 //the patch will stay on the stack
+    std::vector<const Dcel::Face*> faces;
+    std::vector<const Dcel::Face*> stack(1, seed);
+    DynamicBitset visited(seed->getId() + 1);
+    visited.set(seed->getId());
+    internal::dcelFlood(stack, visited, c, &faces);
+    return std::set<const Dcel::Face*>(faces.begin(), faces.end());
+}
 
-    faces.insert(seed);
+template<typename Comp>
+std::set<unsigned int> dcelAlgorithms::flood(const Dcel& d, unsigned int seed, Comp c)
+{
+    std::set<unsigned int> faces;
+    for (const Dcel::Face* f : growRegion(d, d.getFace(seed), c))
+        faces.insert(faces.end(), f->getId());
+    return faces;
+}
 
-    for (const Dcel::Face* adjacent : seed->adjacentFaceIterator()){
-        // adding neighbor triangles (if comp returns true) to the stack
-        if (c(adjacent)) stack_faces.push_back(adjacent);
-    }
+/**
+ * @brief DcelAlgorithms::growRegion
+ * Same of flood, but the visited faces are marked in a bitset instead of a
+ * std::set.
+ * @return the region grown from seed: seed and all the faces f, reachable
+ * from seed through adjacent faces, such that c(f) returns true
+ */
+template <typename Comp>
+DcelFaceSelection dcelAlgorithms::growRegion(const Dcel& d, const Dcel::Face* seed, Comp c)
+{
+    DcelFaceSelection seeds(d);
+    seeds.insert(seed);
+    return growRegion(seeds, c);
+}
 
-    // while there aren't other triangles on the stack
-    while (stack_faces.size() > 0) {
-        const Dcel::Face* fi = stack_faces[stack_faces.size()-1];
-        stack_faces.pop_back(); //pop
-        faces.insert(fi);
-        for (const Dcel::Face* adjacent : fi->adjacentFaceIterator()) {
-            if (c(adjacent)) {
-                if (faces.find(adjacent) == faces.end())
-                    stack_faces.push_back(adjacent);
-            }
+/**
+ * @brief DcelAlgorithms::growRegion
+ * Grows a region from multiple seeds.
+ * @return the selected faces of seeds and all the faces f, reachable from them
+ * through adjacent faces, such that c(f) returns true
+ */
+template <typename Comp>
+DcelFaceSelection dcelAlgorithms::growRegion(const DcelFaceSelection& seeds, Comp c)
+{
+    std::vector<const Dcel::Face*> stack(seeds.begin(), seeds.end());
+    DynamicBitset visited = seeds.getBitset();
+    internal::dcelFlood(stack, visited, c);
+    DcelFaceSelection region(*seeds.getDcel());
+    for (size_t id : visited)
+        region.insert(seeds.getDcel()->getFace((unsigned int)id));
+    return region;
+}
+
+template <typename InputIterator>
+std::vector< std::set<const Dcel::Face*> > dcelAlgorithms::getConnectedComponents(
+        InputIterator first,
+        InputIterator last)
+{
+    std::vector<const Dcel::Face*> faces(first, last);
+    std::sort(faces.begin(), faces.end());
+    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+
+    unsigned int maxId = 0;
+    for (const Dcel::Face* f : faces)
+        maxId = std::max(maxId, f->getId());
+    DynamicBitset contained(maxId + 1), visited(maxId + 1);
+    for (const Dcel::Face* f : faces)
+        contained.set(f->getId());
+    auto comp = [&](const Dcel::Face* f) {
+        return f->getId() < contained.size() && contained.test(f->getId());
+    };
+
+    std::vector< std::set<const Dcel::Face*> > connectedComponents;
+    std::vector<const Dcel::Face*> stack, cc;
+    for (const Dcel::Face* f : faces) {
+        if (!visited.testAndSet(f->getId())) {
+            stack.push_back(f);
+            cc.clear();
+            internal::dcelFlood(stack, visited, comp, &cc);
+            connectedComponents.push_back(std::set<const Dcel::Face*>(cc.begin(), cc.end()));
         }
     }
-    return faces;
+    return connectedComponents;
 }
 
-template<typename Comp>
-std::set<unsigned int> dcelAlgorithms::flood(const Dcel& d, unsigned int seed, Comp c)
+/**
+ * @brief DcelAlgorithms::parallelFlood
+ * Parallel version of flood: the region is grown with a level synchronous
+ * breadth first visit, in which the faces of every level are expanded in
+ * parallel. c is called concurrently by several threads, and it may be called
+ * more than once on the same face.
+ * @return a vector indexed by face id, with 0 for the faces of the region and
+ * -1 for the other faces
+ */
+template <typename Comp>
+std::vector<int> dcelAlgorithms::parallelFlood(const Dcel& d, const Dcel::Face* seed, Comp c)
 {
-    std::set<unsigned int> faces;
-    std::vector<const Dcel::Face *> stack_faces; // only triangles with same label of
-                                                 //the patch will stay on the stack
+    return parallelFlood(d, std::vector<const Dcel::Face*>(1, seed), c);
+}
 
-    faces.insert(seed);
+/**
+ * @brief DcelAlgorithms::parallelFlood
+ * Grows in parallel a region from every seed (see parallelFlood). Regions
+ * grow at the same speed, one ring of adjacent faces at a time, and a face
+ * that can be reached by more than one region goes to the region that reaches
+ * it first, or, among the ones that reach it at the same time, to the one with
+ * the lower seed index. The result does not depend on the number of threads.
+ * @return a vector indexed by face id, with the index of the seed of the
+ * region of every face, -1 for the faces that are not reached by any region
+ */
+template <typename Comp>
+std::vector<int> dcelAlgorithms::parallelFlood(
+        const Dcel& d,
+        const std::vector<const Dcel::Face*>& seeds,
+        Comp c)
+{
+    CG3_PROFILE_SCOPE("dcelAlgorithms::parallelFlood");
+    std::vector<int> labels(d.getNumberFaceIds(), -1);
+    std::vector<int> levels(d.getNumberFaceIds(), -1);
+    ConcurrentBitset visited(d.getNumberFaceIds());
+    std::vector<unsigned int> frontier;
+    for (unsigned int i = 0; i < seeds.size(); i++) {
+        unsigned int id = seeds[i]->getId();
+        if (!visited.testAndSet(id)) {
+            frontier.push_back(id);
+            labels[id] = i;
+            levels[id] = 0;
+        }
+    }
 
-    for (const Dcel::Face* adjacent : d.getFace(seed)->adjacentFaceIterator()){
-        // adding neighbor triangles (if comp returns true) to the stack
-        if (c(adjacent)) stack_faces.push_back(adjacent);
+    for (int level = 0; !frontier.empty(); level++) {
+        std::vector<unsigned int> next = internal::dcelParallelExpand(d, frontier, visited, c);
+        //a face of the next level takes the lowest label among its adjacent
+        //faces of the current level
+        parallelFor((size_t)0, next.size(), [&](size_t i) {
+            int label = INT_MAX;
+            for (const Dcel::HalfEdge* he : d.getFace(next[i])->incidentHalfEdgeIterator()) {
+                if (he->getTwin() != nullptr && he->getTwin()->getFace() != nullptr) {
+                    unsigned int adj = he->getTwin()->getFace()->getId();
+                    if (levels[adj] == level)
+                        label = std::min(label, labels[adj]);
+                }
+            }
+            labels[next[i]] = label;
+        });
+        parallelFor((size_t)0, next.size(), [&](size_t i) {
+            levels[next[i]] = level + 1;
+        });
+        frontier.swap(next);
     }
+    return labels;
+}
+
+/**
+ * @brief DcelAlgorithms::labelConnectedComponents
+ * Computes in parallel the connected components of the faces f such that c(f)
+ * returns true, where two faces are connected if they share an edge. The
+ * components are found with a concurrent union find, and are numbered in order
+ * of their face with the lowest id. c is called once on every face, by
+ * several threads concurrently.
+ * @param nComponents: the number of components
+ * @return a vector indexed by face id, with the component of the faces f such
+ * that c(f) returns true, -1 for the other faces
+ */
+template <typename Comp>
+std::vector<int> dcelAlgorithms::labelConnectedComponents(
+        const Dcel& d,
+        Comp c,
+        unsigned int& nComponents)
+{
+    CG3_PROFILE_SCOPE("dcelAlgorithms::labelConnectedComponents");
+    unsigned int n = d.getNumberFaceIds();
+    std::vector<char> inside(n);
+    std::unique_ptr<std::atomic<unsigned int>[]> parents(new std::atomic<unsigned int>[n]);
+    parallelFor(0u, n, [&](unsigned int i) {
+        const Dcel::Face* f = d.getFace(i);
+        inside[i] = f != nullptr && c(f);
+        parents[i].store(i, std::memory_order_relaxed);
+    });
+
+    parallelFor(0u, n, [&](unsigned int i) {
+        if (!inside[i])
+            return;
+        for (const Dcel::HalfEdge* he : d.getFace(i)->incidentHalfEdgeIterator()) {
+            if (he->getTwin() != nullptr && he->getTwin()->getFace() != nullptr) {
+                unsigned int adj = he->getTwin()->getFace()->getId();
+                if (adj > i && inside[adj])
+                    internal::dcelUnite(parents.get(), i, adj);
+            }
+        }
+    });
+
+    //roots are the faces with the lowest id of their component
+    std::vector<unsigned int> isRoot(n), rootLabels(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        isRoot[i] = inside[i] && internal::dcelFindRoot(parents.get(), i) == i;
+    });
+    nComponents = parallelExclusiveScan(isRoot.begin(), isRoot.end(), rootLabels.begin(), 0u);
+    std::vector<int> labels(n, -1);
+    parallelFor(0u, n, [&](unsigned int i) {
+        if (inside[i])
+            labels[i] = rootLabels[internal::dcelFindRoot(parents.get(), i)];
+    });
+    return labels;
+}
 
-    // while there aren't other triangles on the stack
-    while (stack_faces.size() > 0) {
-        const Dcel::Face* fi = stack_faces[stack_faces.size()-1];
-        stack_faces.pop_back(); //pop
-        faces.insert(fi->getId());
-        for (const Dcel::Face* adjacent : fi->adjacentFaceIterator()) {
-            if (c(adjacent)) {
-                if (faces.find(adjacent->getId()) == faces.end())
-                    stack_faces.push_back(adjacent);
+/**
+ * @brief dcelFlood
+ * Depth first visit of the faces on the stack and of all the faces reachable
+ * from them through faces f such that c(f) returns true. The faces on the
+ * stack must be already marked in visited, which grows if it is smaller than
+ * the ids of the visited faces.
+ * @param faces: if not null, the visited faces are appended to it
+ */
+template <typename Comp>
+void internal::dcelFlood(
+        std::vector<const Dcel::Face*>& stack,
+        DynamicBitset& visited,
+        Comp c,
+        std::vector<const Dcel::Face*>* faces)
+{
+    while (!stack.empty()) {
+        const Dcel::Face* f = stack.back();
+        stack.pop_back();
+        if (faces != nullptr)
+            faces->push_back(f);
+        for (const Dcel::Face* adjacent : f->adjacentFaceIterator()) {
+            unsigned int id = adjacent->getId();
+            if (id >= visited.size())
+                visited.resize(std::max((size_t)id + 1, 2 * visited.size()));
+            if (!visited.test(id) && c(adjacent)) {
+                visited.set(id);
+                stack.push_back(adjacent);
             }
         }
     }
-    return faces;
 }
 
-template <typename InputIterator>
-std::vector< std::set<const Dcel::Face*> > dcelAlgorithms::getConnectedComponents(
-        InputIterator first,
-        InputIterator last)
+/**
+ * @brief dcelParallelExpand
+ * Expands in parallel a level of a breadth first visit of the faces.
+ * @return the faces f, adjacent to the faces of frontier, not marked in visited
+ * and such that c(f) returns true; they are marked in visited.
+ */
+template <typename Comp>
+std::vector<unsigned int> internal::dcelParallelExpand(
+        const Dcel& d,
+        const std::vector<unsigned int>& frontier,
+        ConcurrentBitset& visited,
+        Comp c)
 {
-    struct Comp{
-        const std::set<const Dcel::Face*> &cf;
-        Comp(const std::set<const Dcel::Face*> &cf) : cf(cf) {}
-        bool operator()(const Dcel::Face* f) {
-            return cf.find(f) != cf.end();
+    const size_t grain = 1024;
+    size_t nChunks = (frontier.size() + grain - 1) / grain;
+    std::vector<std::vector<unsigned int>> chunks(nChunks);
+    parallelFor((size_t)0, nChunks, [&](size_t ch) {
+        size_t end = std::min(frontier.size(), (ch + 1) * grain);
+        for (size_t i = ch * grain; i < end; i++) {
+            for (const Dcel::HalfEdge* he : d.getFace(frontier[i])->incidentHalfEdgeIterator()) {
+                if (he->getTwin() == nullptr || he->getTwin()->getFace() == nullptr)
+                    continue;
+                const Dcel::Face* adj = he->getTwin()->getFace();
+                unsigned int id = adj->getId();
+                if (!visited.test(id) && c(adj) && !visited.testAndSet(id))
+                    chunks[ch].push_back(id);
+            }
         }
-    };
+    });
 
-    std::vector< std::set<const Dcel::Face*> > connectedComponents;
-    std::set<const Dcel::Face*> containedFaces(first, last);
-
-    while (containedFaces.size() > 0){
-        Comp comp(containedFaces);
-        const Dcel::Face* f = *(containedFaces.begin());
-        std::set<const Dcel::Face*> cc = flood(f, comp);
-        connectedComponents.push_back(cc);
-        containedFaces = difference(containedFaces, cc);
+    std::vector<size_t> sizes(nChunks), offsets(nChunks);
+    for (size_t ch = 0; ch < nChunks; ch++)
+        sizes[ch] = chunks[ch].size();
+    size_t n = parallelExclusiveScan(sizes.begin(), sizes.end(), offsets.begin(), (size_t)0);
+    std::vector<unsigned int> next(n);
+    parallelFor((size_t)0, nChunks, [&](size_t ch) {
+        std::copy(chunks[ch].begin(), chunks[ch].end(), next.begin() + offsets[ch]);
+    });
+    return next;
+}
+
+/**
+ * @brief dcelFindRoot
+ * Find of a concurrent union find with path halving.
+ */
+inline unsigned int internal::dcelFindRoot(std::atomic<unsigned int>* parents, unsigned int i)
+{
+    unsigned int p = parents[i].load(std::memory_order_relaxed);
+    while (p != i) {
+        unsigned int gp = parents[p].load(std::memory_order_relaxed);
+        if (gp != p)
+            parents[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        i = p;
+        p = parents[i].load(std::memory_order_relaxed);
+    }
+    return i;
+}
+
+/**
+ * @brief dcelUnite
+ * Union of a concurrent union find: the root with the higher index is linked
+ * to the one with the lower index, so the root of every set is its lowest
+ * element regardless of the order of the unions.
+ */
+inline void internal::dcelUnite(std::atomic<unsigned int>* parents, unsigned int i, unsigned int j)
+{
+    for (;;) {
+        i = dcelFindRoot(parents, i);
+        j = dcelFindRoot(parents, j);
+        if (i == j)
+            return;
+        if (i < j)
+            std::swap(i, j);
+        unsigned int expected = i;
+        if (parents[i].compare_exchange_strong(expected, j, std::memory_order_relaxed))
+            return;
     }
-    return connectedComponents;
 }
 
 } //namespace cg3
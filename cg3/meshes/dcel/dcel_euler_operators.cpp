@@ -0,0 +1,507 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "dcel_face_iterators.h"
+#include "dcel_vertex_iterators.h"
+
+#include <algorithm>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Collects the outgoing half edges of v in counterclockwise order,
+ * starting from its incident half edge.
+ * @return false if v is not an interior vertex of a triangle mesh (an half
+ * edge of its one-ring has no twin or no face, or is not a triangle)
+ */
+bool dcelOutgoingHalfEdges(const Dcel::Vertex* v, std::vector<const Dcel::HalfEdge*>& outgoing)
+{
+    outgoing.clear();
+    const Dcel::HalfEdge* start = v->getIncidentHalfEdge();
+    if (start == nullptr)
+        return false;
+    const Dcel::HalfEdge* he = start;
+    do {
+        if (he->getFace() == nullptr || he->getTwin() == nullptr ||
+                he->getNext() == nullptr || he->getPrev() == nullptr ||
+                he->getNext()->getNext() != he->getPrev())
+            return false;
+        outgoing.push_back(he);
+        he = he->getPrev()->getTwin();
+        if (he == nullptr)
+            return false;
+    } while (he != start);
+    return true;
+}
+
+/**
+ * @brief Like dcelOutgoingHalfEdges, for non const vertices.
+ */
+bool dcelOutgoingHalfEdges(Dcel::Vertex* v, std::vector<Dcel::HalfEdge*>& outgoing)
+{
+    std::vector<const Dcel::HalfEdge*> tmp;
+    bool b = dcelOutgoingHalfEdges((const Dcel::Vertex*)v, tmp);
+    outgoing.resize(tmp.size());
+    for (unsigned int i = 0; i < tmp.size(); i++)
+        outgoing[i] = const_cast<Dcel::HalfEdge*>(tmp[i]);
+    return b;
+}
+
+/**
+ * @brief Returns true if he is shared by two triangles.
+ */
+bool dcelIsInteriorTriangleEdge(const Dcel::HalfEdge* he)
+{
+    const Dcel::HalfEdge* t = he->getTwin();
+    return t != nullptr && t->getTwin() == he &&
+            he->getFace() != nullptr && t->getFace() != nullptr &&
+            he->getFace() != t->getFace() &&
+            he->getFace()->isTriangle() && t->getFace()->isTriangle();
+}
+
+bool dcelAreAdjacent(const Dcel::Vertex* v1, const Dcel::Vertex* v2)
+{
+    std::vector<const Dcel::HalfEdge*> outgoing;
+    dcelOutgoingHalfEdges(v1, outgoing);
+    for (const Dcel::HalfEdge* he : outgoing)
+        if (he->getToVertex() == v2)
+            return true;
+    return false;
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief Dcel::isEdgeFlippable
+ * @param he: an half edge of the edge to flip
+ * @return true if the edge of he can be flipped: it is shared by two
+ * triangles, and the edge between the two opposite vertices does not exist
+ */
+bool Dcel::isEdgeFlippable(const HalfEdge* he) const
+{
+    if (!internal::dcelIsInteriorTriangleEdge(he))
+        return false;
+    const Vertex* c = he->getNext()->getToVertex();
+    const Vertex* d = he->getTwin()->getNext()->getToVertex();
+    if (c == d)
+        return false;
+    return !internal::dcelAreAdjacent(c, d);
+}
+
+/**
+ * @brief Dcel::isEdgeCollapsible
+ * Checks the link condition of the edge of he: the edge must be shared by two
+ * triangles, its vertices must be interior vertices that share exactly the
+ * two vertices opposite to the edge, and these two vertices must have at
+ * least four incident edges. Collapsing an edge that satisfies these
+ * conditions preserves the manifoldness and the topology of the mesh.
+ * @param he: an half edge of the edge to collapse
+ * @return true if the edge of he can be collapsed
+ */
+bool Dcel::isEdgeCollapsible(const HalfEdge* he) const
+{
+    if (!internal::dcelIsInteriorTriangleEdge(he))
+        return false;
+    const Vertex* a = he->getFromVertex();
+    const Vertex* b = he->getToVertex();
+    const Vertex* c = he->getNext()->getToVertex();
+    const Vertex* d = he->getTwin()->getNext()->getToVertex();
+    if (c == d)
+        return false;
+
+    std::vector<const HalfEdge*> outA, outB, outC, outD;
+    if (!internal::dcelOutgoingHalfEdges(a, outA) || !internal::dcelOutgoingHalfEdges(b, outB) ||
+            !internal::dcelOutgoingHalfEdges(c, outC) || !internal::dcelOutgoingHalfEdges(d, outD))
+        return false;
+    if (outC.size() < 4 || outD.size() < 4)
+        return false;
+
+    std::vector<const Vertex*> adjA, adjB;
+    for (const HalfEdge* e : outA)
+        adjA.push_back(e->getToVertex());
+    for (const HalfEdge* e : outB)
+        adjB.push_back(e->getToVertex());
+    std::sort(adjA.begin(), adjA.end());
+    std::sort(adjB.begin(), adjB.end());
+    std::vector<const Vertex*> shared;
+    std::set_intersection(adjA.begin(), adjA.end(), adjB.begin(), adjB.end(), std::back_inserter(shared));
+    return shared.size() == 2;
+}
+
+/**
+ * @brief Dcel::flipEdge
+ * Replaces the edge of he, shared by the triangles (a, b, c) and (b, a, d),
+ * with the edge (c, d). The two half edges of the edge and the two faces are
+ * reused; normals, areas and cardinalities of the four vertices are updated.
+ * @param he: an half edge of the edge to flip
+ * @return false if the edge is not flippable (see isEdgeFlippable)
+ * @par Complexity:
+ *      \e O(cardinality of the vertices of the two triangles)
+ */
+bool Dcel::flipEdge(HalfEdge* he)
+{
+    if (!isEdgeFlippable(he))
+        return false;
+    HalfEdge* t = he->twin;
+    HalfEdge* n0 = he->next; //b->c
+    HalfEdge* p0 = he->prev; //c->a
+    HalfEdge* n1 = t->next;  //a->d
+    HalfEdge* p1 = t->prev;  //d->b
+    Vertex* a = he->fromVertex;
+    Vertex* b = he->toVertex;
+    Vertex* c = n0->toVertex;
+    Vertex* d = n1->toVertex;
+    Face* f0 = he->face;
+    Face* f1 = t->face;
+
+    if (a->incidentHalfEdge == he) a->incidentHalfEdge = n1;
+    if (b->incidentHalfEdge == t) b->incidentHalfEdge = n0;
+
+    //f0: (d, c, a)
+    he->fromVertex = d; he->toVertex = c;
+    he->next = p0; p0->next = n1; n1->next = he;
+    he->prev = n1; p0->prev = he; n1->prev = p0;
+    n1->face = f0;
+    f0->outerHalfEdge = he;
+
+    //f1: (c, d, b)
+    t->fromVertex = c; t->toVertex = d;
+    t->next = p1; p1->next = n0; n0->next = t;
+    t->prev = n0; p1->prev = t; n0->prev = p1;
+    n0->face = f1;
+    f1->outerHalfEdge = t;
+
+    updateLocalAttributes({f0, f1});
+    return true;
+}
+
+/**
+ * @brief Dcel::splitEdge
+ * Inserts a new vertex with coordinates p on the edge of he, splitting the two
+ * incident triangles in four triangles. The new faces take the colors of the
+ * faces they are split from.
+ * @param he: an half edge of an edge shared by two triangles
+ * @param p: coordinates of the new vertex
+ * @return the new vertex, nullptr if the edge is not shared by two triangles
+ * @par Complexity:
+ *      \e O(cardinality of the vertices of the two triangles)
+ */
+Dcel::Vertex* Dcel::splitEdge(HalfEdge* he, const Pointd& p)
+{
+    if (!internal::dcelIsInteriorTriangleEdge(he))
+        return nullptr;
+    HalfEdge* t = he->twin;
+    HalfEdge* n0 = he->next; //b->c
+    HalfEdge* p0 = he->prev; //c->a
+    HalfEdge* n1 = t->next;  //a->d
+    HalfEdge* p1 = t->prev;  //d->b
+    Vertex* a = he->fromVertex;
+    Vertex* b = he->toVertex;
+    Vertex* c = n0->toVertex;
+    Vertex* d = n1->toVertex;
+    Face* f0 = he->face;
+    Face* f1 = t->face;
+
+    Vertex* m = addVertex(p);
+    Face* f2 = addFace(f0->getNormal(), f0->getColor());
+    Face* f3 = addFace(f1->getNormal(), f1->getColor());
+    HalfEdge* mb = addHalfEdge(); //twin of t
+    HalfEdge* ma = addHalfEdge(); //twin of he
+    HalfEdge* mc = addHalfEdge();
+    HalfEdge* cm = addHalfEdge();
+    HalfEdge* md = addHalfEdge();
+    HalfEdge* dm = addHalfEdge();
+
+    //f0: (a, m, c)
+    he->toVertex = m;
+    mc->fromVertex = m; mc->toVertex = c;
+    he->next = mc; mc->next = p0; p0->next = he;
+    he->prev = p0; mc->prev = he; p0->prev = mc;
+    mc->face = f0;
+    f0->outerHalfEdge = he;
+
+    //f2: (m, b, c)
+    mb->fromVertex = m; mb->toVertex = b;
+    cm->fromVertex = c; cm->toVertex = m;
+    mb->next = n0; n0->next = cm; cm->next = mb;
+    mb->prev = cm; n0->prev = mb; cm->prev = n0;
+    mb->face = f2; n0->face = f2; cm->face = f2;
+    f2->outerHalfEdge = mb;
+
+    //f1: (b, m, d)
+    t->toVertex = m;
+    md->fromVertex = m; md->toVertex = d;
+    t->next = md; md->next = p1; p1->next = t;
+    t->prev = p1; md->prev = t; p1->prev = md;
+    md->face = f1;
+    f1->outerHalfEdge = t;
+
+    //f3: (m, a, d)
+    ma->fromVertex = m; ma->toVertex = a;
+    dm->fromVertex = d; dm->toVertex = m;
+    ma->next = n1; n1->next = dm; dm->next = ma;
+    ma->prev = dm; n1->prev = ma; dm->prev = n1;
+    ma->face = f3; n1->face = f3; dm->face = f3;
+    f3->outerHalfEdge = ma;
+
+    he->twin = ma; ma->twin = he;
+    t->twin = mb; mb->twin = t;
+    mc->twin = cm; cm->twin = mc;
+    md->twin = dm; dm->twin = md;
+
+    m->incidentHalfEdge = mb;
+
+    updateLocalAttributes({f0, f1, f2, f3});
+    return m;
+}
+
+/**
+ * @brief Dcel::splitFace
+ * Inserts a new vertex with coordinates p inside the triangle f, splitting it
+ * in three triangles. The new faces take the color of f.
+ * @param f: a triangle
+ * @param p: coordinates of the new vertex
+ * @return the new vertex, nullptr if f is not a triangle
+ * @par Complexity:
+ *      \e O(cardinality of the vertices of f)
+ */
+Dcel::Vertex* Dcel::splitFace(Face* f, const Pointd& p)
+{
+    if (f->outerHalfEdge == nullptr || !f->isTriangle() || f->hasHoles())
+        return nullptr;
+    HalfEdge* h0 = f->outerHalfEdge; //a->b
+    HalfEdge* h1 = h0->next;         //b->c
+    HalfEdge* h2 = h1->next;         //c->a
+    Vertex* a = h0->fromVertex;
+    Vertex* b = h1->fromVertex;
+    Vertex* c = h2->fromVertex;
+
+    Vertex* m = addVertex(p);
+    Face* f1 = addFace(f->getNormal(), f->getColor());
+    Face* f2 = addFace(f->getNormal(), f->getColor());
+    HalfEdge* am = addHalfEdge();
+    HalfEdge* ma = addHalfEdge();
+    HalfEdge* bm = addHalfEdge();
+    HalfEdge* mb = addHalfEdge();
+    HalfEdge* cm = addHalfEdge();
+    HalfEdge* mc = addHalfEdge();
+    am->fromVertex = a; am->toVertex = m;
+    ma->fromVertex = m; ma->toVertex = a;
+    bm->fromVertex = b; bm->toVertex = m;
+    mb->fromVertex = m; mb->toVertex = b;
+    cm->fromVertex = c; cm->toVertex = m;
+    mc->fromVertex = m; mc->toVertex = c;
+    am->twin = ma; ma->twin = am;
+    bm->twin = mb; mb->twin = bm;
+    cm->twin = mc; mc->twin = cm;
+
+    //f: (a, b, m)
+    h0->next = bm; bm->next = ma; ma->next = h0;
+    h0->prev = ma; bm->prev = h0; ma->prev = bm;
+    bm->face = f; ma->face = f;
+    f->outerHalfEdge = h0;
+
+    //f1: (b, c, m)
+    h1->next = cm; cm->next = mb; mb->next = h1;
+    h1->prev = mb; cm->prev = h1; mb->prev = cm;
+    h1->face = f1; cm->face = f1; mb->face = f1;
+    f1->outerHalfEdge = h1;
+
+    //f2: (c, a, m)
+    h2->next = am; am->next = mc; mc->next = h2;
+    h2->prev = mc; am->prev = h2; mc->prev = am;
+    h2->face = f2; am->face = f2; mc->face = f2;
+    f2->outerHalfEdge = h2;
+
+    m->incidentHalfEdge = ma;
+
+    updateLocalAttributes({f, f1, f2});
+    return m;
+}
+
+/**
+ * @brief Dcel::collapseEdge
+ * Collapses the edge of he, shared by the triangles (a, b, c) and (b, a, d),
+ * where a and b are the from and to vertices of he. The vertex b, the two
+ * triangles and three edges are deleted (their ids are reused by the next
+ * insertions), and a is moved in p.
+ * Normals, areas and cardinalities of the one-ring of a are updated.
+ * @param he: an half edge of the edge to collapse
+ * @param p: new coordinates of the vertex a
+ * @return the vertex a, nullptr if the edge is not collapsible (see
+ * isEdgeCollapsible)
+ * @par Complexity:
+ *      \e O(cardinality of a and b)
+ */
+Dcel::Vertex* Dcel::collapseEdge(HalfEdge* he, const Pointd& p)
+{
+    if (!isEdgeCollapsible(he))
+        return nullptr;
+    HalfEdge* t = he->twin;
+    HalfEdge* n0 = he->next; //b->c
+    HalfEdge* p0 = he->prev; //c->a
+    HalfEdge* n1 = t->next;  //a->d
+    HalfEdge* p1 = t->prev;  //d->b
+    HalfEdge* on0 = n0->twin; //c->b
+    HalfEdge* op0 = p0->twin; //a->c
+    HalfEdge* on1 = n1->twin; //d->a
+    HalfEdge* op1 = p1->twin; //b->d
+    Vertex* a = he->fromVertex;
+    Vertex* b = he->toVertex;
+    Vertex* c = n0->toVertex;
+    Vertex* d = n1->toVertex;
+    Face* f0 = he->face;
+    Face* f1 = t->face;
+
+    std::vector<HalfEdge*> outB;
+    internal::dcelOutgoingHalfEdges(b, outB);
+    for (HalfEdge* e : outB) {
+        e->fromVertex = a;
+        e->twin->toVertex = a;
+    }
+
+    on0->twin = op0; op0->twin = on0;
+    on1->twin = op1; op1->twin = on1;
+    a->incidentHalfEdge = op0;
+    if (c->incidentHalfEdge == p0) c->incidentHalfEdge = on0;
+    if (d->incidentHalfEdge == p1) d->incidentHalfEdge = on1;
+
+    for (HalfEdge* e : {he, t, n0, p0, n1, p1}) {
+        e->fromVertex = e->toVertex = nullptr;
+        e->twin = e->next = e->prev = nullptr;
+        e->face = nullptr;
+        deleteHalfEdge(e);
+    }
+    for (Face* f : {f0, f1}) {
+        f->outerHalfEdge = nullptr;
+        deleteFace(f);
+    }
+    b->incidentHalfEdge = nullptr;
+    deleteVertex(b);
+
+    a->setCoordinate(p);
+
+    std::vector<HalfEdge*> outA;
+    internal::dcelOutgoingHalfEdges(a, outA);
+    std::vector<Face*> changed;
+    for (HalfEdge* e : outA)
+        changed.push_back(e->face);
+    updateLocalAttributes(changed);
+    return a;
+}
+
+/**
+ * @brief Dcel::splitVertex
+ * Inverse of collapseEdge: splits v in two vertices v and w, where w is a new
+ * vertex with coordinates p. The faces incident to v between the edges
+ * (v, vr) and (v, vl), in counterclockwise order, become incident to w, and
+ * the triangles (v, w, vl) and (w, v, vr) are inserted.
+ * @param v: an interior vertex
+ * @param vl, vr: two distinct vertices adjacent to v
+ * @param p: coordinates of the new vertex w
+ * @return the new vertex w, nullptr if vl or vr are not adjacent to v or v
+ * is not an interior vertex
+ * @par Complexity:
+ *      \e O(cardinality of v)
+ */
+Dcel::Vertex* Dcel::splitVertex(Vertex* v, Vertex* vl, Vertex* vr, const Pointd& p)
+{
+    if (vl == vr)
+        return nullptr;
+    std::vector<HalfEdge*> outV;
+    if (!internal::dcelOutgoingHalfEdges(v, outV))
+        return nullptr;
+    int il = -1, ir = -1;
+    for (unsigned int i = 0; i < outV.size(); i++) {
+        if (outV[i]->toVertex == vl) il = i;
+        if (outV[i]->toVertex == vr) ir = i;
+    }
+    if (il < 0 || ir < 0)
+        return nullptr;
+    HalfEdge* hl = outV[il]; //v->vl
+    HalfEdge* hr = outV[ir]; //v->vr
+    HalfEdge* thl = hl->twin;
+    HalfEdge* thr = hr->twin;
+    Face* fl = thl->face;
+
+    Vertex* w = addVertex(p);
+    //the outgoing half edges from hr (included) to hl (excluded) move to w
+    for (unsigned int i = ir; i != (unsigned int)il; i = (i + 1) % outV.size()) {
+        outV[i]->fromVertex = w;
+        if (outV[i] != hr)
+            outV[i]->twin->toVertex = w;
+    }
+    thl->toVertex = w;
+    if (v->incidentHalfEdge->fromVertex != v)
+        v->incidentHalfEdge = hl;
+
+    Face* f0 = addFace(fl->getNormal(), fl->getColor());
+    Face* f1 = addFace(hr->face->getNormal(), hr->face->getColor());
+    HalfEdge* vw = addHalfEdge();
+    HalfEdge* wvl = addHalfEdge();
+    HalfEdge* vlv = addHalfEdge();
+    HalfEdge* wv = addHalfEdge();
+    HalfEdge* vvr = addHalfEdge();
+    HalfEdge* vrw = addHalfEdge();
+
+    //f0: (v, w, vl)
+    vw->fromVertex = v; vw->toVertex = w;
+    wvl->fromVertex = w; wvl->toVertex = vl;
+    vlv->fromVertex = vl; vlv->toVertex = v;
+    vw->next = wvl; wvl->next = vlv; vlv->next = vw;
+    vw->prev = vlv; wvl->prev = vw; vlv->prev = wvl;
+    vw->face = wvl->face = vlv->face = f0;
+    f0->outerHalfEdge = vw;
+
+    //f1: (w, v, vr)
+    wv->fromVertex = w; wv->toVertex = v;
+    vvr->fromVertex = v; vvr->toVertex = vr;
+    vrw->fromVertex = vr; vrw->toVertex = w;
+    wv->next = vvr; vvr->next = vrw; vrw->next = wv;
+    wv->prev = vrw; vvr->prev = wv; vrw->prev = vvr;
+    wv->face = vvr->face = vrw->face = f1;
+    f1->outerHalfEdge = wv;
+
+    vw->twin = wv; wv->twin = vw;
+    wvl->twin = thl; thl->twin = wvl;
+    vlv->twin = hl; hl->twin = vlv;
+    vvr->twin = thr; thr->twin = vvr;
+    vrw->twin = hr; hr->twin = vrw;
+
+    w->incidentHalfEdge = wv;
+
+    std::vector<HalfEdge*> outW;
+    internal::dcelOutgoingHalfEdges(w, outW);
+    std::vector<Face*> changed;
+    for (HalfEdge* e : outW)
+        changed.push_back(e->face);
+    updateLocalAttributes(changed);
+    return w;
+}
+
+/**
+ * @brief Dcel::updateLocalAttributes
+ * Updates normals and areas of the given faces, and normals and
+ * cardinalities of their vertices.
+ */
+void Dcel::updateLocalAttributes(const std::vector<Face*>& changedFaces)
+{
+    std::vector<Vertex*> changedVertices;
+    for (Face* f : changedFaces) {
+        f->updateArea();
+        for (Vertex* v : f->incidentVertexIterator())
+            changedVertices.push_back(v);
+    }
+    std::sort(changedVertices.begin(), changedVertices.end());
+    changedVertices.erase(std::unique(changedVertices.begin(), changedVertices.end()), changedVertices.end());
+    for (Vertex* v : changedVertices)
+        v->updateNormal();
+}
+
+} //namespace cg3
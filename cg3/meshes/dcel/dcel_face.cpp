@@ -8,6 +8,7 @@
 #include "dcel_face_iterators.h"
 #include "dcel_vertex_iterators.h"
 #include <cg3/geometry/transformations.h>
+#include <cg3/utilities/flat_hash_map.h>
 #ifdef CG3_CGAL_DEFINED
 #include <cg3/cgal/triangulation.h>
 #endif
@@ -158,7 +159,7 @@ void Dcel::Face::getTriangulation(std::vector<std::array<const Dcel::Vertex*, 3>
     // Taking all the coordinates on vectors
     std::vector<Pointd> borderCoordinates;
     std::vector< std::vector<Pointd> > innerBorderCoordinates;
-    std::map<Pointd, const Dcel::Vertex*> pointsVerticesMap;
+    FlatHashMap<Pointd, const Dcel::Vertex*> pointsVerticesMap;
     for (const Dcel::HalfEdge* he : incidentHalfEdgeIterator()){
         assert(he != nullptr && "Next component of Previous HalfEdge is null.");
         assert(he->getFromVertex() != nullptr && "HalfEdge's from vertex is null.");
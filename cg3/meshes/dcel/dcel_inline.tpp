@@ -105,6 +105,36 @@ inline unsigned int Dcel::getNumberFaces () const
     return nFaces;
 }
 
+/**
+ * @brief Dcel::getNumberVertexIds
+ * @return the number of ids used by the vertices, deleted vertices included:
+ * all the vertex ids are lower than this number, which is equal to
+ * getNumberVertices() when there are no deleted vertices
+ */
+inline unsigned int Dcel::getNumberVertexIds() const
+{
+    return (unsigned int)vertices.size();
+}
+
+/**
+ * @brief Dcel::getNumberHalfEdgeIds
+ * @return the number of ids used by the half edges, deleted half edges
+ * included
+ */
+inline unsigned int Dcel::getNumberHalfEdgeIds() const
+{
+    return (unsigned int)halfEdges.size();
+}
+
+/**
+ * @brief Dcel::getNumberFaceIds
+ * @return the number of ids used by the faces, deleted faces included
+ */
+inline unsigned int Dcel::getNumberFaceIds() const
+{
+    return (unsigned int)faces.size();
+}
+
 /**
  * \~Italian
  * @brief Funzione di inizializzazione di Dcel::ConstVertexIterator
@@ -385,6 +415,116 @@ inline Dcel::FaceRangeBasedIterator Dcel::faceIterator()
     return FaceRangeBasedIterator(this);
 }
 
+/**
+ * @brief Dcel::addVertexProperty
+ * Adds to the vertices a property with the given name and type, with a value
+ * for every vertex id initialized to defaultValue. The property is kept sized
+ * as the vertices of the Dcel: see DcelProperty. If a property with the same
+ * name and type already exists, it is returned unchanged.
+ * @throws std::invalid_argument if a property with the same name exists and
+ * has a different type
+ * @return the property
+ */
+template <typename T>
+inline DcelProperty<T>& Dcel::addVertexProperty(const std::string& name, const T& defaultValue)
+{
+    return vertexProperties.add<T>(name, (unsigned int)vertices.size(), defaultValue);
+}
+
+/**
+ * @brief Dcel::getVertexProperty
+ * @throws std::out_of_range if the vertices have not a property with the given
+ * name, std::invalid_argument if the property has a different type
+ * @return the property of the vertices with the given name
+ */
+template <typename T>
+inline DcelProperty<T>& Dcel::getVertexProperty(const std::string& name)
+{
+    return vertexProperties.get<T>(name);
+}
+
+template <typename T>
+inline const DcelProperty<T>& Dcel::getVertexProperty(const std::string& name) const
+{
+    return vertexProperties.get<T>(name);
+}
+
+inline bool Dcel::hasVertexProperty(const std::string& name) const
+{
+    return vertexProperties.has(name);
+}
+
+inline bool Dcel::removeVertexProperty(const std::string& name)
+{
+    return vertexProperties.remove(name);
+}
+
+/**
+ * @brief Dcel::addHalfEdgeProperty
+ * Adds to the half edges a property with the given name and type: see
+ * Dcel::addVertexProperty.
+ */
+template <typename T>
+inline DcelProperty<T>& Dcel::addHalfEdgeProperty(const std::string& name, const T& defaultValue)
+{
+    return halfEdgeProperties.add<T>(name, (unsigned int)halfEdges.size(), defaultValue);
+}
+
+template <typename T>
+inline DcelProperty<T>& Dcel::getHalfEdgeProperty(const std::string& name)
+{
+    return halfEdgeProperties.get<T>(name);
+}
+
+template <typename T>
+inline const DcelProperty<T>& Dcel::getHalfEdgeProperty(const std::string& name) const
+{
+    return halfEdgeProperties.get<T>(name);
+}
+
+inline bool Dcel::hasHalfEdgeProperty(const std::string& name) const
+{
+    return halfEdgeProperties.has(name);
+}
+
+inline bool Dcel::removeHalfEdgeProperty(const std::string& name)
+{
+    return halfEdgeProperties.remove(name);
+}
+
+/**
+ * @brief Dcel::addFaceProperty
+ * Adds to the faces a property with the given name and type: see
+ * Dcel::addVertexProperty.
+ */
+template <typename T>
+inline DcelProperty<T>& Dcel::addFaceProperty(const std::string& name, const T& defaultValue)
+{
+    return faceProperties.add<T>(name, (unsigned int)faces.size(), defaultValue);
+}
+
+template <typename T>
+inline DcelProperty<T>& Dcel::getFaceProperty(const std::string& name)
+{
+    return faceProperties.get<T>(name);
+}
+
+template <typename T>
+inline const DcelProperty<T>& Dcel::getFaceProperty(const std::string& name) const
+{
+    return faceProperties.get<T>(name);
+}
+
+inline bool Dcel::hasFaceProperty(const std::string& name) const
+{
+    return faceProperties.has(name);
+}
+
+inline bool Dcel::removeFaceProperty(const std::string& name)
+{
+    return faceProperties.remove(name);
+}
+
 inline void swap(Dcel& d1, Dcel& d2)
 {
     d1.swap(d2);
@@ -0,0 +1,230 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_DCEL_PROPERTIES_H
+#define CG3_DCEL_PROPERTIES_H
+
+#include <array>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cg3/geometry/point.h>
+#include <cg3/geometry/2d/point2d.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3meshes
+ * @brief The DcelPropertyTraits class gives the name of the type of the values
+ * of a DcelProperty, that is saved with the values by Dcel::serialize and
+ * checked by Dcel::deserialize. The name depends only on the type, and not on
+ * the compiler, so files can be exchanged between different builds.
+ *
+ * A specialization provides a static typeName() function. The library
+ * specializes the traits for the arithmetic types, std::string, Color, Point,
+ * Point2D, std::vector, std::array and std::pair; a property of another type
+ * needs a specialization:
+ *
+ * \code{.cpp}
+ * namespace cg3 {
+ * template <>
+ * struct DcelPropertyTraits<MyLabel>
+ * {
+ *     static std::string typeName() { return "MyLabel"; }
+ * };
+ * }
+ * \endcode
+ */
+template <typename T>
+struct DcelPropertyTraits;
+
+#define CG3_DCEL_PROPERTY_TYPE_NAME(T) \
+    template <> \
+    struct DcelPropertyTraits<T> \
+    { \
+        static std::string typeName() { return #T; } \
+    };
+
+CG3_DCEL_PROPERTY_TYPE_NAME(bool)
+CG3_DCEL_PROPERTY_TYPE_NAME(char)
+CG3_DCEL_PROPERTY_TYPE_NAME(unsigned char)
+CG3_DCEL_PROPERTY_TYPE_NAME(short)
+CG3_DCEL_PROPERTY_TYPE_NAME(unsigned short)
+CG3_DCEL_PROPERTY_TYPE_NAME(int)
+CG3_DCEL_PROPERTY_TYPE_NAME(unsigned int)
+CG3_DCEL_PROPERTY_TYPE_NAME(long)
+CG3_DCEL_PROPERTY_TYPE_NAME(unsigned long)
+CG3_DCEL_PROPERTY_TYPE_NAME(long long)
+CG3_DCEL_PROPERTY_TYPE_NAME(unsigned long long)
+CG3_DCEL_PROPERTY_TYPE_NAME(float)
+CG3_DCEL_PROPERTY_TYPE_NAME(double)
+CG3_DCEL_PROPERTY_TYPE_NAME(std::string)
+CG3_DCEL_PROPERTY_TYPE_NAME(Color)
+
+#undef CG3_DCEL_PROPERTY_TYPE_NAME
+
+template <typename T>
+struct DcelPropertyTraits<Point<T>>
+{
+    static std::string typeName();
+};
+
+template <typename T>
+struct DcelPropertyTraits<Point2D<T>>
+{
+    static std::string typeName();
+};
+
+template <typename T>
+struct DcelPropertyTraits<std::vector<T>>
+{
+    static std::string typeName();
+};
+
+template <typename T, std::size_t N>
+struct DcelPropertyTraits<std::array<T, N>>
+{
+    static std::string typeName();
+};
+
+template <typename T1, typename T2>
+struct DcelPropertyTraits<std::pair<T1, T2>>
+{
+    static std::string typeName();
+};
+
+template <typename T>
+class DcelProperty;
+
+namespace internal {
+
+/**
+ * @brief Type erased interface of the property arrays of a Dcel.
+ */
+class DcelPropertyBase
+{
+public:
+    virtual ~DcelPropertyBase() {}
+
+    virtual DcelPropertyBase* clone() const = 0;
+    virtual void resize(unsigned int n) = 0;
+    virtual void reset(unsigned int id) = 0;
+    virtual void compact(const std::vector<unsigned int>& oldIds) = 0;
+    virtual std::string typeName() const = 0;
+    virtual void serialize(std::ofstream& binaryFile) const = 0;
+    virtual void deserialize(std::ifstream& binaryFile) = 0;
+};
+
+/**
+ * @brief The named property arrays of one type of element (vertices, half
+ * edges or faces) of a Dcel. All the arrays have the same size of the vector
+ * of elements of the Dcel, deleted elements included.
+ */
+class DcelPropertyContainer
+{
+public:
+    DcelPropertyContainer();
+    DcelPropertyContainer(const DcelPropertyContainer& other);
+    DcelPropertyContainer(DcelPropertyContainer&& other);
+    DcelPropertyContainer& operator=(DcelPropertyContainer other);
+
+    template <typename T>
+    DcelProperty<T>& add(const std::string& name, unsigned int size, const T& defaultValue);
+    template <typename T>
+    DcelProperty<T>& get(const std::string& name) const;
+    bool has(const std::string& name) const;
+    bool remove(const std::string& name);
+    bool empty() const;
+    std::vector<std::string> names() const;
+
+    void resize(unsigned int n);
+    void reset(unsigned int id);
+    void compact(const std::vector<unsigned int>& oldIds);
+    void clearValues();
+    DcelPropertyContainer emptyCopy() const;
+
+    void serialize(std::ofstream& binaryFile) const;
+    void deserialize(std::ifstream& binaryFile);
+
+    void swap(DcelPropertyContainer& other);
+
+private:
+    std::map<std::string, std::unique_ptr<DcelPropertyBase>> properties;
+};
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3meshes
+ * @brief The DcelProperty class is a typed array of values associated to the
+ * vertices, the half edges or the faces of a Dcel, indexed by element id.
+ *
+ * Properties are created and retrieved by name through the Dcel (see
+ * Dcel::addVertexProperty, Dcel::addHalfEdgeProperty, Dcel::addFaceProperty),
+ * which keeps them sized as the vector of its elements: when an element is
+ * added its value is set to the default value of the property, and
+ * Dcel::recalculateIds moves the values following the new ids. Values are
+ * stored contiguously, so they are cheaper to access than a std::map indexed by
+ * element pointers:
+ *
+ * \code{.cpp}
+ * cg3::DcelProperty<double>& curv = dcel.addVertexProperty<double>("curv");
+ * for (const cg3::Dcel::Vertex* v : dcel.vertexIterator())
+ *     curv[v] = computeCurvature(v);
+ * \endcode
+ *
+ * References returned by a property remain valid until an element of the same
+ * type is added to the Dcel. Properties are saved by Dcel::serialize, and
+ * therefore T must be serializable with cg3::serialize and must have a
+ * specialization of DcelPropertyTraits. The name of the type of every property
+ * is saved with its values: loading a property saved with another type fails.
+ */
+template <typename T>
+class DcelProperty : public internal::DcelPropertyBase
+{
+public:
+    typedef typename std::vector<T>::reference reference;
+    typedef typename std::vector<T>::const_reference const_reference;
+
+    DcelProperty(const T& defaultValue = T());
+
+    reference operator[](unsigned int id);
+    const_reference operator[](unsigned int id) const;
+    template <typename Element>
+    reference operator[](const Element* e);
+    template <typename Element>
+    const_reference operator[](const Element* e) const;
+
+    unsigned int size() const;
+    const T& getDefaultValue() const;
+    const std::vector<T>& getValues() const;
+    void fill(const T& value);
+
+    // DcelPropertyBase interface
+    internal::DcelPropertyBase* clone() const;
+    void resize(unsigned int n);
+    void reset(unsigned int id);
+    void compact(const std::vector<unsigned int>& oldIds);
+    std::string typeName() const;
+    void serialize(std::ofstream& binaryFile) const;
+    void deserialize(std::ifstream& binaryFile);
+
+private:
+    std::vector<T> values;
+    T defaultValue;
+};
+
+} //namespace cg3
+
+#include "dcel_properties_inline.tpp"
+
+#endif // CG3_DCEL_PROPERTIES_H
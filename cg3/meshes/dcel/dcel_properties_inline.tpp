@@ -0,0 +1,368 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "dcel_properties.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include <cg3/io/serialize.h>
+
+namespace cg3 {
+
+template <typename T>
+std::string DcelPropertyTraits<Point<T>>::typeName()
+{
+    return "Point<" + DcelPropertyTraits<T>::typeName() + ">";
+}
+
+template <typename T>
+std::string DcelPropertyTraits<Point2D<T>>::typeName()
+{
+    return "Point2D<" + DcelPropertyTraits<T>::typeName() + ">";
+}
+
+template <typename T>
+std::string DcelPropertyTraits<std::vector<T>>::typeName()
+{
+    return "std::vector<" + DcelPropertyTraits<T>::typeName() + ">";
+}
+
+template <typename T, std::size_t N>
+std::string DcelPropertyTraits<std::array<T, N>>::typeName()
+{
+    return "std::array<" + DcelPropertyTraits<T>::typeName() + ", " + std::to_string(N) + ">";
+}
+
+template <typename T1, typename T2>
+std::string DcelPropertyTraits<std::pair<T1, T2>>::typeName()
+{
+    return "std::pair<" + DcelPropertyTraits<T1>::typeName() + ", " +
+            DcelPropertyTraits<T2>::typeName() + ">";
+}
+
+namespace internal {
+
+inline DcelPropertyContainer::DcelPropertyContainer()
+{
+}
+
+inline DcelPropertyContainer::DcelPropertyContainer(const DcelPropertyContainer& other)
+{
+    for (const auto& p : other.properties)
+        properties[p.first] = std::unique_ptr<DcelPropertyBase>(p.second->clone());
+}
+
+inline DcelPropertyContainer::DcelPropertyContainer(DcelPropertyContainer&& other) :
+    properties(std::move(other.properties))
+{
+}
+
+inline DcelPropertyContainer& DcelPropertyContainer::operator=(DcelPropertyContainer other)
+{
+    swap(other);
+    return *this;
+}
+
+/**
+ * @brief DcelPropertyContainer::add
+ * Adds a property with the given name and size. If a property with the same
+ * name and type already exists, it is returned unchanged.
+ * @throws std::invalid_argument if a property with the same name and a
+ * different type exists
+ */
+template <typename T>
+DcelProperty<T>& DcelPropertyContainer::add(
+        const std::string& name,
+        unsigned int size,
+        const T& defaultValue)
+{
+    auto it = properties.find(name);
+    if (it != properties.end())
+        return get<T>(name);
+    DcelProperty<T>* p = new DcelProperty<T>(defaultValue);
+    p->resize(size);
+    properties[name] = std::unique_ptr<DcelPropertyBase>(p);
+    return *p;
+}
+
+/**
+ * @brief DcelPropertyContainer::get
+ * @throws std::out_of_range if there is not a property with the given name,
+ * std::invalid_argument if its type is not T
+ */
+template <typename T>
+DcelProperty<T>& DcelPropertyContainer::get(const std::string& name) const
+{
+    auto it = properties.find(name);
+    if (it == properties.end())
+        throw std::out_of_range("Dcel property " + name + " does not exist");
+    DcelProperty<T>* p = dynamic_cast<DcelProperty<T>*>(it->second.get());
+    if (p == nullptr)
+        throw std::invalid_argument("Dcel property " + name + " has a different type");
+    return *p;
+}
+
+inline bool DcelPropertyContainer::has(const std::string& name) const
+{
+    return properties.find(name) != properties.end();
+}
+
+inline bool DcelPropertyContainer::remove(const std::string& name)
+{
+    return properties.erase(name) > 0;
+}
+
+inline bool DcelPropertyContainer::empty() const
+{
+    return properties.empty();
+}
+
+inline std::vector<std::string> DcelPropertyContainer::names() const
+{
+    std::vector<std::string> n;
+    for (const auto& p : properties)
+        n.push_back(p.first);
+    return n;
+}
+
+inline void DcelPropertyContainer::resize(unsigned int n)
+{
+    for (auto& p : properties)
+        p.second->resize(n);
+}
+
+/**
+ * @brief DcelPropertyContainer::reset
+ * Sets to the default value the values of the element id in all the
+ * properties, called when an id is reused.
+ */
+inline void DcelPropertyContainer::reset(unsigned int id)
+{
+    for (auto& p : properties)
+        p.second->reset(id);
+}
+
+/**
+ * @brief DcelPropertyContainer::compact
+ * Moves the values following a renumbering of the elements: the element with
+ * new id i had id oldIds[i].
+ */
+inline void DcelPropertyContainer::compact(const std::vector<unsigned int>& oldIds)
+{
+    for (auto& p : properties)
+        p.second->compact(oldIds);
+}
+
+/**
+ * @brief DcelPropertyContainer::clearValues
+ * Removes the values of all the properties, which remain in the container.
+ */
+inline void DcelPropertyContainer::clearValues()
+{
+    resize(0);
+}
+
+/**
+ * @brief DcelPropertyContainer::emptyCopy
+ * @return a container with the same properties and no values
+ */
+inline DcelPropertyContainer DcelPropertyContainer::emptyCopy() const
+{
+    DcelPropertyContainer c;
+    for (const auto& p : properties) {
+        DcelPropertyBase* e = p.second->clone();
+        e->resize(0);
+        c.properties[p.first] = std::unique_ptr<DcelPropertyBase>(e);
+    }
+    return c;
+}
+
+/**
+ * @brief DcelPropertyContainer::serialize
+ * Every property is saved with its name, the name of its type and the size
+ * in bytes of its values, so that properties that are not registered when
+ * deserializing can be skipped.
+ */
+inline void DcelPropertyContainer::serialize(std::ofstream& binaryFile) const
+{
+    cg3::serialize((unsigned int)properties.size(), binaryFile);
+    for (const auto& p : properties) {
+        cg3::serialize(p.first, binaryFile);
+        cg3::serialize(p.second->typeName(), binaryFile);
+        long long size = 0;
+        std::streampos sizePos = binaryFile.tellp();
+        cg3::serialize(size, binaryFile);
+        std::streampos begin = binaryFile.tellp();
+        p.second->serialize(binaryFile);
+        std::streampos end = binaryFile.tellp();
+        size = (long long)(end - begin);
+        binaryFile.seekp(sizePos);
+        cg3::serialize(size, binaryFile);
+        binaryFile.seekp(end);
+    }
+}
+
+/**
+ * @brief DcelPropertyContainer::deserialize
+ * Loads the values of the saved properties that are in the container, and
+ * skips the other ones.
+ * @throws std::ios_base::failure if a saved property is in the container
+ * with a different type
+ */
+inline void DcelPropertyContainer::deserialize(std::ifstream& binaryFile)
+{
+    unsigned int n;
+    cg3::deserialize(n, binaryFile);
+    for (unsigned int i = 0; i < n; i++) {
+        std::string name, type;
+        long long size;
+        cg3::deserialize(name, binaryFile);
+        cg3::deserialize(type, binaryFile);
+        cg3::deserialize(size, binaryFile);
+        auto it = properties.find(name);
+        if (it != properties.end() && it->second->typeName() != type)
+            throw std::ios_base::failure("Mismatching type of Dcel property " + name);
+        if (it != properties.end())
+            it->second->deserialize(binaryFile);
+        else
+            binaryFile.seekg(size, std::ios_base::cur);
+    }
+}
+
+inline void DcelPropertyContainer::swap(DcelPropertyContainer& other)
+{
+    properties.swap(other.properties);
+}
+
+} //namespace cg3::internal
+
+template <typename T>
+DcelProperty<T>::DcelProperty(const T& defaultValue) :
+    defaultValue(defaultValue)
+{
+}
+
+template <typename T>
+typename DcelProperty<T>::reference DcelProperty<T>::operator[](unsigned int id)
+{
+    assert(id < values.size());
+    return values[id];
+}
+
+template <typename T>
+typename DcelProperty<T>::const_reference DcelProperty<T>::operator[](unsigned int id) const
+{
+    assert(id < values.size());
+    return values[id];
+}
+
+/**
+ * @brief DcelProperty::operator []
+ * @param e: a vertex, an half edge or a face, depending on the property
+ * @return the value of e
+ */
+template <typename T>
+template <typename Element>
+typename DcelProperty<T>::reference DcelProperty<T>::operator[](const Element* e)
+{
+    return (*this)[e->getId()];
+}
+
+template <typename T>
+template <typename Element>
+typename DcelProperty<T>::const_reference DcelProperty<T>::operator[](const Element* e) const
+{
+    return (*this)[e->getId()];
+}
+
+/**
+ * @brief DcelProperty::size
+ * @return the number of values, equal to the number of ids of the elements
+ * (deleted elements included)
+ */
+template <typename T>
+unsigned int DcelProperty<T>::size() const
+{
+    return (unsigned int)values.size();
+}
+
+template <typename T>
+const T& DcelProperty<T>::getDefaultValue() const
+{
+    return defaultValue;
+}
+
+/**
+ * @brief DcelProperty::getValues
+ * @return the contiguous vector of values, indexed by element id
+ */
+template <typename T>
+const std::vector<T>& DcelProperty<T>::getValues() const
+{
+    return values;
+}
+
+template <typename T>
+void DcelProperty<T>::fill(const T& value)
+{
+    std::fill(values.begin(), values.end(), value);
+}
+
+template <typename T>
+internal::DcelPropertyBase* DcelProperty<T>::clone() const
+{
+    return new DcelProperty<T>(*this);
+}
+
+template <typename T>
+void DcelProperty<T>::resize(unsigned int n)
+{
+    values.resize(n, defaultValue);
+}
+
+template <typename T>
+void DcelProperty<T>::reset(unsigned int id)
+{
+    values[id] = defaultValue;
+}
+
+template <typename T>
+void DcelProperty<T>::compact(const std::vector<unsigned int>& oldIds)
+{
+    for (unsigned int i = 0; i < oldIds.size(); i++)
+        if (oldIds[i] != i)
+            values[i] = std::move(values[oldIds[i]]);
+    values.resize(oldIds.size());
+}
+
+/**
+ * @brief DcelProperty::typeName
+ * @return the name of T given by DcelPropertyTraits, saved with the values
+ */
+template <typename T>
+std::string DcelProperty<T>::typeName() const
+{
+    return DcelPropertyTraits<T>::typeName();
+}
+
+template <typename T>
+void DcelProperty<T>::serialize(std::ofstream& binaryFile) const
+{
+    cg3::serialize(values, binaryFile);
+    cg3::serialize(defaultValue, binaryFile);
+}
+
+template <typename T>
+void DcelProperty<T>::deserialize(std::ifstream& binaryFile)
+{
+    cg3::deserialize(values, binaryFile);
+    cg3::deserialize(defaultValue, binaryFile);
+}
+
+} //namespace cg3
@@ -0,0 +1,143 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_DCEL_SELECTION_H
+#define CG3_DCEL_SELECTION_H
+
+#include <cg3/utilities/dynamic_bitset.h>
+
+#include "dcel.h"
+
+namespace cg3 {
+
+namespace internal {
+
+template <typename Element>
+struct DcelSelectionTraits;
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3meshes
+ * @brief The DcelSelection class is a set of vertices, half edges or faces of
+ * a Dcel, stored as a bitset indexed by element id.
+ *
+ * Insertions, erasures and membership tests are constant time bit operations,
+ * and union, intersection, difference and count work on 64 elements at a
+ * time. Unlike the flag of the elements, any number of selections can be used
+ * at the same time, also by different threads. Use the typedefs
+ * DcelVertexSelection, DcelHalfEdgeSelection and DcelFaceSelection:
+ *
+ * \code{.cpp}
+ * cg3::DcelFaceSelection sel(dcel);
+ * sel.insert(f);
+ * cg3::DcelFaceSelection region = dcelAlgorithms::growRegion(sel, comp);
+ * for (const cg3::Dcel::Face* f : region - sel)
+ *     ...
+ * \endcode
+ *
+ * The elements of a selection are visited in increasing order of id. A
+ * selection refers to the Dcel it has been built from, and its elements must
+ * not be deleted while they are in the selection. After adding elements to
+ * the Dcel, they can be inserted directly: the selection grows as needed.
+ * Binary operators require selections of the same Dcel.
+ */
+template <typename Element>
+class DcelSelection
+{
+public:
+    class ConstIterator;
+    typedef ConstIterator const_iterator;
+    typedef ConstIterator iterator;
+
+    DcelSelection();
+    DcelSelection(const Dcel& dcel);
+    template <typename InputIterator>
+    DcelSelection(const Dcel& dcel, InputIterator first, InputIterator last);
+
+    bool insert(const Element* e);
+    bool erase(const Element* e);
+    bool contains(const Element* e) const;
+    bool containsId(unsigned int id) const;
+    unsigned int size() const;
+    bool empty() const;
+    void clear();
+    void selectAll();
+    void invert();
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    const Dcel* getDcel() const;
+    const DynamicBitset& getBitset() const;
+
+    DcelSelection& operator&=(const DcelSelection& other);
+    DcelSelection& operator|=(const DcelSelection& other);
+    DcelSelection& operator^=(const DcelSelection& other);
+    DcelSelection& operator-=(const DcelSelection& other);
+    bool operator==(const DcelSelection& other) const;
+    bool operator!=(const DcelSelection& other) const;
+
+    void swap(DcelSelection& other);
+
+protected:
+    typedef internal::DcelSelectionTraits<Element> Traits;
+
+    void fitSize(unsigned int size);
+    const DynamicBitset& alignedBits(const DcelSelection& other, DynamicBitset& tmp);
+
+    const Dcel* dcel;
+    DynamicBitset bits;
+};
+
+/**
+ * @brief Forward iterator on the elements of a DcelSelection.
+ */
+template <typename Element>
+class DcelSelection<Element>::ConstIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef const Element* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Element* const* pointer;
+    typedef const Element* reference;
+
+    ConstIterator();
+    ConstIterator(const Dcel* dcel, const DynamicBitset::ConstIterator& it);
+
+    const Element* operator*() const;
+    ConstIterator& operator++();
+    ConstIterator operator++(int);
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+
+private:
+    const Dcel* dcel;
+    DynamicBitset::ConstIterator it;
+};
+
+typedef DcelSelection<Dcel::Vertex> DcelVertexSelection;
+typedef DcelSelection<Dcel::HalfEdge> DcelHalfEdgeSelection;
+typedef DcelSelection<Dcel::Face> DcelFaceSelection;
+
+template <typename Element>
+DcelSelection<Element> operator&(DcelSelection<Element> a, const DcelSelection<Element>& b);
+template <typename Element>
+DcelSelection<Element> operator|(DcelSelection<Element> a, const DcelSelection<Element>& b);
+template <typename Element>
+DcelSelection<Element> operator^(DcelSelection<Element> a, const DcelSelection<Element>& b);
+template <typename Element>
+DcelSelection<Element> operator-(DcelSelection<Element> a, const DcelSelection<Element>& b);
+
+template <typename Element>
+void swap(DcelSelection<Element>& a, DcelSelection<Element>& b);
+
+} //namespace cg3
+
+#include "dcel_selection_inline.tpp"
+
+#endif // CG3_DCEL_SELECTION_H
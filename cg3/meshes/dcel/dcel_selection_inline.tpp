@@ -0,0 +1,369 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "dcel_selection.h"
+
+namespace cg3 {
+
+namespace internal {
+
+template <>
+struct DcelSelectionTraits<Dcel::Vertex>
+{
+    static unsigned int numberIds(const Dcel& d) { return d.getNumberVertexIds(); }
+    static const Dcel::Vertex* get(const Dcel& d, unsigned int id) { return d.getVertex(id); }
+};
+
+template <>
+struct DcelSelectionTraits<Dcel::HalfEdge>
+{
+    static unsigned int numberIds(const Dcel& d) { return d.getNumberHalfEdgeIds(); }
+    static const Dcel::HalfEdge* get(const Dcel& d, unsigned int id) { return d.getHalfEdge(id); }
+};
+
+template <>
+struct DcelSelectionTraits<Dcel::Face>
+{
+    static unsigned int numberIds(const Dcel& d) { return d.getNumberFaceIds(); }
+    static const Dcel::Face* get(const Dcel& d, unsigned int id) { return d.getFace(id); }
+};
+
+} //namespace cg3::internal
+
+/* ----- DcelSelection ----- */
+
+template <typename Element>
+DcelSelection<Element>::DcelSelection() :
+    dcel(nullptr)
+{
+}
+
+/**
+ * @brief DcelSelection::DcelSelection
+ * Creates an empty selection of the elements of dcel.
+ */
+template <typename Element>
+DcelSelection<Element>::DcelSelection(const Dcel& dcel) :
+    dcel(&dcel),
+    bits(Traits::numberIds(dcel))
+{
+}
+
+/**
+ * @brief DcelSelection::DcelSelection
+ * Creates a selection of the elements of dcel in the range [first, last).
+ */
+template <typename Element>
+template <typename InputIterator>
+DcelSelection<Element>::DcelSelection(const Dcel& dcel, InputIterator first, InputIterator last) :
+    DcelSelection(dcel)
+{
+    for (; first != last; ++first)
+        insert(*first);
+}
+
+/**
+ * @brief DcelSelection::insert
+ * @return true if e was not in the selection
+ */
+template <typename Element>
+bool DcelSelection<Element>::insert(const Element* e)
+{
+    unsigned int id = e->getId();
+    if (id >= bits.size())
+        fitSize(id + 1);
+    return !bits.testAndSet(id);
+}
+
+/**
+ * @brief DcelSelection::erase
+ * @return true if e was in the selection
+ */
+template <typename Element>
+bool DcelSelection<Element>::erase(const Element* e)
+{
+    if (!contains(e))
+        return false;
+    bits.reset(e->getId());
+    return true;
+}
+
+template <typename Element>
+bool DcelSelection<Element>::contains(const Element* e) const
+{
+    return containsId(e->getId());
+}
+
+template <typename Element>
+bool DcelSelection<Element>::containsId(unsigned int id) const
+{
+    return id < bits.size() && bits.test(id);
+}
+
+/**
+ * @brief DcelSelection::size
+ * @return the number of selected elements
+ */
+template <typename Element>
+unsigned int DcelSelection<Element>::size() const
+{
+    return (unsigned int)bits.count();
+}
+
+template <typename Element>
+bool DcelSelection<Element>::empty() const
+{
+    return bits.none();
+}
+
+template <typename Element>
+void DcelSelection<Element>::clear()
+{
+    bits.resetAll();
+}
+
+/**
+ * @brief DcelSelection::selectAll
+ * Selects all the elements of the Dcel.
+ */
+template <typename Element>
+void DcelSelection<Element>::selectAll()
+{
+    fitSize(Traits::numberIds(*dcel));
+    for (unsigned int id = 0; id < bits.size(); id++)
+        bits.set(id, Traits::get(*dcel, id) != nullptr);
+}
+
+/**
+ * @brief DcelSelection::invert
+ * Selects the elements of the Dcel that are not selected, and deselects the
+ * selected ones.
+ */
+template <typename Element>
+void DcelSelection<Element>::invert()
+{
+    fitSize(Traits::numberIds(*dcel));
+    bits.flipAll();
+    for (unsigned int id = 0; id < bits.size(); id++)
+        if (Traits::get(*dcel, id) == nullptr)
+            bits.reset(id);
+}
+
+template <typename Element>
+typename DcelSelection<Element>::ConstIterator DcelSelection<Element>::begin() const
+{
+    return ConstIterator(dcel, bits.begin());
+}
+
+template <typename Element>
+typename DcelSelection<Element>::ConstIterator DcelSelection<Element>::end() const
+{
+    return ConstIterator(dcel, bits.end());
+}
+
+template <typename Element>
+const Dcel* DcelSelection<Element>::getDcel() const
+{
+    return dcel;
+}
+
+/**
+ * @brief DcelSelection::getBitset
+ * @return the bitset of the selection: the bit i is set if the element with
+ * id i is selected
+ */
+template <typename Element>
+const DynamicBitset& DcelSelection<Element>::getBitset() const
+{
+    return bits;
+}
+
+template <typename Element>
+DcelSelection<Element>& DcelSelection<Element>::operator&=(const DcelSelection& other)
+{
+    assert(dcel == other.dcel);
+    DynamicBitset tmp;
+    bits &= alignedBits(other, tmp);
+    return *this;
+}
+
+template <typename Element>
+DcelSelection<Element>& DcelSelection<Element>::operator|=(const DcelSelection& other)
+{
+    assert(dcel == other.dcel);
+    DynamicBitset tmp;
+    bits |= alignedBits(other, tmp);
+    return *this;
+}
+
+template <typename Element>
+DcelSelection<Element>& DcelSelection<Element>::operator^=(const DcelSelection& other)
+{
+    assert(dcel == other.dcel);
+    DynamicBitset tmp;
+    bits ^= alignedBits(other, tmp);
+    return *this;
+}
+
+/**
+ * @brief DcelSelection::operator -=
+ * Removes from the selection the elements selected in other.
+ */
+template <typename Element>
+DcelSelection<Element>& DcelSelection<Element>::operator-=(const DcelSelection& other)
+{
+    assert(dcel == other.dcel);
+    DynamicBitset tmp;
+    bits -= alignedBits(other, tmp);
+    return *this;
+}
+
+template <typename Element>
+bool DcelSelection<Element>::operator==(const DcelSelection& other) const
+{
+    if (dcel != other.dcel)
+        return false;
+    if (bits.size() == other.bits.size())
+        return bits == other.bits;
+    DcelSelection a(*this);
+    DynamicBitset tmp;
+    const DynamicBitset& b = a.alignedBits(other, tmp);
+    return a.bits == b;
+}
+
+template <typename Element>
+bool DcelSelection<Element>::operator!=(const DcelSelection& other) const
+{
+    return !(*this == other);
+}
+
+template <typename Element>
+void DcelSelection<Element>::swap(DcelSelection& other)
+{
+    std::swap(dcel, other.dcel);
+    bits.swap(other.bits);
+}
+
+/**
+ * @brief DcelSelection::fitSize
+ * Grows the bitset to size bits, if it is smaller.
+ */
+template <typename Element>
+void DcelSelection<Element>::fitSize(unsigned int size)
+{
+    if (bits.size() < size)
+        bits.resize(size);
+}
+
+/**
+ * @brief DcelSelection::alignedBits
+ * Grows the bitset of this selection to the size of the bitset of other, if it
+ * is smaller.
+ * @return the bitset of other if it has the same size of the bitset of this
+ * selection, otherwise tmp, set to a copy of the bitset of other grown to the
+ * same size
+ */
+template <typename Element>
+const DynamicBitset& DcelSelection<Element>::alignedBits(
+        const DcelSelection& other,
+        DynamicBitset& tmp)
+{
+    fitSize((unsigned int)other.bits.size());
+    if (other.bits.size() == bits.size())
+        return other.bits;
+    tmp = other.bits;
+    tmp.resize(bits.size());
+    return tmp;
+}
+
+/* ----- ConstIterator ----- */
+
+template <typename Element>
+DcelSelection<Element>::ConstIterator::ConstIterator() :
+    dcel(nullptr)
+{
+}
+
+template <typename Element>
+DcelSelection<Element>::ConstIterator::ConstIterator(
+        const Dcel* dcel,
+        const DynamicBitset::ConstIterator& it) :
+    dcel(dcel),
+    it(it)
+{
+}
+
+template <typename Element>
+const Element* DcelSelection<Element>::ConstIterator::operator*() const
+{
+    return internal::DcelSelectionTraits<Element>::get(*dcel, (unsigned int)*it);
+}
+
+template <typename Element>
+typename DcelSelection<Element>::ConstIterator& DcelSelection<Element>::ConstIterator::operator++()
+{
+    ++it;
+    return *this;
+}
+
+template <typename Element>
+typename DcelSelection<Element>::ConstIterator DcelSelection<Element>::ConstIterator::operator++(int)
+{
+    ConstIterator old = *this;
+    ++it;
+    return old;
+}
+
+template <typename Element>
+bool DcelSelection<Element>::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return it == other.it;
+}
+
+template <typename Element>
+bool DcelSelection<Element>::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return it != other.it;
+}
+
+/* ----- Non member functions ----- */
+
+template <typename Element>
+DcelSelection<Element> operator&(DcelSelection<Element> a, const DcelSelection<Element>& b)
+{
+    a &= b;
+    return a;
+}
+
+template <typename Element>
+DcelSelection<Element> operator|(DcelSelection<Element> a, const DcelSelection<Element>& b)
+{
+    a |= b;
+    return a;
+}
+
+template <typename Element>
+DcelSelection<Element> operator^(DcelSelection<Element> a, const DcelSelection<Element>& b)
+{
+    a ^= b;
+    return a;
+}
+
+template <typename Element>
+DcelSelection<Element> operator-(DcelSelection<Element> a, const DcelSelection<Element>& b)
+{
+    a -= b;
+    return a;
+}
+
+template <typename Element>
+void swap(DcelSelection<Element>& a, DcelSelection<Element>& b)
+{
+    a.swap(b);
+}
+
+} //namespace cg3
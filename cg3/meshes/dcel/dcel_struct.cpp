@@ -11,7 +11,11 @@
 #include <cg3/utilities/comparators.h>
 #include <cg3/utilities/utils.h>
 #include <cg3/utilities/const.h>
+#include <cg3/utilities/flat_hash_map.h>
+#include <cg3/utilities/parallel.h>
+#include <cg3/utilities/profiler.h>
 #include <cg3/io/load_save_file.h>
+#include <cg3/meshes/compact_trimesh/compact_trimesh.h>
 
 #ifdef  CG3_CGAL_DEFINED
 #include <cg3/cgal/triangulation.h>
@@ -54,6 +58,7 @@ Dcel::Dcel() :
  */
 Dcel::Dcel(const Dcel& dcel)
 {
+    CG3_PROFILE_SCOPE("Dcel::Dcel(const Dcel&)");
     this->unusedVids = dcel.unusedVids;
     this->unusedHeids = dcel.unusedHeids;
     this->unusedFids = dcel.unusedFids;
@@ -61,6 +66,9 @@ Dcel::Dcel(const Dcel& dcel)
     this->nHalfEdges = dcel.nHalfEdges;
     this->nFaces = dcel.nFaces;
     this->boundingBox = dcel.boundingBox;
+    this->vertexProperties = dcel.vertexProperties;
+    this->halfEdgeProperties = dcel.halfEdgeProperties;
+    this->faceProperties = dcel.faceProperties;
     std::map<const Dcel::Vertex*, Dcel::Vertex*> mapVertices;
     std::map<const Dcel::HalfEdge*, Dcel::HalfEdge*> mapHalfEdges;
     std::map<const Dcel::Face*, Dcel::Face*> mapFaces;
@@ -140,6 +148,9 @@ Dcel::Dcel(Dcel&& dcel)
     nHalfEdges = std::move(dcel.nHalfEdges);
     nFaces = std::move(dcel.nFaces);
     boundingBox = std::move(dcel.boundingBox);
+    vertexProperties = std::move(dcel.vertexProperties);
+    halfEdgeProperties = std::move(dcel.halfEdgeProperties);
+    faceProperties = std::move(dcel.faceProperties);
     #ifdef NDEBUG
     vertexCoordinates = std::move(dcel.vertexCoordinates);
     vertexNormals = std::move(dcel.vertexNormals);
@@ -159,15 +170,29 @@ Dcel::Dcel(Dcel&& dcel)
 
 }
 
+/**
+ * @brief Dcel::Dcel
+ * Builds a Dcel from a CompactTriMesh, keeping normals and colors. Vertices,
+ * half edges and faces take the same indices of the CompactTriMesh.
+ * @param mesh
+ */
+Dcel::Dcel(const CompactTriMesh& mesh)
+{
+    CG3_PROFILE_SCOPE("Dcel::Dcel(const CompactTriMesh&)");
+    copyFrom(mesh);
+}
+
 #ifdef  CG3_EIGENMESH_DEFINED
 Dcel::Dcel(const cg3::SimpleEigenMesh& eigenMesh)
 {
+    CG3_PROFILE_SCOPE("Dcel::Dcel(const SimpleEigenMesh&)");
     copyFrom(eigenMesh);
     updateVertexNormals();
 }
 
 Dcel::Dcel(const cg3::EigenMesh& eigenMesh)
 {
+    CG3_PROFILE_SCOPE("Dcel::Dcel(const EigenMesh&)");
     copyFrom(eigenMesh);
 }
 #endif // CG3_EIGNEMESH_DEFINED
@@ -275,6 +300,7 @@ double Dcel::getAverageHalfEdgesLength() const
  */
 void Dcel::saveOnObjFile(std::string fileNameObj) const
 {
+    CG3_PROFILE_SCOPE("Dcel::saveOnObjFile");
     std::vector<double> vertices;
     std::vector<double> verticesNormals;
     std::vector<int> faces;
@@ -305,6 +331,7 @@ void Dcel::saveOnObjFile(std::string fileNameObj) const
  */
 void Dcel::saveOnPlyFile(std::string fileNamePly) const
 {
+    CG3_PROFILE_SCOPE("Dcel::saveOnPlyFile");
     std::vector<double> vertices;
     std::vector<double> verticesNormals;
     std::vector<int> faces;
@@ -350,6 +377,7 @@ Dcel::Vertex *Dcel::addVertex(const Pointd& p, const Vec3& n, const Color& c)
     if (unusedVids.size() == 0) {
         last->setId(nVertices);
         vertices.push_back(last);
+        vertexProperties.resize(vertices.size());
         #ifdef NDEBUG
         vertexCoordinates.push_back(p);
         vertexNormals.push_back(n);
@@ -365,6 +393,7 @@ Dcel::Vertex *Dcel::addVertex(const Pointd& p, const Vec3& n, const Color& c)
         last->setId(vid);
         vertices[vid] = last;
         unusedVids.erase(vid);
+        vertexProperties.reset(vid);
         #ifdef NDEBUG
         vertexCoordinates[vid] = p;
         vertexNormals[vid] = n;
@@ -401,6 +430,7 @@ Dcel::HalfEdge* Dcel::addHalfEdge()
     if (unusedHeids.size() == 0){
         last->setId(nHalfEdges);
         halfEdges.push_back(last);
+        halfEdgeProperties.resize(halfEdges.size());
         //halfEdgeLinks.push_back({-1, -1, -1, -1, -1, -1});
     }
     else {
@@ -409,6 +439,7 @@ Dcel::HalfEdge* Dcel::addHalfEdge()
         halfEdges[heid] = last;
         //halfEdgeLinks[heid] = {-1, -1, -1, -1, -1, -1};
         unusedHeids.erase(heid);
+        halfEdgeProperties.reset(heid);
     }
     nHalfEdges++;
     return last;
@@ -435,6 +466,7 @@ Dcel::Face* Dcel::addFace(const Vec3& n, const Color& c)
     if (unusedFids.size() == 0){
         last->setId(nFaces);
         faces.push_back(last);
+        faceProperties.resize(faces.size());
         #ifdef NDEBUG
         faceNormals.push_back(n);
         faceColors.push_back(c);
@@ -448,6 +480,7 @@ Dcel::Face* Dcel::addFace(const Vec3& n, const Color& c)
         last->setId(fid);
         faces[fid] = last;
         unusedFids.erase(fid);
+        faceProperties.reset(fid);
         #ifdef NDEBUG
         faceNormals[fid] = n;
         faceColors[fid] = c;
@@ -602,10 +635,11 @@ bool Dcel::deleteFace(Face* f)
  */
 void Dcel::updateFaceNormals()
 {
-    FaceIterator fit;
-    for (fit = faceBegin(); fit != faceEnd(); ++fit){
-        (*fit)->updateArea();
-    }
+    CG3_PROFILE_SCOPE("Dcel::updateFaceNormals");
+    parallelFor((size_t)0, faces.size(), [&](size_t i){
+        if (faces[i] != nullptr)
+            faces[i]->updateArea();
+    });
 }
 
 /**
@@ -620,9 +654,11 @@ void Dcel::updateFaceNormals()
  */
 void Dcel::updateVertexNormals()
 {
-    VertexIterator vit;
-    for (vit = vertexBegin(); vit != vertexEnd(); ++vit)
-        (*vit)->updateNormal();
+    CG3_PROFILE_SCOPE("Dcel::updateVertexNormals");
+    parallelFor((size_t)0, vertices.size(), [&](size_t i){
+        if (vertices[i] != nullptr)
+            vertices[i]->updateNormal();
+    });
 }
 
 /**
@@ -634,6 +670,7 @@ void Dcel::updateVertexNormals()
  */
 BoundingBox Dcel::updateBoundingBox()
 {
+    CG3_PROFILE_SCOPE("Dcel::updateBoundingBox");
     boundingBox.reset();
     for (ConstVertexIterator vit = vertexBegin(); vit!=vertexEnd(); ++vit){
         Pointd coord = (*vit)->getCoordinate();
@@ -726,30 +763,65 @@ void Dcel::translate(const Pointd& c)
  */
 void Dcel::recalculateIds()
 {
-    nVertices = 0;
+    CG3_PROFILE_SCOPE("Dcel::recalculateIds");
+    std::vector<unsigned int> oldIds;
+
+    oldIds.clear();
     for (unsigned int i = 0; i < vertices.size(); i++){
-        vertices[nVertices] = vertices[i];
-        if (vertices[i] != nullptr) nVertices++;
+        if (vertices[i] != nullptr) {
+            vertices[oldIds.size()] = vertices[i];
+            #ifdef NDEBUG
+            vertexCoordinates[oldIds.size()] = vertexCoordinates[i];
+            vertexNormals[oldIds.size()] = vertexNormals[i];
+            vertexColors[oldIds.size()] = vertexColors[i];
+            #endif
+            vertices[oldIds.size()]->setId(oldIds.size());
+            oldIds.push_back(i);
+        }
     }
+    nVertices = oldIds.size();
     unusedVids.clear();
     vertices.resize(nVertices);
+    #ifdef NDEBUG
+    vertexCoordinates.resize(nVertices);
+    vertexNormals.resize(nVertices);
+    vertexColors.resize(nVertices);
+    #endif
+    vertexProperties.compact(oldIds);
 
-    nHalfEdges = 0;
+    oldIds.clear();
     for (unsigned int i = 0; i < halfEdges.size(); i++){
-        halfEdges[nHalfEdges] = halfEdges[i];
-        if (halfEdges[i] != nullptr) nHalfEdges++;
+        if (halfEdges[i] != nullptr) {
+            halfEdges[oldIds.size()] = halfEdges[i];
+            halfEdges[oldIds.size()]->setId(oldIds.size());
+            oldIds.push_back(i);
+        }
     }
+    nHalfEdges = oldIds.size();
     unusedHeids.clear();
     halfEdges.resize(nHalfEdges);
+    halfEdgeProperties.compact(oldIds);
 
-    nFaces = 0;
+    oldIds.clear();
     for (unsigned int i = 0; i < faces.size(); i++){
-        faces[nFaces] = faces[i];
-        if (faces[i] != nullptr) nFaces++;
+        if (faces[i] != nullptr) {
+            faces[oldIds.size()] = faces[i];
+            #ifdef NDEBUG
+            faceNormals[oldIds.size()] = faceNormals[i];
+            faceColors[oldIds.size()] = faceColors[i];
+            #endif
+            faces[oldIds.size()]->setId(oldIds.size());
+            oldIds.push_back(i);
+        }
     }
+    nFaces = oldIds.size();
     unusedFids.clear();
     faces.resize(nFaces);
-
+    #ifdef NDEBUG
+    faceNormals.resize(nFaces);
+    faceColors.resize(nFaces);
+    #endif
+    faceProperties.compact(oldIds);
 }
 
 /**
@@ -797,6 +869,9 @@ void Dcel::clear()
     nVertices = 0;
     nFaces = 0;
     nHalfEdges = 0;
+    vertexProperties.clearValues();
+    halfEdgeProperties.clearValues();
+    faceProperties.clearValues();
     #ifdef NDEBUG
     vertexCoordinates.clear();
     vertexNormals.clear();
@@ -831,7 +906,7 @@ unsigned int Dcel::triangulateFace(Dcel::Face* f)
         std::vector< std::vector<Pointd> > innerBorderCoordinates;
         std::map<std::pair<Dcel::Vertex*, Dcel::Vertex*> , Dcel::HalfEdge*> verticesEdgeMap;
         std::map<std::pair<Dcel::Vertex*, Dcel::Vertex*> , Dcel::HalfEdge*> twinsEdgeMap;
-        std::map<Pointd, Dcel::Vertex*> pointsVerticesMap;
+        FlatHashMap<Pointd, Dcel::Vertex*> pointsVerticesMap;
         for (Dcel::Face::IncidentHalfEdgeIterator heit = f->incidentHalfEdgeBegin(); heit != f->incidentHalfEdgeEnd(); ++heit){
             borderCoordinates.push_back((*heit)->getFromVertex()->getCoordinate());
             std::pair<Dcel::Vertex*, Dcel::Vertex*> pp;
@@ -1030,6 +1105,7 @@ bool Dcel::loadFromFile(const std::string& filename)
  */
 bool Dcel::loadFromObjFile(const std::string& filename)
 {
+    CG3_PROFILE_SCOPE("Dcel::loadFromObjFile");
     std::list<double> coords, vnorm;
     std::list<unsigned int> faces, fsizes;
     io::MeshType meshType;
@@ -1062,6 +1138,7 @@ bool Dcel::loadFromObjFile(const std::string& filename)
  */
 bool Dcel::loadFromPlyFile(const std::string& filename)
 {
+    CG3_PROFILE_SCOPE("Dcel::loadFromPlyFile");
     std::list<double> coords, vnorm;
     std::list<unsigned int> faces, fsizes;
     io::MeshType meshType;
@@ -1079,6 +1156,7 @@ bool Dcel::loadFromPlyFile(const std::string& filename)
 
 bool Dcel::loadFromDcelFile(const std::string& filename)
 {
+    CG3_PROFILE_SCOPE("Dcel::loadFromDcelFile");
     std::ifstream myfile;
     myfile.open (filename, std::ios::in | std::ios::binary);
     if (myfile.is_open()) {
@@ -1106,6 +1184,9 @@ void Dcel::swap(Dcel& d)
     std::swap(nHalfEdges, d.nHalfEdges);
     std::swap(nFaces, d.nFaces);
     std::swap(boundingBox, d.boundingBox);
+    vertexProperties.swap(d.vertexProperties);
+    halfEdgeProperties.swap(d.halfEdgeProperties);
+    faceProperties.swap(d.faceProperties);
 
     #ifdef NDEBUG
     std::swap(vertexCoordinates, d.vertexCoordinates);
@@ -1130,7 +1211,10 @@ void Dcel::swap(Dcel& d)
 
 void Dcel::serialize(std::ofstream& binaryFile) const
 {
-    cg3::serialize("cg3Dcel", binaryFile);
+    CG3_PROFILE_SCOPE("Dcel::serialize");
+    //files without properties keep the original format
+    bool hasProperties = !vertexProperties.empty() || !halfEdgeProperties.empty() || !faceProperties.empty();
+    cg3::serialize(hasProperties ? "cg3DcelProperties" : "cg3Dcel", binaryFile);
     //BB
     boundingBox.serialize(binaryFile);
     //N
@@ -1193,18 +1277,38 @@ void Dcel::serialize(std::ofstream& binaryFile) const
         }
 
     }
+    //Properties
+    if (hasProperties){
+        vertexProperties.serialize(binaryFile);
+        halfEdgeProperties.serialize(binaryFile);
+        faceProperties.serialize(binaryFile);
+    }
 }
 
+/**
+ * @brief Dcel::deserialize
+ * Loads a Dcel saved by Dcel::serialize, with the values of the properties
+ * already added to this Dcel. The colors of the vertices saved in the file are
+ * restored (they were read but discarded by older versions, that left every
+ * loaded vertex with the default color).
+ * @throws std::ios_base::failure if the file does not contain a valid Dcel: in
+ * this case, this Dcel is not modified
+ */
 void Dcel::deserialize(std::ifstream& binaryFile)
 {
+    CG3_PROFILE_SCOPE("Dcel::deserialize");
     int begin = binaryFile.tellg();
     Dcel tmp;
     try {
         std::string s;
         cg3::deserialize(s, binaryFile);
 
-        if (s != "cg3Dcel")
+        if (s != "cg3Dcel" && s != "cg3DcelProperties")
             throw std::ios_base::failure("Mismatching String: " + s + " != cg3Dcel");
+        //only the properties already added to this Dcel are loaded
+        tmp.vertexProperties = vertexProperties.emptyCopy();
+        tmp.halfEdgeProperties = halfEdgeProperties.emptyCopy();
+        tmp.faceProperties = faceProperties.emptyCopy();
         //BB
 
         tmp.boundingBox.deserialize(binaryFile);
@@ -1240,6 +1344,7 @@ void Dcel::deserialize(std::ifstream& binaryFile)
             v->setCardinality(c);
             v->setCoordinate(coord);
             v->setNormal(norm);
+            v->setColor(color); //the saved color, not the default one
             v->setFlag(f);
             vert[id] = heid;
         }
@@ -1310,6 +1415,15 @@ void Dcel::deserialize(std::ifstream& binaryFile)
             he->setFace(tmp.getFace(a[5]));
         }
 
+        tmp.vertexProperties.resize(tmp.vertices.size());
+        tmp.halfEdgeProperties.resize(tmp.halfEdges.size());
+        tmp.faceProperties.resize(tmp.faces.size());
+        if (s == "cg3DcelProperties"){
+            tmp.vertexProperties.deserialize(binaryFile);
+            tmp.halfEdgeProperties.deserialize(binaryFile);
+            tmp.faceProperties.deserialize(binaryFile);
+        }
+
         *this = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
@@ -1548,6 +1662,7 @@ void Dcel::afterLoadFile(
         const std::list<Color> &fcolor,
         const std::list<unsigned int> &fsizes)
 {
+    CG3_PROFILE_SCOPE("Dcel::afterLoadFile");
     std::vector<Vertex*> vertices;
 
     std::map< std::pair<int,int>, HalfEdge* > edge;
@@ -1651,6 +1766,43 @@ void Dcel::afterLoadFile(
         updateVertexNormals();
 }
 
+void Dcel::copyFrom(const CompactTriMesh& mesh)
+{
+    clear();
+    std::vector<Vertex*> meshVertices(mesh.getNumberVertices());
+    std::vector<HalfEdge*> meshHalfEdges(mesh.getNumberHalfEdges());
+    std::vector<Face*> meshFaces(mesh.getNumberFaces());
+    for (unsigned int v = 0; v < mesh.getNumberVertices(); v++)
+        meshVertices[v] = addVertex(mesh.getVertex(v), mesh.getVertexNormal(v), mesh.getVertexColor(v));
+    for (unsigned int he = 0; he < mesh.getNumberHalfEdges(); he++)
+        meshHalfEdges[he] = addHalfEdge();
+    for (unsigned int f = 0; f < mesh.getNumberFaces(); f++)
+        meshFaces[f] = addFace(mesh.getFaceNormal(f), mesh.getFaceColor(f));
+
+    parallelFor(0u, mesh.getNumberHalfEdges(), [&](unsigned int he) {
+        HalfEdge* e = meshHalfEdges[he];
+        e->setFromVertex(meshVertices[mesh.getFromVertex(he)]);
+        e->setToVertex(meshVertices[mesh.getToVertex(he)]);
+        e->setNext(meshHalfEdges[CompactTriMesh::getNext(he)]);
+        e->setPrev(meshHalfEdges[CompactTriMesh::getPrev(he)]);
+        e->setFace(meshFaces[CompactTriMesh::getFace(he)]);
+        if (!mesh.isBoundaryHalfEdge(he))
+            e->setTwin(meshHalfEdges[mesh.getTwin(he)]);
+    });
+    parallelFor(0u, mesh.getNumberFaces(), [&](unsigned int f) {
+        meshFaces[f]->setOuterHalfEdge(meshHalfEdges[CompactTriMesh::getHalfEdge(f, 0)]);
+        meshFaces[f]->updateArea();
+        meshFaces[f]->setNormal(mesh.getFaceNormal(f));
+    });
+    parallelFor(0u, mesh.getNumberVertices(), [&](unsigned int v) {
+        unsigned int he = mesh.getIncidentHalfEdge(v);
+        if (he != CompactTriMesh::NULL_ID)
+            meshVertices[v]->setIncidentHalfEdge(meshHalfEdges[he]);
+        meshVertices[v]->setCardinality(mesh.getCardinality(v));
+    });
+    boundingBox = mesh.getBoundingBox();
+}
+
 #ifdef  CG3_EIGENMESH_DEFINED
 void Dcel::copyFrom(const SimpleEigenMesh& eigenMesh)
 {
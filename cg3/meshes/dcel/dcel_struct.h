@@ -11,6 +11,8 @@
 #include <cg3/geometry/bounding_box.h>
 #include <cg3/utilities/color.h>
 
+#include "dcel_properties.h"
+
 #ifdef  CG3_EIGENMESH_DEFINED
 namespace cg3 {
     class SimpleEigenMesh;
@@ -24,6 +26,8 @@ namespace cg3 {
 
 namespace cg3 {
 
+class CompactTriMesh;
+
 /**
  * @class Dcel
  *
@@ -100,6 +104,7 @@ public:
     Dcel(const std::string& filename);
     Dcel(const Dcel& dcel);
     Dcel(Dcel&& dcel);
+    Dcel(const CompactTriMesh& mesh);
     #ifdef  CG3_EIGENMESH_DEFINED
     Dcel(const cg3::SimpleEigenMesh &eigenMesh);
     Dcel(const cg3::EigenMesh &eigenMesh);
@@ -120,6 +125,9 @@ public:
     inline unsigned int getNumberVertices()        const;
     inline unsigned int getNumberHalfEdges()       const;
     inline unsigned int getNumberFaces()           const;
+    inline unsigned int getNumberVertexIds()       const;
+    inline unsigned int getNumberHalfEdgeIds()     const;
+    inline unsigned int getNumberFaceIds()         const;
     inline ConstVertexIterator vertexBegin()       const;
     inline ConstVertexIterator vertexEnd()         const;
     inline ConstHalfEdgeIterator halfEdgeBegin()   const;
@@ -192,6 +200,47 @@ public:
 
     Dcel& operator= (Dcel dcel);
 
+    /******************
+    * Euler Operators *
+    *******************/
+
+    bool isEdgeFlippable(const HalfEdge* he)                const;
+    bool isEdgeCollapsible(const HalfEdge* he)              const;
+    bool flipEdge(HalfEdge* he);
+    Vertex* splitEdge(HalfEdge* he, const Pointd& p);
+    Vertex* splitFace(Face* f, const Pointd& p);
+    Vertex* collapseEdge(HalfEdge* he, const Pointd& p);
+    Vertex* splitVertex(Vertex* v, Vertex* vl, Vertex* vr, const Pointd& p);
+
+    /*************
+    * Properties *
+    **************/
+
+    template <typename T>
+    DcelProperty<T>& addVertexProperty(const std::string& name, const T& defaultValue = T());
+    template <typename T>
+    DcelProperty<T>& getVertexProperty(const std::string& name);
+    template <typename T>
+    const DcelProperty<T>& getVertexProperty(const std::string& name) const;
+    bool hasVertexProperty(const std::string& name)         const;
+    bool removeVertexProperty(const std::string& name);
+    template <typename T>
+    DcelProperty<T>& addHalfEdgeProperty(const std::string& name, const T& defaultValue = T());
+    template <typename T>
+    DcelProperty<T>& getHalfEdgeProperty(const std::string& name);
+    template <typename T>
+    const DcelProperty<T>& getHalfEdgeProperty(const std::string& name) const;
+    bool hasHalfEdgeProperty(const std::string& name)       const;
+    bool removeHalfEdgeProperty(const std::string& name);
+    template <typename T>
+    DcelProperty<T>& addFaceProperty(const std::string& name, const T& defaultValue = T());
+    template <typename T>
+    DcelProperty<T>& getFaceProperty(const std::string& name);
+    template <typename T>
+    const DcelProperty<T>& getFaceProperty(const std::string& name) const;
+    bool hasFaceProperty(const std::string& name)           const;
+    bool removeFaceProperty(const std::string& name);
+
     // SerializableObject interface
     void serialize(std::ofstream& binaryFile) const;
     void deserialize(std::ifstream& binaryFile);
@@ -212,6 +261,9 @@ protected:
     unsigned int            nHalfEdges;     /**< \~Italian @brief Prossimo id dell'half edge. */
     unsigned int            nFaces;         /**< \~Italian @brief Prossimo id della faccia. */
     BoundingBox             boundingBox;    /**< \~Italian @brief Bounding box della mesh. */
+    internal::DcelPropertyContainer vertexProperties;   /**< @brief Named property arrays of the vertices, indexed by id. */
+    internal::DcelPropertyContainer halfEdgeProperties; /**< @brief Named property arrays of the half edges, indexed by id. */
+    internal::DcelPropertyContainer faceProperties;     /**< @brief Named property arrays of the faces, indexed by id. */
 
     //Data
     #ifdef NDEBUG
@@ -231,10 +283,12 @@ protected:
     Face* addFace(int id);
 
     std::vector<const Vertex*> makeSingleBorder(const Face *f)     const;
+    void updateLocalAttributes(const std::vector<Face*>& changedFaces);
     void toStdVectors(std::vector<double> &vertices, std::vector<double> &verticesNormals, std::vector<int> &faces, std::vector<unsigned int> &faceSizes, std::vector<float> &faceColors) const;
 
     void afterLoadFile(const std::list<double>& coords, const std::list<unsigned int>& faces, int mode, const std::list<double>& vnorm, const std::list<Color>& vcolor, const std::list<Color>& fcolor, const std::list<unsigned int>& fsizes);
 
+    void copyFrom(const CompactTriMesh& mesh);
     #ifdef  CG3_EIGENMESH_DEFINED
     void copyFrom(const SimpleEigenMesh &eigenMesh);
     void copyFrom(const EigenMesh &eigenMesh);
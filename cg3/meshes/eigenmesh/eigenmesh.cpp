@@ -7,9 +7,12 @@
 
 #include "eigenmesh.h"
 #include <cg3/io/load_save_file.h>
+#include <cg3/utilities/parallel.h>
 
 #ifdef  CG3_DCEL_DEFINED
 #include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/dcel/algorithms/dcel_algorithms.h>
+#include <cg3/meshes/compact_trimesh/compact_trimesh.h>
 #endif
 
 #ifdef TRIMESH_DEFINED
@@ -54,35 +57,29 @@ EigenMesh::EigenMesh(
 #ifdef  CG3_DCEL_DEFINED
 EigenMesh::EigenMesh(const Dcel& dcel)
 {
-    clear();
-    V.resize(dcel.getNumberVertices(), 3);
-    F.resize(dcel.getNumberFaces(), 3);
+    *this = dcel;
+}
+
+EigenMesh::EigenMesh(const CompactTriMesh& mesh) :
+    SimpleEigenMesh(mesh)
+{
+    CV.resize(V.rows(), 3);
     CF.resize(F.rows(), 3);
-    updateVertexColorsSize();
     NV.resize(V.rows(), 3);
     NF.resize(F.rows(), 3);
-    std::map<int, int> vids;
-    bb = dcel.getBoundingBox();
-    unsigned int i = 0;
-    for (Dcel::ConstVertexIterator vit = dcel.vertexBegin(); vit != dcel.vertexEnd(); ++vit){
-        const Dcel::Vertex* v = *vit;
-        vids[v->getId()] = i;
-        Pointd p = v->getCoordinate();
-        Vec3 n = v->getNormal();
-        V(i,0) = p.x(); V(i,1) = p.y(); V(i,2) = p.z();
+    bb = mesh.getBoundingBox();
+    parallelFor(0u, mesh.getNumberVertices(), [&](unsigned int i) {
+        Vec3 n = mesh.getVertexNormal(i);
+        Color c = mesh.getVertexColor(i);
         NV(i,0) = n.x(); NV(i,1) = n.y(); NV(i,2) = n.z();
-        i++;
-    }
-    i = 0;
-    for (Dcel::ConstFaceIterator fit = dcel.faceBegin(); fit != dcel.faceEnd(); ++fit){
-        const Dcel::Face* f = *fit;
-        F(i, 0) = vids[f->getVertex1()->getId()]; F(i, 1) = vids[f->getVertex2()->getId()]; F(i, 2) = vids[f->getVertex3()->getId()];
-        Color c = f->getColor();
-        Vec3 n = f->getNormal();
-        CF(i,0) = c.redF(); CF(i,1) = c.greenF(); CF(i,2) = c.blueF();
+        CV(i,0) = c.redF(); CV(i,1) = c.greenF(); CV(i,2) = c.blueF();
+    });
+    parallelFor(0u, mesh.getNumberFaces(), [&](unsigned int i) {
+        Vec3 n = mesh.getFaceNormal(i);
+        Color c = mesh.getFaceColor(i);
         NF(i,0) = n.x(); NF(i,1) = n.y(); NF(i,2) = n.z();
-        i++;
-    }
+        CF(i,0) = c.redF(); CF(i,1) = c.greenF(); CF(i,2) = c.blueF();
+    });
 }
 #endif
 
@@ -241,8 +238,7 @@ void EigenMesh::updateFaceNormals()
     Eigen::Matrix<double,3,1> Z(0,0,0);
     NF.resize(F.rows(),3);
     int nf = F.rows();
-    //#pragma omp parallel for
-    for(int i = 0; i < nf; i++) {
+    parallelFor(0, nf, [&](int i) {
         const Eigen::Matrix<double, 1, 3, Eigen::RowMajor> v1 = V.row(F(i,1)) - V.row(F(i,0));
         const Eigen::Matrix<double, 1, 3, Eigen::RowMajor> v2 = V.row(F(i,2)) - V.row(F(i,0));
         Pointd p1(v1(0,0),v1(0,1),v1(0,2));
@@ -256,7 +252,7 @@ void EigenMesh::updateFaceNormals()
         else {
             NF.row(i) /= r;
         }
-    }
+    });
 }
 
 void EigenMesh::updateVerticesNormals()
@@ -359,37 +355,42 @@ EigenMesh EigenMesh::merge(const EigenMesh& m1, const EigenMesh& m2)
 }
 
 #ifdef  CG3_DCEL_DEFINED
+/**
+ * @brief EigenMesh::operator =
+ * Copies coordinates, normals and colors of the vertices and of the faces of
+ * a triangle Dcel. Vertices and faces are numbered following the order of
+ * their ids (see dcelAlgorithms::DenseIndex).
+ */
 EigenMesh& EigenMesh::operator=(const Dcel& dcel)
 {
     clear();
-    V.resize(dcel.getNumberVertices(), 3);
-    F.resize(dcel.getNumberFaces(), 3);
+    dcelAlgorithms::DenseIndex index(dcel);
+    V.resize(index.getNumberVertices(), 3);
+    F.resize(index.getNumberFaces(), 3);
+    CV.resize(V.rows(), 3);
     CF.resize(F.rows(), 3);
-    CV = Eigen::MatrixXf::Constant(V.rows(), 3, 0.5);
     NV.resize(V.rows(), 3);
     NF.resize(F.rows(), 3);
-    std::map<int, int> vids;
     bb = dcel.getBoundingBox();
-    unsigned int i = 0;
-    for (Dcel::ConstVertexIterator vit = dcel.vertexBegin(); vit != dcel.vertexEnd(); ++vit){
-        const Dcel::Vertex* v = *vit;
-        vids[v->getId()] = i;
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        const Dcel::Vertex* v = index.vertex(i);
         Pointd p = v->getCoordinate();
         Vec3 n = v->getNormal();
+        Color c = v->getColor();
         V(i,0) = p.x(); V(i,1) = p.y(); V(i,2) = p.z();
         NV(i,0) = n.x(); NV(i,1) = n.y(); NV(i,2) = n.z();
-        i++;
-    }
-    i = 0;
-    for (Dcel::ConstFaceIterator fit = dcel.faceBegin(); fit != dcel.faceEnd(); ++fit){
-        const Dcel::Face* f = *fit;
-        F(i, 0) = vids[f->getVertex1()->getId()]; F(i, 1) = vids[f->getVertex2()->getId()]; F(i, 2) = vids[f->getVertex3()->getId()];
+        CV(i,0) = c.redF(); CV(i,1) = c.greenF(); CV(i,2) = c.blueF();
+    });
+    parallelFor(0u, index.getNumberFaces(), [&](unsigned int i) {
+        const Dcel::Face* f = index.face(i);
+        F(i, 0) = index.vertexIndex(f->getVertex1());
+        F(i, 1) = index.vertexIndex(f->getVertex2());
+        F(i, 2) = index.vertexIndex(f->getVertex3());
         Color c = f->getColor();
         Vec3 n = f->getNormal();
         CF(i,0) = c.redF(); CF(i,1) = c.greenF(); CF(i,2) = c.blueF();
         NF(i,0) = n.x(); NF(i,1) = n.y(); NF(i,2) = n.z();
-        i++;
-    }
+    });
     return *this;
 }
 #endif
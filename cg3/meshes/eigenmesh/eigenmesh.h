@@ -43,6 +43,7 @@ public:
     EigenMesh(const Eigen::MatrixXd &V, const Eigen::MatrixXi &F, const Eigen::MatrixXf& CV, const Eigen::MatrixXf& CF);
     #ifdef  CG3_DCEL_DEFINED
     EigenMesh(const Dcel& dcel);
+    EigenMesh(const CompactTriMesh& mesh);
     #endif
     #ifdef TRIMESH_DEFINED
     template<typename T>
@@ -8,9 +8,12 @@
 #include "simpleeigenmesh.h"
 
 #include <cg3/io/load_save_file.h>
+#include <cg3/utilities/parallel.h>
 
 #ifdef  CG3_DCEL_DEFINED
 #include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/dcel/algorithms/dcel_algorithms.h>
+#include <cg3/meshes/compact_trimesh/compact_trimesh.h>
 #endif
 
 #ifdef TRIMESH_DEFINED
@@ -23,23 +26,27 @@ namespace cg3 {
 SimpleEigenMesh::SimpleEigenMesh(const Dcel& dcel)
 {
     clear();
-    V.resize(dcel.getNumberVertices(), 3);
-    F.resize(dcel.getNumberFaces(), 3);
-    std::map<int, int> vids;
-    unsigned int i = 0;
-    for (Dcel::ConstVertexIterator vit = dcel.vertexBegin(); vit != dcel.vertexEnd(); ++vit){
-        const Dcel::Vertex* v = *vit;
-        vids[v->getId()] = i;
-        Pointd p = v->getCoordinate();
+    dcelAlgorithms::DenseIndex index(dcel);
+    V.resize(index.getNumberVertices(), 3);
+    F.resize(index.getNumberFaces(), 3);
+    parallelFor(0u, index.getNumberVertices(), [&](unsigned int i) {
+        Pointd p = index.vertex(i)->getCoordinate();
         V(i,0) = p.x(); V(i,1) = p.y(); V(i,2) = p.z();
-        i++;
-    }
-    i = 0;
-    for (Dcel::ConstFaceIterator fit = dcel.faceBegin(); fit != dcel.faceEnd(); ++fit){
-        const Dcel::Face* f = *fit;
-        F(i, 0) = vids[f->getVertex1()->getId()]; F(i, 1) = vids[f->getVertex2()->getId()]; F(i, 2) = vids[f->getVertex3()->getId()];
-        i++;
-    }
+    });
+    parallelFor(0u, index.getNumberFaces(), [&](unsigned int i) {
+        const Dcel::Face* f = index.face(i);
+        F(i, 0) = index.vertexIndex(f->getVertex1());
+        F(i, 1) = index.vertexIndex(f->getVertex2());
+        F(i, 2) = index.vertexIndex(f->getVertex3());
+    });
+}
+
+SimpleEigenMesh::SimpleEigenMesh(const CompactTriMesh& mesh)
+{
+    V.resize(mesh.getNumberVertices(), 3);
+    F.resize(mesh.getNumberFaces(), 3);
+    std::copy(mesh.getCoordinates().begin(), mesh.getCoordinates().end(), V.data());
+    std::copy(mesh.getTriangles().begin(), mesh.getTriangles().end(), F.data());
 }
 #endif // CG3_DCEL_DEFINED
 
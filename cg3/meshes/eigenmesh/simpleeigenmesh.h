@@ -34,6 +34,7 @@ class EigenMeshLibIglAlgorithms;
 
 #ifdef  CG3_DCEL_DEFINED
 class Dcel;
+class CompactTriMesh;
 #endif
 
 #ifdef TRIMESH_DEFINED
@@ -57,6 +58,7 @@ public:
     template <typename T, typename U> SimpleEigenMesh(const Eigen::PlainObjectBase<T> &V, const Eigen::PlainObjectBase<U> &F);
     #ifdef  CG3_DCEL_DEFINED
     SimpleEigenMesh(const Dcel& dcel);
+    SimpleEigenMesh(const CompactTriMesh& mesh);
     #endif
     #ifdef TRIMESH_DEFINED
     template<typename T> SimpleEigenMesh(const Trimesh<T>& trimesh);
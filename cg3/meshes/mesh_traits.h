@@ -0,0 +1,170 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_MESH_TRAITS_H
+#define CG3_MESH_TRAITS_H
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include <cg3/geometry/bounding_box.h>
+#include <cg3/geometry/point.h>
+#include <cg3/meshes/dcel/dcel.h>
+#include <cg3/meshes/compact_trimesh/compact_trimesh.h>
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/eigenmesh.h>
+#endif
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3meshes
+ * @brief The MeshTraits class describes how a generic algorithm accesses a
+ * mesh, so that the algorithm is written once as a template on the mesh type
+ * and runs on every mesh of the library, without conversions and without
+ * virtual calls.
+ *
+ * Vertices and faces are identified by unsigned ids in the ranges
+ * [0, getNumberVertexIds()) and [0, getNumberFaceIds()); ids may have holes
+ * (the ids of the deleted elements of a Dcel), that are recognized with
+ * isVertex() and isFace(). A specialization of MeshTraits provides:
+ *
+ * - TRIANGLE_MESH: true if all the faces are triangles;
+ * - ADJACENCY: true if forEachAdjacentFace() is available;
+ * - getNumberVertexIds(m), getNumberFaceIds(m);
+ * - isVertex(m, v), isFace(m, f);
+ * - getVertex(m, v): the coordinates of a vertex;
+ * - getFaceNormal(m, f): the normal stored in the mesh;
+ * - getFaceSize(m, f): the number of vertices of a face;
+ * - forEachFaceVertex(m, f, fn): calls fn(v) on the vertices of a face, in
+ *   counterclockwise order;
+ * - forEachAdjacentFace(m, f, fn): calls fn(g) on the faces that share an
+ *   edge with f (only if ADJACENCY is true).
+ *
+ * Algorithms use the traits through the functions of this file:
+ *
+ * \code{.cpp}
+ * template <typename Mesh>
+ * double surfaceArea(const Mesh& mesh)
+ * {
+ *     double area = 0;
+ *     forEachMeshFace(mesh, [&](unsigned int f) {
+ *         area += meshFaceArea(mesh, f);
+ *     });
+ *     return area;
+ * }
+ * \endcode
+ *
+ * A new mesh type is supported by specializing MeshTraits for it. Classes
+ * derived from a mesh of the library (e.g. DrawableDcel) use the traits of
+ * their base class.
+ */
+template <typename Mesh, typename Enable = void>
+struct MeshTraits;
+
+template <>
+struct MeshTraits<Dcel>
+{
+    static const bool TRIANGLE_MESH = false;
+    static const bool ADJACENCY = true;
+
+    static unsigned int getNumberVertexIds(const Dcel& m);
+    static unsigned int getNumberFaceIds(const Dcel& m);
+    static bool isVertex(const Dcel& m, unsigned int v);
+    static bool isFace(const Dcel& m, unsigned int f);
+    static Pointd getVertex(const Dcel& m, unsigned int v);
+    static Vec3 getFaceNormal(const Dcel& m, unsigned int f);
+    static unsigned int getFaceSize(const Dcel& m, unsigned int f);
+    template <typename Function>
+    static void forEachFaceVertex(const Dcel& m, unsigned int f, Function fn);
+    template <typename Function>
+    static void forEachAdjacentFace(const Dcel& m, unsigned int f, Function fn);
+};
+
+template <>
+struct MeshTraits<CompactTriMesh>
+{
+    static const bool TRIANGLE_MESH = true;
+    static const bool ADJACENCY = true;
+
+    static unsigned int getNumberVertexIds(const CompactTriMesh& m);
+    static unsigned int getNumberFaceIds(const CompactTriMesh& m);
+    static bool isVertex(const CompactTriMesh& m, unsigned int v);
+    static bool isFace(const CompactTriMesh& m, unsigned int f);
+    static Pointd getVertex(const CompactTriMesh& m, unsigned int v);
+    static Vec3 getFaceNormal(const CompactTriMesh& m, unsigned int f);
+    static unsigned int getFaceSize(const CompactTriMesh& m, unsigned int f);
+    template <typename Function>
+    static void forEachFaceVertex(const CompactTriMesh& m, unsigned int f, Function fn);
+    template <typename Function>
+    static void forEachAdjacentFace(const CompactTriMesh& m, unsigned int f, Function fn);
+};
+
+#ifdef CG3_EIGENMESH_DEFINED
+template <>
+struct MeshTraits<SimpleEigenMesh>
+{
+    static const bool TRIANGLE_MESH = true;
+    static const bool ADJACENCY = false;
+
+    static unsigned int getNumberVertexIds(const SimpleEigenMesh& m);
+    static unsigned int getNumberFaceIds(const SimpleEigenMesh& m);
+    static bool isVertex(const SimpleEigenMesh& m, unsigned int v);
+    static bool isFace(const SimpleEigenMesh& m, unsigned int f);
+    static Pointd getVertex(const SimpleEigenMesh& m, unsigned int v);
+    static Vec3 getFaceNormal(const SimpleEigenMesh& m, unsigned int f);
+    static unsigned int getFaceSize(const SimpleEigenMesh& m, unsigned int f);
+    template <typename Function>
+    static void forEachFaceVertex(const SimpleEigenMesh& m, unsigned int f, Function fn);
+};
+
+template <typename Mesh>
+struct MeshTraits<Mesh, typename std::enable_if<std::is_base_of<SimpleEigenMesh, Mesh>::value>::type> :
+        public MeshTraits<SimpleEigenMesh>
+{
+};
+#endif // CG3_EIGENMESH_DEFINED
+
+template <typename Mesh>
+struct MeshTraits<Mesh, typename std::enable_if<std::is_base_of<Dcel, Mesh>::value>::type> :
+        public MeshTraits<Dcel>
+{
+};
+
+template <typename Mesh>
+struct MeshTraits<Mesh, typename std::enable_if<std::is_base_of<CompactTriMesh, Mesh>::value>::type> :
+        public MeshTraits<CompactTriMesh>
+{
+};
+
+template <typename Mesh, typename Function>
+void forEachMeshVertex(const Mesh& mesh, Function fn);
+
+template <typename Mesh, typename Function>
+void forEachMeshFace(const Mesh& mesh, Function fn);
+
+template <typename Mesh>
+unsigned int meshNumberFaces(const Mesh& mesh);
+
+template <typename Mesh>
+double meshFaceArea(const Mesh& mesh, unsigned int f);
+
+template <typename Mesh>
+BoundingBox meshBoundingBox(const Mesh& mesh);
+
+template <typename Mesh>
+void meshTriangulation(
+        const Mesh& mesh,
+        std::vector<Pointd>& vertices,
+        std::vector<std::array<unsigned int, 3>>& triangles,
+        std::vector<unsigned int>& triangleFaces);
+
+} //namespace cg3
+
+#include "mesh_traits_inline.tpp"
+
+#endif // CG3_MESH_TRAITS_H
@@ -0,0 +1,298 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "mesh_traits.h"
+
+namespace cg3 {
+
+/* Dcel: ids of the Dcel, with holes on the deleted elements */
+
+inline unsigned int MeshTraits<Dcel>::getNumberVertexIds(const Dcel& m)
+{
+    return m.getNumberVertexIds();
+}
+
+inline unsigned int MeshTraits<Dcel>::getNumberFaceIds(const Dcel& m)
+{
+    return m.getNumberFaceIds();
+}
+
+inline bool MeshTraits<Dcel>::isVertex(const Dcel& m, unsigned int v)
+{
+    return m.getVertex(v) != nullptr;
+}
+
+inline bool MeshTraits<Dcel>::isFace(const Dcel& m, unsigned int f)
+{
+    return m.getFace(f) != nullptr;
+}
+
+inline Pointd MeshTraits<Dcel>::getVertex(const Dcel& m, unsigned int v)
+{
+    return m.getVertex(v)->getCoordinate();
+}
+
+inline Vec3 MeshTraits<Dcel>::getFaceNormal(const Dcel& m, unsigned int f)
+{
+    return m.getFace(f)->getNormal();
+}
+
+inline unsigned int MeshTraits<Dcel>::getFaceSize(const Dcel& m, unsigned int f)
+{
+    return (unsigned int)m.getFace(f)->getNumberIncidentVertices();
+}
+
+template <typename Function>
+inline void MeshTraits<Dcel>::forEachFaceVertex(const Dcel& m, unsigned int f, Function fn)
+{
+    for (const Dcel::Vertex* v : m.getFace(f)->incidentVertexIterator())
+        fn(v->getId());
+}
+
+template <typename Function>
+inline void MeshTraits<Dcel>::forEachAdjacentFace(const Dcel& m, unsigned int f, Function fn)
+{
+    for (const Dcel::HalfEdge* he : m.getFace(f)->incidentHalfEdgeIterator())
+        if (he->getTwin() != nullptr && he->getTwin()->getFace() != nullptr)
+            fn(he->getTwin()->getFace()->getId());
+}
+
+/* CompactTriMesh: contiguous indices */
+
+inline unsigned int MeshTraits<CompactTriMesh>::getNumberVertexIds(const CompactTriMesh& m)
+{
+    return m.getNumberVertices();
+}
+
+inline unsigned int MeshTraits<CompactTriMesh>::getNumberFaceIds(const CompactTriMesh& m)
+{
+    return m.getNumberFaces();
+}
+
+inline bool MeshTraits<CompactTriMesh>::isVertex(const CompactTriMesh&, unsigned int)
+{
+    return true;
+}
+
+inline bool MeshTraits<CompactTriMesh>::isFace(const CompactTriMesh&, unsigned int)
+{
+    return true;
+}
+
+inline Pointd MeshTraits<CompactTriMesh>::getVertex(const CompactTriMesh& m, unsigned int v)
+{
+    return m.getVertex(v);
+}
+
+inline Vec3 MeshTraits<CompactTriMesh>::getFaceNormal(const CompactTriMesh& m, unsigned int f)
+{
+    return m.getFaceNormal(f);
+}
+
+inline unsigned int MeshTraits<CompactTriMesh>::getFaceSize(const CompactTriMesh&, unsigned int)
+{
+    return 3;
+}
+
+template <typename Function>
+inline void MeshTraits<CompactTriMesh>::forEachFaceVertex(const CompactTriMesh& m, unsigned int f, Function fn)
+{
+    fn(m.getFaceVertex(f, 0));
+    fn(m.getFaceVertex(f, 1));
+    fn(m.getFaceVertex(f, 2));
+}
+
+template <typename Function>
+inline void MeshTraits<CompactTriMesh>::forEachAdjacentFace(const CompactTriMesh& m, unsigned int f, Function fn)
+{
+    for (unsigned int i = 0; i < 3; i++) {
+        unsigned int twin = m.getTwin(CompactTriMesh::getHalfEdge(f, i));
+        if (twin != CompactTriMesh::NULL_ID)
+            fn(CompactTriMesh::getFace(twin));
+    }
+}
+
+#ifdef CG3_EIGENMESH_DEFINED
+/* SimpleEigenMesh and EigenMesh: contiguous indices */
+
+inline unsigned int MeshTraits<SimpleEigenMesh>::getNumberVertexIds(const SimpleEigenMesh& m)
+{
+    return m.getNumberVertices();
+}
+
+inline unsigned int MeshTraits<SimpleEigenMesh>::getNumberFaceIds(const SimpleEigenMesh& m)
+{
+    return m.getNumberFaces();
+}
+
+inline bool MeshTraits<SimpleEigenMesh>::isVertex(const SimpleEigenMesh&, unsigned int)
+{
+    return true;
+}
+
+inline bool MeshTraits<SimpleEigenMesh>::isFace(const SimpleEigenMesh&, unsigned int)
+{
+    return true;
+}
+
+inline Pointd MeshTraits<SimpleEigenMesh>::getVertex(const SimpleEigenMesh& m, unsigned int v)
+{
+    return m.getVertex(v);
+}
+
+inline Vec3 MeshTraits<SimpleEigenMesh>::getFaceNormal(const SimpleEigenMesh& m, unsigned int f)
+{
+    return m.getFaceNormal(f);
+}
+
+inline unsigned int MeshTraits<SimpleEigenMesh>::getFaceSize(const SimpleEigenMesh&, unsigned int)
+{
+    return 3;
+}
+
+template <typename Function>
+inline void MeshTraits<SimpleEigenMesh>::forEachFaceVertex(const SimpleEigenMesh& m, unsigned int f, Function fn)
+{
+    Pointi t = m.getFace(f);
+    fn((unsigned int)t.x());
+    fn((unsigned int)t.y());
+    fn((unsigned int)t.z());
+}
+#endif // CG3_EIGENMESH_DEFINED
+
+/**
+ * @brief forEachMeshVertex
+ * Calls fn(v) on the id of every vertex of the mesh.
+ */
+template <typename Mesh, typename Function>
+void forEachMeshVertex(const Mesh& mesh, Function fn)
+{
+    typedef MeshTraits<Mesh> Traits;
+    unsigned int n = Traits::getNumberVertexIds(mesh);
+    for (unsigned int v = 0; v < n; v++)
+        if (Traits::isVertex(mesh, v))
+            fn(v);
+}
+
+/**
+ * @brief forEachMeshFace
+ * Calls fn(f) on the id of every face of the mesh.
+ */
+template <typename Mesh, typename Function>
+void forEachMeshFace(const Mesh& mesh, Function fn)
+{
+    typedef MeshTraits<Mesh> Traits;
+    unsigned int n = Traits::getNumberFaceIds(mesh);
+    for (unsigned int f = 0; f < n; f++)
+        if (Traits::isFace(mesh, f))
+            fn(f);
+}
+
+/**
+ * @brief meshNumberFaces
+ * @return the number of faces of the mesh, without the holes of the ids
+ */
+template <typename Mesh>
+unsigned int meshNumberFaces(const Mesh& mesh)
+{
+    unsigned int n = 0;
+    forEachMeshFace(mesh, [&](unsigned int) {
+        n++;
+    });
+    return n;
+}
+
+/**
+ * @brief meshFaceArea
+ * @return the area of the face f, as the sum of the areas of the triangles
+ * of its fan triangulation
+ */
+template <typename Mesh>
+double meshFaceArea(const Mesh& mesh, unsigned int f)
+{
+    typedef MeshTraits<Mesh> Traits;
+    Pointd first, previous;
+    Vec3 cross;
+    unsigned int i = 0;
+    Traits::forEachFaceVertex(mesh, f, [&](unsigned int v) {
+        Pointd p = Traits::getVertex(mesh, v);
+        if (i == 0)
+            first = p;
+        else if (i >= 2)
+            cross += (previous - first).cross(p - first);
+        previous = p;
+        i++;
+    });
+    return cross.getLength() / 2;
+}
+
+template <typename Mesh>
+BoundingBox meshBoundingBox(const Mesh& mesh)
+{
+    typedef MeshTraits<Mesh> Traits;
+    BoundingBox bb;
+    bool empty = true;
+    forEachMeshVertex(mesh, [&](unsigned int v) {
+        Pointd p = Traits::getVertex(mesh, v);
+        if (empty) {
+            bb = BoundingBox(p, p);
+            empty = false;
+        }
+        else {
+            bb.min() = bb.min().min(p);
+            bb.max() = bb.max().max(p);
+        }
+    });
+    return bb;
+}
+
+/**
+ * @brief meshTriangulation
+ * Fan triangulation of the faces of the mesh.
+ * @param[out] vertices: coordinates of the vertices, indexed by vertex id
+ * (origin on the holes of the ids)
+ * @param[out] triangles: triangles, as triplets of vertex ids
+ * @param[out] triangleFaces: id of the face of every triangle
+ */
+template <typename Mesh>
+void meshTriangulation(
+        const Mesh& mesh,
+        std::vector<Pointd>& vertices,
+        std::vector<std::array<unsigned int, 3>>& triangles,
+        std::vector<unsigned int>& triangleFaces)
+{
+    typedef MeshTraits<Mesh> Traits;
+    vertices.assign(Traits::getNumberVertexIds(mesh), Pointd());
+    forEachMeshVertex(mesh, [&](unsigned int v) {
+        vertices[v] = Traits::getVertex(mesh, v);
+    });
+    triangles.clear();
+    triangleFaces.clear();
+    if (Traits::TRIANGLE_MESH) {
+        triangles.reserve(Traits::getNumberFaceIds(mesh));
+        triangleFaces.reserve(Traits::getNumberFaceIds(mesh));
+    }
+    forEachMeshFace(mesh, [&](unsigned int f) {
+        std::array<unsigned int, 3> t;
+        unsigned int i = 0;
+        Traits::forEachFaceVertex(mesh, f, [&](unsigned int v) {
+            if (i < 2) {
+                t[i] = v;
+            }
+            else {
+                if (i > 2)
+                    t[1] = t[2];
+                t[2] = v;
+                triangles.push_back(t);
+                triangleFaces.push_back(f);
+            }
+            i++;
+        });
+    });
+}
+
+} //namespace cg3
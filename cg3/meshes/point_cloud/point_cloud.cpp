@@ -0,0 +1,887 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "point_cloud.h"
+
+#include <cg3/data_structures/trees/kdtree.h>
+#include <cg3/geometry/spatial_hash.h>
+#include <cg3/utilities/lazy_tokenizer.h>
+#include <cg3/utilities/profiler.h>
+
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace cg3 {
+
+namespace internal {
+
+/* points processed by every task of estimateNormals */
+static const unsigned int POINT_CLOUD_CHUNK_SIZE = 1024;
+
+/* accessor of the KdTree on the indices of the points of a PointCloud */
+struct PointCloudAccessor
+{
+    PointCloudAccessor(const double* coordinates = nullptr) : coordinates(coordinates) {}
+    double operator()(unsigned int i, unsigned int dim) const { return coordinates[3*(size_t)i + dim]; }
+    const double* coordinates;
+};
+
+typedef KdTree<3, unsigned int, PointCloudAccessor> PointCloudKdTree;
+
+/**
+ * @brief Eigenvector of the smallest eigenvalue of the 3x3 symmetric matrix
+ * [a[0] a[1] a[2]; a[1] a[3] a[4]; a[2] a[4] a[5]]. The eigenvalue is
+ * computed in closed form, and the eigenvector is the largest cross product
+ * of two rows of A - lambda I.
+ */
+inline Vec3 smallestEigenvector(const std::array<double, 6>& a)
+{
+    double scale = 0;
+    for (double v : a)
+        scale = std::max(scale, std::abs(v));
+    if (scale == 0)
+        return Vec3(0, 0, 1);
+    double m00 = a[0] / scale, m01 = a[1] / scale, m02 = a[2] / scale;
+    double m11 = a[3] / scale, m12 = a[4] / scale, m22 = a[5] / scale;
+
+    //smallest eigenvalue (trigonometric solution of the characteristic equation)
+    double q = (m00 + m11 + m22) / 3;
+    double p1 = m01 * m01 + m02 * m02 + m12 * m12;
+    double p2 = (m00 - q) * (m00 - q) + (m11 - q) * (m11 - q) + (m22 - q) * (m22 - q) + 2 * p1;
+    double p = std::sqrt(p2 / 6);
+    double lambda = q;
+    if (p > 0) {
+        double b00 = (m00 - q) / p, b11 = (m11 - q) / p, b22 = (m22 - q) / p;
+        double b01 = m01 / p, b02 = m02 / p, b12 = m12 / p;
+        double det = b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02) + b02 * (b01 * b12 - b11 * b02);
+        double r = std::max(-1.0, std::min(1.0, det / 2));
+        double phi = std::acos(r) / 3;
+        lambda = q + 2 * p * std::cos(phi + 2 * M_PI / 3);
+    }
+
+    Vec3 r0(m00 - lambda, m01, m02);
+    Vec3 r1(m01, m11 - lambda, m12);
+    Vec3 r2(m02, m12, m22 - lambda);
+    Vec3 c[3] = {r0.cross(r1), r0.cross(r2), r1.cross(r2)};
+    unsigned int best = 0;
+    for (unsigned int i = 1; i < 3; i++)
+        if (c[i].getLengthSquared() > c[best].getLengthSquared())
+            best = i;
+    if (c[best].getLengthSquared() == 0)
+        return Vec3(0, 0, 1); //isotropic neighbourhood
+    c[best].normalize();
+    return c[best];
+}
+
+/* union find with path halving and union by size */
+class DisjointSets
+{
+public:
+    DisjointSets(unsigned int n) : parent(n), size(n, 1)
+    {
+        for (unsigned int i = 0; i < n; i++)
+            parent[i] = i;
+    }
+
+    unsigned int find(unsigned int i)
+    {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    bool merge(unsigned int a, unsigned int b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        if (size[a] < size[b])
+            std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+
+private:
+    std::vector<unsigned int> parent;
+    std::vector<unsigned int> size;
+};
+
+/* PLY */
+
+typedef enum {PLY_INT8, PLY_UINT8, PLY_INT16, PLY_UINT16, PLY_INT32, PLY_UINT32, PLY_FLOAT32, PLY_FLOAT64, PLY_UNKNOWN} PlyType;
+typedef enum {PLY_ASCII, PLY_BINARY_LITTLE_ENDIAN, PLY_BINARY_BIG_ENDIAN} PlyFormat;
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType type;
+    bool isList;
+    PlyType countType;
+};
+
+struct PlyElement
+{
+    std::string name;
+    size_t count;
+    std::vector<PlyProperty> properties;
+};
+
+inline PlyType plyType(const StringView& s)
+{
+    if (s == "char" || s == "int8") return PLY_INT8;
+    if (s == "uchar" || s == "uint8") return PLY_UINT8;
+    if (s == "short" || s == "int16") return PLY_INT16;
+    if (s == "ushort" || s == "uint16") return PLY_UINT16;
+    if (s == "int" || s == "int32") return PLY_INT32;
+    if (s == "uint" || s == "uint32") return PLY_UINT32;
+    if (s == "float" || s == "float32") return PLY_FLOAT32;
+    if (s == "double" || s == "float64") return PLY_FLOAT64;
+    return PLY_UNKNOWN;
+}
+
+inline unsigned int plyTypeSize(PlyType t)
+{
+    static const unsigned int sizes[] = {1, 1, 2, 2, 4, 4, 4, 8, 0};
+    return sizes[t];
+}
+
+inline bool isLittleEndian()
+{
+    std::uint16_t v = 1;
+    unsigned char c;
+    std::memcpy(&c, &v, 1);
+    return c == 1;
+}
+
+template <typename T>
+inline T plyRead(const char* p, bool swap)
+{
+    char b[sizeof(T)];
+    std::memcpy(b, p, sizeof(T));
+    if (swap)
+        std::reverse(b, b + sizeof(T));
+    T v;
+    std::memcpy(&v, b, sizeof(T));
+    return v;
+}
+
+inline double plyValue(const char* p, PlyType t, bool swap)
+{
+    switch (t) {
+    case PLY_INT8: return plyRead<std::int8_t>(p, swap);
+    case PLY_UINT8: return plyRead<std::uint8_t>(p, swap);
+    case PLY_INT16: return plyRead<std::int16_t>(p, swap);
+    case PLY_UINT16: return plyRead<std::uint16_t>(p, swap);
+    case PLY_INT32: return plyRead<std::int32_t>(p, swap);
+    case PLY_UINT32: return plyRead<std::uint32_t>(p, swap);
+    case PLY_FLOAT32: return plyRead<float>(p, swap);
+    case PLY_FLOAT64: return plyRead<double>(p, swap);
+    default: return 0;
+    }
+}
+
+template <typename T>
+inline void plyWrite(char* p, T v, bool swap)
+{
+    std::memcpy(p, &v, sizeof(T));
+    if (swap)
+        std::reverse(p, p + sizeof(T));
+}
+
+/* skips the items of an element that is not the vertex element */
+inline bool plySkipElement(std::ifstream& file, const PlyElement& e, PlyFormat format)
+{
+    if (format == PLY_ASCII) {
+        std::string line;
+        for (size_t i = 0; i < e.count; i++)
+            if (!std::getline(file, line))
+                return false;
+        return true;
+    }
+    bool swap = (format == PLY_BINARY_LITTLE_ENDIAN) != isLittleEndian();
+    char buffer[8];
+    for (size_t i = 0; i < e.count; i++) {
+        for (const PlyProperty& p : e.properties) {
+            if (p.isList) {
+                if (!file.read(buffer, plyTypeSize(p.countType)))
+                    return false;
+                size_t n = (size_t)plyValue(buffer, p.countType, swap);
+                file.seekg(n * plyTypeSize(p.type), std::ios_base::cur);
+            }
+            else
+                file.seekg(plyTypeSize(p.type), std::ios_base::cur);
+        }
+        if (!file)
+            return false;
+    }
+    return true;
+}
+
+} //namespace cg3::internal
+
+PointCloud::PointCloud() :
+    withNormals(false),
+    withColors(false)
+{
+}
+
+/**
+ * @brief PointCloud::PointCloud
+ * Creates a point cloud from the coordinates of its points, three for every
+ * point.
+ */
+PointCloud::PointCloud(const std::vector<double>& coordinates) :
+    coordinates(coordinates),
+    withNormals(false),
+    withColors(false)
+{
+    assert(coordinates.size() % 3 == 0);
+    updateBoundingBox();
+}
+
+PointCloud::PointCloud(const std::vector<Pointd>& points) :
+    coordinates(3 * points.size()),
+    withNormals(false),
+    withColors(false)
+{
+    parallelFor(std::size_t(0), points.size(), [&](std::size_t i) {
+        setPoint((unsigned int)i, points[i]);
+    });
+    updateBoundingBox();
+}
+
+PointCloud::PointCloud(const std::string& filename) :
+    withNormals(false),
+    withColors(false)
+{
+    loadFromFile(filename);
+}
+
+#ifdef CG3_EIGENMESH_DEFINED
+/**
+ * @brief PointCloud::PointCloud
+ * Creates a point cloud with the vertices of a mesh; faces are ignored.
+ */
+PointCloud::PointCloud(const SimpleEigenMesh& mesh) :
+    coordinates(3 * (size_t)mesh.getNumberVertices()),
+    withNormals(false),
+    withColors(false)
+{
+    parallelFor(0u, mesh.getNumberVertices(), [&](unsigned int i) {
+        setPoint(i, mesh.getVertex(i));
+    });
+    updateBoundingBox();
+}
+#endif
+
+void PointCloud::updateBoundingBox(const ParallelOptions& options)
+{
+    if (isEmpty()) {
+        boundingBox = BoundingBox();
+        return;
+    }
+    typedef std::array<double, 6> MinMax;
+    const double inf = std::numeric_limits<double>::infinity();
+    MinMax identity = {{inf, inf, inf, -inf, -inf, -inf}};
+    MinMax mm = parallelReduce(
+                0u, getNumberPoints(), identity,
+                [&](unsigned int i) {
+                    MinMax r;
+                    for (unsigned int j = 0; j < 3; j++)
+                        r[j] = r[j+3] = coordinates[3*i+j];
+                    return r;
+                },
+                [](const MinMax& a, const MinMax& b) {
+                    MinMax r;
+                    for (unsigned int j = 0; j < 3; j++) {
+                        r[j] = std::min(a[j], b[j]);
+                        r[j+3] = std::max(a[j+3], b[j+3]);
+                    }
+                    return r;
+                }, options);
+    boundingBox.setMin(mm[0], mm[1], mm[2]);
+    boundingBox.setMax(mm[3], mm[4], mm[5]);
+}
+
+/**
+ * @brief PointCloud::estimateNormals
+ * Computes the normal of every point as the direction of least variance of
+ * its k nearest neighbours (the eigenvector of the smallest eigenvalue of
+ * their covariance matrix). Neighbourhoods are found with a KdTree, and
+ * points are processed in parallel.
+ *
+ * Normals are not oriented consistently: see PointCloud::orientNormals.
+ */
+void PointCloud::estimateNormals(unsigned int k, const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("PointCloud::estimateNormals");
+    enableNormals();
+    unsigned int n = getNumberPoints();
+    if (n == 0)
+        return;
+    k = std::max(3u, std::min(k, n));
+
+    std::vector<unsigned int> keys(n);
+    parallelFor(0u, n, [&](unsigned int i) { keys[i] = i; }, options);
+    internal::PointCloudKdTree tree(keys, internal::PointCloudAccessor(coordinates.data()), 16, options);
+
+    const unsigned int chunk = internal::POINT_CLOUD_CHUNK_SIZE;
+    unsigned int nChunks = (n + chunk - 1) / chunk;
+    parallelFor(0u, nChunks, [&](unsigned int c) {
+        std::vector<unsigned int> neighbors;
+        std::vector<double> sqDists;
+        unsigned int end = std::min(n, (c + 1) * chunk);
+        for (unsigned int i = c * chunk; i < end; i++) {
+            tree.kNearestNeighbors(i, k, neighbors, sqDists);
+            Pointd centroid;
+            for (unsigned int j : neighbors)
+                centroid += getPoint(j);
+            centroid /= (double)neighbors.size();
+            std::array<double, 6> cov = {{0, 0, 0, 0, 0, 0}};
+            for (unsigned int j : neighbors) {
+                Vec3 d = getPoint(j) - centroid;
+                cov[0] += d.x() * d.x(); cov[1] += d.x() * d.y(); cov[2] += d.x() * d.z();
+                cov[3] += d.y() * d.y(); cov[4] += d.y() * d.z(); cov[5] += d.z() * d.z();
+            }
+            setNormal(i, internal::smallestEigenvector(cov));
+        }
+    }, ParallelOptions(options.nThreads, 1, options.deterministic));
+}
+
+/**
+ * @brief PointCloud::orientNormals
+ * Flips the normals of the points such that they are consistently oriented
+ * (Hoppe et al., Surface reconstruction from unorganized points, 1992).
+ *
+ * The edges of the k nearest neighbours graph are weighted with
+ * 1 - |ni . nj|, and a minimum spanning tree of the graph is computed with
+ * Kruskal's algorithm: in every connected component, the normal of the
+ * highest point is oriented towards +z, and orientations are propagated
+ * along the tree, where adjacent normals are almost parallel.
+ *
+ * The neighbours graph, the edge weights and the sorting of the edges are
+ * computed in parallel; the union find sweep and the propagation are linear
+ * and sequential.
+ */
+void PointCloud::orientNormals(unsigned int k, const ParallelOptions& options)
+{
+    CG3_PROFILE_SCOPE("PointCloud::orientNormals");
+    unsigned int n = getNumberPoints();
+    if (n == 0)
+        return;
+    if (!hasNormals())
+        estimateNormals(k, options);
+    k = std::max(1u, std::min(k, n - 1));
+    std::vector<unsigned int> graph = kNearestNeighborsGraph(k, options);
+
+    //an edge for every pair of neighbours, reported only once
+    auto isEdge = [&](unsigned int i, unsigned int j) {
+        if (j == internal::PointCloudKdTree::npos)
+            return false;
+        if (i < j)
+            return true;
+        const unsigned int* nj = graph.data() + (size_t)j * k;
+        return std::find(nj, nj + k, i) == nj + k;
+    };
+    std::vector<unsigned int> edgeCounts(n), edgeOffsets(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        unsigned int c = 0;
+        for (unsigned int l = 0; l < k; l++)
+            c += isEdge(i, graph[(size_t)i * k + l]) ? 1 : 0;
+        edgeCounts[i] = c;
+    }, options);
+    unsigned int nEdges = parallelExclusiveScan(
+                edgeCounts.begin(), edgeCounts.end(), edgeOffsets.begin(), 0u,
+                std::plus<unsigned int>(), options);
+    std::vector<unsigned int>().swap(edgeCounts);
+
+    struct Edge
+    {
+        float weight;
+        unsigned int a, b;
+    };
+    std::vector<Edge> edges(nEdges);
+    parallelFor(0u, n, [&](unsigned int i) {
+        unsigned int e = edgeOffsets[i];
+        Vec3 ni = getNormal(i);
+        for (unsigned int l = 0; l < k; l++) {
+            unsigned int j = graph[(size_t)i * k + l];
+            if (isEdge(i, j)) {
+                edges[e].weight = (float)(1 - std::abs(ni.dot(getNormal(j))));
+                edges[e].a = i;
+                edges[e].b = j;
+                e++;
+            }
+        }
+    }, options);
+    std::vector<unsigned int>().swap(graph);
+    std::vector<unsigned int>().swap(edgeOffsets);
+    parallelSort(edges.begin(), edges.end(), [](const Edge& e1, const Edge& e2) {
+        return e1.weight < e2.weight;
+    }, options);
+
+    //minimum spanning forest, as adjacency lists
+    internal::DisjointSets sets(n);
+    std::vector<unsigned int> treeOffsets(n + 1, 0);
+    std::vector<std::pair<unsigned int, unsigned int>> treeEdges;
+    treeEdges.reserve(n);
+    for (const Edge& e : edges) {
+        if (sets.merge(e.a, e.b)) {
+            treeEdges.push_back(std::make_pair(e.a, e.b));
+            treeOffsets[e.a + 1]++;
+            treeOffsets[e.b + 1]++;
+        }
+    }
+    std::vector<Edge>().swap(edges);
+    for (unsigned int i = 0; i < n; i++)
+        treeOffsets[i + 1] += treeOffsets[i];
+    std::vector<unsigned int> adjacency(treeOffsets[n]);
+    std::vector<unsigned int> pos(treeOffsets.begin(), treeOffsets.end() - 1);
+    for (const std::pair<unsigned int, unsigned int>& e : treeEdges) {
+        adjacency[pos[e.first]++] = e.second;
+        adjacency[pos[e.second]++] = e.first;
+    }
+
+    //root of every component: the highest point
+    std::vector<unsigned int> roots(n, internal::PointCloudKdTree::npos);
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int& r = roots[sets.find(i)];
+        if (r == internal::PointCloudKdTree::npos || coordinates[3*(size_t)i+2] > coordinates[3*(size_t)r+2])
+            r = i;
+    }
+
+    std::vector<bool> visited(n, false);
+    std::vector<unsigned int> stack;
+    for (unsigned int c = 0; c < n; c++) {
+        unsigned int root = roots[c];
+        if (root == internal::PointCloudKdTree::npos)
+            continue;
+        if (getNormal(root).z() < 0)
+            setNormal(root, -getNormal(root));
+        visited[root] = true;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            unsigned int i = stack.back();
+            stack.pop_back();
+            Vec3 ni = getNormal(i);
+            for (unsigned int a = treeOffsets[i]; a < treeOffsets[i + 1]; a++) {
+                unsigned int j = adjacency[a];
+                if (visited[j])
+                    continue;
+                visited[j] = true;
+                if (ni.dot(getNormal(j)) < 0)
+                    setNormal(j, -getNormal(j));
+                stack.push_back(j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief PointCloud::voxelGridDownsampling
+ * @return a point cloud with a point for every non empty cell of a uniform
+ * grid with cells of size voxelSize: the point is the centroid of the points
+ * of the cell, with their average color and the normalized sum of their
+ * normals. Points are sorted by cell.
+ */
+PointCloud PointCloud::voxelGridDownsampling(
+        double voxelSize,
+        const ParallelOptions& options) const
+{
+    CG3_PROFILE_SCOPE("PointCloud::voxelGridDownsampling");
+    assert(voxelSize > 0);
+    PointCloud res;
+    res.enableNormals(hasNormals());
+    res.enableColors(hasColors());
+    unsigned int n = getNumberPoints();
+    if (n == 0)
+        return res;
+
+    SpatialHash hash(voxelSize);
+    std::vector<Point<long long int>> cells(n);
+    std::vector<unsigned int> sorted(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        cells[i] = hash.cell(getPoint(i));
+        sorted[i] = i;
+    }, options);
+    parallelSort(sorted.begin(), sorted.end(), [&](unsigned int a, unsigned int b) {
+        return cells[a] < cells[b];
+    }, options);
+
+    //first point of every voxel in sorted
+    std::vector<unsigned int> isFirst(n), voxelIds(n);
+    parallelFor(0u, n, [&](unsigned int i) {
+        isFirst[i] = (i == 0 || cells[sorted[i]] != cells[sorted[i-1]]) ? 1 : 0;
+    }, options);
+    unsigned int nVoxels = parallelExclusiveScan(
+                isFirst.begin(), isFirst.end(), voxelIds.begin(), 0u,
+                std::plus<unsigned int>(), options);
+    std::vector<unsigned int> voxelBegins(nVoxels + 1);
+    parallelFor(0u, n, [&](unsigned int i) {
+        if (isFirst[i])
+            voxelBegins[voxelIds[i]] = i;
+    }, options);
+    voxelBegins[nVoxels] = n;
+    std::vector<Point<long long int>>().swap(cells);
+
+    res.coordinates.resize(3 * (size_t)nVoxels);
+    if (res.withNormals)
+        res.normals.resize(3 * (size_t)nVoxels);
+    if (res.withColors)
+        res.colors.resize(4 * (size_t)nVoxels);
+    parallelFor(0u, nVoxels, [&](unsigned int v) {
+        Pointd p;
+        Vec3 nr;
+        std::array<unsigned int, 4> c = {{0, 0, 0, 0}};
+        for (unsigned int s = voxelBegins[v]; s < voxelBegins[v+1]; s++) {
+            unsigned int i = sorted[s];
+            p += getPoint(i);
+            if (withNormals)
+                nr += getNormal(i);
+            if (withColors)
+                for (unsigned int j = 0; j < 4; j++)
+                    c[j] += colors[4*(size_t)i+j];
+        }
+        unsigned int size = voxelBegins[v+1] - voxelBegins[v];
+        res.setPoint(v, p / (double)size);
+        if (withNormals) {
+            nr.normalize();
+            res.setNormal(v, nr);
+        }
+        if (withColors)
+            res.setColor(v, Color(c[0] / size, c[1] / size, c[2] / size, c[3] / size));
+    }, options);
+    res.updateBoundingBox(options);
+    return res;
+}
+
+bool PointCloud::loadFromFile(const std::string& filename)
+{
+    std::string ext = filename.substr(filename.find_last_of(".") + 1);
+    if (ext == "ply" || ext == "PLY")
+        return loadFromPlyFile(filename);
+    else if (ext == "xyz" || ext == "XYZ")
+        return loadFromXyzFile(filename);
+    else
+        return false;
+}
+
+/**
+ * @brief PointCloud::loadFromPlyFile
+ * Loads the vertices of an ascii or binary PLY file, with their normals
+ * (nx, ny, nz) and colors (red, green, blue and optionally alpha) if present.
+ * Other elements, like faces, are ignored.
+ * Binary files are read with a single read of the vertex element, which is
+ * then decoded in parallel.
+ */
+bool PointCloud::loadFromPlyFile(const std::string& filename)
+{
+    CG3_PROFILE_SCOPE("PointCloud::loadFromPlyFile");
+    clear();
+    std::ifstream file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!file.is_open())
+        return false;
+
+    //header
+    std::string line;
+    if (!std::getline(file, line) || line.compare(0, 3, "ply") != 0)
+        return false;
+    internal::PlyFormat format = internal::PLY_ASCII;
+    std::vector<internal::PlyElement> elements;
+    bool endHeader = false;
+    while (!endHeader && std::getline(file, line)) {
+        LazyTokenizer tokenizer(line, " \t\r");
+        if (tokenizer.empty())
+            continue;
+        LazyTokenizer::iterator token = tokenizer.begin();
+        if (*token == "format") {
+            StringView f = *(++token);
+            if (f == "binary_little_endian")
+                format = internal::PLY_BINARY_LITTLE_ENDIAN;
+            else if (f == "binary_big_endian")
+                format = internal::PLY_BINARY_BIG_ENDIAN;
+        }
+        else if (*token == "element") {
+            internal::PlyElement e;
+            e.name = (++token)->toString();
+            e.count = stoul(*(++token));
+            elements.push_back(e);
+        }
+        else if (*token == "property") {
+            if (elements.empty())
+                return false;
+            internal::PlyProperty p;
+            p.isList = *(++token) == "list";
+            p.countType = internal::PLY_UNKNOWN;
+            if (p.isList) {
+                p.countType = internal::plyType(*(++token));
+                ++token;
+            }
+            p.type = internal::plyType(*token);
+            p.name = (++token)->toString();
+            if (p.type == internal::PLY_UNKNOWN || (p.isList && p.countType == internal::PLY_UNKNOWN))
+                return false;
+            elements.back().properties.push_back(p);
+        }
+        else if (*token == "end_header")
+            endHeader = true;
+    }
+    if (!endHeader)
+        return false;
+
+    for (const internal::PlyElement& e : elements) {
+        if (e.name != "vertex") {
+            if (!internal::plySkipElement(file, e, format))
+                return false;
+            continue;
+        }
+
+        //vertex element: role and offset of every property
+        enum {X, Y, Z, NX, NY, NZ, R, G, B, A, NONE};
+        std::vector<unsigned int> roles, offsets;
+        std::array<bool, 10> found{{false}};
+        unsigned int stride = 0;
+        for (const internal::PlyProperty& p : e.properties) {
+            if (p.isList)
+                return false;
+            unsigned int r = NONE;
+            if (p.name == "x") r = X;
+            else if (p.name == "y") r = Y;
+            else if (p.name == "z") r = Z;
+            else if (p.name == "nx") r = NX;
+            else if (p.name == "ny") r = NY;
+            else if (p.name == "nz") r = NZ;
+            else if (p.name == "red" || p.name == "r") r = R;
+            else if (p.name == "green" || p.name == "g") r = G;
+            else if (p.name == "blue" || p.name == "b") r = B;
+            else if (p.name == "alpha" || p.name == "a") r = A;
+            if (r != NONE)
+                found[r] = true;
+            roles.push_back(r);
+            offsets.push_back(stride);
+            stride += internal::plyTypeSize(p.type);
+        }
+        if (!found[X] || !found[Y] || !found[Z])
+            return false;
+        unsigned int n = (unsigned int)e.count;
+        coordinates.resize(3 * (size_t)n);
+        enableNormals(found[NX] && found[NY] && found[NZ]);
+        enableColors(found[R] && found[G] && found[B]);
+
+        //sets the value of the property l of the point i
+        auto set = [&](unsigned int i, unsigned int l, double v) {
+            unsigned int r = roles[l];
+            if (r <= Z)
+                coordinates[3*(size_t)i + r] = v;
+            else if (r <= NZ && withNormals)
+                normals[3*(size_t)i + r - NX] = (float)v;
+            else if (r <= A && withColors) {
+                internal::PlyType t = e.properties[l].type;
+                if (t == internal::PLY_FLOAT32 || t == internal::PLY_FLOAT64)
+                    v *= 255;
+                colors[4*(size_t)i + r - R] = (unsigned char)std::max(0.0, std::min(255.0, v));
+            }
+        };
+
+        if (format == internal::PLY_ASCII) {
+            for (unsigned int i = 0; i < n; ) {
+                if (!std::getline(file, line))
+                    return false;
+                LazyTokenizer tokenizer(line, " \t\r");
+                if (tokenizer.empty())
+                    continue;
+                LazyTokenizer::iterator token = tokenizer.begin();
+                for (unsigned int l = 0; l < roles.size(); l++, ++token) {
+                    if (token == tokenizer.end())
+                        return false;
+                    if (roles[l] != NONE)
+                        set(i, l, stod(*token));
+                }
+                i++;
+            }
+        }
+        else {
+            bool swap = (format == internal::PLY_BINARY_LITTLE_ENDIAN) != internal::isLittleEndian();
+            std::vector<char> buffer((size_t)stride * n);
+            if (!file.read(buffer.data(), buffer.size()))
+                return false;
+            parallelFor(0u, n, [&](unsigned int i) {
+                const char* item = buffer.data() + (size_t)stride * i;
+                for (unsigned int l = 0; l < roles.size(); l++)
+                    if (roles[l] != NONE)
+                        set(i, l, internal::plyValue(item + offsets[l], e.properties[l].type, swap));
+            });
+        }
+        updateBoundingBox();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief PointCloud::loadFromXyzFile
+ * Loads a XYZ file: every line contains the coordinates of a point, followed
+ * optionally by its normal, and then by its color (integers from 0 to 255).
+ * Empty lines and lines starting with '#' are ignored.
+ */
+bool PointCloud::loadFromXyzFile(const std::string& filename)
+{
+    CG3_PROFILE_SCOPE("PointCloud::loadFromXyzFile");
+    clear();
+    std::ifstream file(filename.c_str());
+    if (!file.is_open())
+        return false;
+    std::string line;
+    unsigned int nValues = 0;
+    std::array<double, 9> v;
+    while (std::getline(file, line)) {
+        LazyTokenizer tokenizer(line, " \t\r,");
+        if (tokenizer.empty() || tokenizer.begin()->front() == '#')
+            continue;
+        unsigned int c = 0;
+        for (LazyTokenizer::iterator token = tokenizer.begin(); token != tokenizer.end() && c < 9; ++token)
+            v[c++] = stod(*token);
+        if (nValues == 0) {
+            nValues = c >= 9 ? 9 : c >= 6 ? 6 : 3;
+            enableNormals(nValues >= 6);
+            enableColors(nValues == 9);
+        }
+        if (c < nValues) {
+            clear();
+            return false;
+        }
+        unsigned int i = addPoint(Pointd(v[0], v[1], v[2]));
+        if (withNormals)
+            setNormal(i, Vec3(v[3], v[4], v[5]));
+        if (withColors)
+            setColor(i, Color((unsigned char)v[6], (unsigned char)v[7], (unsigned char)v[8]));
+    }
+    updateBoundingBox();
+    return true;
+}
+
+/**
+ * @brief PointCloud::saveOnPlyFile
+ * Saves the point cloud on a PLY file, binary (little endian) by default.
+ * Coordinates are saved as double, normals as float and colors as uchar.
+ */
+bool PointCloud::saveOnPlyFile(const std::string& filename, bool binary) const
+{
+    CG3_PROFILE_SCOPE("PointCloud::saveOnPlyFile");
+    std::ofstream file(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+    if (!file.is_open())
+        return false;
+    unsigned int n = getNumberPoints();
+    file << "ply\n"
+         << "format " << (binary ? "binary_little_endian" : "ascii") << " 1.0\n"
+         << "element vertex " << n << "\n"
+         << "property double x\nproperty double y\nproperty double z\n";
+    if (withNormals)
+        file << "property float nx\nproperty float ny\nproperty float nz\n";
+    if (withColors)
+        file << "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n";
+    file << "end_header\n";
+
+    if (binary) {
+        bool swap = !internal::isLittleEndian();
+        size_t stride = 24 + (withNormals ? 12 : 0) + (withColors ? 4 : 0);
+        std::vector<char> buffer(stride * n);
+        parallelFor(0u, n, [&](unsigned int i) {
+            char* item = buffer.data() + stride * i;
+            for (unsigned int j = 0; j < 3; j++, item += 8)
+                internal::plyWrite(item, coordinates[3*(size_t)i+j], swap);
+            if (withNormals)
+                for (unsigned int j = 0; j < 3; j++, item += 4)
+                    internal::plyWrite(item, normals[3*(size_t)i+j], swap);
+            if (withColors)
+                std::memcpy(item, colors.data() + 4*(size_t)i, 4);
+        });
+        file.write(buffer.data(), buffer.size());
+    }
+    else {
+        file << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for (unsigned int i = 0; i < n; i++) {
+            file << coordinates[3*i] << " " << coordinates[3*i+1] << " " << coordinates[3*i+2];
+            if (withNormals)
+                file << " " << normals[3*i] << " " << normals[3*i+1] << " " << normals[3*i+2];
+            if (withColors)
+                file << " " << (int)colors[4*i] << " " << (int)colors[4*i+1] << " "
+                     << (int)colors[4*i+2] << " " << (int)colors[4*i+3];
+            file << "\n";
+        }
+    }
+    return (bool)file;
+}
+
+/**
+ * @brief PointCloud::saveOnXyzFile
+ * Saves coordinates, normals and colors (if present) of the points on a XYZ
+ * file, a point per line.
+ */
+bool PointCloud::saveOnXyzFile(const std::string& filename) const
+{
+    CG3_PROFILE_SCOPE("PointCloud::saveOnXyzFile");
+    std::ofstream file(filename.c_str());
+    if (!file.is_open())
+        return false;
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (unsigned int i = 0; i < getNumberPoints(); i++) {
+        file << coordinates[3*i] << " " << coordinates[3*i+1] << " " << coordinates[3*i+2];
+        if (withNormals || withColors) {
+            Vec3 nr = withNormals ? getNormal(i) : Vec3();
+            file << " " << nr.x() << " " << nr.y() << " " << nr.z();
+        }
+        if (withColors)
+            file << " " << (int)colors[4*i] << " " << (int)colors[4*i+1] << " " << (int)colors[4*i+2];
+        file << "\n";
+    }
+    return (bool)file;
+}
+
+/**
+ * @brief PointCloud::kNearestNeighborsGraph
+ * @return the k nearest neighbours of every point, excluding the point
+ * itself, in a single array of k indices per point; missing neighbours are
+ * KdTree::npos
+ */
+std::vector<unsigned int> PointCloud::kNearestNeighborsGraph(
+        unsigned int k,
+        const ParallelOptions& options) const
+{
+    unsigned int n = getNumberPoints();
+    std::vector<unsigned int> keys(n);
+    parallelFor(0u, n, [&](unsigned int i) { keys[i] = i; }, options);
+    internal::PointCloudKdTree tree(keys, internal::PointCloudAccessor(coordinates.data()), 16, options);
+    std::vector<unsigned int> knn = tree.batchKNearestNeighbors(keys, k + 1, 0, options);
+
+    std::vector<unsigned int> graph((size_t)n * k);
+    parallelFor(0u, n, [&](unsigned int i) {
+        const unsigned int* q = knn.data() + (size_t)i * (k + 1);
+        unsigned int* g = graph.data() + (size_t)i * k;
+        unsigned int c = 0;
+        for (unsigned int l = 0; l < k + 1 && c < k; l++)
+            if (q[l] != i)
+                g[c++] = q[l];
+    }, options);
+    return graph;
+}
+
+} //namespace cg3
@@ -0,0 +1,118 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_POINT_CLOUD_H
+#define CG3_POINT_CLOUD_H
+
+#include <string>
+#include <vector>
+
+#include <cg3/geometry/bounding_box.h>
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/color.h>
+#include <cg3/utilities/parallel.h>
+
+namespace cg3 {
+
+#ifdef CG3_EIGENMESH_DEFINED
+class SimpleEigenMesh;
+#endif
+
+/**
+ * @ingroup cg3meshes
+ * @brief The PointCloud class is a set of points with optional normals and
+ * colors, stored as a structure of arrays: coordinates in double, normals in
+ * float and colors in RGBA bytes, in a separate array each, like the
+ * attributes of CompactTriMesh. A point takes 24 bytes, plus 12 bytes if the
+ * cloud has normals and 4 bytes if it has colors.
+ *
+ * Point clouds are loaded from and saved on PLY (ascii and binary) and XYZ
+ * files. The processing methods run in parallel:
+ * - estimateNormals: PCA normals on the k nearest neighbours;
+ * - orientNormals: consistent orientation by propagation on a minimum
+ *   spanning tree of the k nearest neighbours graph;
+ * - voxelGridDownsampling: one point per cell of a uniform grid.
+ *
+ * \code{.cpp}
+ * cg3::PointCloud cloud("scan.ply");
+ * cloud = cloud.voxelGridDownsampling(0.01);
+ * cloud.estimateNormals(12);
+ * cloud.orientNormals(12);
+ * cloud.saveOnPlyFile("scan_normals.ply");
+ * \endcode
+ */
+class PointCloud
+{
+public:
+    PointCloud();
+    explicit PointCloud(const std::vector<double>& coordinates);
+    explicit PointCloud(const std::vector<Pointd>& points);
+    explicit PointCloud(const std::string& filename);
+    #ifdef CG3_EIGENMESH_DEFINED
+    explicit PointCloud(const SimpleEigenMesh& mesh);
+    #endif
+
+    unsigned int getNumberPoints() const;
+    bool isEmpty() const;
+    bool hasNormals() const;
+    bool hasColors() const;
+
+    Pointd getPoint(unsigned int i) const;
+    Vec3 getNormal(unsigned int i) const;
+    Color getColor(unsigned int i) const;
+    const BoundingBox& getBoundingBox() const;
+    const std::vector<double>& getCoordinates() const;
+    const std::vector<float>& getNormals() const;
+    const std::vector<unsigned char>& getColors() const;
+
+    unsigned int addPoint(const Pointd& p);
+    unsigned int addPoint(const Pointd& p, const Vec3& n);
+    unsigned int addPoint(const Pointd& p, const Vec3& n, const Color& c);
+    void setPoint(unsigned int i, const Pointd& p);
+    void setNormal(unsigned int i, const Vec3& n);
+    void setColor(unsigned int i, const Color& c);
+    void enableNormals(bool b = true);
+    void enableColors(bool b = true);
+    void reserve(unsigned int n);
+    void clear();
+
+    void updateBoundingBox(const ParallelOptions& options = ParallelOptions());
+
+    void estimateNormals(
+            unsigned int k = 10,
+            const ParallelOptions& options = ParallelOptions());
+    void orientNormals(
+            unsigned int k = 10,
+            const ParallelOptions& options = ParallelOptions());
+    PointCloud voxelGridDownsampling(
+            double voxelSize,
+            const ParallelOptions& options = ParallelOptions()) const;
+
+    bool loadFromFile(const std::string& filename);
+    bool loadFromPlyFile(const std::string& filename);
+    bool loadFromXyzFile(const std::string& filename);
+    bool saveOnPlyFile(const std::string& filename, bool binary = true) const;
+    bool saveOnXyzFile(const std::string& filename) const;
+
+protected:
+    std::vector<unsigned int> kNearestNeighborsGraph(
+            unsigned int k,
+            const ParallelOptions& options) const;
+
+    std::vector<double> coordinates;     //3 per point
+    std::vector<float> normals;          //3 per point, empty if no normals
+    std::vector<unsigned char> colors;   //4 per point, empty if no colors
+    bool withNormals;
+    bool withColors;
+    BoundingBox boundingBox;
+};
+
+} //namespace cg3
+
+#include "point_cloud_inline.tpp"
+
+#endif // CG3_POINT_CLOUD_H
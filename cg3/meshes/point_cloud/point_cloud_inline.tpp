@@ -0,0 +1,201 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "point_cloud.h"
+
+#include <cassert>
+
+namespace cg3 {
+
+inline unsigned int PointCloud::getNumberPoints() const
+{
+    return (unsigned int)(coordinates.size() / 3);
+}
+
+inline bool PointCloud::isEmpty() const
+{
+    return coordinates.empty();
+}
+
+inline bool PointCloud::hasNormals() const
+{
+    return withNormals;
+}
+
+inline bool PointCloud::hasColors() const
+{
+    return withColors;
+}
+
+inline Pointd PointCloud::getPoint(unsigned int i) const
+{
+    assert(i < getNumberPoints());
+    return Pointd(coordinates[3*i], coordinates[3*i+1], coordinates[3*i+2]);
+}
+
+inline Vec3 PointCloud::getNormal(unsigned int i) const
+{
+    assert(i < getNumberPoints() && hasNormals());
+    return Vec3(normals[3*i], normals[3*i+1], normals[3*i+2]);
+}
+
+inline Color PointCloud::getColor(unsigned int i) const
+{
+    assert(i < getNumberPoints() && hasColors());
+    return Color(colors[4*i], colors[4*i+1], colors[4*i+2], colors[4*i+3]);
+}
+
+inline const BoundingBox& PointCloud::getBoundingBox() const
+{
+    return boundingBox;
+}
+
+/**
+ * @brief PointCloud::getCoordinates
+ * @return the coordinates of the points, three for every point
+ */
+inline const std::vector<double>& PointCloud::getCoordinates() const
+{
+    return coordinates;
+}
+
+/**
+ * @brief PointCloud::getNormals
+ * @return the normals of the points, three for every point; empty if the
+ * point cloud has no normals
+ */
+inline const std::vector<float>& PointCloud::getNormals() const
+{
+    return normals;
+}
+
+/**
+ * @brief PointCloud::getColors
+ * @return the RGBA colors of the points, four for every point; empty if the
+ * point cloud has no colors
+ */
+inline const std::vector<unsigned char>& PointCloud::getColors() const
+{
+    return colors;
+}
+
+/**
+ * @brief PointCloud::addPoint
+ * Adds a point; if the point cloud has normals or colors, the normal of the
+ * point is null and its color is black.
+ * The bounding box is not updated.
+ * @return the index of the new point
+ */
+inline unsigned int PointCloud::addPoint(const Pointd& p)
+{
+    coordinates.push_back(p.x());
+    coordinates.push_back(p.y());
+    coordinates.push_back(p.z());
+    if (withNormals)
+        normals.resize(coordinates.size(), 0);
+    if (withColors) {
+        colors.resize(colors.size() + 3, 0);
+        colors.push_back(255);
+    }
+    return getNumberPoints() - 1;
+}
+
+inline unsigned int PointCloud::addPoint(const Pointd& p, const Vec3& n)
+{
+    enableNormals();
+    unsigned int i = addPoint(p);
+    setNormal(i, n);
+    return i;
+}
+
+inline unsigned int PointCloud::addPoint(const Pointd& p, const Vec3& n, const Color& c)
+{
+    enableColors();
+    unsigned int i = addPoint(p, n);
+    setColor(i, c);
+    return i;
+}
+
+inline void PointCloud::setPoint(unsigned int i, const Pointd& p)
+{
+    assert(i < getNumberPoints());
+    coordinates[3*i] = p.x();
+    coordinates[3*i+1] = p.y();
+    coordinates[3*i+2] = p.z();
+}
+
+inline void PointCloud::setNormal(unsigned int i, const Vec3& n)
+{
+    assert(i < getNumberPoints() && hasNormals());
+    normals[3*i] = (float)n.x();
+    normals[3*i+1] = (float)n.y();
+    normals[3*i+2] = (float)n.z();
+}
+
+inline void PointCloud::setColor(unsigned int i, const Color& c)
+{
+    assert(i < getNumberPoints() && hasColors());
+    colors[4*i] = (unsigned char)c.red();
+    colors[4*i+1] = (unsigned char)c.green();
+    colors[4*i+2] = (unsigned char)c.blue();
+    colors[4*i+3] = (unsigned char)c.alpha();
+}
+
+/**
+ * @brief PointCloud::enableNormals
+ * Adds (null) normals to the points, or removes them if b is false
+ */
+inline void PointCloud::enableNormals(bool b)
+{
+    if (b == withNormals)
+        return;
+    withNormals = b;
+    if (b)
+        normals.resize(coordinates.size(), 0);
+    else
+        std::vector<float>().swap(normals);
+}
+
+/**
+ * @brief PointCloud::enableColors
+ * Adds (black) colors to the points, or removes them if b is false
+ */
+inline void PointCloud::enableColors(bool b)
+{
+    if (b == withColors)
+        return;
+    withColors = b;
+    if (b) {
+        unsigned int n = getNumberPoints();
+        colors.resize(4 * n, 0);
+        for (unsigned int i = 0; i < n; i++)
+            colors[4*i+3] = 255;
+    }
+    else
+        std::vector<unsigned char>().swap(colors);
+}
+
+inline void PointCloud::reserve(unsigned int n)
+{
+    coordinates.reserve(3 * (size_t)n);
+    if (withNormals)
+        normals.reserve(3 * (size_t)n);
+    if (withColors)
+        colors.reserve(4 * (size_t)n);
+}
+
+inline void PointCloud::clear()
+{
+    coordinates.clear();
+    normals.clear();
+    colors.clear();
+    withNormals = false;
+    withColors = false;
+    boundingBox = BoundingBox();
+}
+
+} //namespace cg3
@@ -8,6 +8,9 @@
 
 #include "drawable_dcel.h"
 
+#include <cg3/meshes/dcel/algorithms/dcel_algorithms.h>
+#include <cg3/utilities/parallel.h>
+
 #ifdef __APPLE__
 #include <gl.h>
 #else
@@ -112,38 +115,35 @@ void DrawableDcel::update()
     facesWireframe.clear();
     trianglesFacesMap.clear();
     facesTrianglesMap.clear();
-    vertexCoordinates.reserve(getNumberVertices()*3);
-    vertexNormals.reserve(getNumberVertices()*3);
+    dcelAlgorithms::DenseIndex index(*this);
+    unsigned int nv = index.getNumberVertices();
+    vertexCoordinates.resize(nv*3);
+    vertexNormals.resize(nv*3);
+    vertexColors.resize(nv*3,0.5);
     triangles.reserve(getNumberFaces()*3);
     triangleColors.reserve(getNumberFaces()*3);
     triangleNormals.reserve(getNumberFaces()*3);
-    vertexColors.resize(getNumberVertices()*3,0.5);
     facesWireframe.reserve(getNumberHalfEdges());
     trianglesFacesMap.reserve(getNumberFaces());
-    std::map<int, int> v_ids;
-    int vi = 0;
-
-    for (const Dcel::Vertex* v : vertexIterator()) {
-        Pointd p = v->getCoordinate();
-        Vec3 n = v->getNormal();
-        vertexCoordinates.push_back(p.x());
-        vertexCoordinates.push_back(p.y());
-        vertexCoordinates.push_back(p.z());
-        vertexNormals.push_back(n.x());
-        vertexNormals.push_back(n.y());
-        vertexNormals.push_back(n.z());
 
-        v_ids[v->getId()] = vi;
-        vi++;
-    }
+    parallelFor(0u, nv, [&](unsigned int i) {
+        Pointd p = index.vertex(i)->getCoordinate();
+        Vec3 n = index.vertex(i)->getNormal();
+        vertexCoordinates[i*3] = p.x();
+        vertexCoordinates[i*3+1] = p.y();
+        vertexCoordinates[i*3+2] = p.z();
+        vertexNormals[i*3] = n.x();
+        vertexNormals[i*3+1] = n.y();
+        vertexNormals[i*3+2] = n.z();
+    });
 
     unsigned int actualTriangle = 0;
     #ifdef CG3_CGAL_DEFINED
     for (const Dcel::Face* f : faceIterator()) {
         for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator()) {
             unsigned int p1, p2;
-                p1 = v_ids[he->getFromVertex()->getId()];
-                p2 = v_ids[he->getToVertex()->getId()];
+                p1 = index.vertexIndex(he->getFromVertex());
+                p2 = index.vertexIndex(he->getToVertex());
                 std::pair<unsigned int, unsigned int> edge(p1,p2);
                 facesWireframe.push_back(edge);
             }
@@ -151,7 +151,7 @@ void DrawableDcel::update()
 
         if (f->isTriangle()){
             for (const Dcel::Vertex* v : f->incidentVertexIterator())
-                triangles.push_back(v_ids[v->getId()]);
+                triangles.push_back(index.vertexIndex(v));
             triangleColors.push_back(f->getColor().redF());
             triangleColors.push_back(f->getColor().greenF());
             triangleColors.push_back(f->getColor().blueF());
@@ -173,9 +173,9 @@ void DrawableDcel::update()
                 const Dcel::Vertex* v1 = t[0];
                 const Dcel::Vertex* v2 = t[1];
                 const Dcel::Vertex* v3 = t[2];
-                triangles.push_back(v_ids[v1->getId()]);
-                triangles.push_back(v_ids[v3->getId()]);
-                triangles.push_back(v_ids[v2->getId()]);
+                triangles.push_back(index.vertexIndex(v1));
+                triangles.push_back(index.vertexIndex(v3));
+                triangles.push_back(index.vertexIndex(v2));
                 trianglesFacesMap.push_back(f->getId());
                 triangleColors.push_back(f->getColor().redF());
                 triangleColors.push_back(f->getColor().greenF());
@@ -201,22 +201,31 @@ void DrawableDcel::update()
         }
     }
     #else
-    for (const Dcel::Face* f : faceIterator()) {
+    unsigned int nf = index.getNumberFaces();
+    triangles.resize(nf*3);
+    triangleColors.resize(nf*3);
+    triangleNormals.resize(nf*3);
+    trianglesFacesMap.resize(nf);
+    parallelFor(0u, nf, [&](unsigned int i) {
+        const Dcel::Face* f = index.face(i);
         Dcel::Face::ConstIncidentVertexIterator vit = f->incidentVertexBegin();
-        triangles.push_back(v_ids[(*vit)->getId()]);
+        triangles[i*3] = index.vertexIndex(*vit);
         ++vit;
-        triangles.push_back(v_ids[(*vit)->getId()]);
+        triangles[i*3+1] = index.vertexIndex(*vit);
         ++vit;
-        triangles.push_back(v_ids[(*vit)->getId()]);
-        triangleColors.push_back(f->getColor().redF());
-        triangleColors.push_back(f->getColor().greenF());
-        triangleColors.push_back(f->getColor().blueF());
-        triangleNormals.push_back(f->getNormal().x());
-        triangleNormals.push_back(f->getNormal().y());
-        triangleNormals.push_back(f->getNormal().z());
-        trianglesFacesMap.push_back(f->getId());
-        facesTrianglesMap[f->getId()] = actualTriangle++;
-    }
+        triangles[i*3+2] = index.vertexIndex(*vit);
+        Color c = f->getColor();
+        Vec3 n = f->getNormal();
+        triangleColors[i*3] = c.redF();
+        triangleColors[i*3+1] = c.greenF();
+        triangleColors[i*3+2] = c.blueF();
+        triangleNormals[i*3] = n.x();
+        triangleNormals[i*3+1] = n.y();
+        triangleNormals[i*3+2] = n.z();
+        trianglesFacesMap[i] = f->getId();
+    });
+    for (unsigned int i = 0; i < nf; i++)
+        facesTrianglesMap[index.face(i)->getId()] = actualTriangle++;
     #endif
 }
 